@@ -0,0 +1,201 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/aio.h"
+#include "mpio/os.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_FILE_PATH "mpio-bench-aio.bin"
+#define BENCH_FILE_SIZE (64 * 1024 * 1024)
+#define BENCH_BLOCK_SIZE 4096
+#define BENCH_READ_COUNT 32768
+#define BENCH_MAX_DEPTH 128
+
+static int64_t* offsets = NULL;
+static uint8_t* buffers = NULL;
+
+inline static bool createBenchFile(const char* filePath)
+{
+	FILE* file = openFile(filePath, "wb");
+	if (!file)
+		return false;
+
+	uint8_t* block = malloc(1024 * 1024);
+	if (!block)
+	{
+		closeFile(file);
+		return false;
+	}
+
+	memset(block, 0xAB, 1024 * 1024);
+	for (int i = 0; i < BENCH_FILE_SIZE / (1024 * 1024); i++)
+		fwrite(block, 1, 1024 * 1024, file);
+	free(block); closeFile(file);
+	return true;
+}
+
+inline static void printResult(const char* name, int depth, double time)
+{
+	double megabytes = (double)BENCH_READ_COUNT * BENCH_BLOCK_SIZE / (1024.0 * 1024.0);
+	printf("%-12s %5d %10.3lf %10.1lf %10.0lf\n", name, depth, time * 1000.0,
+		megabytes / time, (double)BENCH_READ_COUNT / time);
+}
+
+inline static bool benchFread(const char* filePath)
+{
+	FILE* file = openFile(filePath, "rb");
+	if (!file)
+		return false;
+
+	double startTime = getCurrentClock();
+	for (int i = 0; i < BENCH_READ_COUNT; i++)
+	{
+		if (seekFile(file, offsets[i], SEEK_SET) != 0 ||
+			fread(buffers, 1, BENCH_BLOCK_SIZE, file) != BENCH_BLOCK_SIZE)
+		{
+			closeFile(file);
+			return false;
+		}
+	}
+	double time = getCurrentClock() - startTime;
+
+	closeFile(file);
+	printResult("fread", 1, time);
+	return true;
+}
+inline static bool benchAio(const char* filePath, uint32_t depth, bool useThreadPool)
+{
+	AioQueue aioQueue = createAioQueue(depth, useThreadPool);
+	if (!aioQueue)
+		return false;
+	if (!useThreadPool && getAioQueueBackend(aioQueue) != IO_URING_AIO_BACKEND)
+	{
+		destroyAioQueue(aioQueue);
+		return true;
+	}
+
+	FILE* file = openFile(filePath, "rb");
+	if (!file)
+	{
+		destroyAioQueue(aioQueue);
+		return false;
+	}
+
+	AioRequest requests[BENCH_MAX_DEPTH];
+	AioCompletion completions[BENCH_MAX_DEPTH];
+	uint32_t freeSlots[BENCH_MAX_DEPTH];
+	for (uint32_t i = 0; i < depth; i++)
+		freeSlots[i] = i;
+	uint32_t freeSlotCount = depth;
+
+	int readIndex = 0, completeCount = 0;
+	double startTime = getCurrentClock();
+
+	while (completeCount < BENCH_READ_COUNT)
+	{
+		uint32_t requestCount = 0;
+		while (freeSlotCount > 0 && readIndex < BENCH_READ_COUNT)
+		{
+			uint32_t slot = freeSlots[--freeSlotCount];
+			AioRequest* request = &requests[requestCount++];
+			request->buffer = buffers + (size_t)slot * BENCH_BLOCK_SIZE;
+			request->userData = (void*)(size_t)slot;
+			request->offset = offsets[readIndex++];
+			request->size = BENCH_BLOCK_SIZE;
+			request->file = getFileHandle(file);
+			request->operation = READ_AIO_OPERATION;
+		}
+
+		uint32_t submitCount = submitAioRequests(aioQueue, requests, requestCount);
+		for (uint32_t i = submitCount; i < requestCount; i++)
+		{
+			freeSlots[freeSlotCount++] = (uint32_t)(size_t)requests[i].userData;
+			readIndex--;
+		}
+
+		uint32_t count = waitAioCompletions(aioQueue, completions, depth, 1);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (completions[i].result != BENCH_BLOCK_SIZE)
+			{
+				closeFile(file); destroyAioQueue(aioQueue);
+				return false;
+			}
+			freeSlots[freeSlotCount++] = (uint32_t)(size_t)completions[i].userData;
+		}
+		completeCount += (int)count;
+	}
+	double time = getCurrentClock() - startTime;
+
+	closeFile(file);
+	destroyAioQueue(aioQueue);
+	printResult(useThreadPool ? "thread-pool" : "io_uring", (int)depth, time);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	// Note: Pass existing file path to benchmark cold (not page cached) reads.
+	const char* filePath = argc > 1 ? argv[1] : BENCH_FILE_PATH;
+	if (argc <= 1 && !createBenchFile(filePath))
+	{
+		printf("Failed to create benchmark file.\n");
+		return EXIT_FAILURE;
+	}
+
+	FILE* file = openFile(filePath, "rb");
+	if (!file)
+	{
+		printf("Failed to open benchmark file.\n");
+		return EXIT_FAILURE;
+	}
+	seekFile(file, 0, SEEK_END);
+	int64_t blockCount = tellFile(file) / BENCH_BLOCK_SIZE;
+	closeFile(file);
+
+	offsets = malloc(BENCH_READ_COUNT * sizeof(int64_t));
+	buffers = malloc((size_t)BENCH_MAX_DEPTH * BENCH_BLOCK_SIZE);
+	if (!offsets || !buffers || blockCount == 0)
+	{
+		printf("Failed to allocate benchmark buffers.\n");
+		return EXIT_FAILURE;
+	}
+
+	srand(1);
+	for (int i = 0; i < BENCH_READ_COUNT; i++)
+		offsets[i] = (int64_t)(((uint64_t)rand() * (uint64_t)RAND_MAX + rand()) % blockCount) * BENCH_BLOCK_SIZE;
+
+	printf("Random %d byte reads: %d\n", BENCH_BLOCK_SIZE, BENCH_READ_COUNT);
+	printf("%-12s %5s %10s %10s %10s\n", "Method", "Depth", "Time (ms)", "MB/s", "IOPS");
+
+	bool result = benchFread(filePath);
+	for (uint32_t depth = 1; depth <= BENCH_MAX_DEPTH; depth *= 2)
+		result &= benchAio(filePath, depth, false);
+	for (uint32_t depth = 1; depth <= BENCH_MAX_DEPTH; depth *= 2)
+		result &= benchAio(filePath, depth, true);
+
+	free(buffers); free(offsets);
+	if (argc <= 1)
+		remove(filePath);
+
+	if (!result)
+	{
+		printf("Failed to run AIO benchmark.\n");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
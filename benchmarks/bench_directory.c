@@ -0,0 +1,188 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/directory.h"
+#include "mpio/os.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if __linux__ || __APPLE__
+#include <unistd.h>
+#define removeBenchDirectory(path) (rmdir(path) == 0)
+#elif _WIN32
+#include <windows.h>
+#define removeBenchDirectory(path) (RemoveDirectoryA(path) != FALSE)
+#endif
+
+#define BENCH_DIRECTORY_PATH "mpio-bench-directory"
+#define BENCH_FANOUT 100 // 100 * 100 directories with 100 files = 1M files.
+#define BENCH_REPEAT_COUNT 3
+
+typedef bool(*TreeFunction)(const char* path, bool isDirectory);
+
+static bool createTreeEntry(const char* path, bool isDirectory)
+{
+	if (isDirectory)
+		return createDirectory(path);
+	FILE* file = fopen(path, "wb");
+	if (!file)
+		return false;
+	fclose(file);
+	return true;
+}
+static bool removeTreeEntry(const char* path, bool isDirectory)
+{
+	if (isDirectory)
+		return removeBenchDirectory(path);
+	return remove(path) == 0;
+}
+
+inline static bool visitBenchTree(TreeFunction function, bool isRemoving)
+{
+	char path[256];
+	if (!isRemoving && !function(BENCH_DIRECTORY_PATH, true))
+		return false;
+
+	for (int i = 0; i < BENCH_FANOUT; i++)
+	{
+		snprintf(path, sizeof(path), BENCH_DIRECTORY_PATH "/%d", i);
+		if (!isRemoving && !function(path, true))
+			return false;
+
+		for (int j = 0; j < BENCH_FANOUT; j++)
+		{
+			snprintf(path, sizeof(path), BENCH_DIRECTORY_PATH "/%d/%d", i, j);
+			if (!isRemoving && !function(path, true))
+				return false;
+
+			for (int k = 0; k < BENCH_FANOUT; k++)
+			{
+				snprintf(path, sizeof(path), BENCH_DIRECTORY_PATH "/%d/%d/file-%d.bin", i, j, k);
+				if (!function(path, false))
+					return false;
+			}
+
+			snprintf(path, sizeof(path), BENCH_DIRECTORY_PATH "/%d/%d", i, j);
+			if (isRemoving && !function(path, true))
+				return false;
+		}
+
+		snprintf(path, sizeof(path), BENCH_DIRECTORY_PATH "/%d", i);
+		if (isRemoving && !function(path, true))
+			return false;
+	}
+	return !isRemoving || function(BENCH_DIRECTORY_PATH, true);
+}
+
+inline static void printResult(const char* name, int threadCount, uint64_t entryCount, double time, double singleTime)
+{
+	printf("%-10s %7d %10llu %10.3lf %12.0lf %8.2lfx\n", name, threadCount, (unsigned long long)entryCount,
+		time * 1000.0, (double)entryCount / time, singleTime / time);
+}
+
+inline static bool benchIterator(const char* path, double* singleTime)
+{
+	double bestTime = 0.0;
+	uint64_t entryCount = 0;
+	for (int i = 0; i < BENCH_REPEAT_COUNT; i++)
+	{
+		double startTime = getCurrentClock();
+		DirectoryIterator directoryIterator = openDirectoryIterator(path, true);
+		if (!directoryIterator)
+			return false;
+
+		DirectoryEntry entry;
+		entryCount = 0;
+		while (nextDirectoryEntry(directoryIterator, &entry))
+			entryCount++;
+		closeDirectoryIterator(directoryIterator);
+
+		double time = getCurrentClock() - startTime;
+		if (i == 0 || time < bestTime)
+			bestTime = time;
+	}
+
+	*singleTime = bestTime;
+	printResult("iterator", 1, entryCount, bestTime, bestTime);
+	return true;
+}
+inline static bool benchWalker(const char* path, int threadCount, double singleTime)
+{
+	// Note: Zero worker count means the default, so the single thread walk runs without the job system.
+	JobSystem jobSystem = NULL;
+	if (threadCount > 1)
+	{
+		jobSystem = createJobSystem((uint32_t)threadCount - 1, false);
+		if (!jobSystem)
+			return false;
+	}
+
+	double bestTime = 0.0;
+	DirectoryWalkStats stats;
+	for (int i = 0; i < BENCH_REPEAT_COUNT; i++)
+	{
+		double startTime = getCurrentClock();
+		if (!walkDirectory(jobSystem, path, NULL, NULL, NULL, &stats))
+		{
+			destroyJobSystem(jobSystem);
+			return false;
+		}
+
+		double time = getCurrentClock() - startTime;
+		if (i == 0 || time < bestTime)
+			bestTime = time;
+	}
+
+	destroyJobSystem(jobSystem);
+	printResult("walker", threadCount, stats.entryCount, bestTime, singleTime);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	// Note: Pass existing directory path to benchmark cold (not cached) directory reads.
+	const char* path = argc > 1 ? argv[1] : BENCH_DIRECTORY_PATH;
+	if (argc <= 1)
+	{
+		printf("Generating %d files...\n", BENCH_FANOUT * BENCH_FANOUT * BENCH_FANOUT);
+		if (!visitBenchTree(createTreeEntry, false))
+		{
+			printf("Failed to create benchmark directory tree.\n");
+			visitBenchTree(removeTreeEntry, true);
+			return EXIT_FAILURE;
+		}
+	}
+
+	printf("Directory tree walk: %s\n", path);
+	printf("%-10s %7s %10s %10s %12s %9s\n", "Method", "Threads", "Entries", "Time (ms)", "Entries/s", "Speedup");
+
+	double singleTime = 0.0;
+	bool result = benchIterator(path, &singleTime);
+
+	// Note: Directory reads block on I/O, so more threads than CPUs can still help on cold storage.
+	int maxThreadCount = getLogicalCpuCount() * 2;
+	for (int i = 1; i <= maxThreadCount && result; i *= 2)
+		result &= benchWalker(path, i, singleTime);
+
+	if (argc <= 1)
+		visitBenchTree(removeTreeEntry, true);
+
+	if (!result)
+	{
+		printf("Failed to run directory benchmark.\n");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/jobs.h"
+#include "mpio/os.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_JOB_COUNT 1000000
+#define BENCH_WORK_SIZE (16 * 1024 * 1024)
+
+static float* workData = NULL;
+
+static void emptyJob(void* argument) { (void)argument; }
+static void emptyRange(void* argument, uint32_t begin, uint32_t end) { (void)argument; (void)begin; (void)end; }
+
+static void workRange(void* argument, uint32_t begin, uint32_t end)
+{
+	(void)argument;
+	for (uint32_t i = begin; i < end; i++)
+		workData[i] = sqrtf((float)i) * 0.5f + sinf(workData[i]);
+}
+
+typedef struct SpawnData
+{
+	JobSystem jobSystem;
+	JobCounter jobCounter;
+} SpawnData;
+
+static void spawnJob(void* argument)
+{
+	SpawnData* data = (SpawnData*)argument;
+	for (int i = 0; i < BENCH_JOB_COUNT; i++)
+		runJob(data->jobSystem, emptyJob, NULL, data->jobCounter, NULL);
+}
+
+inline static bool benchOverhead(JobSystem jobSystem)
+{
+	JobCounter jobCounter = createJobCounter();
+	if (!jobCounter)
+		return false;
+
+	double startTime = getCurrentClock();
+	for (int i = 0; i < BENCH_JOB_COUNT; i++)
+		runJob(jobSystem, emptyJob, NULL, jobCounter, NULL);
+	waitJobCounter(jobSystem, jobCounter);
+	double time = getCurrentClock() - startTime;
+	printf("%-24s %10.1lf\n", "External run + wait", time * 1000000000.0 / BENCH_JOB_COUNT);
+
+	SpawnData data;
+	data.jobSystem = jobSystem;
+	data.jobCounter = jobCounter;
+
+	startTime = getCurrentClock();
+	runJob(jobSystem, spawnJob, &data, jobCounter, NULL);
+	waitJobCounter(jobSystem, jobCounter);
+	time = getCurrentClock() - startTime;
+	printf("%-24s %10.1lf\n", "Worker run + wait", time * 1000000000.0 / BENCH_JOB_COUNT);
+
+	startTime = getCurrentClock();
+	parallelFor(jobSystem, emptyRange, NULL, BENCH_JOB_COUNT, 1);
+	time = getCurrentClock() - startTime;
+	printf("%-24s %10.1lf\n", "Parallel for index", time * 1000000000.0 / BENCH_JOB_COUNT);
+
+	destroyJobCounter(jobCounter);
+	return true;
+}
+
+inline static bool benchScaling(int threadCount, double* singleTime)
+{
+	double time;
+	if (threadCount == 1)
+	{
+		double startTime = getCurrentClock();
+		workRange(NULL, 0, BENCH_WORK_SIZE);
+		time = getCurrentClock() - startTime;
+		*singleTime = time;
+	}
+	else
+	{
+		JobSystem jobSystem = createJobSystem((uint32_t)threadCount - 1, false);
+		if (!jobSystem)
+			return false;
+
+		double startTime = getCurrentClock();
+		parallelFor(jobSystem, workRange, NULL, BENCH_WORK_SIZE, 1024);
+		time = getCurrentClock() - startTime;
+		destroyJobSystem(jobSystem);
+	}
+
+	printf("%7d %10.3lf %8.2lfx\n", threadCount, time * 1000.0, *singleTime / time);
+	return true;
+}
+
+int main()
+{
+	workData = calloc(BENCH_WORK_SIZE, sizeof(float));
+	JobSystem jobSystem = createJobSystem(0, true);
+	if (!workData || !jobSystem)
+	{
+		printf("Failed to create job system.\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("Job overhead (%d empty jobs, %u workers)\n", BENCH_JOB_COUNT, getJobSystemWorkerCount(jobSystem));
+	printf("%-24s %10s\n", "Method", "ns / job");
+	bool result = benchOverhead(jobSystem);
+	destroyJobSystem(jobSystem);
+
+	printf("\nParallel for scaling (%d elements)\n", BENCH_WORK_SIZE);
+	printf("%7s %10s %9s\n", "Threads", "Time (ms)", "Speedup");
+
+	double singleTime = 0.0;
+	int threadCount = getLogicalCpuCount();
+	for (int i = 1; i <= threadCount; i++)
+		result &= benchScaling(i, &singleTime);
+
+	free(workData);
+	if (!result)
+	{
+		printf("Failed to run jobs benchmark.\n");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
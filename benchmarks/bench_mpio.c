@@ -0,0 +1,340 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/defines.h"
+#include "mpio/os.h"
+#include "mpio/memory.h"
+#include "mpio/directory.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_APP_NAME "mpio-bench"
+#define BENCH_MAX_RESULT_COUNT 64
+#define BENCH_DEFAULT_SAMPLE_COUNT 50
+#define BENCH_MAX_ITERATION_COUNT (1 << 24)
+#define BENCH_WARMUP_TIME 20000000 // Note: In nanoseconds.
+#define BENCH_SAMPLE_TIME 1000000 // Note: In nanoseconds.
+#define BENCH_ALLOCATION_SIZE 64
+#define BENCH_ARENA_FRAME_SIZE (1024 * 1024)
+
+typedef void(*BenchFunction)(void* argument);
+
+typedef struct BenchResult
+{
+	const char* name;
+	int64_t iterationCount;
+	double minimum;
+	double median;
+	double p99;
+	double mean;
+	double deviation;
+} BenchResult;
+
+static BenchResult results[BENCH_MAX_RESULT_COUNT];
+static int resultCount = 0;
+static int sampleCount = BENCH_DEFAULT_SAMPLE_COUNT;
+static const char* nameFilter = NULL;
+static char* appDataDirectory = NULL;
+static FILE* logFile = NULL;
+static volatile int64_t benchSink = 0; // Note: Prevents compiler from removing benchmarked calls.
+
+//**********************************************************************************************************************
+static int compareSamples(const void* a, const void* b)
+{
+	double l = *(const double*)a, r = *(const double*)b;
+	return (l > r) - (l < r);
+}
+
+inline static int64_t measureSample(BenchFunction function, void* argument, int64_t iterationCount)
+{
+	int64_t startTime = getCurrentClockNs();
+	for (int64_t i = 0; i < iterationCount; i++)
+		function(argument);
+	return getCurrentClockNs() - startTime;
+}
+
+// Note: Warms up caches and calibrates iteration count so that each sample lasts at least BENCH_SAMPLE_TIME.
+static bool runBench(const char* name, BenchFunction function, void* argument)
+{
+	if (nameFilter && !strstr(name, nameFilter))
+		return true;
+	if (resultCount >= BENCH_MAX_RESULT_COUNT)
+		return false;
+
+	int64_t iterationCount = 1, warmupTime = 0;
+	while (warmupTime < BENCH_WARMUP_TIME)
+	{
+		int64_t time = measureSample(function, argument, iterationCount);
+		if (time < BENCH_SAMPLE_TIME && iterationCount < BENCH_MAX_ITERATION_COUNT)
+			iterationCount *= 2;
+		warmupTime += time;
+	}
+
+	double* samples = malloc(sampleCount * sizeof(double));
+	if (!samples)
+		return false;
+
+	double sum = 0.0;
+	for (int i = 0; i < sampleCount; i++)
+	{
+		double sample = (double)measureSample(function, argument, iterationCount) / (double)iterationCount;
+		samples[i] = sample; sum += sample;
+	}
+	qsort(samples, sampleCount, sizeof(double), compareSamples);
+
+	BenchResult* result = &results[resultCount++];
+	result->name = name;
+	result->iterationCount = iterationCount;
+	result->minimum = samples[0];
+	result->median = sampleCount % 2 == 0 ? (samples[sampleCount / 2 - 1] +
+		samples[sampleCount / 2]) * 0.5 : samples[sampleCount / 2];
+	result->p99 = samples[(int)ceil(sampleCount * 0.99) - 1];
+	result->mean = sum / sampleCount;
+
+	double variance = 0.0;
+	for (int i = 0; i < sampleCount; i++)
+		variance += (samples[i] - result->mean) * (samples[i] - result->mean);
+	result->deviation = sampleCount > 1 ? sqrt(variance / (sampleCount - 1)) : 0.0;
+	free(samples);
+
+	fprintf(logFile, "%-28s %10lld %12.1lf %12.1lf %12.1lf %10.1lf\n", name, (long long)iterationCount,
+		result->median, result->p99, result->minimum, result->deviation);
+	fflush(logFile);
+	return true;
+}
+
+//**********************************************************************************************************************
+static void benchGetCurrentClock(void* argument) { benchSink += (int64_t)getCurrentClock(); }
+static void benchGetCurrentClockNs(void* argument) { benchSink += getCurrentClockNs(); }
+static void benchGetCoarseClockNs(void* argument) { benchSink += getCoarseClockNs(); }
+static void benchGetCycleCount(void* argument) { benchSink += (int64_t)getCycleCount(); }
+
+static void benchGetLogicalCpuCount(void* argument) { benchSink += getLogicalCpuCount(); }
+static void benchGetPhysicalCpuCount(void* argument) { benchSink += getPhysicalCpuCount(); }
+static void benchGetPerformanceCpuCount(void* argument) { benchSink += getPerformanceCpuCount(); }
+static void benchGetTotalRamSize(void* argument) { benchSink += getTotalRamSize(); }
+static void benchGetFreeRamSize(void* argument) { benchSink += getFreeRamSize(); }
+static void benchGetEffectiveCpuCount(void* argument) { benchSink += getEffectiveCpuCount(); }
+static void benchGetEffectiveRamSize(void* argument) { benchSink += getEffectiveRamSize(); }
+static void benchUpdateSystemInfo(void* argument) { benchSink += updateSystemInfo(); }
+static void benchGetThreadCpuTimeNs(void* argument) { benchSink += getThreadCpuTimeNs(); }
+
+static void benchGetResourceUsage(void* argument)
+{
+	ResourceUsage resourceUsage;
+	benchSink += getResourceUsage((ResourceUsageTarget)(size_t)argument, &resourceUsage);
+}
+
+static void benchGetCpuName(void* argument)
+{
+	char* cpuName = getCpuName();
+	benchSink += cpuName != NULL;
+	free(cpuName);
+}
+static void benchCreateCpuTopology(void* argument)
+{
+	CpuTopology* cpuTopology = createCpuTopology();
+	benchSink += cpuTopology != NULL;
+	destroyCpuTopology(cpuTopology);
+}
+static void benchExecuteFile(void* argument)
+{
+#if _WIN32
+	benchSink += executeFile("cmd", "/c", "exit", NULL);
+#else
+	benchSink += executeFile("true", NULL);
+#endif
+}
+
+// Note: Arena is reset like a per-frame scratch memory.
+static void benchAllocateArenaMemory(void* argument)
+{
+	MemoryArena memoryArena = (MemoryArena)argument;
+	if (getMemoryArenaSize(memoryArena) >= BENCH_ARENA_FRAME_SIZE)
+		resetMemoryArena(memoryArena);
+	benchSink += allocateArenaMemory(memoryArena, BENCH_ALLOCATION_SIZE, 16) != NULL;
+}
+static void benchAllocatePoolItem(void* argument)
+{
+	MemoryPool memoryPool = (MemoryPool)argument;
+	void* item = allocatePoolItem(memoryPool);
+	benchSink += item != NULL;
+	freePoolItem(memoryPool, item);
+}
+static void benchMalloc(void* argument)
+{
+	void* memory = malloc(BENCH_ALLOCATION_SIZE);
+	benchSink += memory != NULL;
+	free(memory);
+}
+
+static void benchIsDirectoryExists(void* argument) { benchSink += isDirectoryExists(appDataDirectory); }
+static void benchGetFileInfo(void* argument)
+{
+	FileInfo info;
+	benchSink += getFileInfo(appDataDirectory, FILE_INFO_FIELD_BIT(TYPE_FILE_INFO_FIELD), true, &info);
+}
+static void benchCreateDirectory(void* argument) { benchSink += createDirectory(appDataDirectory); }
+
+static void benchGetDataDirectory(void* argument)
+{
+	char* directory = getDataDirectory(false);
+	benchSink += directory != NULL;
+	free(directory);
+}
+static void benchGetAppDataDirectory(void* argument)
+{
+	char* directory = getAppDataDirectory(BENCH_APP_NAME, false);
+	benchSink += directory != NULL;
+	free(directory);
+}
+static void benchGetResourcesDirectory(void* argument)
+{
+	char* directory = getResourcesDirectory();
+	benchSink += directory != NULL;
+	free(directory);
+}
+
+//**********************************************************************************************************************
+static bool writeJsonResults(const char* filePath)
+{
+	FILE* file = strcmp(filePath, "-") == 0 ? stdout : fopen(filePath, "w");
+	if (!file)
+		return false;
+
+	char* cpuName = getCpuName();
+	fprintf(file, "{\n\t\"library\": \"mpio\",\n\t\"version\": \"%d.%d.%d\",\n",
+		MPIO_VERSION_MAJOR, MPIO_VERSION_MINOR, MPIO_VERSION_PATCH);
+	fputs("\t\"cpuName\": \"", file);
+	for (const char* c = cpuName ? cpuName : ""; *c; c++)
+	{
+		if (*c != '"' && *c != '\\' && (unsigned char)*c >= 0x20)
+			fputc(*c, file);
+	}
+	fprintf(file, "\",\n\t\"logicalCpuCount\": %d,\n\t\"sampleCount\": %d,\n\t\"timeUnit\": \"ns\",\n",
+		getLogicalCpuCount(), sampleCount);
+	free(cpuName);
+
+	fputs("\t\"benchmarks\": [", file);
+	for (int i = 0; i < resultCount; i++)
+	{
+		const BenchResult* result = &results[i];
+		fprintf(file, "%s\n\t\t{ \"name\": \"%s\", \"iterations\": %lld, \"median\": %.3lf, \"p99\": %.3lf, "
+			"\"min\": %.3lf, \"mean\": %.3lf, \"stdDev\": %.3lf }", i > 0 ? "," : "", result->name,
+			(long long)result->iterationCount, result->median, result->p99,
+			result->minimum, result->mean, result->deviation);
+	}
+	fputs("\n\t]\n}\n", file);
+
+	if (file != stdout)
+		fclose(file);
+	return true;
+}
+
+static void printUsage()
+{
+	printf("Usage: mpio-bench [--json <path|->] [--filter <name>] [--samples <count>]\n");
+}
+
+int main(int argc, char** argv)
+{
+	const char* jsonPath = NULL;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			jsonPath = argv[++i];
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+			nameFilter = argv[++i];
+		else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+			sampleCount = atoi(argv[++i]);
+		else
+		{
+			printUsage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	appDataDirectory = getAppDataDirectory(BENCH_APP_NAME, false);
+	if (!appDataDirectory)
+	{
+		printf("Failed to get application data directory.\n");
+		return EXIT_FAILURE;
+	}
+	bool isDirectoryCreated = createDirectory(appDataDirectory);
+
+	// Note: Prints to stderr if JSON goes to stdout, to keep the output parsable.
+	logFile = jsonPath && strcmp(jsonPath, "-") == 0 ? stderr : stdout;
+	fprintf(logFile, "Samples: %d, time unit: ns/op\n", sampleCount);
+	fprintf(logFile, "%-28s %10s %12s %12s %12s %10s\n", "Benchmark", "Iterations", "Median", "P99", "Min", "StdDev");
+
+	bool result = runBench("getCurrentClock", benchGetCurrentClock, NULL);
+	result &= runBench("getCurrentClockNs", benchGetCurrentClockNs, NULL);
+	result &= runBench("getCoarseClockNs", benchGetCoarseClockNs, NULL);
+	result &= runBench("getCycleCount", benchGetCycleCount, NULL);
+	result &= runBench("getLogicalCpuCount", benchGetLogicalCpuCount, NULL);
+	result &= runBench("getPhysicalCpuCount", benchGetPhysicalCpuCount, NULL);
+	result &= runBench("getPerformanceCpuCount", benchGetPerformanceCpuCount, NULL);
+	result &= runBench("getTotalRamSize", benchGetTotalRamSize, NULL);
+	result &= runBench("getFreeRamSize", benchGetFreeRamSize, NULL);
+	result &= runBench("getEffectiveCpuCount", benchGetEffectiveCpuCount, NULL);
+	result &= runBench("getEffectiveRamSize", benchGetEffectiveRamSize, NULL);
+	result &= runBench("getResourceUsage (process)", benchGetResourceUsage, (void*)PROCESS_RESOURCE_USAGE_TARGET);
+	result &= runBench("getResourceUsage (thread)", benchGetResourceUsage, (void*)THREAD_RESOURCE_USAGE_TARGET);
+	result &= runBench("getThreadCpuTimeNs", benchGetThreadCpuTimeNs, NULL);
+	result &= runBench("updateSystemInfo", benchUpdateSystemInfo, NULL);
+	result &= runBench("getCpuName", benchGetCpuName, NULL);
+	result &= runBench("createCpuTopology", benchCreateCpuTopology, NULL);
+	result &= runBench("executeFile", benchExecuteFile, NULL);
+
+	MemoryArena memoryArena = createMemoryArena(BENCH_ARENA_FRAME_SIZE * 2, false);
+	MemoryPool memoryPool = createMemoryPool(BENCH_ALLOCATION_SIZE, 1024);
+	if (memoryArena && memoryPool)
+	{
+		result &= runBench("allocateArenaMemory", benchAllocateArenaMemory, memoryArena);
+		result &= runBench("allocatePoolItem + free", benchAllocatePoolItem, memoryPool);
+		result &= runBench("malloc + free", benchMalloc, NULL);
+	}
+	else
+	{
+		result = false;
+	}
+	destroyMemoryPool(memoryPool);
+	destroyMemoryArena(memoryArena);
+
+	result &= runBench("isDirectoryExists", benchIsDirectoryExists, NULL);
+	result &= runBench("getFileInfo", benchGetFileInfo, NULL);
+	result &= runBench("createDirectory (exists)", benchCreateDirectory, NULL);
+	result &= runBench("getDataDirectory", benchGetDataDirectory, NULL);
+	result &= runBench("getAppDataDirectory", benchGetAppDataDirectory, NULL);
+	result &= runBench("getResourcesDirectory", benchGetResourcesDirectory, NULL);
+
+	if (isDirectoryCreated)
+		remove(appDataDirectory);
+	free(appDataDirectory);
+
+	if (jsonPath && !writeJsonResults(jsonPath))
+	{
+		printf("Failed to write JSON results.\n");
+		return EXIT_FAILURE;
+	}
+	if (!result)
+	{
+		printf("Failed to run MPIO benchmark.\n");
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,155 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Asynchronous file input / output functions.
+ *
+ * @details
+ * Requests are submitted to the queue in batches and their completions are polled or waited for later.
+ * Uses io_uring on Linux, otherwise falls back to the worker thread pool with positional read / write calls.
+ */
+
+#pragma once
+#include "mpio/file.h"
+
+/**
+ * @brief Asynchronous I/O queue structure.
+ */
+typedef struct AioQueue_T AioQueue_T;
+/**
+ * @brief Asynchronous I/O queue instance.
+ */
+typedef AioQueue_T* AioQueue;
+
+/**
+ * @brief Asynchronous I/O queue backend types.
+ */
+typedef enum AioBackend_T
+{
+	IO_URING_AIO_BACKEND = 0,    /**< Linux io_uring kernel interface. */
+	THREAD_POOL_AIO_BACKEND = 1, /**< Worker thread pool with positional read / write calls. */
+	AIO_BACKEND_COUNT = 2,       /**< Asynchronous I/O queue backend type count. */
+} AioBackend_T;
+/**
+ * @brief Asynchronous I/O queue backend type.
+ */
+typedef uint8_t AioBackend;
+
+/**
+ * @brief Asynchronous I/O operation types.
+ */
+typedef enum AioOperation_T
+{
+	READ_AIO_OPERATION = 0,  /**< Reads file data at the offset to the buffer. */
+	WRITE_AIO_OPERATION = 1, /**< Writes buffer data to the file at the offset. */
+	SYNC_AIO_OPERATION = 2,  /**< Flushes written file data to the storage device. (fsync) */
+	AIO_OPERATION_COUNT = 3, /**< Asynchronous I/O operation type count. */
+} AioOperation_T;
+/**
+ * @brief Asynchronous I/O operation type.
+ */
+typedef uint8_t AioOperation;
+
+/**
+ * @brief Asynchronous I/O request description.
+ * @warning Buffer memory should stay valid until the request is completed!
+ */
+typedef struct AioRequest
+{
+	void* buffer;           /**< Read destination or write source buffer. (NULL for sync) */
+	void* userData;         /**< Arbitrary user data, returned with the completion. */
+	int64_t offset;         /**< File offset in bytes. */
+	uint32_t size;          /**< Buffer size in bytes. */
+	FileHandle file;        /**< Target native file handle. (See the getFileHandle()) */
+	AioOperation operation; /**< Request operation type. */
+} AioRequest;
+
+/**
+ * @brief Asynchronous I/O request completion.
+ */
+typedef struct AioCompletion
+{
+	void* userData; /**< Request user data. */
+	int64_t result; /**< Transferred byte count on success (less than size at the end of file), otherwise -1. */
+} AioCompletion;
+
+/**
+ * @brief Creates a new asynchronous I/O queue instance.
+ * @details Falls back to the thread pool backend if io_uring is unavailable.
+ *
+ * @param depth maximum in-flight request count
+ * @param useThreadPool always use worker thread pool backend
+ *
+ * @return A new asynchronous I/O queue instance on success, otherwise NULL.
+ */
+AioQueue createAioQueue(uint32_t depth, bool useThreadPool);
+/**
+ * @brief Destroys asynchronous I/O queue instance.
+ * @details Blocks until all in-flight requests are completed, or abandons them if the io_uring has failed.
+ * @param aioQueue asynchronous I/O queue instance or NULL
+ */
+void destroyAioQueue(AioQueue aioQueue);
+
+/**
+ * @brief Returns asynchronous I/O queue backend type.
+ * @param aioQueue asynchronous I/O queue instance
+ */
+AioBackend getAioQueueBackend(AioQueue aioQueue);
+/**
+ * @brief Returns asynchronous I/O queue maximum in-flight request count.
+ * @param aioQueue asynchronous I/O queue instance
+ */
+uint32_t getAioQueueDepth(AioQueue aioQueue);
+/**
+ * @brief Returns asynchronous I/O queue current in-flight request count.
+ * @param aioQueue asynchronous I/O queue instance
+ */
+uint32_t getAioQueueInFlightCount(AioQueue aioQueue);
+
+/**
+ * @brief Submits asynchronous I/O requests to the queue. (MT-Unsafe)
+ * @details Stops submitting if the queue is full. (In-flight request count equals depth)
+ *
+ * @param aioQueue asynchronous I/O queue instance
+ * @param[in] requests target I/O request array
+ * @param count I/O request array size
+ *
+ * @return Submitted I/O request count.
+ */
+uint32_t submitAioRequests(AioQueue aioQueue, const AioRequest* requests, uint32_t count);
+
+/**
+ * @brief Returns completed asynchronous I/O requests without blocking. (MT-Unsafe)
+ *
+ * @param aioQueue asynchronous I/O queue instance
+ * @param[out] completions I/O completion array
+ * @param capacity I/O completion array size
+ *
+ * @return Returned I/O completion count.
+ */
+uint32_t pollAioCompletions(AioQueue aioQueue, AioCompletion* completions, uint32_t capacity);
+
+/**
+ * @brief Waits for the completed asynchronous I/O requests. (MT-Unsafe)
+ * @details Blocks until at least minCount requests are completed (clamped to the in-flight count).
+ *
+ * @param aioQueue asynchronous I/O queue instance
+ * @param[out] completions I/O completion array
+ * @param capacity I/O completion array size
+ * @param minCount minimal returned I/O completion count
+ *
+ * @return Returned I/O completion count.
+ */
+uint32_t waitAioCompletions(AioQueue aioQueue, AioCompletion* completions, uint32_t capacity, uint32_t minCount);
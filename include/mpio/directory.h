@@ -15,10 +15,18 @@
 /***********************************************************************************************************************
  * @file
  * @brief Common directory functions.
+ *
+ * @details
+ * Directory iterator reads entries in large batches (getdents64 on Linux, large fetch on Windows) and returns
+ * their type without a stat() call per entry. Subdirectories are opened relative to the parent directory handle
+ * (openat), so the kernel does not resolve the whole path again for each of them.
+ *
+ * Directory walker distributes subdirectories across the job system workers: each directory is read by a separate
+ * job, and work stealing keeps all workers busy, so more directory reads are in flight on fast storage.
  */
 
 #pragma once
-#include <stdbool.h>
+#include "mpio/jobs.h"
 
 /**
  * @brief Creates a new directory, if it do not already exist. (MT-Safe)
@@ -26,6 +34,19 @@
  * @return True if a new directory was created, otherwise false.
  */
 bool createDirectory(const char* path);
+/**
+ * @brief Creates a new directory and all missing parent directories. (MT-Safe)
+ *
+ * @details
+ * The leaf directory is created first, parent directories are checked backwards only if it is missing, so an
+ * existing parent costs a single syscall. Missing directories are created relative to the deepest existing one.
+ *
+ * @param[in] path target directory path string
+ * @param[out] isCreated true if a new directory was created, false if it already exists, or NULL
+ *
+ * @return True if the directory was created or already exists, otherwise false on failure.
+ */
+bool createDirectories(const char* path, bool* isCreated);
 
 /**
  * @brief Returns true if directory exists. (MT-Safe)
@@ -64,4 +85,204 @@ char* getAppDataDirectory(const char* appName, bool isShared);
  * @note You should free() allocated string manually.
  * @return An allocated resources directory string on success, otherwise NULL.
  */
-char* getResourcesDirectory();
\ No newline at end of file
+char* getResourcesDirectory();
+
+/***********************************************************************************************************************
+ * @brief File system entry types.
+ */
+typedef enum FileType_T
+{
+	UNKNOWN_FILE_TYPE = 0,   /**< Failed to determine entry type. */
+	REGULAR_FILE_TYPE = 1,   /**< Regular file. */
+	DIRECTORY_FILE_TYPE = 2, /**< Directory. */
+	SYMLINK_FILE_TYPE = 3,   /**< Symbolic link or reparse point, not followed. */
+	OTHER_FILE_TYPE = 4,     /**< Device, pipe, socket, etc. */
+	FILE_TYPE_COUNT = 5,     /**< File system entry type count. */
+} FileType_T;
+/**
+ * @brief File system entry type.
+ */
+typedef uint8_t FileType;
+
+/**
+ * @brief File information field types.
+ */
+typedef enum FileInfoField_T
+{
+	TYPE_FILE_INFO_FIELD = 0,        /**< File type. */
+	SIZE_FILE_INFO_FIELD = 1,        /**< File size in bytes. */
+	MODIFY_TIME_FILE_INFO_FIELD = 2, /**< Last data modification time. */
+	ACCESS_TIME_FILE_INFO_FIELD = 3, /**< Last data access time. */
+	CHANGE_TIME_FILE_INFO_FIELD = 4, /**< Last status change time. (Not supported on Windows) */
+	INODE_FILE_INFO_FIELD = 5,       /**< File serial number and device ID. */
+	FILE_INFO_FIELD_COUNT = 6,       /**< File information field type count. */
+} FileInfoField_T;
+/**
+ * @brief File information field type.
+ */
+typedef uint8_t FileInfoField;
+
+/**
+ * @brief Returns file information field mask bit.
+ * @param field target file information field type
+ */
+#define FILE_INFO_FIELD_BIT(field) (1u << (field))
+/**
+ * @brief File information mask with all field bits.
+ */
+#define ALL_FILE_INFO_FIELDS ((1u << FILE_INFO_FIELD_COUNT) - 1u)
+
+/**
+ * @brief File information.
+ * @details Times are in nanoseconds since the Unix epoch. Symbolic links are followed.
+ */
+typedef struct FileInfo
+{
+	int64_t size;       /**< File size in bytes. */
+	int64_t modifyTime; /**< Last data modification time. */
+	int64_t accessTime; /**< Last data access time. */
+	int64_t changeTime; /**< Last status change time. */
+	uint64_t inode;     /**< File serial number. (Inode or NTFS file index) */
+	uint64_t device;    /**< File device ID. (Volume serial number on Windows) */
+	uint32_t fields;    /**< Filled field bit mask, can contain more than requested or be 0 on failure. */
+	FileType type;      /**< File type. */
+} FileInfo;
+
+/**
+ * @brief Returns file information. (MT-Safe)
+ *
+ * @details
+ * Uses statx() on Linux, so that only the requested fields are retrieved. Cached information allows network
+ * file systems to skip the server synchronization (AT_STATX_DONT_SYNC), it can be slightly out of date.
+ *
+ * @param[in] path target file path string
+ * @param fields requested field bit mask (FILE_INFO_FIELD_BIT)
+ * @param isCached allow cached file information
+ * @param[out] info file information
+ *
+ * @return True on success, otherwise false.
+ */
+bool getFileInfo(const char* path, uint32_t fields, bool isCached, FileInfo* info);
+/**
+ * @brief Returns multiple file information at once. (MT-Safe)
+ *
+ * @details
+ * Directory is opened only once and paths are resolved relative to its handle, so that the kernel does not
+ * walk the directory path again for each of them. Information of the failed paths has zero fields.
+ *
+ * @param[in] directoryPath base directory path string, or NULL for the current directory
+ * @param[in] paths file path string array, relative to the base directory
+ * @param count file path count
+ * @param fields requested field bit mask (FILE_INFO_FIELD_BIT)
+ * @param isCached allow cached file information
+ * @param[out] infos file information array
+ *
+ * @return Successfully retrieved file information count.
+ */
+uint32_t getFileInfos(const char* directoryPath, const char* const* paths,
+	uint32_t count, uint32_t fields, bool isCached, FileInfo* infos);
+
+/**
+ * @brief Directory entry information.
+ * @warning Strings are valid only until the next iterator call!
+ */
+typedef struct DirectoryEntry
+{
+	const char* name;    /**< Entry name string. */
+	const char* path;    /**< Entry path string, relative to the iterated directory. */
+	uint32_t nameLength; /**< Entry name string length. */
+	uint32_t pathLength; /**< Entry path string length. */
+	uint32_t depth;      /**< Entry nesting depth, 0 for the iterated directory entries. */
+	FileType type;       /**< Entry type. */
+} DirectoryEntry;
+
+/**
+ * @brief Directory iterator structure.
+ */
+typedef struct DirectoryIterator_T DirectoryIterator_T;
+/**
+ * @brief Directory iterator instance.
+ */
+typedef DirectoryIterator_T* DirectoryIterator;
+
+/**
+ * @brief Opens a new directory iterator instance.
+ * @details Symbolic links are returned but never followed. Entry order is file system specific.
+ *
+ * @param[in] path target directory path string
+ * @param isRecursive also iterate subdirectory entries (depth-first)
+ *
+ * @return A new directory iterator instance on success, otherwise NULL.
+ */
+DirectoryIterator openDirectoryIterator(const char* path, bool isRecursive);
+/**
+ * @brief Closes directory iterator instance.
+ * @param directoryIterator directory iterator instance or NULL
+ */
+void closeDirectoryIterator(DirectoryIterator directoryIterator);
+
+/**
+ * @brief Returns the next directory entry.
+ * @details Subdirectory entries are returned right after the subdirectory itself.
+ *
+ * @param directoryIterator directory iterator instance
+ * @param[out] entry directory entry information
+ *
+ * @return True on success, otherwise false if there are no more entries or an error occurred.
+ */
+bool nextDirectoryEntry(DirectoryIterator directoryIterator, DirectoryEntry* entry);
+/**
+ * @brief Skips the last returned subdirectory entries. (Prunes recursion)
+ * @param directoryIterator directory iterator instance
+ */
+void skipDirectoryEntries(DirectoryIterator directoryIterator);
+/**
+ * @brief Returns true if failed to read some directory, its entries are skipped.
+ * @details Unreadable subdirectories (permissions, concurrent removal) do not stop the iteration.
+ * @param directoryIterator directory iterator instance
+ */
+bool isDirectoryIteratorFailed(DirectoryIterator directoryIterator);
+
+/**
+ * @brief Directory walk entry filter function.
+ * @details Returns false to drop the entry, dropped directories are not descended.
+ */
+typedef bool(*DirectoryFilterFunction)(const DirectoryEntry* entry, void* argument);
+/**
+ * @brief Directory walk entry function.
+ */
+typedef void(*DirectoryEntryFunction)(const DirectoryEntry* entry, void* argument);
+
+/**
+ * @brief Directory walk aggregated results.
+ */
+typedef struct DirectoryWalkStats
+{
+	uint64_t entryCount;           /**< Accepted entry count. */
+	uint64_t fileCount;            /**< Accepted regular file count. */
+	uint64_t directoryCount;       /**< Accepted directory count. */
+	uint64_t failedDirectoryCount; /**< Unreadable directory count, their entries are skipped. */
+} DirectoryWalkStats;
+
+/**
+ * @brief Walks directory tree in parallel using the job system. (MT-Safe)
+ *
+ * @details
+ * Each directory is read by a separate job, so filter and entry functions are called concurrently from the
+ * worker threads (and from the calling thread, which executes jobs while it waits). Entry order is not defined.
+ * Entry path is relative to the walked directory. Symbolic links are returned but never followed.
+ * Without the job system all directories are read depth-first by the calling thread.
+ *
+ * @warning Entry strings are valid only until the filter or entry function returns!
+ *
+ * @param jobSystem job system instance, or NULL to walk on the calling thread
+ * @param[in] path target directory path string
+ * @param[in] filter entry filter function or NULL
+ * @param[in] onEntry accepted entry function or NULL
+ * @param[in] argument filter and entry function argument or NULL
+ * @param[out] stats directory walk aggregated results or NULL
+ *
+ * @return True on success, otherwise false if failed to open the directory.
+ */
+bool walkDirectory(JobSystem jobSystem, const char* path, DirectoryFilterFunction filter,
+	DirectoryEntryFunction onEntry, void* argument, DirectoryWalkStats* stats);
@@ -19,6 +19,9 @@
 
 #pragma once
 #include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 
 #if __linux__ || __APPLE__
 
@@ -71,7 +74,24 @@
  */
 #define tellFile(file) ftello(file)
 
+/**
+ * @brief Native OS file handle. (File descriptor)
+ */
+typedef int FileHandle;
+/**
+ * @brief Invalid native OS file handle value.
+ */
+#define INVALID_FILE_HANDLE -1
+
+/**
+ * @brief Returns native OS file handle of the file stream.
+ * @warning Do not mix buffered file stream and native handle I/O on the same file region!
+ * @param[in] file target file stream
+ */
+#define getFileHandle(file) fileno(file)
+
 #elif _WIN32
+#include <io.h>
 
 /***********************************************************************************************************************
  * @brief Opens a file indicated by filename.
@@ -129,6 +149,22 @@ inline static FILE* openFile(const char* filePath, const char* mode)
  * @return File position indicator on success or -1L if failure occurs. 
  */
 #define tellFile(file) _ftelli64(file)
+
+/**
+ * @brief Native OS file handle. (HANDLE)
+ */
+typedef void* FileHandle;
+/**
+ * @brief Invalid native OS file handle value.
+ */
+#define INVALID_FILE_HANDLE ((FileHandle)(intptr_t)-1)
+
+/**
+ * @brief Returns native OS file handle of the file stream.
+ * @warning Do not mix buffered file stream and native handle I/O on the same file region!
+ * @param[in] file target file stream
+ */
+#define getFileHandle(file) ((FileHandle)_get_osfhandle(_fileno(file)))
 #else
 #error Unsupported operating system
 #endif
@@ -143,4 +179,290 @@ inline static FILE* openFile(const char* filePath, const char* mode)
  * @param[in] file the file stream to close 
  * @return ​0​ on success, EOF otherwise.
  */
-#define closeFile(file) fclose(file)
\ No newline at end of file
+#define closeFile(file) fclose(file)
+
+/***********************************************************************************************************************
+ * @brief Opens a native file handle for the positional I/O.
+ * 
+ * @details
+ * Uses the same access flags as the openFile(). Positional read / write functions do not 
+ * modify shared file position, so the same handle can be used from multiple threads without locking.
+ * 
+ * @note You should closeFileHandle() the returned handle manually.
+ * @warning On Linux positional writes to the "a" (append) mode file always append data to the end!
+ * 
+ * @param[in] filePath target file path string
+ * @param[in] mode null-terminated character string determining file access mode
+ * 
+ * @return A native file handle on success, otherwise INVALID_FILE_HANDLE.
+ */
+FileHandle openFileHandle(const char* filePath, const char* mode);
+
+/**
+ * @brief Closes the native file handle.
+ * @param file target native file handle
+ * @return True on success, otherwise false.
+ */
+bool closeFileHandle(FileHandle file);
+
+/**
+ * @brief Returns native file handle file size in bytes. (MT-Safe)
+ * @param file target native file handle
+ * @return The file size in bytes on success, otherwise -1.
+ */
+int64_t getFileHandleSize(FileHandle file);
+
+/**
+ * @brief Flushes written native file handle data to the storage device. (MT-Safe)
+ * @param file target native file handle
+ * @return True on success, otherwise false.
+ */
+bool flushFileHandle(FileHandle file);
+
+/**
+ * @brief Reads file data at the offset, without changing the file position. (MT-Safe)
+ * @details Repeats read until the whole buffer is filled or the end of file is reached.
+ * 
+ * @param file target native file handle
+ * @param[out] buffer destination data buffer
+ * @param size data buffer size in bytes
+ * @param offset file offset in bytes
+ * 
+ * @return Read byte count on success (less than size at the end of file), otherwise -1.
+ */
+int64_t readFileAt(FileHandle file, void* buffer, size_t size, int64_t offset);
+
+/**
+ * @brief Writes file data at the offset, without changing the file position. (MT-Safe)
+ * @details Repeats write until the whole buffer is written.
+ * 
+ * @param file target native file handle
+ * @param[in] buffer source data buffer
+ * @param size data buffer size in bytes
+ * @param offset file offset in bytes
+ * 
+ * @return Written byte count on success, otherwise -1.
+ */
+int64_t writeFileAt(FileHandle file, const void* buffer, size_t size, int64_t offset);
+
+/**
+ * @brief File data buffer description for the vectored (scatter / gather) I/O.
+ * @details Has the same memory layout as the POSIX iovec structure.
+ */
+typedef struct FileBuffer
+{
+	void* data;  /**< Data buffer memory. */
+	size_t size; /**< Data buffer size in bytes. */
+} FileBuffer;
+
+/**
+ * @brief Reads file data at the offset to the multiple buffers. (MT-Safe)
+ * 
+ * @details
+ * Buffers are filled in the array order with the consecutive file data, using one syscall when available. (preadv)
+ * Less bytes than requested can be read, the same as with a single positional read call.
+ * 
+ * @param file target native file handle
+ * @param[in] buffers destination data buffer array
+ * @param count data buffer array size
+ * @param offset file offset in bytes
+ * 
+ * @return Read byte count on success, otherwise -1.
+ */
+int64_t readFileVectorAt(FileHandle file, const FileBuffer* buffers, uint32_t count, int64_t offset);
+
+/**
+ * @brief Writes file data at the offset from the multiple buffers. (MT-Safe)
+ * 
+ * @details
+ * Buffers are written in the array order as the consecutive file data, using one syscall when available. (pwritev)
+ * Less bytes than requested can be written, the same as with a single positional write call.
+ * 
+ * @param file target native file handle
+ * @param[in] buffers source data buffer array
+ * @param count data buffer array size
+ * @param offset file offset in bytes
+ * 
+ * @return Written byte count on success, otherwise -1.
+ */
+int64_t writeFileVectorAt(FileHandle file, const FileBuffer* buffers, uint32_t count, int64_t offset);
+
+/***********************************************************************************************************************
+ * @brief Allocates file storage space for the specified byte range. (MT-Safe)
+ * 
+ * @details
+ * Preallocated space is reserved on the storage device, so later writes do not stall on
+ * the block allocation and large files are less fragmented. Allocated not written bytes are read as zeros.
+ * 
+ * @param file target native file handle
+ * @param offset allocated range offset in bytes
+ * @param size allocated range size in bytes
+ * @param keepSize do not change the file size (allocate space beyond the end of file)
+ * 
+ * @return True on success, otherwise false.
+ */
+bool preallocateFile(FileHandle file, int64_t offset, int64_t size, bool keepSize);
+
+/**
+ * @brief Deallocates file storage space for the specified byte range. (MT-Safe)
+ * 
+ * @details
+ * Punched range becomes a sparse file hole, which is read as zeros and does not use storage space.
+ * File size is not changed. Range is usually rounded to the file system block size internally.
+ * 
+ * @param file target native file handle
+ * @param offset deallocated range offset in bytes
+ * @param size deallocated range size in bytes
+ * 
+ * @return True on success, otherwise false. (For example, if not supported by the file system)
+ */
+bool punchFileHole(FileHandle file, int64_t offset, int64_t size);
+
+/**
+ * @brief File data or hole (sparse) extent.
+ */
+typedef struct FileExtent
+{
+	int64_t offset; /**< Extent offset in bytes. */
+	int64_t size;   /**< Extent size in bytes. */
+	bool isHole;    /**< Is extent a sparse file hole. (Not allocated) */
+} FileExtent;
+
+/**
+ * @brief Returns file data and hole extents, starting from the offset.
+ * 
+ * @details
+ * Extents are returned in the file order. To continue enumeration call the function again
+ * with the last extent end offset. File systems without sparse file support report a single data extent.
+ * 
+ * @warning Changes the file position on the POSIX systems! (SEEK_DATA / SEEK_HOLE)
+ * 
+ * @param file target native file handle
+ * @param offset enumeration start offset in bytes
+ * @param[out] extents file extent array
+ * @param capacity file extent array size
+ * 
+ * @return Returned file extent count on success, otherwise -1.
+ */
+int64_t getFileExtents(FileHandle file, int64_t offset, FileExtent* extents, uint32_t capacity);
+
+/**
+ * @brief File access pattern hint types.
+ */
+typedef enum FileAccessHint_T
+{
+	NORMAL_FILE_ACCESS_HINT = 0,     /**< No specific access pattern, default readahead. */
+	SEQUENTIAL_FILE_ACCESS_HINT = 1, /**< Data is accessed sequentially, aggressive readahead. */
+	RANDOM_FILE_ACCESS_HINT = 2,     /**< Data is accessed randomly, readahead is disabled. */
+	WILL_NEED_FILE_ACCESS_HINT = 3,  /**< Data will be accessed soon, start reading it to the page cache. */
+	DONT_NEED_FILE_ACCESS_HINT = 4,  /**< Data will not be accessed soon, evict it from the page cache. */
+	FILE_ACCESS_HINT_COUNT = 5,      /**< File access pattern hint type count. */
+} FileAccessHint_T;
+/**
+ * @brief File access pattern hint type.
+ */
+typedef uint8_t FileAccessHint;
+
+/**
+ * @brief Gives the kernel a hint about the file range access pattern. (MT-Safe)
+ * @details Hint is advisory, unsupported hints are ignored. On Windows access hints are set only on file open.
+ * 
+ * @param file target native file handle
+ * @param offset file range offset in bytes
+ * @param size file range size in bytes, or 0 until the end of file
+ * @param hint file access pattern hint type
+ * 
+ * @return True on success, otherwise false.
+ */
+bool adviseFileAccess(FileHandle file, int64_t offset, int64_t size, FileAccessHint hint);
+
+/***********************************************************************************************************************
+ * @brief File copy methods, in the order they are tried.
+ */
+typedef enum CopyFileMethod_T
+{
+	CLONE_COPY_FILE_METHOD = 0,      /**< Copy-on-write clone, O(1) time. (FICLONE reflink, clonefile) */
+	COPY_RANGE_COPY_FILE_METHOD = 1, /**< In-kernel copy, can be offloaded to the storage. (copy_file_range) */
+	SEND_FILE_COPY_FILE_METHOD = 2,  /**< In-kernel copy through the page cache. (sendfile) */
+	SYSTEM_COPY_FILE_METHOD = 3,     /**< Operating system copy function. (CopyFileEx, fcopyfile) */
+	BUFFERED_COPY_FILE_METHOD = 4,   /**< User space read / write loop. */
+	COPY_FILE_METHOD_COUNT = 5,      /**< File copy method count. */
+} CopyFileMethod_T;
+/**
+ * @brief File copy method.
+ */
+typedef uint8_t CopyFileMethod;
+
+/**
+ * @brief Copies file data to the new file, avoiding the user space data transfer. (MT-Safe)
+ * 
+ * @details
+ * Tries to clone (reflink) the file first, then falls back to the in-kernel copy functions,
+ * and only then to the buffered read / write loop. Existing destination file is overwritten,
+ * unless it is the same file as the source (or its hard link), then the copy fails without changes.
+ * On btrfs, XFS, APFS and other copy-on-write file systems copy is done in the O(1) time.
+ * 
+ * @param[in] sourcePath source file path string
+ * @param[in] destinationPath destination file path string
+ * @param[out] method used file copy method or NULL
+ * 
+ * @return True on success, otherwise false.
+ */
+bool copyFile(const char* sourcePath, const char* destinationPath, CopyFileMethod* method);
+
+/***********************************************************************************************************************
+ * @brief File memory mapping access modes.
+ */
+typedef enum MapFileAccess_T
+{
+	READ_ONLY_MAP_FILE_ACCESS = 0,     /**< Mapped memory can be only read. */
+	READ_WRITE_MAP_FILE_ACCESS = 1,    /**< Mapped memory writes are stored to the file. */
+	COPY_ON_WRITE_MAP_FILE_ACCESS = 2, /**< Mapped memory writes are private to the process. */
+	MAP_FILE_ACCESS_COUNT = 3,         /**< File memory mapping access mode count. */
+} MapFileAccess_T;
+/**
+ * @brief File memory mapping access mode.
+ */
+typedef uint8_t MapFileAccess;
+
+/**
+ * @brief Maps file region into the process address space. (MT-Safe)
+ * 
+ * @details
+ * Mapped memory is backed by the OS page cache, file data is not copied to the intermediate buffers.
+ * The offset can be unaligned, it is internally aligned down to the system page (allocation) granularity.
+ * 
+ * @note You should unmapFile() the returned memory manually.
+ * @warning Accessing mapped memory after the file was truncated by someone else crashes the process!
+ *
+ * @param[in] filePath target file path string
+ * @param access mapped memory access mode
+ * @param offset file region offset in bytes
+ * @param[in,out] size file region size in bytes, or 0 to map until the end of the file
+ * @param prefault populate mapped memory pages in advance (avoids page faults on the first access)
+ * 
+ * @return Pointer to the mapped file region on success, otherwise NULL.
+ */
+void* mapFile(const char* filePath, MapFileAccess access, int64_t offset, size_t* size, bool prefault);
+
+/**
+ * @brief Unmaps file region from the process address space. (MT-Safe)
+ * @details Unwritten read-write memory changes are stored to the file by the OS.
+ * 
+ * @param[in] data mapped file region pointer
+ * @param size mapped file region size in bytes
+ * 
+ * @return True on success, otherwise false.
+ */
+bool unmapFile(void* data, size_t size);
+
+/**
+ * @brief Writes modified mapped memory pages to the file. (MT-Safe)
+ * @details Useful only for the read-write mapped files.
+ * 
+ * @param[in] data mapped file region pointer (can point inside the region)
+ * @param size flushed region size in bytes
+ * 
+ * @return True on success, otherwise false.
+ */
+bool flushMappedFile(void* data, size_t size);
\ No newline at end of file
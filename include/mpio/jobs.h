@@ -0,0 +1,145 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Work-stealing job system functions.
+ *
+ * @details
+ * Each worker thread owns a Chase-Lev deque: jobs scheduled from a worker are pushed to and popped from its own
+ * deque without locks, while idle workers steal from the opposite end of the other deques. Jobs scheduled from
+ * outside of the workers go to a shared injection queue. Waiting threads execute pending jobs instead of blocking.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Job system structure.
+ */
+typedef struct JobSystem_T JobSystem_T;
+/**
+ * @brief Job system instance.
+ */
+typedef JobSystem_T* JobSystem;
+
+/**
+ * @brief Job counter structure.
+ */
+typedef struct JobCounter_T JobCounter_T;
+/**
+ * @brief Job counter instance.
+ * @details Counts pending jobs, used to wait for them and as a dependency of other jobs.
+ */
+typedef JobCounter_T* JobCounter;
+
+/**
+ * @brief Job function.
+ * @param[in] argument job function argument
+ */
+typedef void(*JobFunction)(void* argument);
+/**
+ * @brief Parallel for loop range function.
+ *
+ * @param[in] argument parallel for function argument
+ * @param begin first index of the range
+ * @param end index after the last one of the range
+ */
+typedef void(*ParallelForFunction)(void* argument, uint32_t begin, uint32_t end);
+
+/**
+ * @brief Creates a new job system instance.
+ * 
+ * @details
+ * Default worker count is the smallest of getPerformanceCpuCount() and getEffectiveCpuCount() minus one,
+ * because the calling thread executes jobs while it waits for them.
+ * 
+ * @param workerCount worker thread count, or 0 for the default
+ * @param pinWorkers pin each worker thread to a separate performance core
+ * 
+ * @return A new job system instance on success, otherwise NULL.
+ */
+JobSystem createJobSystem(uint32_t workerCount, bool pinWorkers);
+/**
+ * @brief Destroys job system instance.
+ * @details Blocks until all scheduled jobs are executed.
+ * @warning Jobs waiting for a never completed dependency are discarded!
+ * @param jobSystem job system instance or NULL
+ */
+void destroyJobSystem(JobSystem jobSystem);
+
+/**
+ * @brief Returns job system worker thread count.
+ * @param jobSystem job system instance
+ */
+uint32_t getJobSystemWorkerCount(JobSystem jobSystem);
+
+/**
+ * @brief Creates a new job counter instance. (MT-Safe)
+ * @return A new job counter instance on success, otherwise NULL.
+ */
+JobCounter createJobCounter();
+/**
+ * @brief Destroys job counter instance. (MT-Safe)
+ * @warning Counter should not have pending jobs, wait for them before destruction!
+ * @param jobCounter job counter instance or NULL
+ */
+void destroyJobCounter(JobCounter jobCounter);
+/**
+ * @brief Returns job counter pending job count. (MT-Safe)
+ * @param jobCounter job counter instance
+ */
+int32_t getJobCounterValue(JobCounter jobCounter);
+
+/**
+ * @brief Schedules a new job for the execution. (MT-Safe)
+ * 
+ * @details
+ * The job is not scheduled until the dependency counter reaches zero.
+ * Jobs scheduled from a worker thread are pushed to its own deque, others are pushed to the injection queue.
+ * 
+ * @param jobSystem job system instance
+ * @param[in] function job function
+ * @param[in] argument job function argument or NULL
+ * @param jobCounter job counter to increment until the job is executed, or NULL
+ * @param dependency job counter to wait for before the execution, or NULL
+ * 
+ * @return True on success, otherwise false. (Failed to allocate dependent job)
+ */
+bool runJob(JobSystem jobSystem, JobFunction function, void* argument, JobCounter jobCounter, JobCounter dependency);
+/**
+ * @brief Waits until job counter reaches zero. (MT-Safe)
+ * @details Executes other pending jobs while waiting, instead of blocking the calling thread.
+ *
+ * @param jobSystem job system instance
+ * @param jobCounter job counter instance
+ */
+void waitJobCounter(JobSystem jobSystem, JobCounter jobCounter);
+
+/**
+ * @brief Executes function for the index range in parallel and waits for it. (MT-Safe)
+ * 
+ * @details
+ * Range is split adaptively: each participant takes a chunk of the remaining range,
+ * so the chunks become smaller to the end of the loop, balancing uneven work.
+ * 
+ * @param jobSystem job system instance
+ * @param[in] function parallel for range function
+ * @param[in] argument parallel for function argument or NULL
+ * @param count total index count
+ * @param minChunkSize minimum range size for the single function call, or 0 for 1
+ */
+void parallelFor(JobSystem jobSystem, ParallelForFunction function,
+	void* argument, uint32_t count, uint32_t minChunkSize);
@@ -0,0 +1,310 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Virtual memory, arena allocator and memory pressure monitoring functions.
+ *
+ * @details
+ * Delivers memory pressure events before the system starts thrashing, so that caches can shed memory in advance.
+ * Uses PSI triggers (cgroup memory.pressure or /proc/pressure/memory) and the cgroup v2 memory.events on Linux,
+ * memory pressure dispatch source on macOS and the low memory resource notification on Windows.
+ *
+ * Virtual memory functions reserve address space without using the physical memory, and commit pages on demand.
+ * Linear arena and fixed-size pool allocators are built on top of them: they grow in place inside the reserved
+ * range, so allocated pointers stay stable and no malloc() calls are made after the creation.
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Memory pressure monitor structure.
+ */
+typedef struct MemoryMonitor_T MemoryMonitor_T;
+/**
+ * @brief Memory pressure monitor instance.
+ */
+typedef MemoryMonitor_T* MemoryMonitor;
+
+/**
+ * @brief Memory pressure levels.
+ */
+typedef enum MemoryPressure_T
+{
+	NO_MEMORY_PRESSURE = 0,       /**< No memory pressure event occurred. */
+	LOW_MEMORY_PRESSURE = 1,      /**< Tasks start to stall on memory, drop optional caches. */
+	MEDIUM_MEMORY_PRESSURE = 2,   /**< Noticeable memory stalls or cgroup high limit is hit, shed caches. */
+	CRITICAL_MEMORY_PRESSURE = 3, /**< All tasks stall on memory or OOM is close, free everything possible. */
+	MEMORY_PRESSURE_COUNT = 4,    /**< Memory pressure level count. */
+} MemoryPressure_T;
+/**
+ * @brief Memory pressure level.
+ */
+typedef uint8_t MemoryPressure;
+
+/**
+ * @brief Memory pressure event function.
+ * @warning It is called from the monitor background thread!
+ *
+ * @param pressure memory pressure level
+ * @param[in] argument function argument
+ */
+typedef void(*MemoryPressureFunction)(MemoryPressure pressure, void* argument);
+
+/**
+ * @brief Creates a new memory pressure monitor instance.
+ *
+ * @details
+ * If the function is not NULL, it is called from the monitor background thread on each memory pressure event.
+ * Otherwise use getMemoryMonitorFd() with poll() / epoll and the pollMemoryPressure() to get the events.
+ *
+ * @param onPressure memory pressure event function, or NULL
+ * @param[in] argument function argument, or NULL
+ * @return A new memory pressure monitor instance on success, otherwise NULL. (Also if not supported)
+ */
+MemoryMonitor createMemoryMonitor(MemoryPressureFunction onPressure, void* argument);
+/**
+ * @brief Destroys memory pressure monitor instance.
+ * @details Stops the monitor background thread, if it was started, and waits for the running callback to return.
+ * @param memoryMonitor memory pressure monitor instance or NULL
+ */
+void destroyMemoryMonitor(MemoryMonitor memoryMonitor);
+
+/**
+ * @brief Returns memory pressure monitor file descriptor, readable on a new event.
+ * @details Returns epoll file descriptor on Linux, otherwise -1. (Use pollMemoryPressure() periodically)
+ * @param memoryMonitor memory pressure monitor instance
+ */
+int getMemoryMonitorFd(MemoryMonitor memoryMonitor);
+
+/**
+ * @brief Returns the highest memory pressure level since the last poll, without blocking.
+ * @note Do not use it if the monitor was created with the event function.
+ * @param memoryMonitor memory pressure monitor instance
+ */
+MemoryPressure pollMemoryPressure(MemoryMonitor memoryMonitor);
+
+/***********************************************************************************************************************
+ * @brief Returns system virtual memory page size in bytes. (MT-Safe)
+ */
+size_t getPageSize();
+/**
+ * @brief Returns system huge (large) page size in bytes. (MT-Safe)
+ * @details Returns transparent huge page size on Linux and the large page minimum on Windows.
+ * @return The huge page size on success, otherwise 0. (Also if not supported)
+ */
+size_t getHugePageSize();
+
+/**
+ * @brief Reserves virtual address space range, without committing physical memory. (MT-Safe)
+ * @details Reserved pages are not accessible, use commitMemory() before using them.
+ * @param size reserved range size in bytes (rounded up to the page size)
+ * @return Reserved range pointer on success, otherwise NULL.
+ */
+void* reserveMemory(size_t size);
+/**
+ * @brief Releases reserved virtual address space range. (MT-Safe)
+ *
+ * @param[in] memory reserved range pointer or NULL
+ * @param size reserved range size in bytes
+ *
+ * @return True on success, otherwise false.
+ */
+bool releaseMemory(void* memory, size_t size);
+
+/**
+ * @brief Commits reserved pages, making them readable and writable. (MT-Safe)
+ * @details Committed pages are zero initialized and backed by the physical memory on the first access.
+ *
+ * @param[in] memory page aligned range pointer inside the reservation
+ * @param size range size in bytes
+ *
+ * @return True on success, otherwise false.
+ */
+bool commitMemory(void* memory, size_t size);
+/**
+ * @brief Decommits pages, returning their physical memory to the system. (MT-Safe)
+ * @details Pages stay reserved but become not accessible, their content is lost.
+ *
+ * @param[in] memory page aligned range pointer inside the reservation
+ * @param size range size in bytes
+ *
+ * @return True on success, otherwise false.
+ */
+bool decommitMemory(void* memory, size_t size);
+
+/**
+ * @brief Marks pages as guard pages, any access to them crashes the program. (MT-Safe)
+ * @details Use it to catch buffer overflows and stack overruns. Call commitMemory() to make them usable again.
+ *
+ * @param[in] memory page aligned range pointer
+ * @param size range size in bytes
+ *
+ * @return True on success, otherwise false.
+ */
+bool guardMemory(void* memory, size_t size);
+/**
+ * @brief Advises system to back the range with huge pages. (MT-Safe)
+ * @details Uses transparent huge pages on Linux (MADV_HUGEPAGE). Range should be aligned to the huge page size.
+ *
+ * @param[in] memory page aligned range pointer
+ * @param size range size in bytes
+ *
+ * @return True on success, otherwise false. (Also if not supported)
+ */
+bool adviseHugePages(void* memory, size_t size);
+
+/**
+ * @brief Locks pages in the physical memory, preventing them from being swapped out. (MT-Safe)
+ * @details Limited by the RLIMIT_MEMLOCK on Linux and macOS, and by the working set size on Windows.
+ *
+ * @param[in] memory committed range pointer
+ * @param size range size in bytes
+ *
+ * @return True on success, otherwise false.
+ */
+bool lockMemory(void* memory, size_t size);
+/**
+ * @brief Unlocks pages locked by the lockMemory(). (MT-Safe)
+ *
+ * @param[in] memory locked range pointer
+ * @param size range size in bytes
+ *
+ * @return True on success, otherwise false.
+ */
+bool unlockMemory(void* memory, size_t size);
+
+/***********************************************************************************************************************
+ * @brief Linear memory arena structure.
+ */
+typedef struct MemoryArena_T MemoryArena_T;
+/**
+ * @brief Linear memory arena instance.
+ */
+typedef MemoryArena_T* MemoryArena;
+
+/**
+ * @brief Creates a new linear memory arena instance.
+ *
+ * @details
+ * Reserves maxSize bytes of the address space and commits it on demand. Allocations never move, and the arena
+ * is freed all at once with the resetMemoryArena() or rewindMemoryArena(), which makes it a good per-frame scratch
+ * memory. Uncommitted reservation tail acts as a guard region, so an overflow crashes instead of corrupting memory.
+ *
+ * @param maxSize maximum arena size in bytes
+ * @param useHugePages align and advise the arena to be backed by huge pages
+ *
+ * @return A new linear memory arena instance on success, otherwise NULL.
+ */
+MemoryArena createMemoryArena(size_t maxSize, bool useHugePages);
+/**
+ * @brief Destroys linear memory arena instance, releasing all its memory.
+ * @param memoryArena linear memory arena instance or NULL
+ */
+void destroyMemoryArena(MemoryArena memoryArena);
+
+/**
+ * @brief Allocates memory from the linear arena. (MT-Unsafe)
+ * @details Allocated memory is zero initialized only when it is committed for the first time.
+ *
+ * @param memoryArena linear memory arena instance
+ * @param size allocation size in bytes
+ * @param alignment allocation alignment in bytes (power of two)
+ *
+ * @return Allocated memory pointer on success, otherwise NULL. (If the arena is full)
+ */
+void* allocateArenaMemory(MemoryArena memoryArena, size_t size, size_t alignment);
+
+/**
+ * @brief Returns linear memory arena allocated size in bytes. (Use it as a rewind marker)
+ * @param memoryArena linear memory arena instance
+ */
+size_t getMemoryArenaSize(MemoryArena memoryArena);
+/**
+ * @brief Returns linear memory arena committed size in bytes.
+ * @param memoryArena linear memory arena instance
+ */
+size_t getMemoryArenaCommittedSize(MemoryArena memoryArena);
+
+/**
+ * @brief Frees all linear memory arena allocations after the marker. (MT-Unsafe)
+ * @param memoryArena linear memory arena instance
+ * @param size arena size marker, returned by the getMemoryArenaSize()
+ */
+void rewindMemoryArena(MemoryArena memoryArena, size_t size);
+/**
+ * @brief Frees all linear memory arena allocations. (MT-Unsafe)
+ * @details Committed memory is kept for the next allocations, use trimMemoryArena() to return it.
+ * @param memoryArena linear memory arena instance
+ */
+void resetMemoryArena(MemoryArena memoryArena);
+/**
+ * @brief Decommits unused linear memory arena pages. (MT-Unsafe)
+ * @param memoryArena linear memory arena instance
+ * @return True on success, otherwise false.
+ */
+bool trimMemoryArena(MemoryArena memoryArena);
+
+/***********************************************************************************************************************
+ * @brief Fixed-size memory pool structure.
+ */
+typedef struct MemoryPool_T MemoryPool_T;
+/**
+ * @brief Fixed-size memory pool instance.
+ */
+typedef MemoryPool_T* MemoryPool;
+
+/**
+ * @brief Creates a new fixed-size memory pool instance.
+ * @details Reserves space for maxItemCount items and commits it on demand, item pointers never move.
+ *
+ * @param itemSize pool item size in bytes (rounded up to the 16 bytes)
+ * @param maxItemCount maximum pool item count
+ *
+ * @return A new fixed-size memory pool instance on success, otherwise NULL.
+ */
+MemoryPool createMemoryPool(size_t itemSize, size_t maxItemCount);
+/**
+ * @brief Destroys fixed-size memory pool instance, releasing all its memory.
+ * @param memoryPool fixed-size memory pool instance or NULL
+ */
+void destroyMemoryPool(MemoryPool memoryPool);
+
+/**
+ * @brief Allocates item from the fixed-size memory pool. (MT-Unsafe)
+ * @details Reuses the last freed item first, item memory is not initialized.
+ * @param memoryPool fixed-size memory pool instance
+ * @return Allocated item pointer on success, otherwise NULL. (If the pool is full)
+ */
+void* allocatePoolItem(MemoryPool memoryPool);
+/**
+ * @brief Returns item to the fixed-size memory pool. (MT-Unsafe)
+ * @param memoryPool fixed-size memory pool instance
+ * @param[in] item allocated item pointer or NULL
+ */
+void freePoolItem(MemoryPool memoryPool, void* item);
+
+/**
+ * @brief Returns fixed-size memory pool item size in bytes.
+ * @param memoryPool fixed-size memory pool instance
+ */
+size_t getMemoryPoolItemSize(MemoryPool memoryPool);
+/**
+ * @brief Returns fixed-size memory pool allocated item count.
+ * @param memoryPool fixed-size memory pool instance
+ */
+size_t getMemoryPoolItemCount(MemoryPool memoryPool);
@@ -28,50 +28,518 @@
  * @return The time since some unspecified starting point.
  */
 double getCurrentClock();
+/**
+ * @brief Returns monotonic time stamp in nanoseconds. (MT-Safe)
+ * @details Keeps nanosecond precision regardless of the system uptime, unlike the getCurrentClock().
+ * @return The time since some unspecified starting point.
+ */
+int64_t getCurrentClockNs();
+/**
+ * @brief Returns cheap low resolution monotonic time stamp in nanoseconds. (MT-Safe)
+ * 
+ * @details
+ * Updated once per scheduler tick (1-16ms), suitable for the coarse event time stamping.
+ * Uses CLOCK_MONOTONIC_COARSE on Linux, CLOCK_MONOTONIC_RAW_APPROX on macOS and GetTickCount64 on Windows.
+ * 
+ * @return The time since some unspecified starting point.
+ */
+int64_t getCoarseClockNs();
+
+/**
+ * @brief Returns raw CPU cycle counter value. (MT-Safe)
+ * 
+ * @details
+ * Cheapest time stamp source: rdtsc on x86 and cntvct_el0 on ARM64, otherwise the getCurrentClockNs().
+ * Use getCycleFrequency() or convertCyclesToNs() to convert counter values to time.
+ * 
+ * @note On x86 the counter is constant rate only if CPU has an invariant TSC. (All modern CPUs)
+ */
+uint64_t getCycleCount();
+/**
+ * @brief Returns CPU cycle counter frequency in hertz. (MT-Safe)
+ * 
+ * @details
+ * Calibrated once on the first call: read from the cntfrq_el0 on ARM64 or CPUID leaf 0x15 on x86,
+ * otherwise measured against the getCurrentClockNs() during 10 milliseconds.
+ */
+uint64_t getCycleFrequency();
+/**
+ * @brief Converts CPU cycle counter value difference to the nanoseconds. (MT-Safe)
+ * @param cycles CPU cycle counter value or difference
+ */
+int64_t convertCyclesToNs(uint64_t cycles);
+
+/**
+ * @brief Wall clock and monotonic clocks correlation point.
+ * @details Wall time of a counter value: wallTimeNs + (value - monotonicNs).
+ */
+typedef struct ClockCorrelation
+{
+	int64_t wallTimeNs;  /**< Wall (real) time in nanoseconds since the Unix epoch. */
+	int64_t monotonicNs; /**< getCurrentClockNs() value at the wall time. */
+	uint64_t cycleCount; /**< getCycleCount() value at the wall time. */
+} ClockCorrelation;
+
+/**
+ * @brief Samples wall, monotonic and CPU cycle clocks at the same moment. (MT-Safe)
+ * @details Takes the sample with the smallest cycle counter window out of several tries.
+ * @param[out] clockCorrelation pointer to the clock correlation point
+ */
+void getClockCorrelation(ClockCorrelation* clockCorrelation);
+
+/***********************************************************************************************************************
+ * @brief System information snapshot.
+ * @details CPU fields are static, RAM sizes are refreshed with the updateSystemInfo() call.
+ */
+typedef struct SystemInfo
+{
+	int64_t totalRamSize;    /**< Total physical RAM size in bytes, or -1. */
+	int64_t freeRamSize;     /**< Free (available) physical RAM size in bytes, or -1. */
+	uint64_t cpuFeatures;    /**< Supported CPU feature bit mask. (CPU_FEATURE_BIT) */
+	int logicalCpuCount;     /**< Logical CPU count, or -1. */
+	int physicalCpuCount;    /**< Physical CPU count, or -1. */
+	int performanceCpuCount; /**< Performance CPU count, or -1. */
+	char cpuName[65];        /**< CPU name (brand, model) string. */
+} SystemInfo;
+
+/**
+ * @brief Returns cached system information snapshot. (MT-Safe)
+ * 
+ * @details
+ * Snapshot is filled once on the first call of any system information function, using a single pass over the 
+ * system files (/proc/cpuinfo, /proc/meminfo) without the stdio and heap allocations. Later calls only copy it.
+ * 
+ * @param[out] systemInfo system information snapshot
+ */
+void getSystemInfo(SystemInfo* systemInfo);
+
+/**
+ * @brief Refreshes cached system information snapshot. (MT-Safe)
+ * @details Updates total and free RAM size, other snapshot fields are static.
+ * @return True on success, otherwise false.
+ */
+bool updateSystemInfo();
 
 /**
  * @brief Returns system logical CPU count. (MT-Safe)
- * @details Useful for a background thread pool thread count.
+ * @details Useful for a background thread pool thread count. Served from the system information snapshot.
  */
 int getLogicalCpuCount();
 
 /**
  * @brief Returns system physical CPU count. (MT-Safe)
- * @details Useful for a foreground thread pool thread count.
+ * @details Useful for a foreground thread pool thread count. Served from the system information snapshot.
  */
 int getPhysicalCpuCount();
 
 /**
  * @brief Returns system performance CPU count. (MT-Safe)
- * @details Usefull for a foreground thread pool thread count.
+ * 
+ * @details
+ * Usefull for a foreground thread pool thread count. Served from the system information snapshot.
+ * Counts physical cores in the performance CPU set on hybrid CPUs, see the @ref getHybridCpuSets().
  */
 int getPerformanceCpuCount();
 
 /**
  * @brief Returns system total physical RAM size. (MT-Safe)
- * @details Usefull for an OS information logging.
+ * @details Usefull for an OS information logging. Served from the system information snapshot.
  * @return The total RAM size in bytes on success, otherwise -1.
  */
 int64_t getTotalRamSize();
 
 /**
  * @brief Returns system free physical RAM size. (MT-Safe)
- * @details Usefull for an OS information logging.
+ * 
+ * @details
+ * Usefull for an OS information logging. Served from the system information snapshot,
+ * call updateSystemInfo() to refresh the value.
+ * 
  * @return The free RAM size in bytes on success, otherwise -1.
  */
 int64_t getFreeRamSize();
 
+/**
+ * @brief Returns CPU count available to the process. (MT-Safe)
+ * 
+ * @details
+ * Respects the process affinity mask (taskset, cpuset) and the container CPU quota (cgroup v2 cpu.max,
+ * cgroup v1 cfs_quota_us, Windows job object CPU rate), rounding the quota up. Use it to size thread pools.
+ * Not cached, because limits can be changed at runtime.
+ *
+ * @return The effective CPU count on success, otherwise the logical CPU count.
+ */
+int getEffectiveCpuCount();
+
+/**
+ * @brief Returns RAM size available to the process. (MT-Safe)
+ * 
+ * @details
+ * Smallest of the total physical RAM size and the container memory limits (cgroup v2 memory.max
+ * and memory.high, cgroup v1 memory.limit_in_bytes, Windows job object memory limit). Use it to size
+ * caches and memory pools. Not cached, because limits can be changed at runtime.
+ *
+ * @return The effective RAM size in bytes on success, otherwise -1.
+ */
+int64_t getEffectiveRamSize();
+
 /**
  * @brief Returns system CPU name string. (MT-Safe)
- * @details Usefull for an OS information logging.
+ * @details Usefull for an OS information logging. Served from the system information snapshot.
  * @note You should free() the allocated string manually.
  * @return An allocated CPU name string.
  */
 char* getCpuName();
 
+/***********************************************************************************************************************
+ * @brief Resource usage measurement targets.
+ */
+typedef enum ResourceUsageTarget_T
+{
+	PROCESS_RESOURCE_USAGE_TARGET = 0,  /**< Current process, including all its threads. */
+	THREAD_RESOURCE_USAGE_TARGET = 1,   /**< Calling thread. */
+	CHILDREN_RESOURCE_USAGE_TARGET = 2, /**< Exited and reaped child processes. */
+	RESOURCE_USAGE_TARGET_COUNT = 3,    /**< Resource usage measurement target count. */
+} ResourceUsageTarget_T;
+/**
+ * @brief Resource usage measurement target.
+ */
+typedef uint8_t ResourceUsageTarget;
+
+/**
+ * @brief Resource usage counters. (-1 if not supported by the target or OS)
+ */
+typedef struct ResourceUsage
+{
+	int64_t userTimeNs;             /**< CPU time spent in the user mode in nanoseconds. */
+	int64_t systemTimeNs;           /**< CPU time spent in the kernel mode in nanoseconds. */
+	int64_t currentRssSize;         /**< Current resident set (working set) size in bytes. */
+	int64_t peakRssSize;            /**< Peak resident set size in bytes. (Largest child for children) */
+	int64_t minorFaultCount;        /**< Page faults served without I/O. (All page faults on Windows) */
+	int64_t majorFaultCount;        /**< Page faults which required I/O. */
+	int64_t voluntarySwitchCount;   /**< Context switches caused by waiting for a resource. */
+	int64_t involuntarySwitchCount; /**< Context switches caused by the scheduler preemption. */
+	int64_t readSize;               /**< Bytes read by the read() like calls, including page cache hits. */
+	int64_t writeSize;              /**< Bytes written by the write() like calls. */
+	int64_t diskReadSize;           /**< Bytes fetched from the storage device. */
+	int64_t diskWriteSize;          /**< Bytes sent to the storage device. */
+} ResourceUsage;
+
+/**
+ * @brief Returns process, thread or children resource usage counters. (MT-Safe)
+ * 
+ * @details
+ * Cheap enough to be called on every telemetry tick: getrusage() is combined with the /proc/self/statm and
+ * /proc/self/io files on Linux, which are kept open and read with a single pread() call. Memory and I/O counters
+ * are process wide, so they are -1 for the thread target.
+ *
+ * @param target resource usage measurement target
+ * @param[out] resourceUsage resource usage counters
+ *
+ * @return True on success, otherwise false. (Children usage is not tracked on Windows)
+ */
+bool getResourceUsage(ResourceUsageTarget target, ResourceUsage* resourceUsage);
+
+/**
+ * @brief Returns CPU time consumed by the calling thread in nanoseconds. (MT-Safe)
+ * @details Cheaper than the getResourceUsage(), use it to measure CPU time of a code block.
+ * @return User and kernel mode CPU time sum on success, otherwise -1.
+ */
+int64_t getThreadCpuTimeNs();
+/**
+ * @brief Returns CPU time consumed by the current process in nanoseconds. (MT-Safe)
+ * @return User and kernel mode CPU time sum of all process threads on success, otherwise -1.
+ */
+int64_t getProcessCpuTimeNs();
+
+/***********************************************************************************************************************
+ * @brief CPU instruction set extension types.
+ * @details x86 AVX features are reported only if the OS saves their register state. AES, SHA and CRC32 are
+ *          reported for both x86 (AES-NI, SHA-NI, SSE4.2) and ARM (Crypto, CRC) instruction sets.
+ */
+typedef enum CpuFeature_T
+{
+	SSE2_CPU_FEATURE = 0,
+	SSE3_CPU_FEATURE = 1,
+	SSSE3_CPU_FEATURE = 2,
+	SSE41_CPU_FEATURE = 3,
+	SSE42_CPU_FEATURE = 4,
+	POPCNT_CPU_FEATURE = 5,
+	AVX_CPU_FEATURE = 6,
+	AVX2_CPU_FEATURE = 7,
+	FMA_CPU_FEATURE = 8,
+	F16C_CPU_FEATURE = 9,
+	BMI1_CPU_FEATURE = 10,
+	BMI2_CPU_FEATURE = 11,
+	PCLMUL_CPU_FEATURE = 12,
+	AVX512F_CPU_FEATURE = 13,
+	AVX512DQ_CPU_FEATURE = 14,
+	AVX512CD_CPU_FEATURE = 15,
+	AVX512BW_CPU_FEATURE = 16,
+	AVX512VL_CPU_FEATURE = 17,
+	AVX512VBMI_CPU_FEATURE = 18,
+	AVX512VNNI_CPU_FEATURE = 19,
+	NEON_CPU_FEATURE = 20,
+	SVE_CPU_FEATURE = 21,
+	SVE2_CPU_FEATURE = 22,
+	DOTPROD_CPU_FEATURE = 23,
+	AES_CPU_FEATURE = 24,
+	SHA_CPU_FEATURE = 25,
+	CRC32_CPU_FEATURE = 26,
+	CPU_FEATURE_COUNT = 27,
+} CpuFeature_T;
+/**
+ * @brief CPU instruction set extension type.
+ */
+typedef uint8_t CpuFeature;
+
+/**
+ * @brief Returns CPU feature mask bit.
+ * @param feature target CPU feature type
+ */
+#define CPU_FEATURE_BIT(feature) (1ull << (feature))
+
+/**
+ * @brief Returns supported CPU feature bit mask. (MT-Safe)
+ * @details Detected once using CPUID / HWCAP. Served from the system information snapshot.
+ */
+uint64_t getCpuFeatures();
+/**
+ * @brief Returns true if CPU feature is supported. (MT-Safe)
+ * @param feature target CPU feature type
+ */
+bool hasCpuFeature(CpuFeature feature);
+/**
+ * @brief Returns CPU feature name string. ("AVX2", "NEON", etc.)
+ * @param feature target CPU feature type
+ */
+const char* getCpuFeatureName(CpuFeature feature);
+
+/**
+ * @brief Function implementation pointer. (Cast to the actual function type)
+ */
+typedef void(*CpuFunction)(void);
+
+/**
+ * @brief Function implementation with the required CPU features.
+ */
+typedef struct CpuFunctionVariant
+{
+	CpuFunction function;      /**< Function implementation pointer. */
+	uint64_t requiredFeatures; /**< Required CPU feature bit mask. (CPU_FEATURE_BIT) */
+} CpuFunctionVariant;
+
+/**
+ * @brief Returns the first function variant supported by the CPU. (MT-Safe)
+ *
+ * @details
+ * Sort variants from the best to the most generic one, and resolve the function once at startup,
+ * storing it to a function pointer. Compile variants with the MPIO_TARGET_* attributes.
+ * 
+ * @param[in] variants function variant array
+ * @param count function variant count
+ * @return Selected function pointer, or NULL if none of the variants is supported.
+ */
+CpuFunction selectCpuFunction(const CpuFunctionVariant* variants, uint32_t count);
+
+#if (defined(__GNUC__) || defined(__clang__)) && (__x86_64__ || __i386__)
+/**
+ * @brief Compiles function with the SSE4.2 and POPCNT instructions.
+ */
+#define MPIO_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+/**
+ * @brief Compiles function with the AVX2, FMA and BMI2 instructions.
+ */
+#define MPIO_TARGET_AVX2 __attribute__((target("avx2,fma,bmi,bmi2,f16c")))
+/**
+ * @brief Compiles function with the AVX-512 F, DQ, CD, BW and VL instructions.
+ */
+#define MPIO_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512cd,avx512bw,avx512vl,avx2,fma,bmi,bmi2")))
+#else
+// Note: MSVC allows intrinsics of any x86 instruction set without a target attribute.
+#define MPIO_TARGET_SSE42
+#define MPIO_TARGET_AVX2
+#define MPIO_TARGET_AVX512
+#endif
+
+/***********************************************************************************************************************
+ * @brief Maximum logical CPU count supported by the CPU set.
+ */
+#define MAX_CPU_SET_COUNT 1024
+
+/**
+ * @brief Logical CPU set. (Bit mask)
+ * @details Logical CPU index is the OS processor number. (Windows: group * 64 + number)
+ */
+typedef struct CpuSet
+{
+	uint64_t bits[MAX_CPU_SET_COUNT / 64]; /**< Logical CPU bit mask. */
+} CpuSet;
+
+/**
+ * @brief Removes all logical CPUs from the set.
+ * @param[out] cpuSet target CPU set
+ */
+inline static void clearCpuSet(CpuSet* cpuSet)
+{
+	for (int i = 0; i < MAX_CPU_SET_COUNT / 64; i++)
+		cpuSet->bits[i] = 0;
+}
+/**
+ * @brief Adds logical CPU to the set.
+ * @param[in,out] cpuSet target CPU set
+ * @param cpu logical CPU index
+ */
+inline static void addCpuToSet(CpuSet* cpuSet, int cpu)
+{
+	if (cpu >= 0 && cpu < MAX_CPU_SET_COUNT)
+		cpuSet->bits[cpu / 64] |= (uint64_t)1 << (cpu % 64);
+}
+/**
+ * @brief Removes logical CPU from the set.
+ * @param[in,out] cpuSet target CPU set
+ * @param cpu logical CPU index
+ */
+inline static void removeCpuFromSet(CpuSet* cpuSet, int cpu)
+{
+	if (cpu >= 0 && cpu < MAX_CPU_SET_COUNT)
+		cpuSet->bits[cpu / 64] &= ~((uint64_t)1 << (cpu % 64));
+}
+/**
+ * @brief Returns true if logical CPU is in the set.
+ * @param[in] cpuSet target CPU set
+ * @param cpu logical CPU index
+ */
+inline static bool isCpuInSet(const CpuSet* cpuSet, int cpu)
+{
+	if (cpu < 0 || cpu >= MAX_CPU_SET_COUNT)
+		return false;
+	return (cpuSet->bits[cpu / 64] >> (cpu % 64)) & 1;
+}
+/**
+ * @brief Returns logical CPU count in the set.
+ * @param[in] cpuSet target CPU set
+ */
+inline static int getCpuSetCount(const CpuSet* cpuSet)
+{
+	int count = 0;
+	for (int i = 0; i < MAX_CPU_SET_COUNT / 64; i++)
+	{
+		uint64_t bits = cpuSet->bits[i];
+		while (bits)
+		{
+			bits &= bits - 1; count++;
+		}
+	}
+	return count;
+}
+/**
+ * @brief Returns true if both CPU sets contain the same logical CPUs.
+ * @param[in] a first CPU set
+ * @param[in] b second CPU set
+ */
+inline static bool isCpuSetEqual(const CpuSet* a, const CpuSet* b)
+{
+	for (int i = 0; i < MAX_CPU_SET_COUNT / 64; i++)
+	{
+		if (a->bits[i] != b->bits[i])
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Returns system performance and efficiency core logical CPU sets. (MT-Safe)
+ * 
+ * @details
+ * Useful for pinning latency-critical threads to the performance cores of hybrid CPUs (Intel P/E-cores, ARM
+ * big.LITTLE). On Linux core types are detected from the cpu_core/cpu_atom PMU devices, CPUID hybrid leaf 0x1A,
+ * cpu_capacity or clustered cpufreq maximum frequencies. Served from the system information snapshot.
+ * 
+ * @param[out] performanceCpus performance core logical CPU set or NULL
+ * @param[out] efficiencyCpus efficiency core logical CPU set or NULL
+ * @return True if CPU is hybrid, otherwise false and all logical CPUs are reported as performance.
+ */
+bool getHybridCpuSets(CpuSet* performanceCpus, CpuSet* efficiencyCpus);
+
+/**
+ * @brief CPU cache types.
+ */
+typedef enum CpuCacheType_T
+{
+	UNIFIED_CPU_CACHE_TYPE = 0,     /**< Cache stores both data and instructions. */
+	DATA_CPU_CACHE_TYPE = 1,        /**< Cache stores only data. */
+	INSTRUCTION_CPU_CACHE_TYPE = 2, /**< Cache stores only instructions. */
+	CPU_CACHE_TYPE_COUNT = 3,       /**< CPU cache type count. */
+} CpuCacheType_T;
+/**
+ * @brief CPU cache type.
+ */
+typedef uint8_t CpuCacheType;
+
+/**
+ * @brief CPU cache instance information.
+ */
+typedef struct CpuCache
+{
+	CpuSet cpus;        /**< Logical CPUs sharing this cache instance. */
+	int64_t size;       /**< Cache size in bytes. */
+	int lineSize;       /**< Cache line size in bytes, or 0 if unknown. */
+	int associativity;  /**< Cache ways of associativity, or 0 if unknown. */
+	uint8_t level;      /**< Cache level. (1 = L1, 2 = L2, ...) */
+	CpuCacheType type;  /**< Cache type. */
+} CpuCache;
+
+/**
+ * @brief CPU topology information.
+ * @details Describes unique cache instances, physical cores (SMT siblings), packages and NUMA nodes.
+ */
+typedef struct CpuTopology
+{
+	CpuCache* caches;    /**< Unique CPU cache instance array. */
+	CpuSet* cores;       /**< Physical core SMT sibling logical CPU set array. */
+	CpuSet* packages;    /**< Physical package (socket) logical CPU set array. */
+	CpuSet* nodes;       /**< NUMA node logical CPU set array. */
+	CpuSet onlineCpus;   /**< Online logical CPU set. */
+	int cacheCount;      /**< CPU cache instance count. */
+	int coreCount;       /**< Physical core count. */
+	int packageCount;    /**< Physical package count. */
+	int nodeCount;       /**< NUMA node count. */
+	int cacheLineSize;   /**< Smallest data cache line size in bytes. */
+	int lastCacheLevel;  /**< Last level cache (LLC) level. */
+} CpuTopology;
+
+/**
+ * @brief Creates a new CPU topology information instance. (MT-Safe)
+ * 
+ * @details
+ * On Linux information is read from the /sys/devices/system/cpu and /sys/devices/system/node.
+ * Caches shared by multiple logical CPUs (L2, LLC) are reported once with the sharing CPU set.
+ * 
+ * @note You should destroyCpuTopology() the returned instance manually.
+ * @return A new CPU topology instance on success, otherwise NULL.
+ */
+CpuTopology* createCpuTopology();
+/**
+ * @brief Destroys CPU topology information instance. (MT-Safe)
+ * @param[in] cpuTopology CPU topology instance or NULL
+ */
+void destroyCpuTopology(CpuTopology* cpuTopology);
+
+/**
+ * @brief Returns CPU cache level size in bytes, for a single cache instance. (MT-Safe)
+ * @details Instruction caches are ignored.
+ * 
+ * @param[in] cpuTopology CPU topology instance
+ * @param level target cache level
+ * 
+ * @return Largest data or unified cache instance size on success, otherwise 0.
+ */
+int64_t getCpuCacheSize(const CpuTopology* cpuTopology, uint8_t level);
+
 /**
  * @brief Executes specified file with arguments. (MT-Safe)
- * @details Safe std::system() function alternative with arguments.
+ * @details Safe std::system() function alternative with arguments. See the @ref runProcess().
  * @return Program exit code or -1 if process stopped or crashed.
  *
  * @param[in] filePath file path string
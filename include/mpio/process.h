@@ -0,0 +1,235 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Child process launching functions.
+ *
+ * @details
+ * Processes are spawned with posix_spawn() (vfork / clone(CLONE_VM) based), so the launch time does not depend on
+ * the parent process memory size, unlike the fork(). Standard streams can be inherited, discarded, redirected to
+ * the files or connected to the in-memory buffers through pipes. Processes can be also started without blocking,
+ * or run concurrently by the process pool, which waits for them using pidfd and epoll on Linux.
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Child process standard stream types.
+ */
+typedef enum ProcessStream_T
+{
+	INHERIT_PROCESS_STREAM = 0, /**< Uses the parent process stream. */
+	NULL_PROCESS_STREAM = 1,    /**< Discards output or reads empty input. (/dev/null, NUL) */
+	FILE_PROCESS_STREAM = 2,    /**< Reads input from the file or overwrites file with the output. */
+	PIPE_PROCESS_STREAM = 3,    /**< Writes input data or captures output to the memory buffer. */
+	PROCESS_STREAM_COUNT = 4,   /**< Child process standard stream type count. */
+} ProcessStream_T;
+/**
+ * @brief Child process standard stream type.
+ */
+typedef uint8_t ProcessStream;
+
+/**
+ * @brief Child process launch options.
+ * @details Zero initialized options inherit everything from the parent process.
+ */
+typedef struct ProcessOptions
+{
+	const char* workingDirectory;   /**< Child working directory path, or NULL to inherit. */
+	const char* const* environment; /**< "NAME=VALUE" strings (last should be NULL!), or NULL to inherit. */
+	const char* stdinPath;          /**< Input file path. (FILE_PROCESS_STREAM) */
+	const char* stdoutPath;         /**< Output file path. (FILE_PROCESS_STREAM) */
+	const char* stderrPath;         /**< Error output file path. (FILE_PROCESS_STREAM) */
+	const void* stdinData;          /**< Input data written to the child stdin. (PIPE_PROCESS_STREAM) */
+	size_t stdinSize;               /**< Input data size in bytes. (PIPE_PROCESS_STREAM) */
+	ProcessStream stdinType;        /**< Child stdin stream type. */
+	ProcessStream stdoutType;       /**< Child stdout stream type. */
+	ProcessStream stderrType;       /**< Child stderr stream type. */
+} ProcessOptions;
+
+/**
+ * @brief Child process captured output.
+ * @note You should free() the captured data manually.
+ */
+typedef struct ProcessOutput
+{
+	char* stdoutData;  /**< Captured null-terminated stdout data, or NULL. (PIPE_PROCESS_STREAM) */
+	char* stderrData;  /**< Captured null-terminated stderr data, or NULL. (PIPE_PROCESS_STREAM) */
+	size_t stdoutSize; /**< Captured stdout data size in bytes. */
+	size_t stderrSize; /**< Captured stderr data size in bytes. */
+} ProcessOutput;
+
+/**
+ * @brief Runs specified file with arguments and waits for it to exit. (MT-Safe)
+ * @details File is searched in the PATH directories, if it does not contain a path separator.
+ *
+ * @param[in] filePath executable file path or name string
+ * @param[in] args program arguments, first is the program name (last should be NULL!)
+ * @param[in] options process launch options, or NULL to inherit everything
+ * @param[out] output captured process output, or NULL (if there are no pipe streams)
+ *
+ * @return Program exit code or -1 if failed to launch, process stopped or crashed.
+ */
+int runProcess(const char* filePath, char** args, const ProcessOptions* options, ProcessOutput* output);
+
+/***********************************************************************************************************************
+ * @brief Child process structure.
+ */
+typedef struct Process_T Process_T;
+/**
+ * @brief Child process instance.
+ */
+typedef Process_T* Process;
+
+/**
+ * @brief Exited child process statistics.
+ */
+typedef struct ProcessStats
+{
+	int64_t wallTimeNs;   /**< Time from the process start to the exit in nanoseconds. */
+	int64_t userTimeNs;   /**< CPU time spent in the user mode in nanoseconds. */
+	int64_t systemTimeNs; /**< CPU time spent in the kernel mode in nanoseconds. */
+	int64_t peakRssSize;  /**< Peak resident set (working set) size in bytes, or -1. */
+	int exitCode;         /**< Program exit code or -1 if failed to launch, process stopped or crashed. */
+} ProcessStats;
+
+/**
+ * @brief Starts specified file with arguments without waiting for it to exit. (MT-Safe)
+ * @details See the @ref runProcess(). Pipe streams are not supported, use files to store the output.
+ *
+ * @param[in] filePath executable file path or name string
+ * @param[in] args program arguments, first is the program name (last should be NULL!)
+ * @param[in] options process launch options, or NULL to inherit everything
+ *
+ * @return A new child process instance on success, otherwise NULL.
+ */
+Process startProcess(const char* filePath, char** args, const ProcessOptions* options);
+/**
+ * @brief Destroys child process instance.
+ * @details Kills the process if it is still running and waits for it to exit.
+ * @param process child process instance or NULL
+ */
+void destroyProcess(Process process);
+
+/**
+ * @brief Returns child process file descriptor, readable when the process exits.
+ * @details Returns pidfd on Linux 5.3+, otherwise -1. (Use the pollProcess() periodically)
+ * @param process child process instance
+ */
+int getProcessFd(Process process);
+/**
+ * @brief Kills child process. (SIGKILL, TerminateProcess)
+ * @param process child process instance
+ * @return True on success or if the process has already exited, otherwise false.
+ */
+bool killProcess(Process process);
+
+/**
+ * @brief Returns true if child process has exited, without blocking.
+ * @param process child process instance
+ * @param[out] stats exited process statistics, or NULL
+ */
+bool pollProcess(Process process, ProcessStats* stats);
+/**
+ * @brief Waits for the child process to exit.
+ * @param process child process instance
+ * @param[out] stats exited process statistics, or NULL
+ */
+void waitProcess(Process process, ProcessStats* stats);
+
+/***********************************************************************************************************************
+ * @brief Child process pool structure.
+ */
+typedef struct ProcessPool_T ProcessPool_T;
+/**
+ * @brief Child process pool instance.
+ */
+typedef ProcessPool_T* ProcessPool;
+
+/**
+ * @brief Child process pool job completion.
+ */
+typedef struct ProcessCompletion
+{
+	void* userData;     /**< Job user data. */
+	ProcessStats stats; /**< Exited process statistics. */
+} ProcessCompletion;
+
+/**
+ * @brief Creates a new child process pool instance.
+ * @details Runs at most concurrency processes at once, like the "make -j".
+ * @param concurrency maximum running process count, or 0 for the getEffectiveCpuCount()
+ * @return A new child process pool instance on success, otherwise NULL.
+ */
+ProcessPool createProcessPool(uint32_t concurrency);
+/**
+ * @brief Destroys child process pool instance.
+ * @details Blocks until all running processes exit, queued jobs are dropped.
+ * @param processPool child process pool instance or NULL
+ */
+void destroyProcessPool(ProcessPool processPool);
+
+/**
+ * @brief Returns child process pool maximum running process count.
+ * @param processPool child process pool instance
+ */
+uint32_t getProcessPoolConcurrency(ProcessPool processPool);
+/**
+ * @brief Returns child process pool queued, running and not yet returned completed job count.
+ * @param processPool child process pool instance
+ */
+uint32_t getProcessPoolJobCount(ProcessPool processPool);
+
+/**
+ * @brief Adds a new job to the child process pool queue. (MT-Unsafe)
+ * @details Arguments and options are copied. Pipe streams are not supported, use files to store the output.
+ *
+ * @param processPool child process pool instance
+ * @param[in] filePath executable file path or name string
+ * @param[in] args program arguments, first is the program name (last should be NULL!)
+ * @param[in] options process launch options, or NULL to inherit everything
+ * @param[in] userData arbitrary user data, returned with the completion
+ *
+ * @return True on success, otherwise false.
+ */
+bool addProcessPoolJob(ProcessPool processPool, const char* filePath,
+	char** args, const ProcessOptions* options, void* userData);
+
+/**
+ * @brief Starts queued jobs and returns completed ones without blocking. (MT-Unsafe)
+ *
+ * @param processPool child process pool instance
+ * @param[out] completions job completion array
+ * @param capacity job completion array size
+ *
+ * @return Returned job completion count.
+ */
+uint32_t pollProcessPoolCompletions(ProcessPool processPool, ProcessCompletion* completions, uint32_t capacity);
+/**
+ * @brief Starts queued jobs and waits for the completed ones. (MT-Unsafe)
+ * @details Blocks until at least minCount jobs are completed (clamped to the job count).
+ *
+ * @param processPool child process pool instance
+ * @param[out] completions job completion array
+ * @param capacity job completion array size
+ * @param minCount minimal returned job completion count
+ *
+ * @return Returned job completion count.
+ */
+uint32_t waitProcessPoolCompletions(ProcessPool processPool,
+	ProcessCompletion* completions, uint32_t capacity, uint32_t minCount);
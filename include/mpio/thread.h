@@ -0,0 +1,138 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Common thread functions.
+ *
+ * @details
+ * Threads can be created with a custom stack size and name, pinned to a CPU set from the topology and given a
+ * lower or higher scheduling priority. Functions that accept a thread instance use the calling thread if it is NULL.
+ */
+
+#pragma once
+#include "mpio/os.h"
+#include <stddef.h>
+
+/**
+ * @brief Thread structure.
+ */
+typedef struct Thread_T Thread_T;
+/**
+ * @brief Thread instance.
+ */
+typedef Thread_T* Thread;
+
+/**
+ * @brief Thread function.
+ * @param[in] argument thread function argument
+ */
+typedef void(*ThreadFunction)(void* argument);
+
+/**
+ * @brief Maximum thread name length, including null terminator. (Linux limit)
+ */
+#define MAX_THREAD_NAME_LENGTH 16
+
+/**
+ * @brief Thread scheduling priority types.
+ */
+typedef enum ThreadPriority_T
+{
+	LOW_THREAD_PRIORITY = 0,      /**< Background work, yields to normal threads. */
+	NORMAL_THREAD_PRIORITY = 1,   /**< Default time-sharing scheduling. */
+	HIGH_THREAD_PRIORITY = 2,     /**< Latency-sensitive work, preferred over normal threads. */
+	REALTIME_THREAD_PRIORITY = 3, /**< Realtime FIFO / time-critical scheduling. */
+	THREAD_PRIORITY_COUNT = 4,    /**< Thread scheduling priority type count. */
+} ThreadPriority_T;
+/**
+ * @brief Thread scheduling priority type.
+ */
+typedef uint8_t ThreadPriority;
+
+/**
+ * @brief Creates and starts a new thread instance. (MT-Safe)
+ * @details Returns after the thread has started and applied its name.
+ *
+ * @param[in] function thread function
+ * @param[in] argument thread function argument or NULL
+ * @param stackSize thread stack size in bytes, or 0 for the system default
+ * @param[in] name thread name or NULL, truncated to the MAX_THREAD_NAME_LENGTH
+ *
+ * @return A new thread instance on success, otherwise NULL.
+ */
+Thread createThread(ThreadFunction function, void* argument, size_t stackSize, const char* name);
+/**
+ * @brief Waits for the thread function to return and destroys thread instance.
+ * @param thread thread instance or NULL
+ */
+void destroyThread(Thread thread);
+
+/**
+ * @brief Sets thread name, visible in debuggers and profilers.
+ * @note On macOS only the calling thread name can be changed.
+ *
+ * @param thread thread instance or NULL for the calling thread
+ * @param[in] name thread name, truncated to the MAX_THREAD_NAME_LENGTH
+ *
+ * @return True on success, otherwise false.
+ */
+bool setThreadName(Thread thread, const char* name);
+
+/**
+ * @brief Pins thread to the logical CPU set.
+ * 
+ * @details
+ * Keeps threads with different workloads on separate cores to reduce cache thrashing.
+ * On Windows only CPUs from the processor group of the first set CPU are used.
+ * 
+ * @note macOS does not support thread affinity, false is returned.
+ * 
+ * @param thread thread instance or NULL for the calling thread
+ * @param[in] cpuSet target logical CPU set (see the getHybridCpuSets(), createCpuTopology())
+ * 
+ * @return True on success, otherwise false.
+ */
+bool setThreadAffinity(Thread thread, const CpuSet* cpuSet);
+/**
+ * @brief Returns thread logical CPU affinity set.
+ * @note macOS does not support thread affinity, false is returned.
+ *
+ * @param thread thread instance or NULL for the calling thread
+ * @param[out] cpuSet pointer to the logical CPU set
+ *
+ * @return True on success, otherwise false.
+ */
+bool getThreadAffinity(Thread thread, CpuSet* cpuSet);
+
+/**
+ * @brief Sets thread scheduling priority.
+ * 
+ * @details
+ * On Linux priorities are mapped to the nice values (10, 0, -10) and SCHED_FIFO policy.
+ * Raising priority above the normal usually requires elevated privileges (CAP_SYS_NICE, RLIMIT_NICE).
+ * 
+ * @param thread thread instance or NULL for the calling thread
+ * @param priority thread scheduling priority type
+ * 
+ * @return True on success, otherwise false.
+ */
+bool setThreadPriority(Thread thread, ThreadPriority priority);
+
+/**
+ * @brief Returns logical CPU index the calling thread is running on. (MT-Safe)
+ * @note The returned value can become outdated immediately, unless the thread is pinned.
+ * @return The logical CPU index on success, otherwise -1.
+ */
+int getCurrentThreadCpu();
@@ -0,0 +1,107 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Low-overhead tracing (profiling) functions.
+ * 
+ * @details
+ * Zone and counter events are time stamped with the CPU cycle counter and written to the lock-free per-thread
+ * ring buffers. Background thread flushes them to the Chrome / Perfetto JSON trace file, which can be opened with
+ * the chrome://tracing or https://ui.perfetto.dev. Use MPIO_TRACE_* macros to compile out the instrumentation
+ * completely with the MPIO_ENABLE_TRACING CMake option.
+ */
+
+#pragma once
+#include "mpio/defines.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Per-thread trace event ring buffer capacity.
+ * @details Events are dropped if the buffer is full, until the background thread flushes it.
+ */
+#define TRACE_BUFFER_CAPACITY 32768
+
+/**
+ * @brief Starts writing trace events to the application data directory file.
+ * 
+ * @details
+ * Trace is written to the "trace.json" file inside the getAppDataDirectory().
+ * Previous trace file is overwritten. Not MT-Safe, call it from the main thread.
+ * 
+ * @param[in] appName target application name string
+ * @return True on success, otherwise false.
+ */
+bool startTracing(const char* appName);
+/**
+ * @brief Stops tracing and flushes remaining events to the trace file.
+ * @details Not MT-Safe, call it from the main thread.
+ */
+void stopTracing();
+
+/**
+ * @brief Returns true if tracing is started. (MT-Safe)
+ */
+bool isTracing();
+/**
+ * @brief Returns current trace file path, or NULL if tracing is not started.
+ */
+const char* getTraceFilePath();
+/**
+ * @brief Returns trace event count dropped due to the full buffers. (MT-Safe)
+ */
+uint64_t getTraceDroppedCount();
+
+/**
+ * @brief Begins a new trace zone on the calling thread. (MT-Safe)
+ * @warning Name string should stay valid until tracing is stopped! (string literal)
+ * @param[in] name zone name string
+ */
+void beginTraceZone(const char* name);
+/**
+ * @brief Ends the last begun trace zone on the calling thread. (MT-Safe)
+ */
+void endTraceZone();
+/**
+ * @brief Records trace counter value on the calling thread. (MT-Safe)
+ * @warning Name string should stay valid until tracing is stopped! (string literal)
+ *
+ * @param[in] name counter name string
+ * @param value counter value
+ */
+void traceCounter(const char* name, int64_t value);
+
+#if MPIO_ENABLE_TRACING
+/**
+ * @brief Begins a new trace zone, if tracing is enabled.
+ * @param[in] name zone name string literal
+ */
+#define MPIO_TRACE_BEGIN(name) beginTraceZone(name)
+/**
+ * @brief Ends the last begun trace zone, if tracing is enabled.
+ */
+#define MPIO_TRACE_END() endTraceZone()
+/**
+ * @brief Records trace counter value, if tracing is enabled.
+ *
+ * @param[in] name counter name string literal
+ * @param value counter value
+ */
+#define MPIO_TRACE_COUNTER(name, value) traceCounter(name, value)
+#else
+#define MPIO_TRACE_BEGIN(name) ((void)0)
+#define MPIO_TRACE_END() ((void)0)
+#define MPIO_TRACE_COUNTER(name, value) ((void)0)
+#endif
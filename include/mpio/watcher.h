@@ -0,0 +1,132 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief File system watcher functions.
+ *
+ * @details
+ * Watches directory (and optionally its subdirectories) for changes without polling, using inotify on Linux and
+ * ReadDirectoryChangesW on Windows. Raw events are coalesced per path and debounced into batches: a batch is
+ * delivered once no new events arrived for the debounce delay, so a burst of writes results in a single event.
+ * Rename pairs are matched into one event, and the event queue overflow is reported as a rescan request.
+ * macOS is not supported, createWatcher() always returns NULL there.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief File system watcher structure.
+ */
+typedef struct Watcher_T Watcher_T;
+/**
+ * @brief File system watcher instance.
+ */
+typedef Watcher_T* Watcher;
+
+/**
+ * @brief File system watch event types.
+ */
+typedef enum WatchEventType_T
+{
+	CREATED_WATCH_EVENT_TYPE = 0,  /**< Entry was created or moved into the watched directory. */
+	MODIFIED_WATCH_EVENT_TYPE = 1, /**< Entry data or attributes were changed, or it was replaced. */
+	REMOVED_WATCH_EVENT_TYPE = 2,  /**< Entry was removed or moved out of the watched directory. */
+	RENAMED_WATCH_EVENT_TYPE = 3,  /**< Entry was renamed inside the watched directory. */
+	RESCAN_WATCH_EVENT_TYPE = 4,   /**< Events were lost (queue overflow), rescan the whole directory. */
+	WATCH_EVENT_TYPE_COUNT = 5,    /**< File system watch event type count. */
+} WatchEventType_T;
+/**
+ * @brief File system watch event type.
+ */
+typedef uint8_t WatchEventType;
+
+/**
+ * @brief File system watch event information.
+ * @warning Strings are valid only until the event function returns!
+ */
+typedef struct WatchEvent
+{
+	const char* path;       /**< Entry path string, relative to the watched directory. */
+	const char* oldPath;    /**< Previous entry path string if renamed, otherwise NULL. */
+	uint32_t pathLength;    /**< Entry path string length. */
+	uint32_t oldPathLength; /**< Previous entry path string length. */
+	WatchEventType type;    /**< Watch event type. */
+	bool isDirectory;       /**< Is entry a directory. */
+	bool isModified;        /**< Is entry data changed. (Modified, or renamed and modified in the same batch) */
+} WatchEvent;
+
+/**
+ * @brief File system watch events batch function.
+ *
+ * @param[in] events coalesced watch events array
+ * @param eventCount watch event count
+ * @param[in] argument function argument
+ */
+typedef void(*WatcherFunction)(const WatchEvent* events, uint32_t eventCount, void* argument);
+
+/**
+ * @brief Creates a new file system watcher instance.
+ * @note macOS is not supported, NULL is returned.
+ *
+ * @details
+ * If the function is not NULL, it is called from the watcher background thread with each events batch, the thread
+ * sleeps while there are no events. Otherwise use getWatcherFd() and getWatcherTimeout() with poll() / epoll and
+ * the pollWatcherEvents() to get the events. Created subdirectories are watched and reported automatically.
+ *
+ * @param[in] path target directory path string
+ * @param isRecursive also watch all subdirectories
+ * @param debounceDelay batch delivery delay after the last event in milliseconds
+ * @param onEvents watch events batch function, or NULL
+ * @param[in] argument function argument, or NULL
+ *
+ * @return A new file system watcher instance on success, otherwise NULL.
+ */
+Watcher createWatcher(const char* path, bool isRecursive,
+	uint32_t debounceDelay, WatcherFunction onEvents, void* argument);
+/**
+ * @brief Destroys file system watcher instance.
+ * @details Stops the watcher background thread, if it was started. Pending events are discarded.
+ * @param watcher file system watcher instance or NULL
+ */
+void destroyWatcher(Watcher watcher);
+
+/**
+ * @brief Returns file system watcher file descriptor, readable on a new event.
+ * @details Returns inotify file descriptor on Linux, otherwise -1. (Use pollWatcherEvents() periodically)
+ * @param watcher file system watcher instance
+ */
+int getWatcherFd(Watcher watcher);
+/**
+ * @brief Returns time until the pending events batch is ready in milliseconds.
+ * @details Use it as the poll() / epoll_wait() timeout, the file descriptor is not readable after the last event.
+ *
+ * @param watcher file system watcher instance
+ * @return Milliseconds until the batch is ready, 0 if it is ready, or -1 if there are no pending events.
+ */
+int32_t getWatcherTimeout(Watcher watcher);
+
+/**
+ * @brief Reads new events and delivers the batch if it is ready, without blocking.
+ * @note Do not use it if the watcher was created with the event function.
+ *
+ * @param watcher file system watcher instance
+ * @param onEvents watch events batch function
+ * @param[in] argument function argument, or NULL
+ *
+ * @return Delivered watch event count.
+ */
+uint32_t pollWatcherEvents(Watcher watcher, WatcherFunction onEvents, void* argument);
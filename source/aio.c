@@ -0,0 +1,577 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/aio.h"
+#include "sync.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if __linux__
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+#if __linux__ && defined(__has_include)
+	#if __has_include(<linux/io_uring.h>)
+	#define MPIO_IO_URING 1
+	#endif
+#endif
+
+#if MPIO_IO_URING
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+typedef struct AioSlot
+{
+	struct iovec vector;
+	void* userData;
+	int64_t offset;
+	int64_t transferSize;
+	int file;
+	uint8_t opcode;
+} AioSlot;
+#endif
+
+#define MAX_AIO_THREAD_COUNT 64
+
+struct AioQueue_T
+{
+	uint32_t depth;
+	uint32_t inFlightCount;
+	AioBackend backend;
+	bool isRunning;
+#if MPIO_IO_URING
+	int ringFd;
+	uint32_t pendingSubmitCount;
+	uint8_t* sqRing;
+	uint8_t* cqRing;
+	size_t sqRingSize;
+	size_t cqRingSize;
+	struct io_uring_sqe* sqes;
+	size_t sqesSize;
+	uint32_t* sqTail;
+	uint32_t* sqMask;
+	uint32_t* sqArray;
+	uint32_t* cqHead;
+	uint32_t* cqTail;
+	uint32_t* cqMask;
+	struct io_uring_cqe* cqes;
+	AioSlot* slots;
+	uint32_t* freeSlots;
+	uint32_t freeSlotCount;
+#endif
+	NativeThread* threads;
+	uint32_t threadCount;
+	Mutex mutex;
+	Cond requestCond;
+	Cond completionCond;
+	AioRequest* requests;
+	uint32_t requestHead;
+	uint32_t requestCount;
+	AioCompletion* completions;
+	uint32_t completionHead;
+	uint32_t completionCount;
+};
+
+//**********************************************************************************************************************
+static int64_t executeAioRequest(const AioRequest* request)
+{
+	switch (request->operation)
+	{
+	case READ_AIO_OPERATION:
+		return readFileAt(request->file, request->buffer, request->size, request->offset);
+	case WRITE_AIO_OPERATION:
+		return writeFileAt(request->file, request->buffer, request->size, request->offset);
+	case SYNC_AIO_OPERATION:
+		return flushFileHandle(request->file) ? 0 : -1;
+	default: abort();
+	}
+}
+
+static NativeThreadResult NATIVE_THREAD_CALL aioWorkerFunction(void* argument)
+{
+	AioQueue aioQueue = (AioQueue)argument;
+	uint32_t depth = aioQueue->depth;
+
+	lockMutex(&aioQueue->mutex);
+	while (true)
+	{
+		while (aioQueue->requestCount == 0 && aioQueue->isRunning)
+			waitCond(&aioQueue->requestCond, &aioQueue->mutex);
+		if (aioQueue->requestCount == 0)
+			break;
+
+		AioRequest request = aioQueue->requests[aioQueue->requestHead];
+		aioQueue->requestHead = (aioQueue->requestHead + 1) % depth;
+		aioQueue->requestCount--;
+		unlockMutex(&aioQueue->mutex);
+
+		int64_t result = executeAioRequest(&request);
+
+		lockMutex(&aioQueue->mutex);
+		AioCompletion* completion = &aioQueue->completions[
+			(aioQueue->completionHead + aioQueue->completionCount) % depth];
+		completion->userData = request.userData;
+		completion->result = result;
+		aioQueue->completionCount++;
+		signalCond(&aioQueue->completionCond);
+	}
+	unlockMutex(&aioQueue->mutex);
+	return 0;
+}
+
+static bool createAioThreadPool(AioQueue aioQueue)
+{
+	uint32_t depth = aioQueue->depth;
+	aioQueue->requests = malloc(depth * sizeof(AioRequest));
+	aioQueue->completions = malloc(depth * sizeof(AioCompletion));
+	if (!aioQueue->requests || !aioQueue->completions)
+		return false;
+
+	uint32_t threadCount = depth < MAX_AIO_THREAD_COUNT ? depth : MAX_AIO_THREAD_COUNT;
+	aioQueue->threads = malloc(threadCount * sizeof(NativeThread));
+	if (!aioQueue->threads)
+		return false;
+
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		if (!startNativeThread(&aioQueue->threads[i], aioWorkerFunction, aioQueue, 0))
+			return false;
+		aioQueue->threadCount++;
+	}
+	return true;
+}
+
+#if MPIO_IO_URING
+//**********************************************************************************************************************
+static bool createAioRing(AioQueue aioQueue)
+{
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(struct io_uring_params));
+
+	int ringFd = (int)syscall(__NR_io_uring_setup, aioQueue->depth, &params);
+	if (ringFd < 0)
+		return false;
+	aioQueue->ringFd = ringFd;
+
+	size_t sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	size_t cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+	{
+		if (cqRingSize > sqRingSize)
+			sqRingSize = cqRingSize;
+		cqRingSize = 0;
+	}
+
+	void* sqRing = mmap(NULL, sqRingSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+	if (sqRing == MAP_FAILED)
+		return false;
+	aioQueue->sqRing = sqRing; aioQueue->sqRingSize = sqRingSize;
+
+	if (cqRingSize > 0)
+	{
+		void* cqRing = mmap(NULL, cqRingSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+		if (cqRing == MAP_FAILED)
+			return false;
+		aioQueue->cqRing = cqRing; aioQueue->cqRingSize = cqRingSize;
+	}
+	else
+	{
+		aioQueue->cqRing = aioQueue->sqRing;
+	}
+
+	size_t sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+	void* sqes = mmap(NULL, sqesSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+	if (sqes == MAP_FAILED)
+		return false;
+	aioQueue->sqes = sqes; aioQueue->sqesSize = sqesSize;
+
+	uint8_t* sq = aioQueue->sqRing; uint8_t* cq = aioQueue->cqRing;
+	aioQueue->sqTail = (uint32_t*)(sq + params.sq_off.tail);
+	aioQueue->sqMask = (uint32_t*)(sq + params.sq_off.ring_mask);
+	aioQueue->sqArray = (uint32_t*)(sq + params.sq_off.array);
+	aioQueue->cqHead = (uint32_t*)(cq + params.cq_off.head);
+	aioQueue->cqTail = (uint32_t*)(cq + params.cq_off.tail);
+	aioQueue->cqMask = (uint32_t*)(cq + params.cq_off.ring_mask);
+	aioQueue->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+
+	// Note: Kernel rounds entry count up to the power of two.
+	if (params.sq_entries < aioQueue->depth)
+		aioQueue->depth = params.sq_entries;
+
+	uint32_t depth = aioQueue->depth;
+	aioQueue->slots = malloc(depth * sizeof(AioSlot));
+	aioQueue->freeSlots = malloc(depth * sizeof(uint32_t));
+	if (!aioQueue->slots || !aioQueue->freeSlots)
+		return false;
+
+	for (uint32_t i = 0; i < depth; i++)
+		aioQueue->freeSlots[i] = depth - i - 1;
+	aioQueue->freeSlotCount = depth;
+
+	aioQueue->backend = IO_URING_AIO_BACKEND;
+	return true;
+}
+static void destroyAioRing(AioQueue aioQueue)
+{
+	free(aioQueue->freeSlots);
+	free(aioQueue->slots);
+	if (aioQueue->sqes)
+		munmap(aioQueue->sqes, aioQueue->sqesSize);
+	if (aioQueue->cqRingSize > 0)
+		munmap(aioQueue->cqRing, aioQueue->cqRingSize);
+	if (aioQueue->sqRing)
+		munmap(aioQueue->sqRing, aioQueue->sqRingSize);
+	close(aioQueue->ringFd);
+
+	aioQueue->freeSlots = NULL; aioQueue->slots = NULL;
+	aioQueue->sqes = NULL; aioQueue->cqRing = NULL; aioQueue->sqRing = NULL;
+	aioQueue->cqRingSize = 0; aioQueue->ringFd = -1;
+}
+
+static int enterAioRing(AioQueue aioQueue, uint32_t minCount)
+{
+	unsigned int flags = minCount > 0 ? IORING_ENTER_GETEVENTS : 0;
+	int result;
+	do
+	{
+		result = (int)syscall(__NR_io_uring_enter, aioQueue->ringFd,
+			aioQueue->pendingSubmitCount, minCount, flags, NULL, 0);
+	}
+	while (result < 0 && errno == EINTR);
+
+	if (result > 0)
+		aioQueue->pendingSubmitCount -= (uint32_t)result;
+	return result;
+}
+static void writeAioSqe(AioQueue aioQueue, uint32_t tail, uint32_t slotIndex)
+{
+	AioSlot* slot = &aioQueue->slots[slotIndex];
+	uint32_t index = tail & *aioQueue->sqMask;
+	struct io_uring_sqe* sqe = &aioQueue->sqes[index];
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	sqe->opcode = slot->opcode;
+	sqe->fd = slot->file;
+	sqe->user_data = slotIndex;
+
+	if (slot->opcode != IORING_OP_FSYNC)
+	{
+		sqe->off = (uint64_t)slot->offset;
+		sqe->addr = (uint64_t)(uintptr_t)&slot->vector;
+		sqe->len = 1;
+	}
+	aioQueue->sqArray[index] = index;
+}
+static uint32_t submitAioRing(AioQueue aioQueue, const AioRequest* requests, uint32_t count)
+{
+	uint32_t tail = *aioQueue->sqTail, submitCount = 0;
+
+	for (; submitCount < count && aioQueue->freeSlotCount > 0; submitCount++)
+	{
+		const AioRequest* request = &requests[submitCount];
+		assert(request->operation < AIO_OPERATION_COUNT);
+
+		uint32_t slotIndex = aioQueue->freeSlots[--aioQueue->freeSlotCount];
+		AioSlot* slot = &aioQueue->slots[slotIndex];
+		slot->vector.iov_base = request->buffer;
+		slot->vector.iov_len = request->size;
+		slot->userData = request->userData;
+		slot->offset = request->offset;
+		slot->transferSize = 0;
+		slot->file = request->file;
+
+		if (request->operation == SYNC_AIO_OPERATION)
+			slot->opcode = IORING_OP_FSYNC;
+		else if (request->operation == READ_AIO_OPERATION)
+			slot->opcode = IORING_OP_READV;
+		else
+			slot->opcode = IORING_OP_WRITEV;
+		writeAioSqe(aioQueue, tail++, slotIndex);
+	}
+
+	if (submitCount == 0)
+		return 0;
+
+	__atomic_store_n(aioQueue->sqTail, tail, __ATOMIC_RELEASE);
+	aioQueue->pendingSubmitCount += submitCount;
+	aioQueue->inFlightCount += submitCount;
+	enterAioRing(aioQueue, 0); // Note: Not submitted entries are retried on the next call.
+	return submitCount;
+}
+static uint32_t pollAioRing(AioQueue aioQueue, AioCompletion* completions, uint32_t capacity)
+{
+	uint32_t head = *aioQueue->cqHead, mask = *aioQueue->cqMask;
+	uint32_t tail = __atomic_load_n(aioQueue->cqTail, __ATOMIC_ACQUIRE);
+	uint32_t sqTail = *aioQueue->sqTail, completionCount = 0, resubmitCount = 0;
+
+	while (head != tail && completionCount < capacity)
+	{
+		const struct io_uring_cqe* cqe = &aioQueue->cqes[head & mask];
+		uint32_t slotIndex = (uint32_t)cqe->user_data;
+		int32_t result = cqe->res;
+		AioSlot* slot = &aioQueue->slots[slotIndex];
+		head++;
+
+		// Note: Kernel can transfer less than requested before the end of file, so the rest is resubmitted.
+		//       This matches the readFileAt() and writeFileAt() behavior used by the thread pool backend.
+		if (result > 0 && slot->opcode != IORING_OP_FSYNC && (size_t)result < slot->vector.iov_len)
+		{
+			slot->vector.iov_base = (uint8_t*)slot->vector.iov_base + result;
+			slot->vector.iov_len -= (size_t)result;
+			slot->offset += result;
+			slot->transferSize += result;
+			writeAioSqe(aioQueue, sqTail++, slotIndex);
+			resubmitCount++;
+			continue;
+		}
+
+		AioCompletion* completion = &completions[completionCount++];
+		completion->userData = slot->userData;
+		completion->result = result >= 0 ? slot->transferSize + result : -1;
+		aioQueue->freeSlots[aioQueue->freeSlotCount++] = slotIndex;
+	}
+
+	__atomic_store_n(aioQueue->cqHead, head, __ATOMIC_RELEASE);
+	aioQueue->inFlightCount -= completionCount;
+
+	if (resubmitCount > 0)
+	{
+		__atomic_store_n(aioQueue->sqTail, sqTail, __ATOMIC_RELEASE);
+		aioQueue->pendingSubmitCount += resubmitCount;
+		enterAioRing(aioQueue, 0);
+	}
+	return completionCount;
+}
+#endif
+
+//**********************************************************************************************************************
+AioQueue createAioQueue(uint32_t depth, bool useThreadPool)
+{
+	assert(depth > 0);
+
+	AioQueue aioQueue = calloc(1, sizeof(AioQueue_T));
+	if (!aioQueue)
+		return NULL;
+
+	aioQueue->depth = depth;
+	aioQueue->backend = THREAD_POOL_AIO_BACKEND;
+	aioQueue->isRunning = true;
+
+	if (!initMutex(&aioQueue->mutex))
+	{
+		free(aioQueue);
+		return NULL;
+	}
+	if (!initCond(&aioQueue->requestCond))
+	{
+		destroyMutex(&aioQueue->mutex);
+		free(aioQueue);
+		return NULL;
+	}
+	if (!initCond(&aioQueue->completionCond))
+	{
+		destroyCond(&aioQueue->requestCond);
+		destroyMutex(&aioQueue->mutex);
+		free(aioQueue);
+		return NULL;
+	}
+
+#if MPIO_IO_URING
+	aioQueue->ringFd = -1;
+	if (!useThreadPool)
+	{
+		if (createAioRing(aioQueue))
+			return aioQueue;
+		if (aioQueue->ringFd >= 0)
+			destroyAioRing(aioQueue);
+		aioQueue->depth = depth;
+	}
+#endif
+
+	if (!createAioThreadPool(aioQueue))
+	{
+		destroyAioQueue(aioQueue);
+		return NULL;
+	}
+	return aioQueue;
+}
+void destroyAioQueue(AioQueue aioQueue)
+{
+	if (!aioQueue)
+		return;
+
+#if MPIO_IO_URING
+	if (aioQueue->backend == IO_URING_AIO_BACKEND)
+	{
+		AioCompletion completions[32];
+		while (aioQueue->inFlightCount > 0)
+		{
+			// Note: Zero completions means that the ring has failed, in-flight requests
+			//       are abandoned and cancelled by the kernel when the ring is closed.
+			if (waitAioCompletions(aioQueue, completions, 32, 1) == 0)
+				break;
+		}
+		destroyAioRing(aioQueue);
+	}
+#endif
+
+	if (aioQueue->threads)
+	{
+		lockMutex(&aioQueue->mutex);
+		aioQueue->isRunning = false;
+		broadcastCond(&aioQueue->requestCond);
+		unlockMutex(&aioQueue->mutex);
+
+		for (uint32_t i = 0; i < aioQueue->threadCount; i++)
+			joinNativeThread(aioQueue->threads[i]);
+		free(aioQueue->threads);
+	}
+
+	free(aioQueue->completions);
+	free(aioQueue->requests);
+	destroyCond(&aioQueue->completionCond);
+	destroyCond(&aioQueue->requestCond);
+	destroyMutex(&aioQueue->mutex);
+	free(aioQueue);
+}
+
+AioBackend getAioQueueBackend(AioQueue aioQueue)
+{
+	assert(aioQueue);
+	return aioQueue->backend;
+}
+uint32_t getAioQueueDepth(AioQueue aioQueue)
+{
+	assert(aioQueue);
+	return aioQueue->depth;
+}
+uint32_t getAioQueueInFlightCount(AioQueue aioQueue)
+{
+	assert(aioQueue);
+	return aioQueue->inFlightCount;
+}
+
+//**********************************************************************************************************************
+uint32_t submitAioRequests(AioQueue aioQueue, const AioRequest* requests, uint32_t count)
+{
+	assert(aioQueue);
+	assert(requests || count == 0);
+
+#if MPIO_IO_URING
+	if (aioQueue->backend == IO_URING_AIO_BACKEND)
+		return submitAioRing(aioQueue, requests, count);
+#endif
+
+	uint32_t depth = aioQueue->depth;
+	uint32_t submitCount = depth - aioQueue->inFlightCount;
+	if (submitCount > count)
+		submitCount = count;
+	if (submitCount == 0)
+		return 0;
+
+	lockMutex(&aioQueue->mutex);
+	for (uint32_t i = 0; i < submitCount; i++)
+	{
+		assert(requests[i].operation < AIO_OPERATION_COUNT);
+		aioQueue->requests[(aioQueue->requestHead + aioQueue->requestCount) % depth] = requests[i];
+		aioQueue->requestCount++;
+	}
+	if (submitCount > 1)
+		broadcastCond(&aioQueue->requestCond);
+	else
+		signalCond(&aioQueue->requestCond);
+	unlockMutex(&aioQueue->mutex);
+
+	aioQueue->inFlightCount += submitCount;
+	return submitCount;
+}
+
+static uint32_t popAioCompletions(AioQueue aioQueue, AioCompletion* completions, uint32_t capacity)
+{
+	uint32_t depth = aioQueue->depth;
+	uint32_t completionCount = aioQueue->completionCount < capacity ? aioQueue->completionCount : capacity;
+	for (uint32_t i = 0; i < completionCount; i++)
+	{
+		completions[i] = aioQueue->completions[aioQueue->completionHead];
+		aioQueue->completionHead = (aioQueue->completionHead + 1) % depth;
+	}
+	aioQueue->completionCount -= completionCount;
+	aioQueue->inFlightCount -= completionCount;
+	return completionCount;
+}
+uint32_t pollAioCompletions(AioQueue aioQueue, AioCompletion* completions, uint32_t capacity)
+{
+	assert(aioQueue);
+	assert(completions || capacity == 0);
+
+#if MPIO_IO_URING
+	if (aioQueue->backend == IO_URING_AIO_BACKEND)
+	{
+		if (aioQueue->pendingSubmitCount > 0)
+			enterAioRing(aioQueue, 0);
+		return pollAioRing(aioQueue, completions, capacity);
+	}
+#endif
+
+	lockMutex(&aioQueue->mutex);
+	uint32_t completionCount = popAioCompletions(aioQueue, completions, capacity);
+	unlockMutex(&aioQueue->mutex);
+	return completionCount;
+}
+uint32_t waitAioCompletions(AioQueue aioQueue, AioCompletion* completions, uint32_t capacity, uint32_t minCount)
+{
+	assert(aioQueue);
+	assert(completions || capacity == 0);
+
+	if (minCount > capacity)
+		minCount = capacity;
+	if (minCount > aioQueue->inFlightCount)
+		minCount = aioQueue->inFlightCount;
+
+#if MPIO_IO_URING
+	if (aioQueue->backend == IO_URING_AIO_BACKEND)
+	{
+		uint32_t completionCount = pollAioRing(aioQueue, completions, capacity);
+		while (completionCount < minCount)
+		{
+			if (enterAioRing(aioQueue, minCount - completionCount) < 0 && errno != EBUSY)
+				break;
+			completionCount += pollAioRing(aioQueue,
+				completions + completionCount, capacity - completionCount);
+		}
+		return completionCount;
+	}
+#endif
+
+	lockMutex(&aioQueue->mutex);
+	while (aioQueue->completionCount < minCount)
+		waitCond(&aioQueue->completionCond, &aioQueue->mutex);
+	uint32_t completionCount = popAioCompletions(aioQueue, completions, capacity);
+	unlockMutex(&aioQueue->mutex);
+	return completionCount;
+}
@@ -0,0 +1,87 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Internal atomic memory operations. (Not a public API)
+ * @details Loads have acquire, stores have release and read-modify-write operations have sequential consistency.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <windows.h>
+
+inline static int32_t atomicLoad32(volatile int32_t* atomic) { return ReadAcquire((volatile LONG*)atomic); }
+inline static int64_t atomicLoad64(volatile int64_t* atomic) { return ReadAcquire64((volatile LONG64*)atomic); }
+inline static void atomicStore32(volatile int32_t* atomic, int32_t value) { WriteRelease((volatile LONG*)atomic, value); }
+inline static void atomicStore64(volatile int64_t* atomic, int64_t value) { WriteRelease64((volatile LONG64*)atomic, value); }
+
+inline static int32_t atomicFetchAdd32(volatile int32_t* atomic, int32_t value)
+{
+	return InterlockedExchangeAdd((volatile LONG*)atomic, value);
+}
+inline static int64_t atomicFetchAdd64(volatile int64_t* atomic, int64_t value)
+{
+	return InterlockedExchangeAdd64((volatile LONG64*)atomic, value);
+}
+inline static bool atomicCompareExchange32(volatile int32_t* atomic, int32_t* expected, int32_t desired)
+{
+	int32_t previous = InterlockedCompareExchange((volatile LONG*)atomic, desired, *expected);
+	if (previous == *expected)
+		return true;
+	*expected = previous;
+	return false;
+}
+inline static bool atomicCompareExchange64(volatile int64_t* atomic, int64_t* expected, int64_t desired)
+{
+	int64_t previous = InterlockedCompareExchange64((volatile LONG64*)atomic, desired, *expected);
+	if (previous == *expected)
+		return true;
+	*expected = previous;
+	return false;
+}
+inline static void atomicFence() { MemoryBarrier(); }
+#else
+inline static int32_t atomicLoad32(volatile int32_t* atomic) { return __atomic_load_n(atomic, __ATOMIC_ACQUIRE); }
+inline static int64_t atomicLoad64(volatile int64_t* atomic) { return __atomic_load_n(atomic, __ATOMIC_ACQUIRE); }
+inline static void atomicStore32(volatile int32_t* atomic, int32_t value)
+{
+	__atomic_store_n(atomic, value, __ATOMIC_RELEASE);
+}
+inline static void atomicStore64(volatile int64_t* atomic, int64_t value)
+{
+	__atomic_store_n(atomic, value, __ATOMIC_RELEASE);
+}
+
+inline static int32_t atomicFetchAdd32(volatile int32_t* atomic, int32_t value)
+{
+	return __atomic_fetch_add(atomic, value, __ATOMIC_SEQ_CST);
+}
+inline static int64_t atomicFetchAdd64(volatile int64_t* atomic, int64_t value)
+{
+	return __atomic_fetch_add(atomic, value, __ATOMIC_SEQ_CST);
+}
+inline static bool atomicCompareExchange32(volatile int32_t* atomic, int32_t* expected, int32_t desired)
+{
+	return __atomic_compare_exchange_n(atomic, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+inline static bool atomicCompareExchange64(volatile int64_t* atomic, int64_t* expected, int64_t desired)
+{
+	return __atomic_compare_exchange_n(atomic, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+inline static void atomicFence() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+#endif
@@ -12,7 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if __linux__
+#define _GNU_SOURCE
+#endif
+
 #include "mpio/directory.h"
+#include "atomic.h"
 #include <stdio.h>
 #include <assert.h>
 
@@ -27,8 +32,9 @@ bool createDirectory(const char* path)
 bool isDirectoryExists(const char* path)
 {
 	assert(path != NULL);
-	struct stat sb;
-	return stat(path, &sb) == 0 && S_ISDIR(sb.st_mode);
+	FileInfo info;
+	return getFileInfo(path, FILE_INFO_FIELD_BIT(TYPE_FILE_INFO_FIELD), false, &info) &&
+		info.type == DIRECTORY_FILE_TYPE;
 }
 
 #if __linux__
@@ -172,4 +178,981 @@ char* getResourcesDirectory()
 }
 #else
 #error Unknown operating system
-#endif
\ No newline at end of file
+#endif
+
+//**********************************************************************************************************************
+#include <stdlib.h>
+#include <string.h>
+
+#if __linux__ || __APPLE__
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+	#if __linux__
+	#include <sys/syscall.h>
+	#include <sys/sysmacros.h>
+	#endif
+#define PATH_SEPARATOR '/'
+#elif _WIN32
+#define PATH_SEPARATOR '\\'
+#endif
+
+#define DIRECTORY_BUFFER_SIZE 32768
+
+#if __linux__
+// Note: glibc added getdents64() wrapper only in 2.30.
+typedef struct LinuxDirent64
+{
+	uint64_t d_ino;
+	int64_t d_off;
+	unsigned short d_reclen;
+	unsigned char d_type;
+	char d_name[];
+} LinuxDirent64;
+#endif
+
+typedef struct DirectoryLevel
+{
+#if __linux__
+	uint8_t* buffer;
+	int fd;
+	int bufferOffset;
+	int bufferSize;
+#elif __APPLE__
+	DIR* dir;
+#elif _WIN32
+	HANDLE find;
+	bool hasFindData;
+#endif
+	size_t pathLength;
+} DirectoryLevel;
+
+struct DirectoryIterator_T
+{
+	DirectoryLevel* levels;
+	DirectoryLevel* parentLevel;
+	char* path;
+	size_t pathCapacity;
+	size_t rootLength;
+	size_t nameOffset;
+	uint32_t levelCount;
+	uint32_t levelCapacity;
+	bool isRecursive;
+	bool hasPendingDirectory;
+	bool isFailed;
+#if _WIN32
+	WIN32_FIND_DATAA findData;
+#endif
+};
+
+static bool reservePathCapacity(DirectoryIterator directoryIterator, size_t length)
+{
+	if (length + 1 <= directoryIterator->pathCapacity)
+		return true;
+
+	size_t capacity = directoryIterator->pathCapacity * 2;
+	while (length + 1 > capacity)
+		capacity *= 2;
+	char* path = realloc(directoryIterator->path, capacity);
+	if (!path)
+		return false;
+	directoryIterator->path = path;
+	directoryIterator->pathCapacity = capacity;
+	return true;
+}
+
+#if __linux__ || __APPLE__
+inline static FileType toFileType(unsigned char type)
+{
+	switch (type)
+	{
+	case DT_REG: return REGULAR_FILE_TYPE;
+	case DT_DIR: return DIRECTORY_FILE_TYPE;
+	case DT_LNK: return SYMLINK_FILE_TYPE;
+	case DT_UNKNOWN: return UNKNOWN_FILE_TYPE;
+	default: return OTHER_FILE_TYPE;
+	}
+}
+inline static FileType toModeFileType(mode_t mode)
+{
+	if (S_ISREG(mode))
+		return REGULAR_FILE_TYPE;
+	if (S_ISDIR(mode))
+		return DIRECTORY_FILE_TYPE;
+	if (S_ISLNK(mode))
+		return SYMLINK_FILE_TYPE;
+	return OTHER_FILE_TYPE;
+}
+static FileType statFileType(int directoryFd, const char* name)
+{
+	struct stat sb;
+	if (fstatat(directoryFd, name, &sb, AT_SYMLINK_NOFOLLOW) != 0)
+		return UNKNOWN_FILE_TYPE;
+	return toModeFileType(sb.st_mode);
+}
+
+// Note: O_NOFOLLOW prevents escaping the tree, if a subdirectory is replaced with a symlink during iteration.
+static bool openDirectoryLevel(DirectoryLevel* level, DirectoryLevel* parent, const char* path)
+{
+	int parentFd;
+	#if __linux__
+	parentFd = parent ? parent->fd : AT_FDCWD;
+	#else
+	parentFd = parent ? dirfd(parent->dir) : AT_FDCWD;
+	#endif
+
+	int fd = openat(parentFd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC | (parent ? O_NOFOLLOW : 0));
+	if (fd == -1)
+		return false;
+
+	#if __linux__
+	if (!level->buffer)
+	{
+		level->buffer = malloc(DIRECTORY_BUFFER_SIZE);
+		if (!level->buffer)
+		{
+			close(fd);
+			return false;
+		}
+	}
+	level->fd = fd;
+	level->bufferOffset = level->bufferSize = 0;
+	#else
+	level->dir = fdopendir(fd);
+	if (!level->dir)
+	{
+		close(fd);
+		return false;
+	}
+	#endif
+	return true;
+}
+static void closeDirectoryLevel(DirectoryLevel* level)
+{
+	#if __linux__
+	close(level->fd);
+	#else
+	closedir(level->dir);
+	#endif
+}
+
+static bool readDirectoryLevel(DirectoryIterator directoryIterator,
+	DirectoryLevel* level, const char** name, FileType* type)
+{
+	while (true)
+	{
+	#if __linux__
+		if (level->bufferOffset >= level->bufferSize)
+		{
+			long size = syscall(SYS_getdents64, level->fd, level->buffer, DIRECTORY_BUFFER_SIZE);
+			if (size <= 0)
+			{
+				if (size < 0)
+					directoryIterator->isFailed = true;
+				return false;
+			}
+			level->bufferOffset = 0;
+			level->bufferSize = (int)size;
+		}
+
+		LinuxDirent64* dirent = (LinuxDirent64*)(level->buffer + level->bufferOffset);
+		level->bufferOffset += dirent->d_reclen;
+		const char* entryName = dirent->d_name;
+		unsigned char entryType = dirent->d_type;
+		int directoryFd = level->fd;
+	#else
+		errno = 0;
+		struct dirent* dirent = readdir(level->dir);
+		if (!dirent)
+		{
+			if (errno != 0)
+				directoryIterator->isFailed = true;
+			return false;
+		}
+		const char* entryName = dirent->d_name;
+		unsigned char entryType = dirent->d_type;
+		int directoryFd = dirfd(level->dir);
+	#endif
+
+		if (entryName[0] == '.' && (entryName[1] == '\0' || (entryName[1] == '.' && entryName[2] == '\0')))
+			continue;
+
+		*name = entryName;
+		*type = toFileType(entryType);
+		if (*type == UNKNOWN_FILE_TYPE) // Note: Some file systems do not fill d_type.
+			*type = statFileType(directoryFd, entryName);
+		return true;
+	}
+}
+#elif _WIN32
+static bool openDirectoryLevel(DirectoryIterator directoryIterator, DirectoryLevel* level, size_t pathLength)
+{
+	if (!reservePathCapacity(directoryIterator, pathLength + 2))
+		return false;
+
+	char* path = directoryIterator->path;
+	path[pathLength] = PATH_SEPARATOR;
+	path[pathLength + 1] = '*';
+	path[pathLength + 2] = '\0';
+
+	level->find = FindFirstFileExA(path, FindExInfoBasic, &directoryIterator->findData,
+		FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+	path[pathLength] = '\0';
+	if (level->find == INVALID_HANDLE_VALUE)
+		return false;
+	level->hasFindData = true;
+	return true;
+}
+static void closeDirectoryLevel(DirectoryLevel* level)
+{
+	FindClose(level->find);
+}
+
+static bool readDirectoryLevel(DirectoryIterator directoryIterator,
+	DirectoryLevel* level, const char** name, FileType* type)
+{
+	WIN32_FIND_DATAA* findData = &directoryIterator->findData;
+	while (true)
+	{
+		if (!level->hasFindData)
+		{
+			if (FindNextFileA(level->find, findData) == FALSE)
+			{
+				if (GetLastError() != ERROR_NO_MORE_FILES)
+					directoryIterator->isFailed = true;
+				return false;
+			}
+		}
+		level->hasFindData = false;
+
+		const char* entryName = findData->cFileName;
+		if (entryName[0] == '.' && (entryName[1] == '\0' || (entryName[1] == '.' && entryName[2] == '\0')))
+			continue;
+
+		DWORD attributes = findData->dwFileAttributes;
+		*name = entryName;
+		if (attributes & FILE_ATTRIBUTE_REPARSE_POINT)
+			*type = SYMLINK_FILE_TYPE;
+		else if (attributes & FILE_ATTRIBUTE_DIRECTORY)
+			*type = DIRECTORY_FILE_TYPE;
+		else if (attributes & FILE_ATTRIBUTE_DEVICE)
+			*type = OTHER_FILE_TYPE;
+		else
+			*type = REGULAR_FILE_TYPE;
+		return true;
+	}
+}
+#endif
+
+static bool pushDirectoryLevel(DirectoryIterator directoryIterator, const char* path, size_t pathLength)
+{
+	if (directoryIterator->levelCount == directoryIterator->levelCapacity)
+	{
+		uint32_t capacity = directoryIterator->levelCapacity > 0 ? directoryIterator->levelCapacity * 2 : 8;
+		DirectoryLevel* levels = realloc(directoryIterator->levels, capacity * sizeof(DirectoryLevel));
+		if (!levels)
+			return false;
+		memset(levels + directoryIterator->levelCapacity, 0,
+			(capacity - directoryIterator->levelCapacity) * sizeof(DirectoryLevel));
+		directoryIterator->levels = levels;
+		directoryIterator->levelCapacity = capacity;
+	}
+
+	DirectoryLevel* level = &directoryIterator->levels[directoryIterator->levelCount];
+#if __linux__ || __APPLE__
+	DirectoryLevel* parent = directoryIterator->levelCount > 0 ? level - 1 : directoryIterator->parentLevel;
+	if (!openDirectoryLevel(level, parent, path))
+		return false;
+#elif _WIN32
+	if (!openDirectoryLevel(directoryIterator, level, pathLength))
+		return false;
+#endif
+
+	level->pathLength = pathLength;
+	directoryIterator->levelCount++;
+	return true;
+}
+
+// Note: Path is relative to the parent level (or to the root path), it is prepended to the returned entry paths.
+static DirectoryIterator createDirectoryIterator(const char* rootPath,
+	DirectoryLevel* parentLevel, const char* path, bool isRecursive)
+{
+	DirectoryIterator directoryIterator = calloc(1, sizeof(DirectoryIterator_T));
+	if (!directoryIterator)
+		return NULL;
+
+	directoryIterator->parentLevel = parentLevel;
+	directoryIterator->isRecursive = isRecursive;
+	directoryIterator->pathCapacity = 256;
+	directoryIterator->path = malloc(directoryIterator->pathCapacity);
+	if (!directoryIterator->path)
+	{
+		free(directoryIterator);
+		return NULL;
+	}
+
+	size_t pathLength = strlen(path);
+#if __linux__ || __APPLE__
+	bool result = reservePathCapacity(directoryIterator, pathLength);
+	if (result)
+		memcpy(directoryIterator->path, path, pathLength + 1);
+	if (!result || !pushDirectoryLevel(directoryIterator, pathLength > 0 ? path : rootPath, pathLength))
+#elif _WIN32
+	// Note: Windows has no handle relative search, so the iterator keeps the full path.
+	size_t rootLength = strlen(rootPath);
+	while (rootLength > 0 && (rootPath[rootLength - 1] == '\\' || rootPath[rootLength - 1] == '/'))
+		rootLength--;
+	size_t fullLength = pathLength > 0 ? rootLength + 1 + pathLength : rootLength;
+	bool result = reservePathCapacity(directoryIterator, fullLength + 1);
+	if (result)
+	{
+		char* fullPath = directoryIterator->path;
+		memcpy(fullPath, rootPath, rootLength);
+		if (pathLength > 0)
+		{
+			fullPath[rootLength] = PATH_SEPARATOR;
+			memcpy(fullPath + rootLength + 1, path, pathLength);
+		}
+		fullPath[fullLength] = '\0';
+		directoryIterator->rootLength = rootLength + 1;
+	}
+	if (!result || !pushDirectoryLevel(directoryIterator, NULL, fullLength))
+#endif
+	{
+		closeDirectoryIterator(directoryIterator);
+		return NULL;
+	}
+	return directoryIterator;
+}
+
+//**********************************************************************************************************************
+DirectoryIterator openDirectoryIterator(const char* path, bool isRecursive)
+{
+	assert(path);
+	return createDirectoryIterator(path, NULL, "", isRecursive);
+}
+void closeDirectoryIterator(DirectoryIterator directoryIterator)
+{
+	if (!directoryIterator)
+		return;
+
+	for (uint32_t i = 0; i < directoryIterator->levelCount; i++)
+		closeDirectoryLevel(&directoryIterator->levels[i]);
+#if __linux__
+	for (uint32_t i = 0; i < directoryIterator->levelCapacity; i++)
+		free(directoryIterator->levels[i].buffer);
+#endif
+	free(directoryIterator->levels);
+	free(directoryIterator->path);
+	free(directoryIterator);
+}
+
+bool nextDirectoryEntry(DirectoryIterator directoryIterator, DirectoryEntry* entry)
+{
+	assert(directoryIterator);
+	assert(entry);
+
+	char* path = directoryIterator->path;
+	if (directoryIterator->hasPendingDirectory)
+	{
+		directoryIterator->hasPendingDirectory = false;
+		size_t pathLength = strlen(path);
+		if (!pushDirectoryLevel(directoryIterator, path + directoryIterator->nameOffset, pathLength))
+			directoryIterator->isFailed = true;
+	}
+
+	while (directoryIterator->levelCount > 0)
+	{
+		DirectoryLevel* level = &directoryIterator->levels[directoryIterator->levelCount - 1];
+		const char* name; FileType type;
+		if (!readDirectoryLevel(directoryIterator, level, &name, &type))
+		{
+			closeDirectoryLevel(level);
+			directoryIterator->levelCount--;
+			continue;
+		}
+
+		size_t nameOffset = level->pathLength, nameLength = strlen(name);
+		if (nameOffset > 0 || directoryIterator->rootLength > 0)
+			nameOffset++;
+		if (!reservePathCapacity(directoryIterator, nameOffset + nameLength))
+		{
+			directoryIterator->isFailed = true;
+			continue;
+		}
+
+		path = directoryIterator->path;
+		if (nameOffset > level->pathLength)
+			path[level->pathLength] = PATH_SEPARATOR;
+		memcpy(path + nameOffset, name, nameLength + 1);
+		directoryIterator->nameOffset = nameOffset;
+
+		size_t rootLength = directoryIterator->rootLength;
+		entry->name = path + nameOffset;
+		entry->path = path + rootLength;
+		entry->nameLength = (uint32_t)nameLength;
+		entry->pathLength = (uint32_t)(nameOffset + nameLength - rootLength);
+		entry->depth = directoryIterator->levelCount - 1;
+		entry->type = type;
+
+		directoryIterator->hasPendingDirectory = directoryIterator->isRecursive && type == DIRECTORY_FILE_TYPE;
+		return true;
+	}
+	return false;
+}
+void skipDirectoryEntries(DirectoryIterator directoryIterator)
+{
+	assert(directoryIterator);
+	directoryIterator->hasPendingDirectory = false;
+}
+bool isDirectoryIteratorFailed(DirectoryIterator directoryIterator)
+{
+	assert(directoryIterator);
+	return directoryIterator->isFailed;
+}
+
+//**********************************************************************************************************************
+typedef struct DirectoryWalk
+{
+	JobSystem jobSystem;
+	JobCounter jobCounter;
+	const char* rootPath;
+	DirectoryFilterFunction filter;
+	DirectoryEntryFunction onEntry;
+	void* argument;
+#if __linux__ || __APPLE__
+	DirectoryLevel rootLevel;
+#endif
+	volatile int64_t entryCount;
+	volatile int64_t fileCount;
+	volatile int64_t directoryCount;
+	volatile int64_t failedDirectoryCount;
+} DirectoryWalk;
+
+typedef struct DirectoryWalkJob
+{
+	DirectoryWalk* walk;
+	uint32_t depth;
+	char path[];
+} DirectoryWalkJob;
+
+static bool runDirectoryWalkJob(DirectoryWalk* walk, const char* path, size_t pathLength, uint32_t depth);
+
+static void walkDirectoryEntries(DirectoryWalk* walk, DirectoryIterator directoryIterator, uint32_t depth)
+{
+	DirectoryFilterFunction filter = walk->filter;
+	DirectoryEntryFunction onEntry = walk->onEntry;
+	void* argument = walk->argument;
+	int64_t entryCount = 0, fileCount = 0, directoryCount = 0, failedDirectoryCount = 0;
+
+	DirectoryEntry entry;
+	while (nextDirectoryEntry(directoryIterator, &entry))
+	{
+		entry.depth = depth;
+		if (filter && !filter(&entry, argument))
+			continue;
+		if (onEntry)
+			onEntry(&entry, argument);
+
+		entryCount++;
+		if (entry.type == DIRECTORY_FILE_TYPE)
+		{
+			directoryCount++;
+			if (!runDirectoryWalkJob(walk, entry.path, entry.pathLength, depth + 1))
+				failedDirectoryCount++;
+		}
+		else if (entry.type == REGULAR_FILE_TYPE)
+		{
+			fileCount++;
+		}
+	}
+
+	if (isDirectoryIteratorFailed(directoryIterator))
+		failedDirectoryCount++;
+	closeDirectoryIterator(directoryIterator);
+
+	// Note: Counting locally and publishing once per directory avoids contention on the shared counters.
+	atomicFetchAdd64(&walk->entryCount, entryCount);
+	atomicFetchAdd64(&walk->fileCount, fileCount);
+	atomicFetchAdd64(&walk->directoryCount, directoryCount);
+	if (failedDirectoryCount > 0)
+		atomicFetchAdd64(&walk->failedDirectoryCount, failedDirectoryCount);
+}
+static void walkDirectoryJob(void* argument)
+{
+	DirectoryWalkJob* job = argument;
+	DirectoryWalk* walk = job->walk;
+	uint32_t depth = job->depth;
+
+	DirectoryLevel* parentLevel = NULL;
+#if __linux__ || __APPLE__
+	parentLevel = &walk->rootLevel;
+#endif
+
+	DirectoryIterator directoryIterator = createDirectoryIterator(walk->rootPath, parentLevel, job->path, false);
+	free(job);
+
+	if (directoryIterator)
+		walkDirectoryEntries(walk, directoryIterator, depth);
+	else
+		atomicFetchAdd64(&walk->failedDirectoryCount, 1);
+}
+static bool runDirectoryWalkJob(DirectoryWalk* walk, const char* path, size_t pathLength, uint32_t depth)
+{
+	DirectoryWalkJob* job = malloc(sizeof(DirectoryWalkJob) + pathLength + 1);
+	if (!job)
+		return false;
+
+	job->walk = walk;
+	job->depth = depth;
+	memcpy(job->path, path, pathLength);
+	job->path[pathLength] = '\0';
+
+	if (!walk->jobSystem)
+	{
+		walkDirectoryJob(job);
+		return true;
+	}
+	if (!runJob(walk->jobSystem, walkDirectoryJob, job, walk->jobCounter, NULL))
+	{
+		free(job);
+		return false;
+	}
+	return true;
+}
+
+//**********************************************************************************************************************
+bool walkDirectory(JobSystem jobSystem, const char* path, DirectoryFilterFunction filter,
+	DirectoryEntryFunction onEntry, void* argument, DirectoryWalkStats* stats)
+{
+	assert(path);
+
+	DirectoryWalk walk;
+	memset(&walk, 0, sizeof(DirectoryWalk));
+	walk.jobSystem = jobSystem;
+	walk.rootPath = path;
+	walk.filter = filter;
+	walk.onEntry = onEntry;
+	walk.argument = argument;
+
+	DirectoryIterator directoryIterator = createDirectoryIterator(path, NULL, "", false);
+	if (!directoryIterator)
+		return false;
+
+	if (jobSystem)
+	{
+		walk.jobCounter = createJobCounter();
+		if (!walk.jobCounter)
+		{
+			closeDirectoryIterator(directoryIterator);
+			return false;
+		}
+	}
+
+	// Note: Subdirectories are opened relative to the root handle, so only their relative paths are resolved.
+#if __linux__ || __APPLE__
+	if (!openDirectoryLevel(&walk.rootLevel, NULL, path))
+	{
+		#if __linux__
+		free(walk.rootLevel.buffer);
+		#endif
+		if (walk.jobCounter)
+			destroyJobCounter(walk.jobCounter);
+		closeDirectoryIterator(directoryIterator);
+		return false;
+	}
+#endif
+
+	// Note: The calling thread reads the root directory and then executes jobs while it waits for them.
+	walkDirectoryEntries(&walk, directoryIterator, 0);
+	if (jobSystem)
+	{
+		waitJobCounter(jobSystem, walk.jobCounter);
+		destroyJobCounter(walk.jobCounter);
+	}
+
+#if __linux__ || __APPLE__
+	closeDirectoryLevel(&walk.rootLevel);
+	#if __linux__
+	free(walk.rootLevel.buffer);
+	#endif
+#endif
+
+	if (stats)
+	{
+		stats->entryCount = (uint64_t)walk.entryCount;
+		stats->fileCount = (uint64_t)walk.fileCount;
+		stats->directoryCount = (uint64_t)walk.directoryCount;
+		stats->failedDirectoryCount = (uint64_t)walk.failedDirectoryCount;
+	}
+	return true;
+}
+
+//**********************************************************************************************************************
+typedef enum MakeDirectoryResult
+{
+	CREATED_MAKE_DIRECTORY_RESULT,
+	EXISTS_MAKE_DIRECTORY_RESULT,
+	NOT_FOUND_MAKE_DIRECTORY_RESULT,
+	FAILED_MAKE_DIRECTORY_RESULT,
+} MakeDirectoryResult;
+
+#if __linux__ || __APPLE__
+#define CURRENT_DIRECTORY_FD AT_FDCWD
+#define isPathSeparator(c) ((c) == '/')
+
+static MakeDirectoryResult makeDirectory(int parentFd, const char* path)
+{
+	if (mkdirat(parentFd, path, 0777) == 0)
+		return CREATED_MAKE_DIRECTORY_RESULT;
+	if (errno == EEXIST)
+		return EXISTS_MAKE_DIRECTORY_RESULT;
+	return errno == ENOENT ? NOT_FOUND_MAKE_DIRECTORY_RESULT : FAILED_MAKE_DIRECTORY_RESULT;
+}
+#elif _WIN32
+#define CURRENT_DIRECTORY_FD -1
+#define isPathSeparator(c) ((c) == '/' || (c) == '\\')
+
+static MakeDirectoryResult makeDirectory(int parentFd, const char* path)
+{
+	if (CreateDirectoryA(path, NULL) == TRUE)
+		return CREATED_MAKE_DIRECTORY_RESULT;
+	DWORD error = GetLastError();
+	if (error == ERROR_ALREADY_EXISTS)
+		return EXISTS_MAKE_DIRECTORY_RESULT;
+	return error == ERROR_PATH_NOT_FOUND ? NOT_FOUND_MAKE_DIRECTORY_RESULT : FAILED_MAKE_DIRECTORY_RESULT;
+}
+#endif
+
+bool createDirectories(const char* path, bool* isCreated)
+{
+	assert(path);
+	if (isCreated)
+		*isCreated = false;
+
+	// Note: Usually only the leaf is missing, so it costs a single syscall without path parsing.
+	MakeDirectoryResult result = makeDirectory(CURRENT_DIRECTORY_FD, path);
+	if (result == CREATED_MAKE_DIRECTORY_RESULT)
+	{
+		if (isCreated)
+			*isCreated = true;
+		return true;
+	}
+	if (result == EXISTS_MAKE_DIRECTORY_RESULT)
+		return isDirectoryExists(path);
+	if (result == FAILED_MAKE_DIRECTORY_RESULT)
+		return false;
+
+	size_t length = strlen(path);
+	char* buffer = malloc(length + 1);
+	if (!buffer)
+		return false;
+	memcpy(buffer, path, length + 1);
+	while (length > 1 && isPathSeparator(buffer[length - 1]))
+		length--;
+	buffer[length] = '\0';
+
+	// Note: Walks backwards until the deepest existing (or just created) ancestor is found.
+	size_t parentLength = length;
+	while (true)
+	{
+		while (parentLength > 0 && !isPathSeparator(buffer[parentLength - 1]))
+			parentLength--;
+		while (parentLength > 0 && isPathSeparator(buffer[parentLength - 1]))
+			parentLength--;
+		if (parentLength == 0)
+			break;
+
+		char separator = buffer[parentLength];
+		buffer[parentLength] = '\0';
+		result = makeDirectory(CURRENT_DIRECTORY_FD, buffer);
+		buffer[parentLength] = separator;
+		if (result != NOT_FOUND_MAKE_DIRECTORY_RESULT)
+			break;
+	}
+
+	int parentFd = CURRENT_DIRECTORY_FD;
+	size_t pathOffset = 0;
+#if __linux__ || __APPLE__
+	// Note: Remaining directories are created relative to the ancestor, so its path is not resolved again.
+	if (parentLength > 0)
+	{
+		char separator = buffer[parentLength];
+		buffer[parentLength] = '\0';
+		int fd = open(buffer, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		buffer[parentLength] = separator;
+		if (fd != -1)
+		{
+			parentFd = fd;
+			pathOffset = parentLength;
+			while (isPathSeparator(buffer[pathOffset]))
+				pathOffset++;
+		}
+	}
+#endif
+
+	size_t index = parentLength;
+	while (index < length)
+	{
+		while (index < length && isPathSeparator(buffer[index]))
+			index++;
+		while (index < length && !isPathSeparator(buffer[index]))
+			index++;
+
+		char separator = buffer[index];
+		buffer[index] = '\0';
+		result = makeDirectory(parentFd, buffer + pathOffset);
+		buffer[index] = separator;
+		if (result == NOT_FOUND_MAKE_DIRECTORY_RESULT || result == FAILED_MAKE_DIRECTORY_RESULT)
+			break;
+	}
+
+#if __linux__ || __APPLE__
+	if (parentFd != CURRENT_DIRECTORY_FD)
+		close(parentFd);
+#endif
+	free(buffer);
+
+	if (result == CREATED_MAKE_DIRECTORY_RESULT)
+	{
+		if (isCreated)
+			*isCreated = true;
+		return true;
+	}
+	// Note: Leaf could be created concurrently by another thread or process.
+	return result == EXISTS_MAKE_DIRECTORY_RESULT && isDirectoryExists(path);
+}
+
+//**********************************************************************************************************************
+#if __linux__ || __APPLE__
+inline static int64_t toTimeNs(int64_t seconds, int64_t nanoseconds)
+{
+	return seconds * 1000000000ll + nanoseconds;
+}
+
+#if __linux__ && defined(STATX_TYPE)
+static unsigned int toStatxMask(uint32_t fields)
+{
+	unsigned int mask = 0;
+	if (fields & FILE_INFO_FIELD_BIT(TYPE_FILE_INFO_FIELD))
+		mask |= STATX_TYPE;
+	if (fields & FILE_INFO_FIELD_BIT(SIZE_FILE_INFO_FIELD))
+		mask |= STATX_SIZE;
+	if (fields & FILE_INFO_FIELD_BIT(MODIFY_TIME_FILE_INFO_FIELD))
+		mask |= STATX_MTIME;
+	if (fields & FILE_INFO_FIELD_BIT(ACCESS_TIME_FILE_INFO_FIELD))
+		mask |= STATX_ATIME;
+	if (fields & FILE_INFO_FIELD_BIT(CHANGE_TIME_FILE_INFO_FIELD))
+		mask |= STATX_CTIME;
+	if (fields & FILE_INFO_FIELD_BIT(INODE_FILE_INFO_FIELD))
+		mask |= STATX_INO;
+	return mask;
+}
+#endif
+
+// Note: Only the requested fields are retrieved, network file systems may skip the other attributes.
+static bool queryFileInfo(int directoryFd, const char* path, uint32_t fields, bool isCached, FileInfo* info)
+{
+	memset(info, 0, sizeof(FileInfo));
+
+	#if __linux__ && defined(STATX_TYPE)
+	struct statx sx;
+	if (statx(directoryFd, path, isCached ? AT_STATX_DONT_SYNC : AT_STATX_SYNC_AS_STAT, toStatxMask(fields), &sx) == 0)
+	{
+		unsigned int mask = sx.stx_mask;
+		if (mask & STATX_TYPE)
+		{
+			info->type = toModeFileType(sx.stx_mode);
+			info->fields |= FILE_INFO_FIELD_BIT(TYPE_FILE_INFO_FIELD);
+		}
+		if (mask & STATX_SIZE)
+		{
+			info->size = (int64_t)sx.stx_size;
+			info->fields |= FILE_INFO_FIELD_BIT(SIZE_FILE_INFO_FIELD);
+		}
+		if (mask & STATX_MTIME)
+		{
+			info->modifyTime = toTimeNs(sx.stx_mtime.tv_sec, sx.stx_mtime.tv_nsec);
+			info->fields |= FILE_INFO_FIELD_BIT(MODIFY_TIME_FILE_INFO_FIELD);
+		}
+		if (mask & STATX_ATIME)
+		{
+			info->accessTime = toTimeNs(sx.stx_atime.tv_sec, sx.stx_atime.tv_nsec);
+			info->fields |= FILE_INFO_FIELD_BIT(ACCESS_TIME_FILE_INFO_FIELD);
+		}
+		if (mask & STATX_CTIME)
+		{
+			info->changeTime = toTimeNs(sx.stx_ctime.tv_sec, sx.stx_ctime.tv_nsec);
+			info->fields |= FILE_INFO_FIELD_BIT(CHANGE_TIME_FILE_INFO_FIELD);
+		}
+		if (mask & STATX_INO)
+		{
+			info->inode = sx.stx_ino;
+			info->device = (uint64_t)makedev(sx.stx_dev_major, sx.stx_dev_minor);
+			info->fields |= FILE_INFO_FIELD_BIT(INODE_FILE_INFO_FIELD);
+		}
+		return true;
+	}
+	if (errno != ENOSYS) // Note: statx() was added in Linux 4.11.
+		return false;
+	#endif
+
+	struct stat sb;
+	if (fstatat(directoryFd, path, &sb, 0) != 0)
+		return false;
+
+	info->size = (int64_t)sb.st_size;
+	#if __APPLE__
+	info->modifyTime = toTimeNs(sb.st_mtimespec.tv_sec, sb.st_mtimespec.tv_nsec);
+	info->accessTime = toTimeNs(sb.st_atimespec.tv_sec, sb.st_atimespec.tv_nsec);
+	info->changeTime = toTimeNs(sb.st_ctimespec.tv_sec, sb.st_ctimespec.tv_nsec);
+	#else
+	info->modifyTime = toTimeNs(sb.st_mtim.tv_sec, sb.st_mtim.tv_nsec);
+	info->accessTime = toTimeNs(sb.st_atim.tv_sec, sb.st_atim.tv_nsec);
+	info->changeTime = toTimeNs(sb.st_ctim.tv_sec, sb.st_ctim.tv_nsec);
+	#endif
+	info->inode = (uint64_t)sb.st_ino;
+	info->device = (uint64_t)sb.st_dev;
+	info->fields = ALL_FILE_INFO_FIELDS;
+	info->type = toModeFileType(sb.st_mode);
+	return true;
+}
+#elif _WIN32
+#define WINDOWS_TO_UNIX_EPOCH 116444736000000000ll // Note: In 100 nanosecond intervals.
+
+inline static int64_t toTimeNs(FILETIME time)
+{
+	int64_t value = (int64_t)(((uint64_t)time.dwHighDateTime << 32) | time.dwLowDateTime);
+	return (value - WINDOWS_TO_UNIX_EPOCH) * 100;
+}
+
+static void setFileInfo(DWORD attributes, DWORD sizeHigh, DWORD sizeLow,
+	FILETIME modifyTime, FILETIME accessTime, FileInfo* info)
+{
+	if (attributes & FILE_ATTRIBUTE_DIRECTORY)
+		info->type = DIRECTORY_FILE_TYPE;
+	else if (attributes & FILE_ATTRIBUTE_DEVICE)
+		info->type = OTHER_FILE_TYPE;
+	else
+		info->type = REGULAR_FILE_TYPE;
+
+	info->size = (int64_t)(((uint64_t)sizeHigh << 32) | sizeLow);
+	info->modifyTime = toTimeNs(modifyTime);
+	info->accessTime = toTimeNs(accessTime);
+	info->fields = FILE_INFO_FIELD_BIT(TYPE_FILE_INFO_FIELD) | FILE_INFO_FIELD_BIT(SIZE_FILE_INFO_FIELD) |
+		FILE_INFO_FIELD_BIT(MODIFY_TIME_FILE_INFO_FIELD) | FILE_INFO_FIELD_BIT(ACCESS_TIME_FILE_INFO_FIELD);
+}
+static bool queryFileInfo(const char* path, uint32_t fields, FileInfo* info)
+{
+	memset(info, 0, sizeof(FileInfo));
+
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (GetFileAttributesExA(path, GetFileExInfoStandard, &data) == FALSE)
+		return false;
+
+	// Note: Attributes describe the reparse point (symbolic link, junction) itself, so it is opened to follow
+	//       the link like the stat(). File index also requires opening the file, so it is retrieved only if requested.
+	bool isReparsePoint = (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+	if (isReparsePoint || (fields & FILE_INFO_FIELD_BIT(INODE_FILE_INFO_FIELD)))
+	{
+		HANDLE file = CreateFileA(path, 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			BY_HANDLE_FILE_INFORMATION fileInfo;
+			BOOL result = GetFileInformationByHandle(file, &fileInfo);
+			CloseHandle(file);
+
+			if (result == TRUE)
+			{
+				setFileInfo(fileInfo.dwFileAttributes, fileInfo.nFileSizeHigh, fileInfo.nFileSizeLow,
+					fileInfo.ftLastWriteTime, fileInfo.ftLastAccessTime, info);
+				info->inode = ((uint64_t)fileInfo.nFileIndexHigh << 32) | fileInfo.nFileIndexLow;
+				info->device = fileInfo.dwVolumeSerialNumber;
+				info->fields |= FILE_INFO_FIELD_BIT(INODE_FILE_INFO_FIELD);
+				return true;
+			}
+		}
+		if (isReparsePoint)
+			return false; // Note: Broken link target, like the stat() ENOENT.
+	}
+
+	setFileInfo(data.dwFileAttributes, data.nFileSizeHigh, data.nFileSizeLow,
+		data.ftLastWriteTime, data.ftLastAccessTime, info);
+	return true;
+}
+#endif
+
+bool getFileInfo(const char* path, uint32_t fields, bool isCached, FileInfo* info)
+{
+	assert(path);
+	assert(info);
+#if __linux__ || __APPLE__
+	return queryFileInfo(AT_FDCWD, path, fields, isCached, info);
+#elif _WIN32
+	return queryFileInfo(path, fields, info);
+#endif
+}
+uint32_t getFileInfos(const char* directoryPath, const char* const* paths,
+	uint32_t count, uint32_t fields, bool isCached, FileInfo* infos)
+{
+	assert(paths || count == 0);
+	assert(infos || count == 0);
+	uint32_t successCount = 0;
+
+#if __linux__ || __APPLE__
+	int directoryFd = AT_FDCWD;
+	if (directoryPath)
+	{
+		#if __linux__
+		directoryFd = open(directoryPath, O_PATH | O_DIRECTORY | O_CLOEXEC);
+		#else
+		directoryFd = open(directoryPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		#endif
+		if (directoryFd == -1)
+		{
+			memset(infos, 0, count * sizeof(FileInfo));
+			return 0;
+		}
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+		successCount += queryFileInfo(directoryFd, paths[i], fields, isCached, &infos[i]) ? 1 : 0;
+
+	if (directoryFd != AT_FDCWD)
+		close(directoryFd);
+#elif _WIN32
+	// Note: Windows has no handle relative file information query, so the full path is used.
+	size_t directoryLength = directoryPath ? strlen(directoryPath) : 0, capacity = 0;
+	char* fullPath = NULL;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		size_t pathLength = strlen(paths[i]);
+		if (directoryLength + pathLength + 2 > capacity)
+		{
+			capacity = (directoryLength + pathLength + 2) * 2;
+			char* newPath = realloc(fullPath, capacity);
+			if (!newPath)
+			{
+				memset(infos + i, 0, (count - i) * sizeof(FileInfo));
+				break;
+			}
+			fullPath = newPath;
+		}
+
+		size_t offset = 0;
+		if (directoryLength > 0)
+		{
+			memcpy(fullPath, directoryPath, directoryLength);
+			fullPath[directoryLength] = PATH_SEPARATOR;
+			offset = directoryLength + 1;
+		}
+		memcpy(fullPath + offset, paths[i], pathLength + 1);
+		successCount += queryFileInfo(fullPath, fields, &infos[i]) ? 1 : 0;
+	}
+	free(fullPath);
+#endif
+	return successCount;
+}
@@ -0,0 +1,889 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "mpio/file.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define COPY_FILE_BUFFER_SIZE (1024 * 1024)
+
+static bool copyFileBuffered(FileHandle sourceFile, FileHandle destinationFile, int64_t offset, int64_t size)
+{
+	uint8_t* buffer = malloc(COPY_FILE_BUFFER_SIZE);
+	if (!buffer)
+		return false;
+
+	while (offset < size)
+	{
+		int64_t remaining = size - offset;
+		size_t count = remaining > COPY_FILE_BUFFER_SIZE ? COPY_FILE_BUFFER_SIZE : (size_t)remaining;
+		int64_t readSize = readFileAt(sourceFile, buffer, count, offset);
+
+		// Note: Zero read size means that the source file was truncated during the copy.
+		if (readSize <= 0 || writeFileAt(destinationFile, buffer, (size_t)readSize, offset) != readSize)
+		{
+			free(buffer);
+			return false;
+		}
+		offset += readSize;
+	}
+
+	free(buffer);
+	return true;
+}
+
+#if __linux__ || __APPLE__
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#if __linux__
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+#elif __APPLE__
+#include <copyfile.h>
+#include <sys/clonefile.h>
+#endif
+
+typedef char FileBufferLayoutCheck[sizeof(FileBuffer) == sizeof(struct iovec) &&
+	offsetof(FileBuffer, size) == offsetof(struct iovec, iov_len) ? 1 : -1];
+
+FileHandle openFileHandle(const char* filePath, const char* mode)
+{
+	assert(filePath);
+	assert(mode);
+
+	bool isUpdate = strchr(mode, '+') != NULL;
+	int flags = O_CLOEXEC;
+	switch (mode[0])
+	{
+	case 'r': flags |= isUpdate ? O_RDWR : O_RDONLY; break;
+	case 'w': flags |= (isUpdate ? O_RDWR : O_WRONLY) | O_CREAT | O_TRUNC; break;
+	case 'a': flags |= (isUpdate ? O_RDWR : O_WRONLY) | O_CREAT | O_APPEND; break;
+	default: return INVALID_FILE_HANDLE;
+	}
+
+	int file;
+	do { file = open(filePath, flags, 0666); } while (file == -1 && errno == EINTR);
+	return file;
+}
+bool closeFileHandle(FileHandle file)
+{
+	return close(file) == 0;
+}
+int64_t getFileHandleSize(FileHandle file)
+{
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0)
+		return -1;
+	return (int64_t)fileStat.st_size;
+}
+bool flushFileHandle(FileHandle file)
+{
+	return fsync(file) == 0;
+}
+
+//**********************************************************************************************************************
+int64_t readFileAt(FileHandle file, void* buffer, size_t size, int64_t offset)
+{
+	assert(buffer || size == 0);
+	assert(offset >= 0);
+
+	size_t readSize = 0;
+	while (readSize < size)
+	{
+		ssize_t result = pread(file, (uint8_t*)buffer + readSize, size - readSize, (off_t)(offset + readSize));
+		if (result < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		if (result == 0)
+			break;
+		readSize += (size_t)result;
+	}
+	return (int64_t)readSize;
+}
+int64_t writeFileAt(FileHandle file, const void* buffer, size_t size, int64_t offset)
+{
+	assert(buffer || size == 0);
+	assert(offset >= 0);
+
+	size_t writeSize = 0;
+	while (writeSize < size)
+	{
+		ssize_t result = pwrite(file, (const uint8_t*)buffer + writeSize,
+			size - writeSize, (off_t)(offset + writeSize));
+		if (result < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		writeSize += (size_t)result;
+	}
+	return (int64_t)writeSize;
+}
+
+#if __linux__
+int64_t readFileVectorAt(FileHandle file, const FileBuffer* buffers, uint32_t count, int64_t offset)
+{
+	assert(buffers || count == 0);
+	assert(offset >= 0);
+
+	ssize_t result;
+	do { result = preadv(file, (const struct iovec*)buffers, (int)count, (off_t)offset); }
+	while (result < 0 && errno == EINTR);
+	return result;
+}
+int64_t writeFileVectorAt(FileHandle file, const FileBuffer* buffers, uint32_t count, int64_t offset)
+{
+	assert(buffers || count == 0);
+	assert(offset >= 0);
+
+	ssize_t result;
+	do { result = pwritev(file, (const struct iovec*)buffers, (int)count, (off_t)offset); }
+	while (result < 0 && errno == EINTR);
+	return result;
+}
+#endif
+
+//**********************************************************************************************************************
+bool copyFile(const char* sourcePath, const char* destinationPath, CopyFileMethod* method)
+{
+	assert(sourcePath);
+	assert(destinationPath);
+
+	int sourceFile = open(sourcePath, O_RDONLY | O_CLOEXEC);
+	if (sourceFile == -1)
+		return false;
+
+	struct stat sourceStat;
+	if (fstat(sourceFile, &sourceStat) != 0)
+	{
+		close(sourceFile);
+		return false;
+	}
+
+	#if __APPLE__
+	int cloneResult = clonefile(sourcePath, destinationPath, 0);
+	if (cloneResult != 0 && errno == EEXIST)
+	{
+		struct stat destinationStat;
+		if (stat(destinationPath, &destinationStat) != 0 || (destinationStat.st_dev == sourceStat.st_dev &&
+			destinationStat.st_ino == sourceStat.st_ino))
+		{
+			close(sourceFile);
+			return false;
+		}
+		if (unlink(destinationPath) == 0)
+			cloneResult = clonefile(sourcePath, destinationPath, 0);
+	}
+
+	if (cloneResult == 0)
+	{
+		close(sourceFile);
+		if (method)
+			*method = CLONE_COPY_FILE_METHOD;
+		return true;
+	}
+	#endif
+
+	// Note: Destination is truncated only after checking that it is not the same file (or hard link).
+	int destinationFile = open(destinationPath, O_WRONLY | O_CREAT | O_CLOEXEC, sourceStat.st_mode & 0777);
+	if (destinationFile == -1)
+	{
+		close(sourceFile);
+		return false;
+	}
+
+	struct stat destinationStat;
+	if (fstat(destinationFile, &destinationStat) != 0 || (destinationStat.st_dev == sourceStat.st_dev &&
+		destinationStat.st_ino == sourceStat.st_ino) || ftruncate(destinationFile, 0) != 0)
+	{
+		close(destinationFile); close(sourceFile);
+		return false;
+	}
+
+	int64_t size = (int64_t)sourceStat.st_size, offset = 0;
+	CopyFileMethod copyMethod = BUFFERED_COPY_FILE_METHOD;
+
+	#if __linux__
+	if (ioctl(destinationFile, FICLONE, sourceFile) == 0)
+	{
+		copyMethod = CLONE_COPY_FILE_METHOD;
+		offset = size;
+	}
+
+	while (offset < size)
+	{
+		off_t sourceOffset = (off_t)offset, destinationOffset = (off_t)offset;
+		ssize_t result = copy_file_range(sourceFile, &sourceOffset, destinationFile,
+			&destinationOffset, (size_t)(size - offset), 0);
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			break; // Note: Not supported by the file system or kernel, trying next method.
+		copyMethod = COPY_RANGE_COPY_FILE_METHOD;
+		offset += result;
+	}
+
+	if (offset < size && lseek(destinationFile, (off_t)offset, SEEK_SET) == (off_t)offset)
+	{
+		while (offset < size)
+		{
+			off_t sourceOffset = (off_t)offset;
+			ssize_t result = sendfile(destinationFile, sourceFile, &sourceOffset, (size_t)(size - offset));
+			if (result < 0 && errno == EINTR)
+				continue;
+			if (result <= 0)
+				break;
+			copyMethod = SEND_FILE_COPY_FILE_METHOD;
+			offset += result;
+		}
+	}
+	#elif __APPLE__
+	if (fcopyfile(sourceFile, destinationFile, NULL, COPYFILE_DATA) == 0)
+	{
+		copyMethod = SYSTEM_COPY_FILE_METHOD;
+		offset = size;
+	}
+	#endif
+
+	bool result = true;
+	if (offset < size)
+	{
+		copyMethod = BUFFERED_COPY_FILE_METHOD;
+		result = copyFileBuffered(sourceFile, destinationFile, offset, size);
+	}
+
+	close(sourceFile);
+	if (close(destinationFile) != 0)
+		result = false;
+
+	if (!result)
+	{
+		unlink(destinationPath);
+		return false;
+	}
+
+	if (method)
+		*method = copyMethod;
+	return true;
+}
+
+//**********************************************************************************************************************
+bool preallocateFile(FileHandle file, int64_t offset, int64_t size, bool keepSize)
+{
+	assert(offset >= 0);
+	assert(size > 0);
+
+	#if __linux__
+	int result;
+	do { result = fallocate(file, keepSize ? FALLOC_FL_KEEP_SIZE : 0, (off_t)offset, (off_t)size); }
+	while (result != 0 && errno == EINTR);
+
+	if (result == 0)
+		return true;
+	if (keepSize || errno != EOPNOTSUPP)
+		return false;
+	return posix_fallocate(file, (off_t)offset, (off_t)size) == 0; // Note: Emulated with the writes.
+	#elif __APPLE__
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0)
+		return false;
+
+	int64_t fileSize = (int64_t)fileStat.st_size, endOffset = offset + size;
+	if (endOffset <= fileSize)
+		return true;
+
+	fstore_t store;
+	memset(&store, 0, sizeof(fstore_t));
+	store.fst_flags = F_ALLOCATECONTIG | F_ALLOCATEALL;
+	store.fst_posmode = F_PEOFPOSMODE;
+	store.fst_length = (off_t)(endOffset - fileSize);
+
+	if (fcntl(file, F_PREALLOCATE, &store) == -1)
+	{
+		store.fst_flags = F_ALLOCATEALL;
+		if (fcntl(file, F_PREALLOCATE, &store) == -1)
+			return false;
+	}
+	return keepSize || ftruncate(file, (off_t)endOffset) == 0;
+	#endif
+}
+bool punchFileHole(FileHandle file, int64_t offset, int64_t size)
+{
+	assert(offset >= 0);
+	assert(size > 0);
+
+	#if __linux__
+	int result;
+	do { result = fallocate(file, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, (off_t)offset, (off_t)size); }
+	while (result != 0 && errno == EINTR);
+	return result == 0;
+	#elif __APPLE__
+	fpunchhole_t punchHole;
+	memset(&punchHole, 0, sizeof(fpunchhole_t));
+	punchHole.fp_offset = (off_t)offset;
+	punchHole.fp_length = (off_t)size;
+	return fcntl(file, F_PUNCHHOLE, &punchHole) != -1;
+	#endif
+}
+int64_t getFileExtents(FileHandle file, int64_t offset, FileExtent* extents, uint32_t capacity)
+{
+	assert(offset >= 0);
+	assert(extents || capacity == 0);
+
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0)
+		return -1;
+
+	int64_t fileSize = (int64_t)fileStat.st_size;
+	uint32_t count = 0;
+
+	while (offset < fileSize && count < capacity)
+	{
+		off_t dataOffset = lseek(file, (off_t)offset, SEEK_DATA);
+		if (dataOffset == -1)
+		{
+			if (errno != ENXIO)
+				return count > 0 ? (int64_t)count : -1;
+			dataOffset = (off_t)fileSize; // Note: No more data until the end of file.
+		}
+
+		if (dataOffset > offset)
+		{
+			FileExtent* extent = &extents[count++];
+			extent->offset = offset;
+			extent->size = (int64_t)dataOffset - offset;
+			extent->isHole = true;
+			offset = (int64_t)dataOffset;
+			if (offset >= fileSize || count >= capacity)
+				break;
+		}
+
+		off_t holeOffset = lseek(file, (off_t)offset, SEEK_HOLE);
+		if (holeOffset == -1)
+			return count > 0 ? (int64_t)count : -1;
+
+		FileExtent* extent = &extents[count++];
+		extent->offset = offset;
+		extent->size = (int64_t)holeOffset - offset;
+		extent->isHole = false;
+		offset = (int64_t)holeOffset;
+	}
+	return (int64_t)count;
+}
+bool adviseFileAccess(FileHandle file, int64_t offset, int64_t size, FileAccessHint hint)
+{
+	assert(offset >= 0);
+	assert(size >= 0);
+	assert(hint < FILE_ACCESS_HINT_COUNT);
+
+	#if __linux__
+	static const int advices[FILE_ACCESS_HINT_COUNT] =
+	{
+		POSIX_FADV_NORMAL, POSIX_FADV_SEQUENTIAL, POSIX_FADV_RANDOM, POSIX_FADV_WILLNEED, POSIX_FADV_DONTNEED,
+	};
+	return posix_fadvise(file, (off_t)offset, (off_t)size, advices[hint]) == 0;
+	#elif __APPLE__
+	switch (hint)
+	{
+	case NORMAL_FILE_ACCESS_HINT:
+	case SEQUENTIAL_FILE_ACCESS_HINT:
+		return fcntl(file, F_RDAHEAD, 1) != -1;
+	case RANDOM_FILE_ACCESS_HINT:
+		return fcntl(file, F_RDAHEAD, 0) != -1;
+	case WILL_NEED_FILE_ACCESS_HINT:
+	{
+		if (size == 0)
+		{
+			struct stat fileStat;
+			if (fstat(file, &fileStat) != 0)
+				return false;
+			size = (int64_t)fileStat.st_size - offset;
+		}
+		struct radvisory advisory;
+		advisory.ra_offset = (off_t)offset;
+		advisory.ra_count = size > INT32_MAX ? INT32_MAX : (int)size;
+		return fcntl(file, F_RDADVISE, &advisory) != -1;
+	}
+	default:
+		return true;
+	}
+	#endif
+}
+
+//**********************************************************************************************************************
+void* mapFile(const char* filePath, MapFileAccess access, int64_t offset, size_t* size, bool prefault)
+{
+	assert(filePath);
+	assert(access < MAP_FILE_ACCESS_COUNT);
+	assert(offset >= 0);
+	assert(size);
+
+	int openFlags = (access == READ_WRITE_MAP_FILE_ACCESS ? O_RDWR : O_RDONLY) | O_CLOEXEC;
+	int file;
+	do { file = open(filePath, openFlags); } while (file == -1 && errno == EINTR);
+	if (file == -1)
+		return NULL;
+
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0 || offset >= fileStat.st_size)
+	{
+		close(file);
+		return NULL;
+	}
+
+	size_t mapSize = *size;
+	if (mapSize == 0)
+		mapSize = (size_t)(fileStat.st_size - offset);
+	else if ((int64_t)mapSize > fileStat.st_size - offset)
+	{
+		close(file);
+		return NULL;
+	}
+
+	int64_t pageSize = (int64_t)sysconf(_SC_PAGESIZE);
+	int64_t alignedOffset = offset - offset % pageSize;
+	size_t alignment = (size_t)(offset - alignedOffset);
+
+	int protection = access == READ_ONLY_MAP_FILE_ACCESS ? PROT_READ : PROT_READ | PROT_WRITE;
+	int flags = access == COPY_ON_WRITE_MAP_FILE_ACCESS ? MAP_PRIVATE : MAP_SHARED;
+	#if __linux__
+	if (prefault)
+		flags |= MAP_POPULATE;
+	#endif
+
+	void* mapping = mmap(NULL, mapSize + alignment, protection, flags, file, (off_t)alignedOffset);
+	close(file); // Note: Mapping keeps a reference to the file.
+
+	if (mapping == MAP_FAILED)
+		return NULL;
+
+	#if __APPLE__
+	if (prefault)
+		madvise(mapping, mapSize + alignment, MADV_WILLNEED);
+	#endif
+
+	*size = mapSize;
+	return (uint8_t*)mapping + alignment;
+}
+bool unmapFile(void* data, size_t size)
+{
+	assert(data);
+	assert(size > 0);
+
+	size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	size_t alignment = (size_t)data % pageSize;
+	return munmap((uint8_t*)data - alignment, size + alignment) == 0;
+}
+bool flushMappedFile(void* data, size_t size)
+{
+	assert(data);
+	assert(size > 0);
+
+	size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	size_t alignment = (size_t)data % pageSize;
+	return msync((uint8_t*)data - alignment, size + alignment, MS_SYNC) == 0;
+}
+
+#elif _WIN32
+//**********************************************************************************************************************
+#include <windows.h>
+
+FileHandle openFileHandle(const char* filePath, const char* mode)
+{
+	assert(filePath);
+	assert(mode);
+
+	bool isUpdate = strchr(mode, '+') != NULL;
+	DWORD access, disposition;
+	switch (mode[0])
+	{
+	case 'r':
+		access = isUpdate ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+		disposition = OPEN_EXISTING; break;
+	case 'w':
+		access = isUpdate ? GENERIC_READ | GENERIC_WRITE : GENERIC_WRITE;
+		disposition = CREATE_ALWAYS; break;
+	case 'a':
+		access = isUpdate ? GENERIC_READ | GENERIC_WRITE : GENERIC_WRITE;
+		disposition = OPEN_ALWAYS; break;
+	default: return INVALID_FILE_HANDLE;
+	}
+
+	return CreateFileA(filePath, access, FILE_SHARE_READ | FILE_SHARE_WRITE,
+		NULL, disposition, FILE_ATTRIBUTE_NORMAL, NULL);
+}
+bool closeFileHandle(FileHandle file)
+{
+	return CloseHandle(file) == TRUE;
+}
+int64_t getFileHandleSize(FileHandle file)
+{
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) != TRUE)
+		return -1;
+	return fileSize.QuadPart;
+}
+bool flushFileHandle(FileHandle file)
+{
+	return FlushFileBuffers(file) == TRUE;
+}
+
+//**********************************************************************************************************************
+int64_t readFileAt(FileHandle file, void* buffer, size_t size, int64_t offset)
+{
+	assert(buffer || size == 0);
+	assert(offset >= 0);
+
+	size_t readSize = 0;
+	while (readSize < size)
+	{
+		OVERLAPPED overlapped;
+		memset(&overlapped, 0, sizeof(OVERLAPPED));
+		int64_t readOffset = offset + (int64_t)readSize;
+		overlapped.Offset = (DWORD)(readOffset & 0xFFFFFFFF);
+		overlapped.OffsetHigh = (DWORD)(readOffset >> 32);
+
+		size_t remaining = size - readSize;
+		DWORD chunkSize = remaining > 0x40000000 ? 0x40000000 : (DWORD)remaining, result = 0;
+		if (ReadFile(file, (uint8_t*)buffer + readSize, chunkSize, &result, &overlapped) != TRUE)
+		{
+			if (GetLastError() == ERROR_HANDLE_EOF)
+				break;
+			return -1;
+		}
+		if (result == 0)
+			break;
+		readSize += result;
+	}
+	return (int64_t)readSize;
+}
+int64_t writeFileAt(FileHandle file, const void* buffer, size_t size, int64_t offset)
+{
+	assert(buffer || size == 0);
+	assert(offset >= 0);
+
+	size_t writeSize = 0;
+	while (writeSize < size)
+	{
+		OVERLAPPED overlapped;
+		memset(&overlapped, 0, sizeof(OVERLAPPED));
+		int64_t writeOffset = offset + (int64_t)writeSize;
+		overlapped.Offset = (DWORD)(writeOffset & 0xFFFFFFFF);
+		overlapped.OffsetHigh = (DWORD)(writeOffset >> 32);
+
+		size_t remaining = size - writeSize;
+		DWORD chunkSize = remaining > 0x40000000 ? 0x40000000 : (DWORD)remaining, result = 0;
+		if (WriteFile(file, (const uint8_t*)buffer + writeSize, chunkSize, &result, &overlapped) != TRUE)
+			return -1;
+		writeSize += result;
+	}
+	return (int64_t)writeSize;
+}
+
+//**********************************************************************************************************************
+bool copyFile(const char* sourcePath, const char* destinationPath, CopyFileMethod* method)
+{
+	assert(sourcePath);
+	assert(destinationPath);
+
+	// Note: CopyFileEx uses block cloning on the ReFS and Dev Drive volumes.
+	if (CopyFileExA(sourcePath, destinationPath, NULL, NULL, NULL, 0) == TRUE)
+	{
+		if (method)
+			*method = SYSTEM_COPY_FILE_METHOD;
+		return true;
+	}
+
+	FileHandle sourceFile = openFileHandle(sourcePath, "r");
+	if (sourceFile == INVALID_FILE_HANDLE)
+		return false;
+
+	// Note: Destination is truncated only after checking that it is not the same file (or hard link).
+	FileHandle destinationFile = CreateFileA(destinationPath, GENERIC_WRITE,
+		FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (destinationFile == INVALID_FILE_HANDLE)
+	{
+		CloseHandle(sourceFile);
+		return false;
+	}
+
+	BY_HANDLE_FILE_INFORMATION sourceInfo, destinationInfo;
+	if (GetFileInformationByHandle(sourceFile, &sourceInfo) != TRUE ||
+		GetFileInformationByHandle(destinationFile, &destinationInfo) != TRUE ||
+		(sourceInfo.dwVolumeSerialNumber == destinationInfo.dwVolumeSerialNumber &&
+		sourceInfo.nFileIndexHigh == destinationInfo.nFileIndexHigh &&
+		sourceInfo.nFileIndexLow == destinationInfo.nFileIndexLow) || SetEndOfFile(destinationFile) != TRUE)
+	{
+		CloseHandle(sourceFile); CloseHandle(destinationFile);
+		return false;
+	}
+
+	int64_t size = getFileHandleSize(sourceFile);
+	bool result = size >= 0 && copyFileBuffered(sourceFile, destinationFile, 0, size);
+	CloseHandle(sourceFile); CloseHandle(destinationFile);
+
+	if (!result)
+	{
+		DeleteFileA(destinationPath);
+		return false;
+	}
+
+	if (method)
+		*method = BUFFERED_COPY_FILE_METHOD;
+	return true;
+}
+
+//**********************************************************************************************************************
+bool preallocateFile(FileHandle file, int64_t offset, int64_t size, bool keepSize)
+{
+	assert(offset >= 0);
+	assert(size > 0);
+
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) != TRUE)
+		return false;
+
+	int64_t endOffset = offset + size;
+	if (endOffset <= fileSize.QuadPart)
+		return true;
+
+	FILE_ALLOCATION_INFO allocationInfo;
+	allocationInfo.AllocationSize.QuadPart = endOffset;
+	if (SetFileInformationByHandle(file, FileAllocationInfo, &allocationInfo, sizeof(FILE_ALLOCATION_INFO)) != TRUE)
+		return false;
+	if (keepSize)
+		return true;
+
+	FILE_END_OF_FILE_INFO endOfFileInfo;
+	endOfFileInfo.EndOfFile.QuadPart = endOffset;
+	return SetFileInformationByHandle(file, FileEndOfFileInfo, &endOfFileInfo, sizeof(FILE_END_OF_FILE_INFO)) == TRUE;
+}
+bool punchFileHole(FileHandle file, int64_t offset, int64_t size)
+{
+	assert(offset >= 0);
+	assert(size > 0);
+
+	DWORD returnedSize = 0;
+	FILE_SET_SPARSE_BUFFER sparseBuffer;
+	sparseBuffer.SetSparse = TRUE;
+	if (DeviceIoControl(file, FSCTL_SET_SPARSE, &sparseBuffer,
+		sizeof(FILE_SET_SPARSE_BUFFER), NULL, 0, &returnedSize, NULL) != TRUE)
+	{
+		return false;
+	}
+
+	FILE_ZERO_DATA_INFORMATION zeroData;
+	zeroData.FileOffset.QuadPart = offset;
+	zeroData.BeyondFinalZero.QuadPart = offset + size;
+	return DeviceIoControl(file, FSCTL_SET_ZERO_DATA, &zeroData,
+		sizeof(FILE_ZERO_DATA_INFORMATION), NULL, 0, &returnedSize, NULL) == TRUE;
+}
+int64_t getFileExtents(FileHandle file, int64_t offset, FileExtent* extents, uint32_t capacity)
+{
+	assert(offset >= 0);
+	assert(extents || capacity == 0);
+
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) != TRUE)
+		return -1;
+
+	uint32_t count = 0;
+	while (offset < fileSize.QuadPart && count < capacity)
+	{
+		FILE_ALLOCATED_RANGE_BUFFER queryRange, range;
+		queryRange.FileOffset.QuadPart = offset;
+		queryRange.Length.QuadPart = fileSize.QuadPart - offset;
+
+		DWORD returnedSize = 0;
+		BOOL result = DeviceIoControl(file, FSCTL_QUERY_ALLOCATED_RANGES, &queryRange,
+			sizeof(FILE_ALLOCATED_RANGE_BUFFER), &range, sizeof(FILE_ALLOCATED_RANGE_BUFFER), &returnedSize, NULL);
+		if (result != TRUE && GetLastError() != ERROR_MORE_DATA)
+			return count > 0 ? (int64_t)count : -1;
+
+		int64_t dataOffset = fileSize.QuadPart, dataSize = 0;
+		if (returnedSize >= sizeof(FILE_ALLOCATED_RANGE_BUFFER))
+		{
+			dataOffset = range.FileOffset.QuadPart < offset ? offset : range.FileOffset.QuadPart;
+			dataSize = range.FileOffset.QuadPart + range.Length.QuadPart - dataOffset;
+		}
+
+		if (dataOffset > offset)
+		{
+			FileExtent* extent = &extents[count++];
+			extent->offset = offset;
+			extent->size = dataOffset - offset;
+			extent->isHole = true;
+			offset = dataOffset;
+			if (dataSize == 0 || count >= capacity)
+				break;
+		}
+
+		FileExtent* extent = &extents[count++];
+		extent->offset = offset;
+		extent->size = dataSize;
+		extent->isHole = false;
+		offset += dataSize;
+	}
+	return (int64_t)count;
+}
+bool adviseFileAccess(FileHandle file, int64_t offset, int64_t size, FileAccessHint hint)
+{
+	assert(offset >= 0);
+	assert(size >= 0);
+	assert(hint < FILE_ACCESS_HINT_COUNT);
+	(void)file; (void)offset; (void)size; (void)hint;
+	return true; // Note: Windows sets access pattern only with the CreateFile flags.
+}
+
+//**********************************************************************************************************************
+void* mapFile(const char* filePath, MapFileAccess access, int64_t offset, size_t* size, bool prefault)
+{
+	assert(filePath);
+	assert(access < MAP_FILE_ACCESS_COUNT);
+	assert(offset >= 0);
+	assert(size);
+
+	DWORD fileAccess = GENERIC_READ, protection, mapAccess;
+	if (access == READ_WRITE_MAP_FILE_ACCESS)
+	{
+		fileAccess |= GENERIC_WRITE;
+		protection = PAGE_READWRITE; mapAccess = FILE_MAP_WRITE;
+	}
+	else if (access == COPY_ON_WRITE_MAP_FILE_ACCESS)
+	{
+		protection = PAGE_WRITECOPY; mapAccess = FILE_MAP_COPY;
+	}
+	else
+	{
+		protection = PAGE_READONLY; mapAccess = FILE_MAP_READ;
+	}
+
+	HANDLE file = CreateFileA(filePath, fileAccess, FILE_SHARE_READ | FILE_SHARE_WRITE,
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) != TRUE || offset >= fileSize.QuadPart)
+	{
+		CloseHandle(file);
+		return NULL;
+	}
+
+	size_t mapSize = *size;
+	if (mapSize == 0)
+		mapSize = (size_t)(fileSize.QuadPart - offset);
+	else if ((int64_t)mapSize > fileSize.QuadPart - offset)
+	{
+		CloseHandle(file);
+		return NULL;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, protection, 0, 0, NULL);
+	CloseHandle(file);
+	if (!mapping)
+		return NULL;
+
+	SYSTEM_INFO systemInfo; GetSystemInfo(&systemInfo);
+	int64_t granularity = (int64_t)systemInfo.dwAllocationGranularity;
+	int64_t alignedOffset = offset - offset % granularity;
+	size_t alignment = (size_t)(offset - alignedOffset);
+
+	void* view = MapViewOfFile(mapping, mapAccess, (DWORD)(alignedOffset >> 32),
+		(DWORD)(alignedOffset & 0xFFFFFFFF), mapSize + alignment);
+	CloseHandle(mapping); // Note: View keeps a reference to the mapping.
+
+	if (!view)
+		return NULL;
+
+	if (prefault)
+	{
+		WIN32_MEMORY_RANGE_ENTRY range;
+		range.VirtualAddress = view;
+		range.NumberOfBytes = mapSize + alignment;
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+
+	*size = mapSize;
+	return (uint8_t*)view + alignment;
+}
+bool unmapFile(void* data, size_t size)
+{
+	assert(data);
+	assert(size > 0);
+
+	SYSTEM_INFO systemInfo; GetSystemInfo(&systemInfo);
+	size_t alignment = (size_t)data % systemInfo.dwAllocationGranularity;
+	return UnmapViewOfFile((uint8_t*)data - alignment) == TRUE;
+}
+bool flushMappedFile(void* data, size_t size)
+{
+	assert(data);
+	assert(size > 0);
+	return FlushViewOfFile(data, size) == TRUE;
+}
+#else
+#error Unknown operating system
+#endif
+
+#if !__linux__
+//**********************************************************************************************************************
+int64_t readFileVectorAt(FileHandle file, const FileBuffer* buffers, uint32_t count, int64_t offset)
+{
+	assert(buffers || count == 0);
+	assert(offset >= 0);
+
+	int64_t readSize = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		int64_t result = readFileAt(file, buffers[i].data, buffers[i].size, offset + readSize);
+		if (result < 0)
+			return readSize > 0 ? readSize : -1;
+		readSize += result;
+		if ((size_t)result < buffers[i].size)
+			break;
+	}
+	return readSize;
+}
+int64_t writeFileVectorAt(FileHandle file, const FileBuffer* buffers, uint32_t count, int64_t offset)
+{
+	assert(buffers || count == 0);
+	assert(offset >= 0);
+
+	int64_t writeSize = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		int64_t result = writeFileAt(file, buffers[i].data, buffers[i].size, offset + writeSize);
+		if (result < 0)
+			return writeSize > 0 ? writeSize : -1;
+		writeSize += result;
+	}
+	return writeSize;
+}
+#endif
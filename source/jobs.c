@@ -0,0 +1,706 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/jobs.h"
+#include "mpio/thread.h"
+#include "atomic.h"
+#include "sync.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if __linux__ || __APPLE__
+#include <sched.h>
+#elif _WIN32
+#include <windows.h>
+#else
+#error Unknown operating system
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define pauseCpu() YieldProcessor()
+#else
+#if __x86_64__ || __i386__
+#define pauseCpu() __builtin_ia32_pause()
+#elif __aarch64__ || __arm__
+#define pauseCpu() __asm__ __volatile__("yield")
+#else
+#define pauseCpu()
+#endif
+#endif
+
+#define JOB_DEQUE_CAPACITY 4096 // Note: Should be power of two.
+#define JOB_SPIN_COUNT 256
+#define JOB_CACHE_LINE_SIZE 64
+
+typedef struct Job
+{
+	JobFunction function;
+	void* argument;
+	JobCounter counter;
+} Job;
+
+typedef struct DependentJob
+{
+	Job job;
+	struct DependentJob* next;
+} DependentJob;
+
+struct JobCounter_T
+{
+	volatile int32_t value;
+	volatile int32_t lock;
+	DependentJob* dependents;
+};
+
+// Note: Deque top and bottom are placed on separate cache lines to prevent false sharing.
+typedef struct JobWorker
+{
+	volatile int64_t top;
+	uint8_t _topPadding[JOB_CACHE_LINE_SIZE - sizeof(int64_t)];
+	volatile int64_t bottom;
+	uint8_t _bottomPadding[JOB_CACHE_LINE_SIZE - sizeof(int64_t)];
+	Job jobs[JOB_DEQUE_CAPACITY];
+	JobSystem jobSystem;
+	Thread thread;
+} JobWorker;
+
+struct JobSystem_T
+{
+	JobWorker** workers;
+	Job* injectedJobs;
+	uint32_t injectedHead;
+	uint32_t injectedCount;
+	uint32_t injectedCapacity;
+	uint32_t workerCount;
+	volatile int32_t injectedJobCount;
+	volatile int32_t sleepingCount;
+	volatile int32_t isRunning;
+	Mutex injectionMutex;
+	Mutex sleepMutex;
+	Cond workCond;
+};
+
+static THREAD_LOCAL JobWorker* currentWorker = NULL;
+static THREAD_LOCAL uint32_t randomState = 0;
+
+inline static uint32_t nextRandom()
+{
+	uint32_t state = randomState;
+	if (state == 0)
+		state = (uint32_t)(size_t)&randomState | 1u;
+	state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+	randomState = state;
+	return state;
+}
+inline static void yieldCpu()
+{
+#if __linux__ || __APPLE__
+	sched_yield();
+#elif _WIN32
+	SwitchToThread();
+#endif
+}
+
+//**********************************************************************************************************************
+static bool pushWorkerJob(JobWorker* worker, const Job* job)
+{
+	int64_t bottom = worker->bottom, top = atomicLoad64(&worker->top);
+	if (bottom - top >= JOB_DEQUE_CAPACITY)
+		return false;
+	worker->jobs[bottom & (JOB_DEQUE_CAPACITY - 1)] = *job;
+	atomicStore64(&worker->bottom, bottom + 1);
+	return true;
+}
+static bool popWorkerJob(JobWorker* worker, Job* job)
+{
+	int64_t bottom = worker->bottom;
+	if (bottom <= atomicLoad64(&worker->top))
+		return false;
+
+	bottom--;
+	atomicStore64(&worker->bottom, bottom);
+	atomicFence();
+	int64_t top = atomicLoad64(&worker->top);
+
+	if (top > bottom)
+	{
+		atomicStore64(&worker->bottom, bottom + 1);
+		return false;
+	}
+
+	*job = worker->jobs[bottom & (JOB_DEQUE_CAPACITY - 1)];
+	if (top != bottom)
+		return true;
+
+	// Note: Last job in the deque, racing with the thieves for it.
+	bool result = atomicCompareExchange64(&worker->top, &top, top + 1);
+	atomicStore64(&worker->bottom, bottom + 1);
+	return result;
+}
+static bool stealWorkerJob(JobWorker* worker, Job* job)
+{
+	int64_t top = atomicLoad64(&worker->top);
+	atomicFence();
+	int64_t bottom = atomicLoad64(&worker->bottom);
+	if (top >= bottom)
+		return false;
+
+	// Note: Copied job is discarded if another thread took it first.
+	*job = worker->jobs[top & (JOB_DEQUE_CAPACITY - 1)];
+	return atomicCompareExchange64(&worker->top, &top, top + 1);
+}
+
+static bool pushInjectedJobs(JobSystem jobSystem, const Job* jobs, uint32_t count)
+{
+	lockMutex(&jobSystem->injectionMutex);
+	uint32_t injectedCount = jobSystem->injectedCount;
+	if (injectedCount + count > jobSystem->injectedCapacity)
+	{
+		uint32_t capacity = jobSystem->injectedCapacity > 0 ? jobSystem->injectedCapacity * 2 : 64;
+		while (capacity < injectedCount + count)
+			capacity *= 2;
+
+		Job* injectedJobs = malloc(capacity * sizeof(Job));
+		if (!injectedJobs)
+		{
+			unlockMutex(&jobSystem->injectionMutex);
+			return false;
+		}
+
+		for (uint32_t i = 0; i < injectedCount; i++)
+		{
+			injectedJobs[i] = jobSystem->injectedJobs[
+				(jobSystem->injectedHead + i) % jobSystem->injectedCapacity];
+		}
+
+		free(jobSystem->injectedJobs);
+		jobSystem->injectedJobs = injectedJobs;
+		jobSystem->injectedCapacity = capacity;
+		jobSystem->injectedHead = 0;
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		jobSystem->injectedJobs[(jobSystem->injectedHead + injectedCount + i) %
+			jobSystem->injectedCapacity] = jobs[i];
+	}
+	jobSystem->injectedCount = injectedCount + count;
+	atomicStore32(&jobSystem->injectedJobCount, (int32_t)jobSystem->injectedCount);
+	unlockMutex(&jobSystem->injectionMutex);
+	return true;
+}
+static bool popInjectedJob(JobSystem jobSystem, Job* job)
+{
+	if (atomicLoad32(&jobSystem->injectedJobCount) == 0)
+		return false;
+
+	lockMutex(&jobSystem->injectionMutex);
+	if (jobSystem->injectedCount == 0)
+	{
+		unlockMutex(&jobSystem->injectionMutex);
+		return false;
+	}
+
+	*job = jobSystem->injectedJobs[jobSystem->injectedHead];
+	jobSystem->injectedHead = (jobSystem->injectedHead + 1) % jobSystem->injectedCapacity;
+	jobSystem->injectedCount--;
+	atomicStore32(&jobSystem->injectedJobCount, (int32_t)jobSystem->injectedCount);
+	unlockMutex(&jobSystem->injectionMutex);
+	return true;
+}
+
+static bool hasPendingJobs(JobSystem jobSystem)
+{
+	if (atomicLoad32(&jobSystem->injectedJobCount) > 0)
+		return true;
+	for (uint32_t i = 0; i < jobSystem->workerCount; i++)
+	{
+		JobWorker* worker = jobSystem->workers[i];
+		if (atomicLoad64(&worker->bottom) > atomicLoad64(&worker->top))
+			return true;
+	}
+	return false;
+}
+static void wakeWorkers(JobSystem jobSystem, uint32_t jobCount)
+{
+	// Note: Pairs with the sleeping worker counter increment, so that a pushed job is never missed.
+	atomicFence();
+	if (atomicLoad32(&jobSystem->sleepingCount) == 0)
+		return;
+
+	lockMutex(&jobSystem->sleepMutex);
+	if (jobCount == 1)
+		signalCond(&jobSystem->workCond);
+	else
+		broadcastCond(&jobSystem->workCond);
+	unlockMutex(&jobSystem->sleepMutex);
+}
+
+//**********************************************************************************************************************
+static void lockJobCounter(JobCounter jobCounter)
+{
+	int32_t expected = 0;
+	while (!atomicCompareExchange32(&jobCounter->lock, &expected, 1))
+	{
+		expected = 0;
+		pauseCpu();
+	}
+}
+inline static void unlockJobCounter(JobCounter jobCounter)
+{
+	atomicStore32(&jobCounter->lock, 0);
+}
+
+static void executeJob(JobSystem jobSystem, const Job* job);
+
+static void scheduleJobs(JobSystem jobSystem, const Job* jobs, uint32_t count)
+{
+	JobWorker* worker = currentWorker;
+	if (worker && worker->jobSystem == jobSystem)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (!pushWorkerJob(worker, &jobs[i]))
+				executeJob(jobSystem, &jobs[i]); // Note: Deque is full, executing the job in place.
+		}
+	}
+	else if (!pushInjectedJobs(jobSystem, jobs, count))
+	{
+		for (uint32_t i = 0; i < count; i++)
+			executeJob(jobSystem, &jobs[i]);
+		return;
+	}
+	wakeWorkers(jobSystem, count);
+}
+
+// Note: Counter is decremented under the lock, so the waiting thread can safely destroy it after the zero.
+static void completeJobCounter(JobSystem jobSystem, JobCounter jobCounter)
+{
+	DependentJob* dependents = NULL;
+	lockJobCounter(jobCounter);
+	if (atomicFetchAdd32(&jobCounter->value, -1) == 1)
+	{
+		dependents = jobCounter->dependents;
+		jobCounter->dependents = NULL;
+	}
+	unlockJobCounter(jobCounter);
+
+	while (dependents)
+	{
+		DependentJob* next = dependents->next;
+		scheduleJobs(jobSystem, &dependents->job, 1);
+		free(dependents);
+		dependents = next;
+	}
+}
+static void executeJob(JobSystem jobSystem, const Job* job)
+{
+	job->function(job->argument);
+	if (job->counter)
+		completeJobCounter(jobSystem, job->counter);
+}
+
+static bool tryExecuteJob(JobSystem jobSystem)
+{
+	Job job;
+	JobWorker* worker = currentWorker;
+	if (worker && worker->jobSystem != jobSystem)
+		worker = NULL;
+
+	if ((worker && popWorkerJob(worker, &job)) || popInjectedJob(jobSystem, &job))
+	{
+		executeJob(jobSystem, &job);
+		return true;
+	}
+
+	uint32_t workerCount = jobSystem->workerCount, offset = nextRandom();
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		JobWorker* victim = jobSystem->workers[(offset + i) % workerCount];
+		if (victim != worker && stealWorkerJob(victim, &job))
+		{
+			executeJob(jobSystem, &job);
+			return true;
+		}
+	}
+	return false;
+}
+
+static void jobWorkerFunction(void* argument)
+{
+	JobWorker* worker = (JobWorker*)argument;
+	JobSystem jobSystem = worker->jobSystem;
+	currentWorker = worker;
+
+	uint32_t spinCount = 0;
+	while (true)
+	{
+		if (tryExecuteJob(jobSystem))
+		{
+			spinCount = 0;
+			continue;
+		}
+		if (++spinCount < JOB_SPIN_COUNT)
+		{
+			pauseCpu();
+			continue;
+		}
+		spinCount = 0;
+
+		lockMutex(&jobSystem->sleepMutex);
+		atomicFetchAdd32(&jobSystem->sleepingCount, 1);
+		while (atomicLoad32(&jobSystem->isRunning) && !hasPendingJobs(jobSystem))
+			waitCond(&jobSystem->workCond, &jobSystem->sleepMutex);
+		atomicFetchAdd32(&jobSystem->sleepingCount, -1);
+		bool isRunning = atomicLoad32(&jobSystem->isRunning);
+		unlockMutex(&jobSystem->sleepMutex);
+
+		if (!isRunning && !hasPendingJobs(jobSystem))
+			break;
+	}
+	currentWorker = NULL;
+}
+
+//**********************************************************************************************************************
+static uint32_t getPerformanceCoreCpus(int* cpus)
+{
+	CpuSet performanceCpus, allowedCpus;
+	getHybridCpuSets(&performanceCpus, NULL);
+
+	// Note: Skipping CPUs outside of the process affinity mask. (taskset, container cpuset)
+	if (getThreadAffinity(NULL, &allowedCpus) && getCpuSetCount(&allowedCpus) > 0)
+	{
+		for (int i = 0; i < MAX_CPU_SET_COUNT / 64; i++)
+			performanceCpus.bits[i] &= allowedCpus.bits[i];
+		if (getCpuSetCount(&performanceCpus) == 0)
+			performanceCpus = allowedCpus;
+	}
+
+	uint32_t count = 0;
+	CpuTopology* cpuTopology = createCpuTopology();
+	if (cpuTopology)
+	{
+		// Note: Taking one logical CPU of each core, so that workers do not share SMT siblings.
+		for (int i = 0; i < cpuTopology->coreCount; i++)
+		{
+			for (int cpu = 0; cpu < MAX_CPU_SET_COUNT; cpu++)
+			{
+				if (isCpuInSet(&cpuTopology->cores[i], cpu) && isCpuInSet(&performanceCpus, cpu))
+				{
+					cpus[count++] = cpu;
+					break;
+				}
+			}
+		}
+		destroyCpuTopology(cpuTopology);
+	}
+
+	if (count == 0)
+	{
+		for (int cpu = 0; cpu < MAX_CPU_SET_COUNT; cpu++)
+		{
+			if (isCpuInSet(&performanceCpus, cpu))
+				cpus[count++] = cpu;
+		}
+	}
+	return count;
+}
+
+JobSystem createJobSystem(uint32_t workerCount, bool pinWorkers)
+{
+	if (workerCount == 0)
+	{
+		int cpuCount = getPerformanceCpuCount(), effectiveCpuCount = getEffectiveCpuCount();
+		if (effectiveCpuCount < cpuCount)
+			cpuCount = effectiveCpuCount;
+		workerCount = cpuCount > 1 ? (uint32_t)cpuCount - 1 : 1;
+	}
+
+	JobSystem jobSystem = calloc(1, sizeof(JobSystem_T));
+	if (!jobSystem)
+		return NULL;
+
+	JobWorker** workers = calloc(workerCount, sizeof(JobWorker*));
+	if (!workers)
+	{
+		free(jobSystem);
+		return NULL;
+	}
+	jobSystem->workers = workers;
+
+	if (!initMutex(&jobSystem->injectionMutex))
+	{
+		free(workers); free(jobSystem);
+		return NULL;
+	}
+	if (!initMutex(&jobSystem->sleepMutex))
+	{
+		destroyMutex(&jobSystem->injectionMutex);
+		free(workers); free(jobSystem);
+		return NULL;
+	}
+	if (!initCond(&jobSystem->workCond))
+	{
+		destroyMutex(&jobSystem->sleepMutex);
+		destroyMutex(&jobSystem->injectionMutex);
+		free(workers); free(jobSystem);
+		return NULL;
+	}
+
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		JobWorker* worker = calloc(1, sizeof(JobWorker));
+		if (!worker)
+		{
+			destroyJobSystem(jobSystem);
+			return NULL;
+		}
+		worker->jobSystem = jobSystem;
+		workers[i] = worker;
+		jobSystem->workerCount = i + 1;
+	}
+
+	int* cpus = NULL; uint32_t cpuCount = 0;
+	if (pinWorkers)
+	{
+		cpus = malloc(MAX_CPU_SET_COUNT * sizeof(int));
+		if (cpus)
+			cpuCount = getPerformanceCoreCpus(cpus);
+	}
+
+	jobSystem->isRunning = 1;
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "mpio-job-%u", i);
+
+		JobWorker* worker = workers[i];
+		worker->thread = createThread(jobWorkerFunction, worker, 0, name);
+		if (!worker->thread)
+		{
+			free(cpus);
+			destroyJobSystem(jobSystem);
+			return NULL;
+		}
+
+		if (cpuCount > 0)
+		{
+			CpuSet cpuSet; clearCpuSet(&cpuSet);
+			addCpuToSet(&cpuSet, cpus[i % cpuCount]);
+			setThreadAffinity(worker->thread, &cpuSet);
+		}
+	}
+
+	free(cpus);
+	return jobSystem;
+}
+void destroyJobSystem(JobSystem jobSystem)
+{
+	if (!jobSystem)
+		return;
+
+	lockMutex(&jobSystem->sleepMutex);
+	atomicStore32(&jobSystem->isRunning, 0);
+	broadcastCond(&jobSystem->workCond);
+	unlockMutex(&jobSystem->sleepMutex);
+
+	JobWorker** workers = jobSystem->workers;
+	for (uint32_t i = 0; i < jobSystem->workerCount; i++)
+		destroyThread(workers[i]->thread);
+	for (uint32_t i = 0; i < jobSystem->workerCount; i++)
+		free(workers[i]);
+
+	destroyCond(&jobSystem->workCond);
+	destroyMutex(&jobSystem->sleepMutex);
+	destroyMutex(&jobSystem->injectionMutex);
+	free(jobSystem->injectedJobs);
+	free(workers);
+	free(jobSystem);
+}
+
+uint32_t getJobSystemWorkerCount(JobSystem jobSystem)
+{
+	assert(jobSystem);
+	return jobSystem->workerCount;
+}
+
+//**********************************************************************************************************************
+JobCounter createJobCounter()
+{
+	return calloc(1, sizeof(JobCounter_T));
+}
+void destroyJobCounter(JobCounter jobCounter)
+{
+	if (!jobCounter)
+		return;
+	assert(atomicLoad32(&jobCounter->value) == 0);
+	free(jobCounter);
+}
+int32_t getJobCounterValue(JobCounter jobCounter)
+{
+	assert(jobCounter);
+	return atomicLoad32(&jobCounter->value);
+}
+
+bool runJob(JobSystem jobSystem, JobFunction function, void* argument, JobCounter jobCounter, JobCounter dependency)
+{
+	assert(jobSystem);
+	assert(function);
+
+	if (jobCounter)
+		atomicFetchAdd32(&jobCounter->value, 1);
+
+	Job job;
+	job.function = function;
+	job.argument = argument;
+	job.counter = jobCounter;
+
+	if (dependency)
+	{
+		lockJobCounter(dependency);
+		if (atomicLoad32(&dependency->value) > 0)
+		{
+			DependentJob* dependentJob = malloc(sizeof(DependentJob));
+			if (!dependentJob)
+			{
+				unlockJobCounter(dependency);
+				if (jobCounter)
+					atomicFetchAdd32(&jobCounter->value, -1);
+				return false;
+			}
+
+			dependentJob->job = job;
+			dependentJob->next = dependency->dependents;
+			dependency->dependents = dependentJob;
+			unlockJobCounter(dependency);
+			return true;
+		}
+		unlockJobCounter(dependency);
+	}
+
+	scheduleJobs(jobSystem, &job, 1);
+	return true;
+}
+
+void waitJobCounter(JobSystem jobSystem, JobCounter jobCounter)
+{
+	assert(jobSystem);
+	assert(jobCounter);
+
+	uint32_t spinCount = 0;
+	while (atomicLoad32(&jobCounter->value) > 0)
+	{
+		if (tryExecuteJob(jobSystem))
+		{
+			spinCount = 0;
+			continue;
+		}
+		if (++spinCount < JOB_SPIN_COUNT)
+		{
+			pauseCpu();
+			continue;
+		}
+		spinCount = 0;
+		yieldCpu();
+	}
+
+	// Note: Waiting for the last completing thread to release the counter.
+	lockJobCounter(jobCounter);
+	unlockJobCounter(jobCounter);
+}
+
+//**********************************************************************************************************************
+typedef struct ParallelForState
+{
+	ParallelForFunction function;
+	void* argument;
+	volatile int64_t next;
+	uint32_t count;
+	uint32_t minChunkSize;
+	uint32_t participantCount;
+} ParallelForState;
+
+static void parallelForJob(void* argument)
+{
+	ParallelForState* state = (ParallelForState*)argument;
+	int64_t count = state->count, begin = atomicLoad64(&state->next);
+
+	while (begin < count)
+	{
+		// Note: Guided chunking, taking a part of the remaining range.
+		int64_t remaining = count - begin;
+		int64_t chunkSize = remaining / ((int64_t)state->participantCount * 2);
+		if (chunkSize < state->minChunkSize)
+			chunkSize = state->minChunkSize;
+		if (chunkSize > remaining)
+			chunkSize = remaining;
+
+		if (!atomicCompareExchange64(&state->next, &begin, begin + chunkSize))
+			continue;
+
+		state->function(state->argument, (uint32_t)begin, (uint32_t)(begin + chunkSize));
+		begin = atomicLoad64(&state->next);
+	}
+}
+
+void parallelFor(JobSystem jobSystem, ParallelForFunction function,
+	void* argument, uint32_t count, uint32_t minChunkSize)
+{
+	assert(jobSystem);
+	assert(function);
+
+	if (count == 0)
+		return;
+	if (minChunkSize == 0)
+		minChunkSize = 1;
+
+	uint32_t chunkCount = (count + minChunkSize - 1) / minChunkSize;
+	uint32_t helperCount = chunkCount - 1 < jobSystem->workerCount ? chunkCount - 1 : jobSystem->workerCount;
+	if (helperCount == 0)
+	{
+		function(argument, 0, count);
+		return;
+	}
+
+	ParallelForState state;
+	state.function = function;
+	state.argument = argument;
+	state.next = 0;
+	state.count = count;
+	state.minChunkSize = minChunkSize;
+	state.participantCount = helperCount + 1;
+
+	JobCounter_T jobCounter;
+	memset(&jobCounter, 0, sizeof(JobCounter_T));
+	jobCounter.value = (int32_t)helperCount;
+
+	Job jobs[64];
+	for (uint32_t i = 0; i < helperCount; i += 64)
+	{
+		uint32_t batchSize = helperCount - i < 64 ? helperCount - i : 64;
+		for (uint32_t j = 0; j < batchSize; j++)
+		{
+			jobs[j].function = parallelForJob;
+			jobs[j].argument = &state;
+			jobs[j].counter = &jobCounter;
+		}
+		scheduleJobs(jobSystem, jobs, batchSize);
+	}
+
+	parallelForJob(&state);
+	waitJobCounter(jobSystem, &jobCounter);
+}
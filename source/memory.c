@@ -0,0 +1,851 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/memory.h"
+#include "mpio/thread.h"
+#include "atomic.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#elif __APPLE__
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/sysctl.h>
+#include <dispatch/dispatch.h>
+#elif _WIN32
+#include <windows.h>
+#else
+#error Unknown operating system
+#endif
+
+#if __linux__
+#define CGROUP_ROOT_PATH "/sys/fs/cgroup"
+#define MEMORY_EVENTS_ID 8
+#define STOP_EVENT_ID 9
+#define MAX_EPOLL_EVENT_COUNT 8
+
+// Note: Unprivileged PSI triggers require a 2 second window. Stall time thresholds are in microseconds.
+static const char* const psiTriggers[CRITICAL_MEMORY_PRESSURE] =
+{
+	"some 140000 2000000", // Note: Some tasks stall on memory for 7% of the time.
+	"some 200000 2000000", // Note: Some tasks stall on memory for 10% of the time.
+	"full 140000 2000000", // Note: All tasks stall on memory for 7% of the time.
+};
+#endif
+
+struct MemoryMonitor_T
+{
+	MemoryPressureFunction onPressure;
+	void* argument;
+#if __linux__
+	Thread thread;
+	int epollFd;
+	int stopFd;
+	int eventsFd;
+	int triggerFds[CRITICAL_MEMORY_PRESSURE];
+	int64_t eventCounts[4];
+#elif __APPLE__
+	dispatch_source_t source;
+	dispatch_semaphore_t cancelSemaphore;
+#elif _WIN32
+	Thread thread;
+	HANDLE notification;
+	HANDLE stopEvent;
+#endif
+};
+
+#if __linux__
+//**********************************************************************************************************************
+static bool getCgroupDirectory(char* directory, size_t directorySize)
+{
+	if (access(CGROUP_ROOT_PATH "/cgroup.controllers", F_OK) != 0)
+		return false; // Note: Legacy cgroup v1 hierarchy has no PSI and memory.events files.
+
+	FILE* file = fopen("/proc/self/cgroup", "r");
+	if (!file)
+		return false;
+
+	char line[1024]; bool isFound = false;
+	while (fgets(line, sizeof(line), file))
+	{
+		if (memcmp(line, "0::", 3) != 0)
+			continue;
+		line[strcspn(line, "\n")] = '\0';
+		int length = snprintf(directory, directorySize, CGROUP_ROOT_PATH "%s", line + 3);
+		isFound = length > 0 && (size_t)length < directorySize;
+		if (isFound && directory[length - 1] == '/')
+			directory[length - 1] = '\0';
+		break;
+	}
+
+	fclose(file);
+	return isFound;
+}
+
+static int openPsiTrigger(const char* filePath, const char* trigger)
+{
+	int fd = open(filePath, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+	if (fd == -1)
+		return -1;
+	if (write(fd, trigger, strlen(trigger) + 1) < 0)
+	{
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+static bool addEpollFd(int epollFd, int fd, uint32_t events, uint32_t id)
+{
+	struct epoll_event event;
+	memset(&event, 0, sizeof(struct epoll_event));
+	event.events = events;
+	event.data.u32 = id;
+	return epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+static void readMemoryEvents(int fd, int64_t* eventCounts)
+{
+	char buffer[512];
+	ssize_t result = pread(fd, buffer, sizeof(buffer) - 1, 0);
+	if (result <= 0)
+		return;
+	buffer[result] = '\0';
+
+	// Note: memory.events format is "low N\nhigh N\nmax N\noom N\noom_kill N\n..."
+	static const char* const keys[4] = { "low ", "high ", "max ", "oom_kill " };
+	for (int i = 0; i < 4; i++)
+	{
+		const char* line = buffer;
+		while (line)
+		{
+			size_t keyLength = strlen(keys[i]);
+			if (memcmp(line, keys[i], keyLength) == 0)
+			{
+				eventCounts[i] = atoll(line + keyLength);
+				break;
+			}
+			line = strchr(line, '\n');
+			if (line)
+				line++;
+		}
+	}
+}
+static MemoryPressure processEpollEvents(MemoryMonitor memoryMonitor,
+	const struct epoll_event* events, int count, bool* isStopped)
+{
+	MemoryPressure pressure = NO_MEMORY_PRESSURE;
+	for (int i = 0; i < count; i++)
+	{
+		uint32_t id = events[i].data.u32;
+		if (id == STOP_EVENT_ID)
+		{
+			*isStopped = true;
+		}
+		else if (id == MEMORY_EVENTS_ID)
+		{
+			int64_t eventCounts[4];
+			memcpy(eventCounts, memoryMonitor->eventCounts, sizeof(eventCounts));
+			readMemoryEvents(memoryMonitor->eventsFd, memoryMonitor->eventCounts);
+
+			// Note: low -> LOW, high -> MEDIUM, max and oom_kill -> CRITICAL.
+			static const MemoryPressure levels[4] = { LOW_MEMORY_PRESSURE,
+				MEDIUM_MEMORY_PRESSURE, CRITICAL_MEMORY_PRESSURE, CRITICAL_MEMORY_PRESSURE };
+			for (int j = 0; j < 4; j++)
+			{
+				if (memoryMonitor->eventCounts[j] > eventCounts[j] && levels[j] > pressure)
+					pressure = levels[j];
+			}
+		}
+		else if (events[i].events & EPOLLERR)
+		{
+			// Note: PSI trigger is destroyed when its cgroup is removed.
+			int* fd = &memoryMonitor->triggerFds[id - 1];
+			epoll_ctl(memoryMonitor->epollFd, EPOLL_CTL_DEL, *fd, NULL);
+			close(*fd); *fd = -1;
+		}
+		else if (id > pressure)
+		{
+			pressure = (MemoryPressure)id;
+		}
+	}
+	return pressure;
+}
+static void memoryMonitorFunction(void* argument)
+{
+	MemoryMonitor memoryMonitor = (MemoryMonitor)argument;
+	struct epoll_event events[MAX_EPOLL_EVENT_COUNT];
+	bool isStopped = false;
+
+	while (!isStopped)
+	{
+		int count = epoll_wait(memoryMonitor->epollFd, events, MAX_EPOLL_EVENT_COUNT, -1);
+		if (count < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		MemoryPressure pressure = processEpollEvents(memoryMonitor, events, count, &isStopped);
+		if (pressure != NO_MEMORY_PRESSURE && !isStopped)
+			memoryMonitor->onPressure(pressure, memoryMonitor->argument);
+	}
+}
+#elif __APPLE__
+//**********************************************************************************************************************
+static void memoryPressureHandler(void* context)
+{
+	MemoryMonitor memoryMonitor = (MemoryMonitor)context;
+	uintptr_t data = dispatch_source_get_data(memoryMonitor->source);
+	MemoryPressure pressure = NO_MEMORY_PRESSURE;
+	if (data & DISPATCH_MEMORYPRESSURE_CRITICAL)
+		pressure = CRITICAL_MEMORY_PRESSURE;
+	else if (data & DISPATCH_MEMORYPRESSURE_WARN)
+		pressure = MEDIUM_MEMORY_PRESSURE;
+
+	if (pressure != NO_MEMORY_PRESSURE)
+		memoryMonitor->onPressure(pressure, memoryMonitor->argument);
+}
+static void memoryPressureCancelHandler(void* context)
+{
+	MemoryMonitor memoryMonitor = (MemoryMonitor)context;
+	dispatch_semaphore_signal(memoryMonitor->cancelSemaphore);
+}
+#elif _WIN32
+//**********************************************************************************************************************
+#define LOW_MEMORY_NOTIFY_DELAY 1000 // Note: In milliseconds.
+
+static void memoryMonitorFunction(void* argument)
+{
+	MemoryMonitor memoryMonitor = (MemoryMonitor)argument;
+	HANDLE handles[2] = { memoryMonitor->stopEvent, memoryMonitor->notification };
+
+	while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0 + 1)
+	{
+		memoryMonitor->onPressure(CRITICAL_MEMORY_PRESSURE, memoryMonitor->argument);
+
+		// Note: Notification stays signaled while memory is low, so limiting the event rate.
+		if (WaitForSingleObject(memoryMonitor->stopEvent, LOW_MEMORY_NOTIFY_DELAY) == WAIT_OBJECT_0)
+			break;
+	}
+}
+#endif
+
+//**********************************************************************************************************************
+MemoryMonitor createMemoryMonitor(MemoryPressureFunction onPressure, void* argument)
+{
+	MemoryMonitor memoryMonitor = calloc(1, sizeof(MemoryMonitor_T));
+	if (!memoryMonitor)
+		return NULL;
+
+	memoryMonitor->onPressure = onPressure;
+	memoryMonitor->argument = argument;
+
+#if __linux__
+	memoryMonitor->stopFd = memoryMonitor->eventsFd = -1;
+	for (int i = 0; i < CRITICAL_MEMORY_PRESSURE; i++)
+		memoryMonitor->triggerFds[i] = -1;
+
+	memoryMonitor->epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (memoryMonitor->epollFd == -1)
+	{
+		free(memoryMonitor);
+		return NULL;
+	}
+
+	// Note: Preferring cgroup files, so that the container memory limit pressure is also reported.
+	char directory[1024], path[1100];
+	bool isCgroup = getCgroupDirectory(directory, sizeof(directory));
+	if (isCgroup)
+		snprintf(path, sizeof(path), "%s/memory.pressure", directory);
+
+	bool isSupported = false;
+	for (int i = 0; i < CRITICAL_MEMORY_PRESSURE; i++)
+	{
+		int fd = isCgroup ? openPsiTrigger(path, psiTriggers[i]) : -1;
+		if (fd == -1)
+			fd = openPsiTrigger("/proc/pressure/memory", psiTriggers[i]);
+		if (fd == -1)
+			continue;
+
+		memoryMonitor->triggerFds[i] = fd;
+		if (!addEpollFd(memoryMonitor->epollFd, fd, EPOLLPRI, (uint32_t)i + 1))
+		{
+			destroyMemoryMonitor(memoryMonitor);
+			return NULL;
+		}
+		isSupported = true;
+	}
+
+	if (isCgroup)
+	{
+		snprintf(path, sizeof(path), "%s/memory.events", directory);
+		memoryMonitor->eventsFd = open(path, O_RDONLY | O_CLOEXEC);
+		if (memoryMonitor->eventsFd != -1)
+		{
+			readMemoryEvents(memoryMonitor->eventsFd, memoryMonitor->eventCounts);
+			if (!addEpollFd(memoryMonitor->epollFd, memoryMonitor->eventsFd, EPOLLPRI, MEMORY_EVENTS_ID))
+			{
+				destroyMemoryMonitor(memoryMonitor);
+				return NULL;
+			}
+			isSupported = true;
+		}
+	}
+
+	if (!isSupported)
+	{
+		destroyMemoryMonitor(memoryMonitor);
+		return NULL;
+	}
+
+	if (onPressure)
+	{
+		memoryMonitor->stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		if (memoryMonitor->stopFd == -1 || !addEpollFd(memoryMonitor->epollFd,
+			memoryMonitor->stopFd, EPOLLIN, STOP_EVENT_ID))
+		{
+			destroyMemoryMonitor(memoryMonitor);
+			return NULL;
+		}
+
+		memoryMonitor->thread = createThread(memoryMonitorFunction, memoryMonitor, 0, "mpio-memory");
+		if (!memoryMonitor->thread)
+		{
+			destroyMemoryMonitor(memoryMonitor);
+			return NULL;
+		}
+	}
+#elif __APPLE__
+	if (onPressure)
+	{
+		dispatch_source_t source = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+			DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+			dispatch_get_global_queue(QOS_CLASS_UTILITY, 0));
+		if (!source)
+		{
+			free(memoryMonitor);
+			return NULL;
+		}
+
+		dispatch_semaphore_t cancelSemaphore = dispatch_semaphore_create(0);
+		if (!cancelSemaphore)
+		{
+			dispatch_release(source);
+			free(memoryMonitor);
+			return NULL;
+		}
+
+		memoryMonitor->source = source;
+		memoryMonitor->cancelSemaphore = cancelSemaphore;
+		dispatch_set_context(source, memoryMonitor);
+		dispatch_source_set_event_handler_f(source, memoryPressureHandler);
+		dispatch_source_set_cancel_handler_f(source, memoryPressureCancelHandler);
+		dispatch_resume(source);
+	}
+#elif _WIN32
+	memoryMonitor->notification = CreateMemoryResourceNotification(LowMemoryResourceNotification);
+	if (!memoryMonitor->notification)
+	{
+		free(memoryMonitor);
+		return NULL;
+	}
+
+	if (onPressure)
+	{
+		memoryMonitor->stopEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+		if (!memoryMonitor->stopEvent)
+		{
+			destroyMemoryMonitor(memoryMonitor);
+			return NULL;
+		}
+
+		memoryMonitor->thread = createThread(memoryMonitorFunction, memoryMonitor, 0, "mpio-memory");
+		if (!memoryMonitor->thread)
+		{
+			destroyMemoryMonitor(memoryMonitor);
+			return NULL;
+		}
+	}
+#endif
+	return memoryMonitor;
+}
+void destroyMemoryMonitor(MemoryMonitor memoryMonitor)
+{
+	if (!memoryMonitor)
+		return;
+
+#if __linux__
+	if (memoryMonitor->thread)
+	{
+		uint64_t value = 1;
+		ssize_t result = write(memoryMonitor->stopFd, &value, sizeof(uint64_t));
+		(void)result;
+		destroyThread(memoryMonitor->thread);
+	}
+
+	for (int i = 0; i < CRITICAL_MEMORY_PRESSURE; i++)
+	{
+		if (memoryMonitor->triggerFds[i] != -1)
+			close(memoryMonitor->triggerFds[i]);
+	}
+	if (memoryMonitor->eventsFd != -1)
+		close(memoryMonitor->eventsFd);
+	if (memoryMonitor->stopFd != -1)
+		close(memoryMonitor->stopFd);
+	close(memoryMonitor->epollFd);
+#elif __APPLE__
+	if (memoryMonitor->source)
+	{
+		// Note: Cancel handler runs after the last event handler has returned, so the monitor can be freed.
+		dispatch_source_cancel(memoryMonitor->source);
+		dispatch_semaphore_wait(memoryMonitor->cancelSemaphore, DISPATCH_TIME_FOREVER);
+		dispatch_release(memoryMonitor->cancelSemaphore);
+		dispatch_release(memoryMonitor->source);
+	}
+#elif _WIN32
+	if (memoryMonitor->thread)
+	{
+		SetEvent(memoryMonitor->stopEvent);
+		destroyThread(memoryMonitor->thread);
+	}
+	if (memoryMonitor->stopEvent)
+		CloseHandle(memoryMonitor->stopEvent);
+	CloseHandle(memoryMonitor->notification);
+#endif
+	free(memoryMonitor);
+}
+
+int getMemoryMonitorFd(MemoryMonitor memoryMonitor)
+{
+	assert(memoryMonitor);
+#if __linux__
+	return memoryMonitor->epollFd;
+#else
+	return -1;
+#endif
+}
+MemoryPressure pollMemoryPressure(MemoryMonitor memoryMonitor)
+{
+	assert(memoryMonitor);
+	assert(!memoryMonitor->onPressure);
+
+#if __linux__
+	MemoryPressure pressure = NO_MEMORY_PRESSURE;
+	struct epoll_event events[MAX_EPOLL_EVENT_COUNT];
+	bool isStopped = false;
+
+	while (true)
+	{
+		int count = epoll_wait(memoryMonitor->epollFd, events, MAX_EPOLL_EVENT_COUNT, 0);
+		if (count <= 0)
+			break;
+		MemoryPressure eventPressure = processEpollEvents(memoryMonitor, events, count, &isStopped);
+		if (eventPressure > pressure)
+			pressure = eventPressure;
+	}
+	return pressure;
+#elif __APPLE__
+	int level = 0; size_t length = sizeof(int);
+	if (sysctlbyname("kern.memorystatus_vm_pressure_level", &level, &length, NULL, 0) != 0)
+		return NO_MEMORY_PRESSURE;
+	if (level >= 4)
+		return CRITICAL_MEMORY_PRESSURE;
+	return level >= 2 ? MEDIUM_MEMORY_PRESSURE : NO_MEMORY_PRESSURE;
+#elif _WIN32
+	BOOL isLowMemory = FALSE;
+	if (QueryMemoryResourceNotification(memoryMonitor->notification, &isLowMemory) == FALSE)
+		return NO_MEMORY_PRESSURE;
+	return isLowMemory ? CRITICAL_MEMORY_PRESSURE : NO_MEMORY_PRESSURE;
+#endif
+}
+
+//**********************************************************************************************************************
+size_t getPageSize()
+{
+#if __linux__ || __APPLE__
+	return (size_t)sysconf(_SC_PAGESIZE);
+#elif _WIN32
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	return systemInfo.dwPageSize;
+#endif
+}
+
+#if __linux__
+static volatile int64_t hugePageSize = -1;
+#endif
+
+size_t getHugePageSize()
+{
+#if __linux__
+	int64_t size = atomicLoad64(&hugePageSize);
+	if (size >= 0)
+		return (size_t)size;
+
+	size = 0;
+	FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+	if (file)
+	{
+		long long value;
+		if (fscanf(file, "%lld", &value) == 1 && value > 0)
+			size = value;
+		fclose(file);
+	}
+	atomicStore64(&hugePageSize, size);
+	return (size_t)size;
+#elif __APPLE__
+	return 0;
+#elif _WIN32
+	return GetLargePageMinimum();
+#endif
+}
+
+void* reserveMemory(size_t size)
+{
+	assert(size > 0);
+#if __linux__ || __APPLE__
+	void* memory = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	return memory != MAP_FAILED ? memory : NULL;
+#elif _WIN32
+	return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+#endif
+}
+bool releaseMemory(void* memory, size_t size)
+{
+	if (!memory)
+		return true;
+#if __linux__ || __APPLE__
+	return munmap(memory, size) == 0;
+#elif _WIN32
+	return VirtualFree(memory, 0, MEM_RELEASE) != FALSE;
+#endif
+}
+
+bool commitMemory(void* memory, size_t size)
+{
+	assert(memory);
+#if __linux__ || __APPLE__
+	return mprotect(memory, size, PROT_READ | PROT_WRITE) == 0;
+#elif _WIN32
+	return VirtualAlloc(memory, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#endif
+}
+bool decommitMemory(void* memory, size_t size)
+{
+	assert(memory);
+#if __linux__ || __APPLE__
+	// Note: Mapping over the range frees its pages and the commit charge, madvise() keeps the commit charge.
+	int flags = MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+	return mmap(memory, size, PROT_NONE, flags, -1, 0) != MAP_FAILED;
+#elif _WIN32
+	return VirtualFree(memory, size, MEM_DECOMMIT) != FALSE;
+#endif
+}
+
+bool guardMemory(void* memory, size_t size)
+{
+	assert(memory);
+#if __linux__ || __APPLE__
+	return mprotect(memory, size, PROT_NONE) == 0;
+#elif _WIN32
+	DWORD oldProtection;
+	return VirtualProtect(memory, size, PAGE_NOACCESS, &oldProtection) != FALSE;
+#endif
+}
+bool adviseHugePages(void* memory, size_t size)
+{
+	assert(memory);
+#if __linux__ && defined(MADV_HUGEPAGE)
+	return madvise(memory, size, MADV_HUGEPAGE) == 0;
+#else
+	return false; // Note: Windows large pages require a privilege and can not be enabled after the reservation.
+#endif
+}
+
+bool lockMemory(void* memory, size_t size)
+{
+	assert(memory);
+#if __linux__ || __APPLE__
+	return mlock(memory, size) == 0;
+#elif _WIN32
+	return VirtualLock(memory, size) != FALSE;
+#endif
+}
+bool unlockMemory(void* memory, size_t size)
+{
+	assert(memory);
+#if __linux__ || __APPLE__
+	return munlock(memory, size) == 0;
+#elif _WIN32
+	return VirtualUnlock(memory, size) != FALSE;
+#endif
+}
+
+//**********************************************************************************************************************
+#define MEMORY_COMMIT_STEP 65536
+#define MEMORY_HEADER_ALIGNMENT 64
+#define MEMORY_POOL_ALIGNMENT 16
+
+inline static size_t alignMemorySize(size_t size, size_t alignment)
+{
+	return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// Note: Commits the next step, so the allocations do not call into the kernel each time.
+static bool growCommittedMemory(uint8_t* memory, size_t* committedSize,
+	size_t requiredSize, size_t reservedSize, size_t commitStep)
+{
+	size_t newSize = alignMemorySize(requiredSize, commitStep);
+	if (newSize > reservedSize)
+		newSize = reservedSize;
+	if (!commitMemory(memory + *committedSize, newSize - *committedSize))
+		return false;
+	*committedSize = newSize;
+	return true;
+}
+
+// Note: Arena header is stored in its first page, so there is no malloc() call at all.
+struct MemoryArena_T
+{
+	uint8_t* memory;
+	void* reservation;
+	size_t reservationSize;
+	size_t reservedSize;
+	size_t committedSize;
+	size_t commitStep;
+	size_t offset;
+};
+
+#define MEMORY_ARENA_HEADER_SIZE \
+	((sizeof(MemoryArena_T) + MEMORY_HEADER_ALIGNMENT - 1) & ~(size_t)(MEMORY_HEADER_ALIGNMENT - 1))
+
+MemoryArena createMemoryArena(size_t maxSize, bool useHugePages)
+{
+	assert(maxSize > 0);
+	size_t pageSize = getPageSize(), commitStep = MEMORY_COMMIT_STEP > pageSize ? MEMORY_COMMIT_STEP : pageSize;
+	size_t alignment = pageSize;
+
+	if (useHugePages)
+	{
+		size_t hugePageSize = getHugePageSize();
+		if (hugePageSize > pageSize)
+			alignment = commitStep = hugePageSize;
+	}
+
+	size_t reservedSize = alignMemorySize(MEMORY_ARENA_HEADER_SIZE + maxSize, alignment);
+	if (reservedSize < maxSize)
+		return NULL;
+	size_t reservationSize = reservedSize + (alignment > pageSize ? alignment : 0);
+	void* reservation = reserveMemory(reservationSize);
+	if (!reservation)
+		return NULL;
+
+	uint8_t* memory = (uint8_t*)alignMemorySize((size_t)reservation, alignment);
+	if (useHugePages)
+		adviseHugePages(memory, reservedSize);
+
+	size_t committedSize = commitStep < reservedSize ? commitStep : reservedSize;
+	if (!commitMemory(memory, committedSize))
+	{
+		releaseMemory(reservation, reservationSize);
+		return NULL;
+	}
+
+	MemoryArena memoryArena = (MemoryArena)memory;
+	memoryArena->memory = memory;
+	memoryArena->reservation = reservation;
+	memoryArena->reservationSize = reservationSize;
+	memoryArena->reservedSize = reservedSize;
+	memoryArena->committedSize = committedSize;
+	memoryArena->commitStep = commitStep;
+	memoryArena->offset = MEMORY_ARENA_HEADER_SIZE;
+	return memoryArena;
+}
+void destroyMemoryArena(MemoryArena memoryArena)
+{
+	if (memoryArena)
+		releaseMemory(memoryArena->reservation, memoryArena->reservationSize);
+}
+
+void* allocateArenaMemory(MemoryArena memoryArena, size_t size, size_t alignment)
+{
+	assert(memoryArena);
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	uint8_t* memory = memoryArena->memory;
+	size_t offset = alignMemorySize((size_t)memory + memoryArena->offset, alignment) - (size_t)memory;
+	if (offset > memoryArena->reservedSize || size > memoryArena->reservedSize - offset)
+		return NULL;
+
+	size_t newOffset = offset + size;
+	if (newOffset > memoryArena->committedSize && !growCommittedMemory(memory,
+		&memoryArena->committedSize, newOffset, memoryArena->reservedSize, memoryArena->commitStep))
+	{
+		return NULL;
+	}
+
+	memoryArena->offset = newOffset;
+	return memory + offset;
+}
+
+size_t getMemoryArenaSize(MemoryArena memoryArena)
+{
+	assert(memoryArena);
+	return memoryArena->offset - MEMORY_ARENA_HEADER_SIZE;
+}
+size_t getMemoryArenaCommittedSize(MemoryArena memoryArena)
+{
+	assert(memoryArena);
+	return memoryArena->committedSize;
+}
+
+void rewindMemoryArena(MemoryArena memoryArena, size_t size)
+{
+	assert(memoryArena);
+	assert(size <= memoryArena->offset - MEMORY_ARENA_HEADER_SIZE);
+	memoryArena->offset = MEMORY_ARENA_HEADER_SIZE + size;
+}
+void resetMemoryArena(MemoryArena memoryArena)
+{
+	assert(memoryArena);
+	memoryArena->offset = MEMORY_ARENA_HEADER_SIZE;
+}
+bool trimMemoryArena(MemoryArena memoryArena)
+{
+	assert(memoryArena);
+	size_t committedSize = alignMemorySize(memoryArena->offset, memoryArena->commitStep);
+	if (committedSize >= memoryArena->committedSize)
+		return true;
+	if (!decommitMemory(memoryArena->memory + committedSize, memoryArena->committedSize - committedSize))
+		return false;
+	memoryArena->committedSize = committedSize;
+	return true;
+}
+
+//**********************************************************************************************************************
+// Note: Freed items are linked through their first bytes, the pool header is stored in its first page.
+struct MemoryPool_T
+{
+	uint8_t* memory;
+	void* freeItem;
+	size_t reservedSize;
+	size_t maxSize;
+	size_t committedSize;
+	size_t offset;
+	size_t itemSize;
+	size_t itemCount;
+};
+
+#define MEMORY_POOL_HEADER_SIZE \
+	((sizeof(MemoryPool_T) + MEMORY_HEADER_ALIGNMENT - 1) & ~(size_t)(MEMORY_HEADER_ALIGNMENT - 1))
+
+MemoryPool createMemoryPool(size_t itemSize, size_t maxItemCount)
+{
+	assert(itemSize > 0);
+	assert(maxItemCount > 0);
+
+	itemSize = alignMemorySize(itemSize, MEMORY_POOL_ALIGNMENT);
+	if (maxItemCount > (SIZE_MAX - MEMORY_POOL_HEADER_SIZE - MEMORY_COMMIT_STEP) / itemSize)
+		return NULL;
+
+	size_t pageSize = getPageSize(), commitStep = MEMORY_COMMIT_STEP > pageSize ? MEMORY_COMMIT_STEP : pageSize;
+	size_t maxSize = MEMORY_POOL_HEADER_SIZE + itemSize * maxItemCount;
+	size_t reservedSize = alignMemorySize(maxSize, pageSize);
+	uint8_t* memory = reserveMemory(reservedSize);
+	if (!memory)
+		return NULL;
+
+	size_t committedSize = commitStep < reservedSize ? commitStep : reservedSize;
+	if (!commitMemory(memory, committedSize))
+	{
+		releaseMemory(memory, reservedSize);
+		return NULL;
+	}
+
+	MemoryPool memoryPool = (MemoryPool)memory;
+	memoryPool->memory = memory;
+	memoryPool->freeItem = NULL;
+	memoryPool->reservedSize = reservedSize;
+	memoryPool->maxSize = maxSize;
+	memoryPool->committedSize = committedSize;
+	memoryPool->offset = MEMORY_POOL_HEADER_SIZE;
+	memoryPool->itemSize = itemSize;
+	memoryPool->itemCount = 0;
+	return memoryPool;
+}
+void destroyMemoryPool(MemoryPool memoryPool)
+{
+	if (memoryPool)
+		releaseMemory(memoryPool->memory, memoryPool->reservedSize);
+}
+
+void* allocatePoolItem(MemoryPool memoryPool)
+{
+	assert(memoryPool);
+	void* item = memoryPool->freeItem;
+	if (item)
+	{
+		memoryPool->freeItem = *(void**)item;
+		memoryPool->itemCount++;
+		return item;
+	}
+
+	size_t newOffset = memoryPool->offset + memoryPool->itemSize;
+	if (newOffset > memoryPool->maxSize)
+		return NULL;
+	if (newOffset > memoryPool->committedSize && !growCommittedMemory(memoryPool->memory,
+		&memoryPool->committedSize, newOffset, memoryPool->reservedSize, MEMORY_COMMIT_STEP))
+	{
+		return NULL;
+	}
+
+	item = memoryPool->memory + memoryPool->offset;
+	memoryPool->offset = newOffset;
+	memoryPool->itemCount++;
+	return item;
+}
+void freePoolItem(MemoryPool memoryPool, void* item)
+{
+	assert(memoryPool);
+	if (!item)
+		return;
+
+	assert((uint8_t*)item >= memoryPool->memory + MEMORY_POOL_HEADER_SIZE &&
+		(uint8_t*)item < memoryPool->memory + memoryPool->offset);
+	*(void**)item = memoryPool->freeItem;
+	memoryPool->freeItem = item;
+	memoryPool->itemCount--;
+}
+
+size_t getMemoryPoolItemSize(MemoryPool memoryPool)
+{
+	assert(memoryPool);
+	return memoryPool->itemSize;
+}
+size_t getMemoryPoolItemCount(MemoryPool memoryPool)
+{
+	assert(memoryPool);
+	return memoryPool->itemCount;
+}
@@ -12,7 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if __linux__
+#define _GNU_SOURCE
+#endif
+
 #include "mpio/os.h"
+#include "mpio/process.h"
+#include "atomic.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,23 +27,34 @@
 
 #if __linux__ || __APPLE__
 #include <time.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
-#include <sys/wait.h>
+#include <pthread.h>
+#include <sys/resource.h>
 	#if __x86_64__ || __i386__
 	#include <cpuid.h>
+	#include <x86intrin.h>
 	#endif
 #elif _WIN32
 #include <intrin.h>
 #include <windows.h>
-#include <process.h>
+#define PSAPI_VERSION 2 // Note: Uses K32GetProcessMemoryInfo() from the kernel32.
+#include <psapi.h>
 #else
 #error Unknown operating system
 #endif
 
 #if __linux__
+#include <sched.h>
 #include <sys/sysinfo.h>
+	#if __aarch64__ || __arm__
+	#include <sys/auxv.h>
+	#endif
 #elif __APPLE__
+#include <libproc.h>
 #include <sys/sysctl.h>
+#include <mach/mach.h>
 #include <mach/mach_host.h>
 #include <CoreFoundation/CoreFoundation.h>
 #endif
@@ -44,9 +62,30 @@
 #if __x86_64__ || _M_X64 || __i386__
 #if __linux__ || __APPLE__
 #define CPUID(id, cpuInfo) __cpuid(id, cpuInfo[0], cpuInfo[1], cpuInfo[2], cpuInfo[3])
+#define CPUID_COUNT(id, subId, cpuInfo) __cpuid_count(id, subId, cpuInfo[0], cpuInfo[1], cpuInfo[2], cpuInfo[3])
 #elif _WIN32
 #define CPUID(id, cpuInfo) __cpuid((int*)cpuInfo, id)
+#define CPUID_COUNT(id, subId, cpuInfo) __cpuidex((int*)cpuInfo, id, subId)
+#endif
 #endif
+
+#if _WIN32
+static volatile int64_t performanceFrequency = 0;
+
+// Note: Frequency is fixed at the system boot, so it is queried only once.
+inline static int64_t getPerformanceFrequency()
+{
+	int64_t frequency = atomicLoad64(&performanceFrequency);
+	if (frequency == 0)
+	{
+		LARGE_INTEGER value;
+		if (QueryPerformanceFrequency(&value) != TRUE)
+			abort();
+		frequency = value.QuadPart;
+		atomicStore64(&performanceFrequency, frequency);
+	}
+	return frequency;
+}
 #endif
 
 double getCurrentClock()
@@ -56,215 +95,532 @@ double getCurrentClock()
 	if (clock_gettime(CLOCK_MONOTONIC, &time) != 0) abort();
 	return (double)time.tv_sec + (double)time.tv_nsec / 1000000000.0;
 #elif _WIN32
-	LARGE_INTEGER frequency;
-	if (QueryPerformanceFrequency(&frequency) != TRUE)
+	LARGE_INTEGER counter;
+	if (QueryPerformanceCounter(&counter) != TRUE)
 		abort();
+	return (double)counter.QuadPart / (double)getPerformanceFrequency();
+#endif
+}
+int64_t getCurrentClockNs()
+{
+#if __linux__ || __APPLE__
+	struct timespec time;
+	if (clock_gettime(CLOCK_MONOTONIC, &time) != 0) abort();
+	return (int64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+#elif _WIN32
 	LARGE_INTEGER counter;
 	if (QueryPerformanceCounter(&counter) != TRUE)
 		abort();
-	return (double)counter.QuadPart / (double)frequency.QuadPart;
+	int64_t frequency = getPerformanceFrequency();
+	return counter.QuadPart / frequency * 1000000000 + counter.QuadPart % frequency * 1000000000 / frequency;
+#endif
+}
+int64_t getCoarseClockNs()
+{
+#if __linux__
+	struct timespec time;
+	if (clock_gettime(CLOCK_MONOTONIC_COARSE, &time) != 0) abort();
+	return (int64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+#elif __APPLE__
+	return (int64_t)clock_gettime_nsec_np(CLOCK_MONOTONIC_RAW_APPROX);
+#elif _WIN32
+	return (int64_t)GetTickCount64() * 1000000;
+#endif
+}
+
+static int64_t getWallClockNs()
+{
+#if __linux__ || __APPLE__
+	struct timespec time;
+	if (clock_gettime(CLOCK_REALTIME, &time) != 0) abort();
+	return (int64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+#elif _WIN32
+	FILETIME fileTime; GetSystemTimePreciseAsFileTime(&fileTime);
+	int64_t time = ((int64_t)fileTime.dwHighDateTime << 32) | fileTime.dwLowDateTime;
+	return (time - 116444736000000000LL) * 100; // Note: Converting from 100ns intervals since the 1601 year.
 #endif
 }
 
 //**********************************************************************************************************************
-int getLogicalCpuCount()
+uint64_t getCycleCount()
 {
-	int cpuCount = -1;
-#if __linux__
-	cpuCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
-	if (cpuCount <= 0)
-	{
-		FILE* file = fopen("/proc/cpuinfo", "r");
-		if (file)
-		{
-			const size_t bufferSize = 256;
-			char* line = malloc(bufferSize);
-			if (!line)
-			{
-				fclose(file);
-				return -1;
-			}
+#if __x86_64__ || _M_X64 || __i386__
+	return __rdtsc();
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+	uint64_t value;
+	__asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+	return value;
+#elif defined(_M_ARM64)
+	return (uint64_t)_ReadStatusReg(ARM64_CNTVCT);
+#else
+	return (uint64_t)getCurrentClockNs();
+#endif
+}
 
-			while (fgets(line, bufferSize, file))
-			{
-				size_t lineLength = strlen(line);
-				if (lineLength == 0 || memcmp(line, "processor", 9) != 0)
-					continue;
-				char* pointer = memchr(line + 9, ':', lineLength - 9);
-				if (!pointer)
-					continue;
-
-				int count = atoi(pointer + 1) + 1;
-				if (count > cpuCount)
-					cpuCount = count;
-			}
-			free(line); fclose(file);
-		}
-	}
-#elif __APPLE__
-	size_t size = sizeof(cpuCount);
-	sysctlbyname("hw.logicalcpu", &cpuCount, &size, NULL, 0);
+static uint64_t cycleFrequency;
 
-	if (cpuCount <= 0)
+static void initCycleFrequency()
+{
+	uint64_t frequency = 0;
+#if defined(__aarch64__) && !defined(_MSC_VER)
+	__asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+#elif __x86_64__ || _M_X64 || __i386__
+	unsigned int cpuInfo[4] = { 0, 0, 0, 0 };
+	CPUID(0, cpuInfo);
+	if (cpuInfo[0] >= 0x15)
 	{
-		size = sizeof(cpuCount);
-		sysctlbyname("machdep.cpu.thread_count", &cpuCount, &size, NULL, 0);
+		// Note: TSC / core crystal clock ratio, crystal frequency is not reported by some CPUs.
+		CPUID(0x15, cpuInfo);
+		if (cpuInfo[0] != 0 && cpuInfo[1] != 0 && cpuInfo[2] != 0)
+			frequency = (uint64_t)cpuInfo[2] * cpuInfo[1] / cpuInfo[0];
 	}
-	if (cpuCount <= 0)
+#elif !defined(_M_ARM64)
+	frequency = 1000000000;
+#endif
+
+	if (frequency == 0)
 	{
-		size = sizeof(cpuCount);
-		sysctlbyname("hw.activecpu", &cpuCount, &size, NULL, 0);
+		int64_t startTime = getCurrentClockNs(), stopTime;
+		uint64_t startCycles = getCycleCount();
+		do { stopTime = getCurrentClockNs(); } while (stopTime - startTime < 10000000);
+		uint64_t stopCycles = getCycleCount();
+		frequency = (uint64_t)((double)(stopCycles - startCycles) * 1000000000.0 / (double)(stopTime - startTime));
 	}
+	cycleFrequency = frequency > 0 ? frequency : 1000000000;
+}
+
+#if __linux__ || __APPLE__
+static pthread_once_t cycleFrequencyOnce = PTHREAD_ONCE_INIT;
+uint64_t getCycleFrequency()
+{
+	pthread_once(&cycleFrequencyOnce, initCycleFrequency);
+	return cycleFrequency;
+}
 #elif _WIN32
-	SYSTEM_INFO systemInfo; GetSystemInfo(&systemInfo);
-	cpuCount = (int)systemInfo.dwNumberOfProcessors;
+static INIT_ONCE cycleFrequencyOnce = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK initCycleFrequencyCallback(PINIT_ONCE initOnce, PVOID parameter, PVOID* context)
+{
+	initCycleFrequency();
+	return TRUE;
+}
+uint64_t getCycleFrequency()
+{
+	InitOnceExecuteOnce(&cycleFrequencyOnce, initCycleFrequencyCallback, NULL, NULL);
+	return cycleFrequency;
+}
 #endif
-	return cpuCount;
+
+int64_t convertCyclesToNs(uint64_t cycles)
+{
+	uint64_t frequency = getCycleFrequency();
+	return (int64_t)(cycles / frequency * 1000000000 + cycles % frequency * 1000000000 / frequency);
 }
 
-//**********************************************************************************************************************
-int getPhysicalCpuCount()
+void getClockCorrelation(ClockCorrelation* clockCorrelation)
 {
-	int cpuCount = -1;
+	assert(clockCorrelation);
+	uint64_t minWindow = UINT64_MAX;
+
+	// Note: Sample can be disturbed by an interrupt or preemption, so the tightest one is used.
+	for (int i = 0; i < 8; i++)
+	{
+		uint64_t startCycles = getCycleCount();
+		int64_t monotonicNs = getCurrentClockNs();
+		int64_t wallTimeNs = getWallClockNs();
+		uint64_t stopCycles = getCycleCount();
+
+		uint64_t window = stopCycles - startCycles;
+		if (window < minWindow)
+		{
+			minWindow = window;
+			clockCorrelation->wallTimeNs = wallTimeNs;
+			clockCorrelation->monotonicNs = monotonicNs;
+			clockCorrelation->cycleCount = startCycles + window / 2;
+		}
+	}
+}
+
+//**********************************************************************************************************************
 #if __linux__
-	int processorCount = -1;
-	FILE* file = fopen("/proc/cpuinfo", "r");
-	if (file)
+#define PROC_BUFFER_SIZE 4096
+#define MAX_PROC_CPU_CORE_COUNT 1024
+
+typedef void(*ProcLineFunction)(char* line, void* argument);
+
+// Note: Reads whole file with large read() calls into a stack buffer, without stdio and heap allocations.
+static bool parseProcFile(const char* filePath, ProcLineFunction function, void* argument)
+{
+	int file = open(filePath, O_RDONLY | O_CLOEXEC);
+	if (file == -1)
+		return false;
+
+	char buffer[PROC_BUFFER_SIZE];
+	size_t bufferSize = 0; bool isSkipping = false;
+
+	while (true)
 	{
-		const size_t bufferSize = 256;
-		char* line = malloc(bufferSize);
-		if (!line)
+		ssize_t result = read(file, buffer + bufferSize, PROC_BUFFER_SIZE - 1 - bufferSize);
+		if (result < 0)
 		{
-			fclose(file);
-			return -1;
+			if (errno == EINTR)
+				continue;
+			close(file);
+			return false;
 		}
 
-		while (fgets(line, bufferSize, file))
+		size_t dataSize = bufferSize + (size_t)result, lineStart = 0;
+		for (size_t i = bufferSize; i < dataSize; i++)
 		{
-			size_t lineLength = strlen(line);
-			if (lineLength == 0)
+			if (buffer[i] != '\n')
 				continue;
+			buffer[i] = '\0';
+			if (!isSkipping)
+				function(buffer + lineStart, argument);
+			isSkipping = false; lineStart = i + 1;
+		}
 
-			if (memcmp(line, "cpu cores", 9) == 0)
-			{
-				char* pointer = memchr(line + 9, ':', lineLength - 9);
-				if (!pointer)
-					continue;
-				cpuCount = atoi(pointer + 1);
-				free(line); fclose(file);
-				return cpuCount;
-			}
-			if (memcmp(line, "processor", 9) == 0)
-			{
-				char* pointer = memchr(line + 9, ':', lineLength - 9);
-				if (!pointer)
-					continue;
-				int count = atoi(pointer + 1) + 1;
-				if (count > processorCount)
-					processorCount = count;
-			}
-			if (memcmp(line, "core id", 7) != 0)
+		if (result == 0)
+		{
+			if (lineStart < dataSize && !isSkipping)
 			{
-				char* pointer = memchr(line + 7, ':', lineLength - 7);
-				if (!pointer)
-					continue;
-				int count = atoi(pointer + 1) + 1;
-				if (count > cpuCount)
-					cpuCount = count;
+				buffer[dataSize] = '\0';
+				function(buffer + lineStart, argument);
 			}
+			break;
+		}
+
+		bufferSize = dataSize - lineStart;
+		if (bufferSize == PROC_BUFFER_SIZE - 1)
+		{
+			isSkipping = true; bufferSize = 0; // Note: Skipping too long line.
+		}
+		else if (lineStart > 0)
+		{
+			memmove(buffer, buffer + lineStart, bufferSize);
 		}
-		free(line); fclose(file);
 	}
 
-	if (cpuCount <= 0)
-		cpuCount = processorCount;
-#elif __APPLE__
-	size_t size = sizeof(cpuCount);
-	sysctlbyname("hw.physicalcpu", &cpuCount, &size, NULL, 0);
+	close(file);
+	return true;
+}
+static const char* getProcValue(const char* line, const char* key, size_t keyLength)
+{
+	if (memcmp(line, key, keyLength) != 0 || (line[keyLength] != ' ' &&
+		line[keyLength] != '\t' && line[keyLength] != ':'))
+	{
+		return NULL;
+	}
+	const char* value = strchr(line + keyLength, ':');
+	if (!value)
+		return NULL;
+	value++;
+	while (*value == ' ' || *value == '\t')
+		value++;
+	return value;
+}
 
-	if (cpuCount <= 0)
+typedef struct CpuInfoState
+{
+	int processorCount;
+	int coreCount;
+	int physicalId;
+	int cpuCores;
+	char* cpuName;
+	uint32_t cores[MAX_PROC_CPU_CORE_COUNT];
+} CpuInfoState;
+
+static void parseCpuInfoLine(char* line, void* argument)
+{
+	CpuInfoState* state = (CpuInfoState*)argument;
+	const char* value;
+
+	if ((value = getProcValue(line, "processor", 9)))
 	{
-		size = sizeof(cpuCount);
-		sysctlbyname("machdep.cpu.core_count", &cpuCount, &size, NULL, 0);
+		int count = atoi(value) + 1;
+		if (count > state->processorCount)
+			state->processorCount = count;
 	}
-#elif _WIN32
-	DWORD infoSize = 0; GetLogicalProcessorInformationEx(RelationProcessorCore, NULL, &infoSize);
-	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
-		return -1;
+	else if ((value = getProcValue(line, "physical id", 11)))
+	{
+		state->physicalId = atoi(value);
+	}
+	else if ((value = getProcValue(line, "core id", 7)))
+	{
+		uint32_t core = ((uint32_t)state->physicalId << 16) | ((uint32_t)atoi(value) & 0xFFFF);
+		for (int i = 0; i < state->coreCount; i++)
+		{
+			if (state->cores[i] == core)
+				return;
+		}
+		if (state->coreCount < MAX_PROC_CPU_CORE_COUNT)
+			state->cores[state->coreCount++] = core;
+	}
+	else if ((value = getProcValue(line, "cpu cores", 9)))
+	{
+		if (state->cpuCores <= 0)
+			state->cpuCores = atoi(value);
+	}
+	else if (state->cpuName[0] == '\0' && ((value = getProcValue(line, "model name", 10)) ||
+		(value = getProcValue(line, "Model", 5))))
+	{
+		size_t length = strlen(value);
+		if (length > 64)
+			length = 64;
+		memcpy(state->cpuName, value, length);
+		state->cpuName[length] = '\0';
+	}
+}
 
-	char* infoBuffer = malloc(infoSize);
-	if (!infoBuffer)
-		return -1;
+typedef struct MemInfoState
+{
+	int64_t memAvailable;
+	int64_t memFree;
+	int64_t buffers;
+	int64_t cached;
+	int64_t sReclaimable;
+} MemInfoState;
 
-	PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)infoBuffer;
-	if (GetLogicalProcessorInformationEx(RelationProcessorCore, info, &infoSize) != TRUE)
+static void parseMemInfoLine(char* line, void* argument)
+{
+	MemInfoState* state = (MemInfoState*)argument;
+	const char* value;
+
+	if ((value = getProcValue(line, "MemAvailable", 12)))
+		state->memAvailable = atoll(value);
+	else if ((value = getProcValue(line, "MemFree", 7)))
+		state->memFree = atoll(value);
+	else if ((value = getProcValue(line, "Buffers", 7)))
+		state->buffers = atoll(value);
+	else if ((value = getProcValue(line, "Cached", 6)))
+		state->cached = atoll(value);
+	else if ((value = getProcValue(line, "SReclaimable", 12)))
+		state->sReclaimable = atoll(value);
+}
+
+static bool readSysFile(const char* filePath, char* buffer, size_t bufferSize)
+{
+	int file = open(filePath, O_RDONLY | O_CLOEXEC);
+	if (file == -1)
+		return false;
+
+	ssize_t result;
+	do { result = read(file, buffer, bufferSize - 1); } while (result < 0 && errno == EINTR);
+	close(file);
+
+	if (result <= 0)
+		return false;
+	while (result > 0 && (buffer[result - 1] == '\n' || buffer[result - 1] == ' '))
+		result--;
+	buffer[result] = '\0';
+	return true;
+}
+static void parseCpuList(const char* list, CpuSet* cpuSet)
+{
+	clearCpuSet(cpuSet);
+	while (*list)
 	{
-		free(infoBuffer);
-		return -1;
+		char* end;
+		long first = strtol(list, &end, 10);
+		if (end == list)
+			break;
+
+		long last = first;
+		if (*end == '-')
+		{
+			list = end + 1;
+			last = strtol(list, &end, 10);
+		}
+		for (long i = first; i <= last && i < MAX_CPU_SET_COUNT; i++)
+			addCpuToSet(cpuSet, (int)i);
+
+		list = end;
+		if (*list == ',')
+			list++;
+	}
+}
+static void readOnlineCpus(CpuSet* cpuSet)
+{
+	char buffer[PROC_BUFFER_SIZE];
+	if (readSysFile("/sys/devices/system/cpu/online", buffer, sizeof(buffer)))
+	{
+		parseCpuList(buffer, cpuSet);
+		return;
 	}
 
-	cpuCount = 0; size_t offset = 0;
-	do
+	clearCpuSet(cpuSet);
+	int cpuCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	for (int i = 0; i < cpuCount; i++)
+		addCpuToSet(cpuSet, i);
+}
+
+#define CGROUP_ROOT_PATH "/sys/fs/cgroup"
+
+// Note: Returns cgroup hierarchy root path length, or 0 on failure. Controller is NULL for the cgroup v2.
+static size_t getCgroupDirectory(const char* controller, char* directory, size_t directorySize)
+{
+	char buffer[PROC_BUFFER_SIZE];
+	if (!readSysFile("/proc/self/cgroup", buffer, sizeof(buffer)))
+		return 0;
+
+	char* line = buffer;
+	while (line)
 	{
-		const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX currentInfo =
-			(const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(infoBuffer + offset);
-		offset += currentInfo->Size; cpuCount++;
+		char* nextLine = strchr(line, '\n');
+		if (nextLine)
+			*nextLine++ = '\0';
+
+		char* controllers = strchr(line, ':');
+		char* path = controllers ? strchr(controllers + 1, ':') : NULL;
+		line = nextLine;
+		if (!path)
+			continue;
+		controllers++; *path++ = '\0';
+
+		bool isFound = false;
+		if (controller)
+		{
+			size_t controllerLength = strlen(controller);
+			for (const char* name = controllers; name && !isFound; name = strchr(name, ','))
+			{
+				if (*name == ',')
+					name++;
+				isFound = memcmp(name, controller, controllerLength) == 0 &&
+					(name[controllerLength] == ',' || name[controllerLength] == '\0');
+			}
+		}
+		else
+		{
+			isFound = controllers[0] == '\0';
+		}
+		if (!isFound)
+			continue;
+
+		int rootLength = snprintf(directory, directorySize, "%s%s%s",
+			CGROUP_ROOT_PATH, controller ? "/" : "", controller ? controller : "");
+		int length = snprintf(directory + rootLength, directorySize - rootLength, "%s", path);
+		if (rootLength <= 0 || length < 0 || (size_t)(rootLength + length) >= directorySize)
+			return 0;
+
+		// Note: Process cgroup is not visible inside a container without the cgroup namespace.
+		if (access(directory, F_OK) != 0)
+			length = 0;
+		if (length > 0 && directory[rootLength + length - 1] == '/')
+			length--;
+		directory[rootLength + length] = '\0';
+		return (size_t)rootLength;
 	}
-	while (offset < infoSize);
+	return 0;
+}
+static bool moveToParentCgroup(char* directory, size_t rootLength)
+{
+	char* separator = strrchr(directory, '/');
+	if (strlen(directory) <= rootLength || !separator)
+		return false;
+	*separator = '\0';
+	return true;
+}
+static bool readCgroupFile(const char* directory, const char* fileName, char* buffer, size_t bufferSize)
+{
+	char path[PROC_BUFFER_SIZE];
+	if (snprintf(path, sizeof(path), "%s/%s", directory, fileName) >= (int)sizeof(path))
+		return false;
+	return readSysFile(path, buffer, bufferSize) && memcmp(buffer, "max", 3) != 0;
+}
+static int64_t readCgroupValue(const char* directory, const char* fileName)
+{
+	char buffer[64];
+	return readCgroupFile(directory, fileName, buffer, sizeof(buffer)) ? atoll(buffer) : 0;
+}
 
-	free(infoBuffer);
-#endif
-	return cpuCount;
+static void updateCpuLimit(double* cpuLimit, int64_t quota, int64_t period)
+{
+	if (quota <= 0 || period <= 0)
+		return;
+	double limit = (double)quota / (double)period;
+	if (*cpuLimit == 0.0 || limit < *cpuLimit)
+		*cpuLimit = limit;
+}
+static void updateMemoryLimit(int64_t* memoryLimit, int64_t limit)
+{
+	if (limit > 0 && (*memoryLimit == 0 || limit < *memoryLimit))
+		*memoryLimit = limit;
 }
 
-//**********************************************************************************************************************
-int getPerformanceCpuCount()
+// Note: Limits of the parent cgroups also apply, so walking up to the hierarchy root.
+static void queryCgroupLimits(double* cpuLimit, int64_t* memoryLimit)
 {
-	int cpuCount = -1;
-#if __linux__
-	// TODO: use libcpuid approach with cpuid and affinity.
-	// https://github.com/anrieff/libcpuid/blob/master/libcpuid/cpuid_main.c#L96
-#elif _WIN32
-	DWORD infoSize = 0; GetLogicalProcessorInformationEx(RelationProcessorCore, NULL, &infoSize);
-	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
-		return -1;
+	*cpuLimit = 0.0; *memoryLimit = 0;
+	char directory[PROC_BUFFER_SIZE], buffer[64];
 
-	char* infoBuffer = malloc(infoSize);
-	if (!infoBuffer)
-		return -1;
+	if (access(CGROUP_ROOT_PATH "/cgroup.controllers", F_OK) == 0)
+	{
+		size_t rootLength = getCgroupDirectory(NULL, directory, sizeof(directory));
+		while (rootLength > 0)
+		{
+			if (readCgroupFile(directory, "cpu.max", buffer, sizeof(buffer)))
+			{
+				char* period = strchr(buffer, ' ');
+				updateCpuLimit(cpuLimit, atoll(buffer), period ? atoll(period + 1) : 100000);
+			}
+			updateMemoryLimit(memoryLimit, readCgroupValue(directory, "memory.max"));
+			updateMemoryLimit(memoryLimit, readCgroupValue(directory, "memory.high"));
+			if (!moveToParentCgroup(directory, rootLength))
+				break;
+		}
+		return;
+	}
 
-	PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)infoBuffer;
-	if (GetLogicalProcessorInformationEx(RelationProcessorCore, info, &infoSize) != TRUE)
+	size_t rootLength = getCgroupDirectory("cpu", directory, sizeof(directory));
+	while (rootLength > 0)
 	{
-		free(infoBuffer);
-		return -1;
+		updateCpuLimit(cpuLimit, readCgroupValue(directory, "cpu.cfs_quota_us"),
+			readCgroupValue(directory, "cpu.cfs_period_us"));
+		if (!moveToParentCgroup(directory, rootLength))
+			break;
 	}
 
-	cpuCount = 0; size_t offset = 0;
-	do
+	rootLength = getCgroupDirectory("memory", directory, sizeof(directory));
+	while (rootLength > 0)
 	{
-		const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX currentInfo =
-			(const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(infoBuffer + offset);
-		if (currentInfo->Relationship == RelationProcessorCore)
+		// Note: Unlimited cgroup v1 memory limit is a huge value, it is clamped by the total RAM size.
+		updateMemoryLimit(memoryLimit, readCgroupValue(directory, "memory.limit_in_bytes"));
+		if (!moveToParentCgroup(directory, rootLength))
+			break;
+	}
+}
+#elif _WIN32
+static void queryJobObjectLimits(double* cpuLimit, int64_t* memoryLimit)
+{
+	*cpuLimit = 0.0; *memoryLimit = 0;
+
+	JOBOBJECT_CPU_RATE_CONTROL_INFORMATION cpuRateInfo;
+	if (QueryInformationJobObject(NULL, JobObjectCpuRateControlInformation,
+		&cpuRateInfo, sizeof(cpuRateInfo), NULL) != FALSE &&
+		(cpuRateInfo.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_ENABLE) &&
+		(cpuRateInfo.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_HARD_CAP))
+	{
+		// Note: CPU rate is a percentage of the all system CPUs time multiplied by 100.
+		*cpuLimit = (double)cpuRateInfo.CpuRate / 10000.0 * GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+	}
+
+	JOBOBJECT_EXTENDED_LIMIT_INFORMATION limitInfo;
+	if (QueryInformationJobObject(NULL, JobObjectExtendedLimitInformation,
+		&limitInfo, sizeof(limitInfo), NULL) != FALSE)
+	{
+		DWORD flags = limitInfo.BasicLimitInformation.LimitFlags;
+		if (flags & JOB_OBJECT_LIMIT_JOB_MEMORY)
+			*memoryLimit = (int64_t)limitInfo.JobMemoryLimit;
+		if ((flags & JOB_OBJECT_LIMIT_PROCESS_MEMORY) && (*memoryLimit == 0 ||
+			(int64_t)limitInfo.ProcessMemoryLimit < *memoryLimit))
 		{
-			if (currentInfo->Processor.EfficiencyClass > 0)
-				cpuCount++;
+			*memoryLimit = (int64_t)limitInfo.ProcessMemoryLimit;
 		}
-		offset += currentInfo->Size;
-	} while (offset < infoSize);
-
-	free(infoBuffer);
-#elif __APPLE__
-	size_t size = sizeof(cpuCount);
-	sysctlbyname("hw.perflevel0.physicalcpu", &cpuCount, &size, NULL, 0);
-#endif
-	if(cpuCount <= 0)
-		cpuCount = getPhysicalCpuCount();
-	return cpuCount;
+	}
 }
+#endif
 
 //**********************************************************************************************************************
-int64_t getTotalRamSize()
+static int64_t queryTotalRamSize()
 {
 #if __linux__
 	struct sysinfo info;
@@ -285,184 +641,1373 @@ int64_t getTotalRamSize()
 	return statex.ullTotalPhys;
 #endif
 }
-
-int64_t getFreeRamSize()
+static int64_t queryFreeRamSize()
 {
 #if __linux__
-	FILE* file = fopen("/proc/meminfo", "r");
-	if (file)
+	MemInfoState state;
+	memset(&state, 0, sizeof(MemInfoState));
+	state.memAvailable = -1;
+
+	if (parseProcFile("/proc/meminfo", parseMemInfoLine, &state))
+	{
+		if (state.memAvailable >= 0)
+			return state.memAvailable * 1024;
+		return (state.memFree + state.buffers + state.cached + state.sReclaimable) * 1024;
+	}
+
+	struct sysinfo info;
+	if (sysinfo(&info) != 0)
+		return -1;
+	return (int64_t)info.freeram * (int64_t)info.mem_unit;
+#elif __APPLE__
+	mach_msg_type_number_t count = HOST_VM_INFO64_COUNT; vm_statistics64_data_t vmStat;
+	if (host_statistics64(mach_host_self(), HOST_VM_INFO64, (host_info64_t)&vmStat, &count) != KERN_SUCCESS)
+		return -1;
+	return (vmStat.inactive_count + vmStat.free_count + vmStat.speculative_count) * (int64_t)getpagesize();
+#elif _WIN32
+	MEMORYSTATUSEX statex;
+	statex.dwLength = sizeof(statex);
+	if (GlobalMemoryStatusEx(&statex) == FALSE)
+		return -1;
+	return statex.ullAvailPhys;
+#endif
+}
+
+#if __APPLE__ || _WIN32
+static int queryLogicalCpuCount()
+{
+	int cpuCount = -1;
+#if __APPLE__
+	size_t size = sizeof(cpuCount);
+	sysctlbyname("hw.logicalcpu", &cpuCount, &size, NULL, 0);
+
+	if (cpuCount <= 0)
+	{
+		size = sizeof(cpuCount);
+		sysctlbyname("machdep.cpu.thread_count", &cpuCount, &size, NULL, 0);
+	}
+	if (cpuCount <= 0)
+	{
+		size = sizeof(cpuCount);
+		sysctlbyname("hw.activecpu", &cpuCount, &size, NULL, 0);
+	}
+#elif _WIN32
+	SYSTEM_INFO systemInfo; GetSystemInfo(&systemInfo);
+	cpuCount = (int)systemInfo.dwNumberOfProcessors;
+#endif
+	return cpuCount;
+}
+static int queryPhysicalCpuCount()
+{
+	int cpuCount = -1;
+#if __APPLE__
+	size_t size = sizeof(cpuCount);
+	sysctlbyname("hw.physicalcpu", &cpuCount, &size, NULL, 0);
+
+	if (cpuCount <= 0)
+	{
+		size = sizeof(cpuCount);
+		sysctlbyname("machdep.cpu.core_count", &cpuCount, &size, NULL, 0);
+	}
+#elif _WIN32
+	DWORD infoSize = 0; GetLogicalProcessorInformationEx(RelationProcessorCore, NULL, &infoSize);
+	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+		return -1;
+
+	char* infoBuffer = malloc(infoSize);
+	if (!infoBuffer)
+		return -1;
+
+	PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)infoBuffer;
+	if (GetLogicalProcessorInformationEx(RelationProcessorCore, info, &infoSize) != TRUE)
+	{
+		free(infoBuffer);
+		return -1;
+	}
+
+	cpuCount = 0; size_t offset = 0;
+	do
+	{
+		const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX currentInfo =
+			(const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(infoBuffer + offset);
+		offset += currentInfo->Size; cpuCount++;
+	}
+	while (offset < infoSize);
+
+	free(infoBuffer);
+#endif
+	return cpuCount;
+}
+#endif
+
+#if __linux__
+#define MIN_HYBRID_VALUE_GAP 0.15
+
+static int compareInt64(const void* a, const void* b)
+{
+	int64_t left = *(const int64_t*)a, right = *(const int64_t*)b;
+	return (left > right) - (left < right);
+}
+static bool readCpuValues(const CpuSet* cpus, const char* fileName, int64_t* values)
+{
+	char path[128], buffer[64];
+	for (int cpu = 0; cpu < MAX_CPU_SET_COUNT; cpu++)
+	{
+		if (!isCpuInSet(cpus, cpu))
+			continue;
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/%s", cpu, fileName);
+		if (!readSysFile(path, buffer, sizeof(buffer)))
+			return false;
+		values[cpu] = atoll(buffer);
+	}
+	return true;
+}
+
+// Note: Splits CPUs into two clusters at the largest relative gap between sorted values.
+static bool splitCpuValues(const CpuSet* cpus, const int64_t* values, int64_t* sortedValues,
+	CpuSet* performanceCpus, CpuSet* efficiencyCpus)
+{
+	int count = 0;
+	for (int cpu = 0; cpu < MAX_CPU_SET_COUNT; cpu++)
+	{
+		if (!isCpuInSet(cpus, cpu))
+			continue;
+		if (values[cpu] <= 0)
+			return false;
+		sortedValues[count++] = values[cpu];
+	}
+	if (count < 2)
+		return false;
+	qsort(sortedValues, count, sizeof(int64_t), compareInt64);
+
+	int64_t threshold = 0; double maxGap = 0.0;
+	for (int i = 1; i < count; i++)
+	{
+		double gap = (double)(sortedValues[i] - sortedValues[i - 1]) / (double)sortedValues[i];
+		if (gap > maxGap)
+		{
+			maxGap = gap; threshold = sortedValues[i];
+		}
+	}
+
+	// Note: Ignores small differences, like Intel Turbo Boost Max 3.0 favored cores.
+	if (maxGap < MIN_HYBRID_VALUE_GAP)
+		return false;
+
+	clearCpuSet(performanceCpus); clearCpuSet(efficiencyCpus);
+	for (int cpu = 0; cpu < MAX_CPU_SET_COUNT; cpu++)
+	{
+		if (!isCpuInSet(cpus, cpu))
+			continue;
+		addCpuToSet(values[cpu] >= threshold ? performanceCpus : efficiencyCpus, cpu);
+	}
+	return true;
+}
+
+#if __x86_64__ || __i386__
+typedef struct CpuidHybridProbe
+{
+	const CpuSet* cpus;
+	CpuSet* performanceCpus;
+	CpuSet* efficiencyCpus;
+	bool result;
+} CpuidHybridProbe;
+
+// Note: CPUID leaf 0x1A reports type of the core it is executed on, so the probe thread is pinned to each CPU in turn.
+//       Separate short-lived thread is used to not change the caller thread affinity.
+static void* cpuidHybridProbeFunction(void* argument)
+{
+	CpuidHybridProbe* probe = (CpuidHybridProbe*)argument;
+	unsigned int cpuInfo[4] = { 0, 0, 0, 0 };
+
+	for (int cpu = 0; cpu < MAX_CPU_SET_COUNT && cpu < CPU_SETSIZE; cpu++)
+	{
+		if (!isCpuInSet(probe->cpus, cpu))
+			continue;
+
+		cpu_set_t affinity; CPU_ZERO(&affinity); CPU_SET(cpu, &affinity);
+		if (sched_setaffinity(0, sizeof(cpu_set_t), &affinity) != 0)
+			return NULL; // Note: CPU is not allowed for this process (cpuset cgroup).
+
+		__cpuid_count(0x1A, 0, cpuInfo[0], cpuInfo[1], cpuInfo[2], cpuInfo[3]);
+		uint8_t coreType = (uint8_t)(cpuInfo[0] >> 24); // Note: 0x20 = Atom, 0x40 = Core.
+		addCpuToSet(coreType == 0x20 ? probe->efficiencyCpus : probe->performanceCpus, cpu);
+	}
+
+	probe->result = true;
+	return NULL;
+}
+static bool queryCpuidHybridCpuSets(const CpuSet* cpus, CpuSet* performanceCpus, CpuSet* efficiencyCpus)
+{
+	unsigned int cpuInfo[4] = { 0, 0, 0, 0 };
+	CPUID(0, cpuInfo);
+	if (cpuInfo[0] < 0x1A)
+		return false;
+
+	__cpuid_count(7, 0, cpuInfo[0], cpuInfo[1], cpuInfo[2], cpuInfo[3]);
+	if (!(cpuInfo[3] & (1u << 15)))
+		return false; // Note: Not a hybrid CPU.
+
+	clearCpuSet(performanceCpus); clearCpuSet(efficiencyCpus);
+	CpuidHybridProbe probe = { cpus, performanceCpus, efficiencyCpus, false };
+
+	pthread_t thread;
+	if (pthread_create(&thread, NULL, cpuidHybridProbeFunction, &probe) != 0)
+		return false;
+	pthread_join(thread, NULL);
+
+	return probe.result && getCpuSetCount(performanceCpus) > 0 && getCpuSetCount(efficiencyCpus) > 0;
+}
+#endif
+
+static int countPhysicalCpus(const CpuSet* cpus)
+{
+	char path[128], buffer[PROC_BUFFER_SIZE];
+	int count = 0;
+
+	for (int cpu = 0; cpu < MAX_CPU_SET_COUNT; cpu++)
+	{
+		if (!isCpuInSet(cpus, cpu))
+			continue;
+
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+		if (!readSysFile(path, buffer, sizeof(buffer)))
+		{
+			count++;
+			continue;
+		}
+
+		CpuSet siblings; parseCpuList(buffer, &siblings);
+		bool isFirstSibling = true;
+		for (int i = 0; i < cpu; i++)
+		{
+			if (isCpuInSet(&siblings, i) && isCpuInSet(cpus, i))
+			{
+				isFirstSibling = false;
+				break;
+			}
+		}
+		if (isFirstSibling)
+			count++;
+	}
+	return count;
+}
+#endif
+
+// Note: Returns performance physical core count, or -1 if CPU is not hybrid.
+static int queryHybridCpuSets(CpuSet* performanceCpus, CpuSet* efficiencyCpus)
+{
+	clearCpuSet(performanceCpus); clearCpuSet(efficiencyCpus);
+	int cpuCount = -1;
+#if __linux__
+	CpuSet onlineCpus; readOnlineCpus(&onlineCpus);
+	bool isHybrid = false;
+
+	// Note: Intel hybrid CPUs expose separate PMU devices for the each core type.
+	char buffer[PROC_BUFFER_SIZE];
+	if (readSysFile("/sys/devices/cpu_core/cpus", buffer, sizeof(buffer)))
+	{
+		parseCpuList(buffer, performanceCpus);
+		if (readSysFile("/sys/devices/cpu_atom/cpus", buffer, sizeof(buffer)))
+			parseCpuList(buffer, efficiencyCpus);
+		isHybrid = getCpuSetCount(performanceCpus) > 0 && getCpuSetCount(efficiencyCpus) > 0;
+	}
+#if __x86_64__ || __i386__
+	if (!isHybrid)
+		isHybrid = queryCpuidHybridCpuSets(&onlineCpus, performanceCpus, efficiencyCpus);
+#endif
+	if (!isHybrid)
+	{
+		int64_t* values = malloc(MAX_CPU_SET_COUNT * 2 * sizeof(int64_t));
+		if (values)
+		{
+			int64_t* sortedValues = values + MAX_CPU_SET_COUNT;
+			isHybrid = (readCpuValues(&onlineCpus, "cpu_capacity", values) &&
+				splitCpuValues(&onlineCpus, values, sortedValues, performanceCpus, efficiencyCpus)) ||
+				(readCpuValues(&onlineCpus, "cpufreq/cpuinfo_max_freq", values) &&
+				splitCpuValues(&onlineCpus, values, sortedValues, performanceCpus, efficiencyCpus));
+			free(values);
+		}
+	}
+
+	if (isHybrid)
+	{
+		cpuCount = countPhysicalCpus(performanceCpus);
+	}
+	else
+	{
+		*performanceCpus = onlineCpus;
+		clearCpuSet(efficiencyCpus);
+	}
+#elif _WIN32
+	DWORD infoSize = 0; GetLogicalProcessorInformationEx(RelationProcessorCore, NULL, &infoSize);
+	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+		return -1;
+
+	char* infoBuffer = malloc(infoSize);
+	if (!infoBuffer)
+		return -1;
+
+	PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)infoBuffer;
+	if (GetLogicalProcessorInformationEx(RelationProcessorCore, info, &infoSize) != TRUE)
+	{
+		free(infoBuffer);
+		return -1;
+	}
+
+	BYTE minClass = 255, maxClass = 0; size_t offset = 0;
+	do
+	{
+		const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX currentInfo =
+			(const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(infoBuffer + offset);
+		if (currentInfo->Processor.EfficiencyClass < minClass)
+			minClass = currentInfo->Processor.EfficiencyClass;
+		if (currentInfo->Processor.EfficiencyClass > maxClass)
+			maxClass = currentInfo->Processor.EfficiencyClass;
+		offset += currentInfo->Size;
+	} while (offset < infoSize);
+
+	// Note: Higher efficiency class means greater performance and lower efficiency.
+	int coreCount = 0; offset = 0;
+	do
+	{
+		const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX currentInfo =
+			(const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(infoBuffer + offset);
+		bool isPerformance = currentInfo->Processor.EfficiencyClass == maxClass;
+		for (WORD i = 0; i < currentInfo->Processor.GroupCount; i++)
+		{
+			const GROUP_AFFINITY* affinity = &currentInfo->Processor.GroupMask[i];
+			for (int j = 0; j < 64; j++)
+			{
+				if ((affinity->Mask >> j) & 1)
+					addCpuToSet(isPerformance ? performanceCpus : efficiencyCpus, affinity->Group * 64 + j);
+			}
+		}
+		if (isPerformance)
+			coreCount++;
+		offset += currentInfo->Size;
+	} while (offset < infoSize);
+
+	free(infoBuffer);
+	if (minClass != maxClass)
+		cpuCount = coreCount;
+#elif __APPLE__
+	int logicalCpuCount = queryLogicalCpuCount(), levelCount = 0, efficiencyCpuCount = 0;
+	size_t size = sizeof(levelCount);
+	sysctlbyname("hw.nperflevels", &levelCount, &size, NULL, 0);
+
+	if (levelCount >= 2)
+	{
+		size = sizeof(efficiencyCpuCount);
+		sysctlbyname("hw.perflevel1.logicalcpu", &efficiencyCpuCount, &size, NULL, 0);
+		size = sizeof(cpuCount);
+		sysctlbyname("hw.perflevel0.physicalcpu", &cpuCount, &size, NULL, 0);
+	}
+	if (efficiencyCpuCount <= 0 || efficiencyCpuCount >= logicalCpuCount)
+	{
+		efficiencyCpuCount = 0; cpuCount = -1;
+	}
+
+	// Note: macOS does not expose per CPU core type, Apple silicon numbers efficiency cores first.
+	for (int i = 0; i < logicalCpuCount; i++)
+		addCpuToSet(i < efficiencyCpuCount ? efficiencyCpus : performanceCpus, i);
+#endif
+	return cpuCount;
+}
+
+static void queryCpuName(char* cpuName)
+{
+#if __x86_64__ || _M_X64 || __i386__
+	unsigned int cpuInfo[4] = { 0, 0, 0, 0 };
+	CPUID(0x80000000, cpuInfo);
+
+	unsigned int nExIds = cpuInfo[0];
+	for (unsigned int i = 0x80000000; i <= nExIds; ++i)
+	{
+		CPUID(i, cpuInfo);
+		if (i == 0x80000002)
+			memcpy(cpuName, cpuInfo, sizeof(cpuInfo));
+		else if (i == 0x80000003)
+			memcpy(cpuName + 16, cpuInfo, sizeof(cpuInfo));
+		else if (i == 0x80000004)
+			memcpy(cpuName + 32, cpuInfo, sizeof(cpuInfo));
+	}
+#elif __APPLE__
+	size_t brandLength = 64;
+	sysctlbyname("machdep.cpu.brand_string", cpuName, &brandLength, NULL, 0);
+#endif
+	// Note: Otherwise on Linux name is parsed from the /proc/cpuinfo.
+}
+
+#define SET_CPU_FEATURE(features, feature, isSupported) if (isSupported) features |= CPU_FEATURE_BIT(feature)
+
+#if __APPLE__
+static bool isSysctlFlagSet(const char* name)
+{
+	int value = 0; size_t length = sizeof(int);
+	return sysctlbyname(name, &value, &length, NULL, 0) == 0 && value != 0;
+}
+#endif
+
+#if __x86_64__ || _M_X64 || __i386__
+static uint64_t getExtendedControlRegister()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	return _xgetbv(0);
+#else
+	uint32_t low, high;
+	__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+	return ((uint64_t)high << 32) | low;
+#endif
+}
+#endif
+
+static uint64_t queryCpuFeatures()
+{
+	uint64_t features = 0;
+#if __x86_64__ || _M_X64 || __i386__
+	unsigned int cpuInfo[4] = { 0, 0, 0, 0 };
+	CPUID(0, cpuInfo);
+	unsigned int maxId = cpuInfo[0];
+	if (maxId < 1)
+		return 0;
+
+	CPUID(1, cpuInfo);
+	unsigned int ecx1 = cpuInfo[2], edx1 = cpuInfo[3];
+	SET_CPU_FEATURE(features, SSE2_CPU_FEATURE, edx1 & (1u << 26));
+	SET_CPU_FEATURE(features, SSE3_CPU_FEATURE, ecx1 & (1u << 0));
+	SET_CPU_FEATURE(features, PCLMUL_CPU_FEATURE, ecx1 & (1u << 1));
+	SET_CPU_FEATURE(features, SSSE3_CPU_FEATURE, ecx1 & (1u << 9));
+	SET_CPU_FEATURE(features, SSE41_CPU_FEATURE, ecx1 & (1u << 19));
+	SET_CPU_FEATURE(features, SSE42_CPU_FEATURE, ecx1 & (1u << 20));
+	SET_CPU_FEATURE(features, CRC32_CPU_FEATURE, ecx1 & (1u << 20));
+	SET_CPU_FEATURE(features, POPCNT_CPU_FEATURE, ecx1 & (1u << 23));
+	SET_CPU_FEATURE(features, AES_CPU_FEATURE, ecx1 & (1u << 25));
+
+	// Note: AVX registers are usable only if the OS saves XMM and YMM state on the context switch.
+	uint64_t xcr0 = (ecx1 & (1u << 27)) ? getExtendedControlRegister() : 0;
+	bool isAvxState = (xcr0 & 0x06) == 0x06;
+#if __APPLE__
+	// Note: macOS enables AVX-512 state lazily, on the first AVX-512 instruction.
+	bool isAvx512State = isAvxState && isSysctlFlagSet("hw.optional.avx512f");
+#else
+	bool isAvx512State = (xcr0 & 0xE6) == 0xE6;
+#endif
+
+	if (isAvxState)
+	{
+		SET_CPU_FEATURE(features, AVX_CPU_FEATURE, ecx1 & (1u << 28));
+		SET_CPU_FEATURE(features, FMA_CPU_FEATURE, ecx1 & (1u << 12));
+		SET_CPU_FEATURE(features, F16C_CPU_FEATURE, ecx1 & (1u << 29));
+	}
+
+	if (maxId >= 7)
+	{
+		CPUID_COUNT(7, 0, cpuInfo);
+		unsigned int ebx7 = cpuInfo[1], ecx7 = cpuInfo[2];
+		SET_CPU_FEATURE(features, BMI1_CPU_FEATURE, ebx7 & (1u << 3));
+		SET_CPU_FEATURE(features, BMI2_CPU_FEATURE, ebx7 & (1u << 8));
+		SET_CPU_FEATURE(features, SHA_CPU_FEATURE, ebx7 & (1u << 29));
+		if (isAvxState)
+			SET_CPU_FEATURE(features, AVX2_CPU_FEATURE, ebx7 & (1u << 5));
+
+		if (isAvx512State)
+		{
+			SET_CPU_FEATURE(features, AVX512F_CPU_FEATURE, ebx7 & (1u << 16));
+			SET_CPU_FEATURE(features, AVX512DQ_CPU_FEATURE, ebx7 & (1u << 17));
+			SET_CPU_FEATURE(features, AVX512CD_CPU_FEATURE, ebx7 & (1u << 28));
+			SET_CPU_FEATURE(features, AVX512BW_CPU_FEATURE, ebx7 & (1u << 30));
+			SET_CPU_FEATURE(features, AVX512VL_CPU_FEATURE, ebx7 & (1u << 31));
+			SET_CPU_FEATURE(features, AVX512VBMI_CPU_FEATURE, ecx7 & (1u << 1));
+			SET_CPU_FEATURE(features, AVX512VNNI_CPU_FEATURE, ecx7 & (1u << 11));
+		}
+	}
+#elif __linux__ && __aarch64__
+	unsigned long hwcap = getauxval(AT_HWCAP), hwcap2 = getauxval(AT_HWCAP2);
+	SET_CPU_FEATURE(features, NEON_CPU_FEATURE, hwcap & (1ul << 1));
+	SET_CPU_FEATURE(features, AES_CPU_FEATURE, hwcap & (1ul << 3));
+	SET_CPU_FEATURE(features, SHA_CPU_FEATURE, hwcap & (1ul << 6));
+	SET_CPU_FEATURE(features, CRC32_CPU_FEATURE, hwcap & (1ul << 7));
+	SET_CPU_FEATURE(features, DOTPROD_CPU_FEATURE, hwcap & (1ul << 20));
+	SET_CPU_FEATURE(features, SVE_CPU_FEATURE, hwcap & (1ul << 22));
+	SET_CPU_FEATURE(features, SVE2_CPU_FEATURE, hwcap2 & (1ul << 1));
+#elif __linux__ && __arm__
+	unsigned long hwcap = getauxval(AT_HWCAP), hwcap2 = getauxval(AT_HWCAP2);
+	SET_CPU_FEATURE(features, NEON_CPU_FEATURE, hwcap & (1ul << 12));
+	SET_CPU_FEATURE(features, AES_CPU_FEATURE, hwcap2 & (1ul << 0));
+	SET_CPU_FEATURE(features, SHA_CPU_FEATURE, hwcap2 & (1ul << 3));
+	SET_CPU_FEATURE(features, CRC32_CPU_FEATURE, hwcap2 & (1ul << 4));
+#elif __APPLE__ && __aarch64__
+	features |= CPU_FEATURE_BIT(NEON_CPU_FEATURE);
+	SET_CPU_FEATURE(features, AES_CPU_FEATURE, isSysctlFlagSet("hw.optional.arm.FEAT_AES"));
+	SET_CPU_FEATURE(features, SHA_CPU_FEATURE, isSysctlFlagSet("hw.optional.arm.FEAT_SHA256"));
+	SET_CPU_FEATURE(features, CRC32_CPU_FEATURE, isSysctlFlagSet("hw.optional.armv8_crc32"));
+	SET_CPU_FEATURE(features, DOTPROD_CPU_FEATURE, isSysctlFlagSet("hw.optional.arm.FEAT_DotProd"));
+#elif _WIN32 && _M_ARM64
+	// Note: Using raw values, older SDKs do not define all PF_ARM_* constants.
+	SET_CPU_FEATURE(features, NEON_CPU_FEATURE, IsProcessorFeaturePresent(19));
+	SET_CPU_FEATURE(features, AES_CPU_FEATURE, IsProcessorFeaturePresent(30));
+	SET_CPU_FEATURE(features, SHA_CPU_FEATURE, IsProcessorFeaturePresent(30));
+	SET_CPU_FEATURE(features, CRC32_CPU_FEATURE, IsProcessorFeaturePresent(31));
+	SET_CPU_FEATURE(features, DOTPROD_CPU_FEATURE, IsProcessorFeaturePresent(43));
+	SET_CPU_FEATURE(features, SVE_CPU_FEATURE, IsProcessorFeaturePresent(46));
+	SET_CPU_FEATURE(features, SVE2_CPU_FEATURE, IsProcessorFeaturePresent(47));
+#endif
+	return features;
+}
+
+//**********************************************************************************************************************
+static SystemInfo systemInfo;
+static CpuSet performanceCpuSet, efficiencyCpuSet;
+static bool isHybridCpu;
+
+static void initSystemInfo()
+{
+	memset(&systemInfo, 0, sizeof(SystemInfo));
+	char* cpuName = systemInfo.cpuName;
+	queryCpuName(cpuName);
+	systemInfo.cpuFeatures = queryCpuFeatures();
+
+#if __linux__
+	CpuInfoState* cpuInfo = calloc(1, sizeof(CpuInfoState));
+	if (cpuInfo)
+	{
+		cpuInfo->processorCount = -1;
+		cpuInfo->cpuName = cpuName;
+		parseProcFile("/proc/cpuinfo", parseCpuInfoLine, cpuInfo);
+	}
+
+	int logicalCpuCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (logicalCpuCount <= 0 && cpuInfo)
+		logicalCpuCount = cpuInfo->processorCount;
+
+	int physicalCpuCount = -1;
+	if (cpuInfo)
+	{
+		physicalCpuCount = cpuInfo->coreCount;
+		if (physicalCpuCount <= 0)
+			physicalCpuCount = cpuInfo->cpuCores;
+		if (physicalCpuCount <= 0)
+			physicalCpuCount = cpuInfo->processorCount;
+		free(cpuInfo);
+	}
+	if (physicalCpuCount <= 0)
+		physicalCpuCount = logicalCpuCount;
+
+	systemInfo.logicalCpuCount = logicalCpuCount;
+	systemInfo.physicalCpuCount = physicalCpuCount;
+#else
+	systemInfo.logicalCpuCount = queryLogicalCpuCount();
+	systemInfo.physicalCpuCount = queryPhysicalCpuCount();
+#endif
+
+	int performanceCpuCount = queryHybridCpuSets(&performanceCpuSet, &efficiencyCpuSet);
+	isHybridCpu = performanceCpuCount > 0;
+	if (performanceCpuCount <= 0)
+		performanceCpuCount = systemInfo.physicalCpuCount;
+	if (getCpuSetCount(&performanceCpuSet) == 0)
+	{
+		for (int i = 0; i < systemInfo.logicalCpuCount; i++)
+			addCpuToSet(&performanceCpuSet, i);
+	}
+	systemInfo.performanceCpuCount = performanceCpuCount;
+
+	if (cpuName[0] == '\0')
+		memcpy(cpuName, "Unknown", 8);
+
+	size_t nameLength = strlen(cpuName);
+	for (int64_t i = nameLength - 1; i > 0; i--)
+	{
+		if (cpuName[i] != ' ')
+		{
+			nameLength = i + 1;
+			break;
+		}
+	}
+	cpuName[nameLength] = '\0';
+
+	systemInfo.totalRamSize = queryTotalRamSize();
+	systemInfo.freeRamSize = queryFreeRamSize();
+}
+
+#if __linux__ || __APPLE__
+static pthread_once_t systemInfoOnce = PTHREAD_ONCE_INIT;
+inline static void initSystemInfoOnce()
+{
+	pthread_once(&systemInfoOnce, initSystemInfo);
+}
+#elif _WIN32
+static INIT_ONCE systemInfoOnce = INIT_ONCE_STATIC_INIT;
+static BOOL CALLBACK initSystemInfoCallback(PINIT_ONCE initOnce, PVOID parameter, PVOID* context)
+{
+	initSystemInfo();
+	return TRUE;
+}
+inline static void initSystemInfoOnce()
+{
+	InitOnceExecuteOnce(&systemInfoOnce, initSystemInfoCallback, NULL, NULL);
+}
+#endif
+
+void getSystemInfo(SystemInfo* info)
+{
+	assert(info);
+	initSystemInfoOnce();
+	*info = systemInfo;
+	info->totalRamSize = atomicLoad64(&systemInfo.totalRamSize);
+	info->freeRamSize = atomicLoad64(&systemInfo.freeRamSize);
+}
+bool updateSystemInfo()
+{
+	initSystemInfoOnce();
+	int64_t totalRamSize = queryTotalRamSize(), freeRamSize = queryFreeRamSize();
+	atomicStore64(&systemInfo.totalRamSize, totalRamSize);
+	atomicStore64(&systemInfo.freeRamSize, freeRamSize);
+	return totalRamSize >= 0 && freeRamSize >= 0;
+}
+
+//**********************************************************************************************************************
+int getLogicalCpuCount()
+{
+	initSystemInfoOnce();
+	return systemInfo.logicalCpuCount;
+}
+int getPhysicalCpuCount()
+{
+	initSystemInfoOnce();
+	return systemInfo.physicalCpuCount;
+}
+int getPerformanceCpuCount()
+{
+	initSystemInfoOnce();
+	return systemInfo.performanceCpuCount;
+}
+bool getHybridCpuSets(CpuSet* performanceCpus, CpuSet* efficiencyCpus)
+{
+	initSystemInfoOnce();
+	if (performanceCpus)
+		*performanceCpus = performanceCpuSet;
+	if (efficiencyCpus)
+		*efficiencyCpus = efficiencyCpuSet;
+	return isHybridCpu;
+}
+int64_t getTotalRamSize()
+{
+	initSystemInfoOnce();
+	return atomicLoad64(&systemInfo.totalRamSize);
+}
+int64_t getFreeRamSize()
+{
+	initSystemInfoOnce();
+	return atomicLoad64(&systemInfo.freeRamSize);
+}
+int getEffectiveCpuCount()
+{
+	int cpuCount = getLogicalCpuCount();
+#if __linux__ || _WIN32
+	int affinityCount = 0;
+	#if __linux__
+	cpu_set_t affinity;
+	if (sched_getaffinity(0, sizeof(cpu_set_t), &affinity) == 0)
+		affinityCount = CPU_COUNT(&affinity);
+	#else
+	DWORD_PTR processMask, systemMask;
+	if (GetActiveProcessorGroupCount() == 1 && GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+	{
+		for (; processMask; processMask &= processMask - 1)
+			affinityCount++;
+	}
+	#endif
+	if (affinityCount > 0 && (cpuCount <= 0 || affinityCount < cpuCount))
+		cpuCount = affinityCount;
+
+	double cpuLimit; int64_t memoryLimit;
+	#if __linux__
+	queryCgroupLimits(&cpuLimit, &memoryLimit);
+	#else
+	queryJobObjectLimits(&cpuLimit, &memoryLimit);
+	#endif
+
+	if (cpuLimit > 0.0)
+	{
+		int limitCount = (int)cpuLimit;
+		if ((double)limitCount < cpuLimit)
+			limitCount++;
+		if (cpuCount <= 0 || limitCount < cpuCount)
+			cpuCount = limitCount;
+	}
+#endif
+	return cpuCount > 0 ? cpuCount : 1;
+}
+int64_t getEffectiveRamSize()
+{
+	int64_t ramSize = getTotalRamSize();
+#if __linux__ || _WIN32
+	double cpuLimit; int64_t memoryLimit;
+	#if __linux__
+	queryCgroupLimits(&cpuLimit, &memoryLimit);
+	#else
+	queryJobObjectLimits(&cpuLimit, &memoryLimit);
+	#endif
+
+	if (memoryLimit > 0 && (ramSize < 0 || memoryLimit < ramSize))
+		ramSize = memoryLimit;
+#endif
+	return ramSize;
+}
+char* getCpuName()
+{
+	initSystemInfoOnce();
+	size_t nameLength = strlen(systemInfo.cpuName);
+	char* cpuName = malloc(nameLength + 1);
+	if (!cpuName)
+		return NULL;
+	memcpy(cpuName, systemInfo.cpuName, nameLength + 1);
+	return cpuName;
+}
+
+uint64_t getCpuFeatures()
+{
+	initSystemInfoOnce();
+	return systemInfo.cpuFeatures;
+}
+bool hasCpuFeature(CpuFeature feature)
+{
+	assert(feature < CPU_FEATURE_COUNT);
+	initSystemInfoOnce();
+	return (systemInfo.cpuFeatures & CPU_FEATURE_BIT(feature)) != 0;
+}
+
+static const char* const cpuFeatureNames[CPU_FEATURE_COUNT] =
+{
+	"SSE2", "SSE3", "SSSE3", "SSE4.1", "SSE4.2", "POPCNT", "AVX", "AVX2", "FMA", "F16C", "BMI1", "BMI2", "PCLMUL",
+	"AVX512F", "AVX512DQ", "AVX512CD", "AVX512BW", "AVX512VL", "AVX512VBMI", "AVX512VNNI",
+	"NEON", "SVE", "SVE2", "DOTPROD", "AES", "SHA", "CRC32",
+};
+
+const char* getCpuFeatureName(CpuFeature feature)
+{
+	assert(feature < CPU_FEATURE_COUNT);
+	return cpuFeatureNames[feature];
+}
+
+CpuFunction selectCpuFunction(const CpuFunctionVariant* variants, uint32_t count)
+{
+	assert(variants);
+	uint64_t features = getCpuFeatures();
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if ((variants[i].requiredFeatures & features) == variants[i].requiredFeatures)
+			return variants[i].function;
+	}
+	return NULL;
+}
+
+//**********************************************************************************************************************
+#if __linux__ || __APPLE__
+inline static int64_t timevalToNs(struct timeval time)
+{
+	return (int64_t)time.tv_sec * 1000000000 + (int64_t)time.tv_usec * 1000;
+}
+static void setRusage(const struct rusage* usage, ResourceUsage* resourceUsage)
+{
+	resourceUsage->userTimeNs = timevalToNs(usage->ru_utime);
+	resourceUsage->systemTimeNs = timevalToNs(usage->ru_stime);
+	#if __APPLE__
+	resourceUsage->peakRssSize = (int64_t)usage->ru_maxrss;
+	#else
+	resourceUsage->peakRssSize = (int64_t)usage->ru_maxrss * 1024;
+	#endif
+	resourceUsage->minorFaultCount = (int64_t)usage->ru_minflt;
+	resourceUsage->majorFaultCount = (int64_t)usage->ru_majflt;
+	resourceUsage->voluntarySwitchCount = (int64_t)usage->ru_nvcsw;
+	resourceUsage->involuntarySwitchCount = (int64_t)usage->ru_nivcsw;
+}
+#endif
+
+#if __linux__
+#define CLOSED_PROC_FILE -1
+#define MISSING_PROC_FILE -2
+
+static volatile int32_t statmFile = CLOSED_PROC_FILE, ioFile = CLOSED_PROC_FILE;
+
+// Note: Forked child would read the parent process files, because /proc/self is resolved on open.
+static void onResourceUsageFork()
+{
+	int32_t files[2] = { atomicLoad32(&statmFile), atomicLoad32(&ioFile) };
+	for (int i = 0; i < 2; i++)
+	{
+		if (files[i] >= 0)
+			close(files[i]);
+	}
+	atomicStore32(&statmFile, CLOSED_PROC_FILE);
+	atomicStore32(&ioFile, CLOSED_PROC_FILE);
+}
+static pthread_once_t resourceUsageOnce = PTHREAD_ONCE_INIT;
+static void initResourceUsage() { pthread_atfork(NULL, NULL, onResourceUsageFork); }
+
+// Note: Keeps the file open to skip the path lookup, read with pread() to avoid sharing the file offset.
+static ssize_t readProcFile(volatile int32_t* cachedFile, const char* path, char* buffer, size_t size)
+{
+	int32_t file = atomicLoad32(cachedFile);
+	if (file == MISSING_PROC_FILE)
+		return -1;
+
+	if (file == CLOSED_PROC_FILE)
 	{
-		const size_t bufferSize = 256;
-		char* line = malloc(bufferSize);
-		if (!line)
+		pthread_once(&resourceUsageOnce, initResourceUsage);
+		int newFile = open(path, O_RDONLY | O_CLOEXEC);
+		int32_t expected = CLOSED_PROC_FILE;
+		if (atomicCompareExchange32(cachedFile, &expected, newFile >= 0 ? newFile : MISSING_PROC_FILE))
 		{
-			fclose(file);
-			return -1;
+			file = newFile >= 0 ? newFile : MISSING_PROC_FILE;
 		}
-	
-		int64_t memFree = 0, buffers = 0, cached = 0, sReclaimable = 0;
-		while (fgets(line, bufferSize, file))
+		else
 		{
-			size_t lineLength = strlen(line);
-			if (lineLength == 0)
-				continue;
+			if (newFile >= 0)
+				close(newFile);
+			file = expected;
+		}
+		if (file < 0)
+			return -1;
+	}
 
-			if (memcmp(line, "MemAvailable", 12) == 0)
-			{
-				char* pointer = memchr(line + 12, ':', lineLength - 12);
-				if (!pointer)
-					continue;
-				memFree = atoll(pointer + 1);
-				free(line); fclose(file);
-				return memFree * 1024;
-			}
+	ssize_t readSize = pread(file, buffer, size - 1, 0);
+	if (readSize < 0)
+		return -1;
+	buffer[readSize] = '\0';
+	return readSize;
+}
+static int64_t parseProcValue(const char* text, const char* key)
+{
+	const char* value = strstr(text, key);
+	if (!value)
+		return -1;
+	return strtoll(value + strlen(key), NULL, 10);
+}
 
-			if (memcmp(line, "MemFree", 7) == 0)
-			{
-				char* pointer = memchr(line + 7, ':', lineLength - 7);
-				if (!pointer)
-					continue;
-				memFree = atoll(pointer + 1);
-			}
-			else if (memcmp(line, "Buffers", 7) == 0)
-			{
-				char* pointer = memchr(line + 7, ':', lineLength - 7);
-				if (!pointer)
-					continue;
-				buffers = atoll(pointer + 1);
-			}
-			else if (memcmp(line, "Cached", 6) == 0)
-			{
-				char* pointer = memchr(line + 6, ':', lineLength - 6);
-				if (!pointer)
-					continue;
-				cached = atoll(pointer + 1);
-			}
-			else if (memcmp(line, "SReclaimable", 12) == 0)
-			{
-				char* pointer = memchr(line + 12, ':', lineLength - 12);
-				if (!pointer)
-					continue;
-				sReclaimable = atoll(pointer + 1);
-			}
+static void queryProcessUsage(ResourceUsage* resourceUsage)
+{
+	char buffer[256];
+	if (readProcFile(&statmFile, "/proc/self/statm", buffer, sizeof(buffer)) > 0)
+	{
+		char* pageCount = NULL;
+		strtoll(buffer, &pageCount, 10); // Note: Skipping the total program size.
+		resourceUsage->currentRssSize = strtoll(pageCount, NULL, 10) * sysconf(_SC_PAGESIZE);
+
+		// Note: Kernel RSS counters are batched per CPU, so the peak can lag behind a bit.
+		if (resourceUsage->currentRssSize > resourceUsage->peakRssSize)
+			resourceUsage->peakRssSize = resourceUsage->currentRssSize;
+	}
+	if (readProcFile(&ioFile, "/proc/self/io", buffer, sizeof(buffer)) > 0)
+	{
+		resourceUsage->readSize = parseProcValue(buffer, "rchar:");
+		resourceUsage->writeSize = parseProcValue(buffer, "wchar:");
+		resourceUsage->diskReadSize = parseProcValue(buffer, "\nread_bytes:");
+		resourceUsage->diskWriteSize = parseProcValue(buffer, "\nwrite_bytes:");
+	}
+}
+#elif __APPLE__
+static void queryProcessUsage(ResourceUsage* resourceUsage)
+{
+	struct mach_task_basic_info taskInfo;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&taskInfo, &count) == KERN_SUCCESS)
+		resourceUsage->currentRssSize = (int64_t)taskInfo.resident_size;
+
+	struct rusage_info_v2 usageInfo;
+	if (proc_pid_rusage(getpid(), RUSAGE_INFO_V2, (rusage_info_t*)&usageInfo) == 0)
+	{
+		resourceUsage->diskReadSize = (int64_t)usageInfo.ri_diskio_bytesread;
+		resourceUsage->diskWriteSize = (int64_t)usageInfo.ri_diskio_byteswritten;
+	}
+}
+#elif _WIN32
+inline static int64_t fileTimeToNs(FILETIME fileTime)
+{
+	return (int64_t)(((uint64_t)fileTime.dwHighDateTime << 32) | fileTime.dwLowDateTime) * 100;
+}
+#endif
+
+bool getResourceUsage(ResourceUsageTarget target, ResourceUsage* resourceUsage)
+{
+	assert(target < RESOURCE_USAGE_TARGET_COUNT);
+	assert(resourceUsage);
+
+	memset(resourceUsage, 0xFF, sizeof(ResourceUsage)); // Note: Sets all counters to the -1.
+
+#if __linux__ || __APPLE__
+	struct rusage usage;
+	if (target == THREAD_RESOURCE_USAGE_TARGET)
+	{
+	#if __linux__
+		if (getrusage(RUSAGE_THREAD, &usage) != 0)
+			return false;
+		setRusage(&usage, resourceUsage);
+		resourceUsage->peakRssSize = -1; // Note: Returns process wide value.
+	#else
+		thread_basic_info_data_t threadInfo;
+		mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+		if (thread_info(pthread_mach_thread_np(pthread_self()), THREAD_BASIC_INFO,
+			(thread_info_t)&threadInfo, &count) != KERN_SUCCESS)
+		{
+			return false;
 		}
-		free(line); fclose(file);
+		resourceUsage->userTimeNs = (int64_t)threadInfo.user_time.seconds * 1000000000 +
+			(int64_t)threadInfo.user_time.microseconds * 1000;
+		resourceUsage->systemTimeNs = (int64_t)threadInfo.system_time.seconds * 1000000000 +
+			(int64_t)threadInfo.system_time.microseconds * 1000;
+	#endif
+		return true;
+	}
 
-		return (memFree + buffers + cached + sReclaimable) * 1024;
+	if (getrusage(target == PROCESS_RESOURCE_USAGE_TARGET ? RUSAGE_SELF : RUSAGE_CHILDREN, &usage) != 0)
+		return false;
+	setRusage(&usage, resourceUsage);
+	if (target == PROCESS_RESOURCE_USAGE_TARGET)
+		queryProcessUsage(resourceUsage);
+	return true;
+#elif _WIN32
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (target == THREAD_RESOURCE_USAGE_TARGET)
+	{
+		if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime) == FALSE)
+			return false;
+		resourceUsage->userTimeNs = fileTimeToNs(userTime);
+		resourceUsage->systemTimeNs = fileTimeToNs(kernelTime);
+		return true;
 	}
+	if (target == CHILDREN_RESOURCE_USAGE_TARGET)
+		return false;
 
-	struct sysinfo info;
-	if (sysinfo(&info) != 0)
+	HANDLE process = GetCurrentProcess();
+	if (GetProcessTimes(process, &creationTime, &exitTime, &kernelTime, &userTime) == FALSE)
+		return false;
+	resourceUsage->userTimeNs = fileTimeToNs(userTime);
+	resourceUsage->systemTimeNs = fileTimeToNs(kernelTime);
+
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(process, &counters, sizeof(PROCESS_MEMORY_COUNTERS)) != FALSE)
+	{
+		resourceUsage->currentRssSize = (int64_t)counters.WorkingSetSize;
+		resourceUsage->peakRssSize = (int64_t)counters.PeakWorkingSetSize;
+		resourceUsage->minorFaultCount = (int64_t)counters.PageFaultCount;
+	}
+
+	IO_COUNTERS ioCounters;
+	if (GetProcessIoCounters(process, &ioCounters) != FALSE)
+	{
+		resourceUsage->readSize = (int64_t)ioCounters.ReadTransferCount;
+		resourceUsage->writeSize = (int64_t)ioCounters.WriteTransferCount;
+	}
+	return true;
+#endif
+}
+
+int64_t getThreadCpuTimeNs()
+{
+#if __linux__ || __APPLE__
+	struct timespec time;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
 		return -1;
-	return (int64_t)info.freeram * (int64_t)info.mem_unit;
-#elif __APPLE__
-	mach_msg_type_number_t count = HOST_VM_INFO64_COUNT; vm_statistics64_data_t vmStat;
-	if (host_statistics64(mach_host_self(), HOST_VM_INFO64, (host_info64_t)&vmStat, &count) != KERN_SUCCESS)
+	return (int64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+#elif _WIN32
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime) == FALSE)
 		return -1;
-	return (vmStat.inactive_count + vmStat.free_count + vmStat.speculative_count) * (int64_t)getpagesize();
+	return fileTimeToNs(userTime) + fileTimeToNs(kernelTime);
+#endif
+}
+int64_t getProcessCpuTimeNs()
+{
+#if __linux__ || __APPLE__
+	struct timespec time;
+	if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0)
+		return -1;
+	return (int64_t)time.tv_sec * 1000000000 + time.tv_nsec;
 #elif _WIN32
-	MEMORYSTATUSEX statex;
-	statex.dwLength = sizeof(statex);
-	if (GlobalMemoryStatusEx(&statex) == FALSE)
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime) == FALSE)
 		return -1;
-	return statex.ullAvailPhys;
+	return fileTimeToNs(userTime) + fileTimeToNs(kernelTime);
 #endif
 }
 
 //**********************************************************************************************************************
-char* getCpuName()
+static bool addUniqueCpuSet(CpuSet** cpuSets, int* count, int* capacity, const CpuSet* cpuSet)
 {
-	char* cpuName = calloc(65, sizeof(char));
-	if (!cpuName)
-		return NULL;
+	for (int i = 0; i < *count; i++)
+	{
+		if (isCpuSetEqual(&(*cpuSets)[i], cpuSet))
+			return true;
+	}
 
-#if __x86_64__ || _M_X64 || __i386__
-	unsigned int cpuInfo[4] = { 0, 0, 0, 0 };
-	CPUID(0x80000000, cpuInfo);
+	if (*count == *capacity)
+	{
+		int newCapacity = *capacity > 0 ? *capacity * 2 : 8;
+		CpuSet* newCpuSets = realloc(*cpuSets, newCapacity * sizeof(CpuSet));
+		if (!newCpuSets)
+			return false;
+		*cpuSets = newCpuSets; *capacity = newCapacity;
+	}
 
-	unsigned int nExIds = cpuInfo[0];
-	for (unsigned int i = 0x80000000; i <= nExIds; ++i)
+	(*cpuSets)[(*count)++] = *cpuSet;
+	return true;
+}
+static bool addUniqueCpuCache(CpuTopology* cpuTopology, int* capacity, const CpuCache* cache)
+{
+	for (int i = 0; i < cpuTopology->cacheCount; i++)
 	{
-		CPUID(i, cpuInfo);
-		if (i == 0x80000002)
-			memcpy(cpuName, cpuInfo, sizeof(cpuInfo));
-		else if (i == 0x80000003)
-			memcpy(cpuName + 16, cpuInfo, sizeof(cpuInfo));
-		else if (i == 0x80000004)
-			memcpy(cpuName + 32, cpuInfo, sizeof(cpuInfo));
+		const CpuCache* other = &cpuTopology->caches[i];
+		if (other->level == cache->level && other->type == cache->type && isCpuSetEqual(&other->cpus, &cache->cpus))
+			return true;
 	}
-#else
-	memcpy(cpuName, "Unknown\0", 8);
 
-	#if __APPLE__
-	size_t brandLength = 64;
-	sysctlbyname("machdep.cpu.brand_string", cpuName, &brandLength, NULL, 0);
-	#else
-	FILE* file = fopen("/proc/cpuinfo", "r");
-	if (file)
+	if (cpuTopology->cacheCount == *capacity)
+	{
+		int newCapacity = *capacity > 0 ? *capacity * 2 : 8;
+		CpuCache* newCaches = realloc(cpuTopology->caches, newCapacity * sizeof(CpuCache));
+		if (!newCaches)
+			return false;
+		cpuTopology->caches = newCaches; *capacity = newCapacity;
+	}
+
+	cpuTopology->caches[cpuTopology->cacheCount++] = *cache;
+	return true;
+}
+static bool isCpuCacheFound(const CpuTopology* cpuTopology, uint8_t level, CpuCacheType type, int cpu)
+{
+	for (int i = 0; i < cpuTopology->cacheCount; i++)
+	{
+		const CpuCache* cache = &cpuTopology->caches[i];
+		if (cache->level == level && cache->type == type && isCpuInSet(&cache->cpus, cpu))
+			return true;
+	}
+	return false;
+}
+
+#if __linux__
+static int64_t parseCacheSize(const char* value)
+{
+	char* end;
+	int64_t size = strtoll(value, &end, 10);
+	if (*end == 'K')
+		size *= 1024;
+	else if (*end == 'M')
+		size *= 1024 * 1024;
+	else if (*end == 'G')
+		size *= 1024 * 1024 * 1024;
+	return size;
+}
+
+static bool fillCpuTopology(CpuTopology* cpuTopology)
+{
+	char buffer[4096], path[128];
+	int coreCapacity = 0, packageCapacity = 0, nodeCapacity = 0, cacheCapacity = 0;
+
+	readOnlineCpus(&cpuTopology->onlineCpus);
+
+	for (int cpu = 0; cpu < MAX_CPU_SET_COUNT; cpu++)
 	{
-		const size_t bufferSize = 256;
-		char* line = malloc(bufferSize);
-		if (!line)
+		if (!isCpuInSet(&cpuTopology->onlineCpus, cpu))
+			continue;
+
+		CpuSet cpuSet;
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+		if (readSysFile(path, buffer, sizeof(buffer)))
+			parseCpuList(buffer, &cpuSet);
+		else
 		{
-			fclose(file);
-			return cpuName;
+			clearCpuSet(&cpuSet); addCpuToSet(&cpuSet, cpu);
 		}
+		if (!addUniqueCpuSet(&cpuTopology->cores, &cpuTopology->coreCount, &coreCapacity, &cpuSet))
+			return false;
 
-		while (fgets(line, bufferSize, file))
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/package_cpus_list", cpu);
+		if (readSysFile(path, buffer, sizeof(buffer)))
+			parseCpuList(buffer, &cpuSet);
+		else
 		{
-			size_t lineLength = strlen(line);
-			if (lineLength == 0 || memcmp(line, "model name", 10) != 0 && memcmp(line, "Model", 5) != 0)
-				continue;
-			char* pointer = memchr(line + 5, ':', lineLength - 5);
-			if (!pointer)
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_siblings_list", cpu);
+			if (readSysFile(path, buffer, sizeof(buffer)))
+				parseCpuList(buffer, &cpuSet);
+			else
+				cpuSet = cpuTopology->onlineCpus;
+		}
+		if (!addUniqueCpuSet(&cpuTopology->packages, &cpuTopology->packageCount, &packageCapacity, &cpuSet))
+			return false;
+
+		for (int index = 0; index < 16; index++)
+		{
+			CpuCache cache;
+			memset(&cache, 0, sizeof(CpuCache));
+
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/level", cpu, index);
+			if (!readSysFile(path, buffer, sizeof(buffer)))
+				break;
+			cache.level = (uint8_t)atoi(buffer);
+
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/type", cpu, index);
+			if (readSysFile(path, buffer, sizeof(buffer)))
+			{
+				if (strcmp(buffer, "Data") == 0)
+					cache.type = DATA_CPU_CACHE_TYPE;
+				else if (strcmp(buffer, "Instruction") == 0)
+					cache.type = INSTRUCTION_CPU_CACHE_TYPE;
+			}
+
+			if (isCpuCacheFound(cpuTopology, cache.level, cache.type, cpu))
+				continue; // Note: Already added by one of the sharing CPUs.
+
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/size", cpu, index);
+			if (readSysFile(path, buffer, sizeof(buffer)))
+				cache.size = parseCacheSize(buffer);
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/coherency_line_size", cpu, index);
+			if (readSysFile(path, buffer, sizeof(buffer)))
+				cache.lineSize = atoi(buffer);
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/ways_of_associativity", cpu, index);
+			if (readSysFile(path, buffer, sizeof(buffer)))
+				cache.associativity = atoi(buffer);
+
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+			if (readSysFile(path, buffer, sizeof(buffer)))
+				parseCpuList(buffer, &cache.cpus);
+			else
+				addCpuToSet(&cache.cpus, cpu);
+
+			if (!addUniqueCpuCache(cpuTopology, &cacheCapacity, &cache))
+				return false;
+		}
+	}
+
+	CpuSet nodeIds;
+	if (readSysFile("/sys/devices/system/node/online", buffer, sizeof(buffer)))
+	{
+		parseCpuList(buffer, &nodeIds);
+		for (int node = 0; node < MAX_CPU_SET_COUNT; node++)
+		{
+			if (!isCpuInSet(&nodeIds, node))
 				continue;
 
-			size_t index = (pointer - line) + 2;
-			if (index >= lineLength)
+			CpuSet cpuSet;
+			snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+			if (!readSysFile(path, buffer, sizeof(buffer)))
 				continue;
+			parseCpuList(buffer, &cpuSet);
+			if (getCpuSetCount(&cpuSet) == 0)
+				continue; // Note: Memory-only NUMA node.
+			if (!addUniqueCpuSet(&cpuTopology->nodes, &cpuTopology->nodeCount, &nodeCapacity, &cpuSet))
+				return false;
+		}
+	}
+	if (cpuTopology->nodeCount == 0 && !addUniqueCpuSet(&cpuTopology->nodes,
+		&cpuTopology->nodeCount, &nodeCapacity, &cpuTopology->onlineCpus))
+	{
+		return false;
+	}
+	return true;
+}
+#elif __APPLE__
+static bool fillCpuTopology(CpuTopology* cpuTopology)
+{
+	int coreCapacity = 0, packageCapacity = 0, nodeCapacity = 0, cacheCapacity = 0;
+	int logicalCpuCount = getLogicalCpuCount(), physicalCpuCount = getPhysicalCpuCount();
+	if (logicalCpuCount <= 0)
+		return false;
+
+	for (int i = 0; i < logicalCpuCount; i++)
+		addCpuToSet(&cpuTopology->onlineCpus, i);
+
+	int smtCount = physicalCpuCount > 0 ? logicalCpuCount / physicalCpuCount : 1;
+	if (smtCount <= 0)
+		smtCount = 1;
 
-			for (size_t i = index; i < lineLength; i++)
+	for (int i = 0; i < logicalCpuCount; i += smtCount)
+	{
+		CpuSet cpuSet; clearCpuSet(&cpuSet);
+		for (int j = i; j < i + smtCount && j < logicalCpuCount; j++)
+			addCpuToSet(&cpuSet, j);
+		if (!addUniqueCpuSet(&cpuTopology->cores, &cpuTopology->coreCount, &coreCapacity, &cpuSet))
+			return false;
+	}
+
+	if (!addUniqueCpuSet(&cpuTopology->packages, &cpuTopology->packageCount,
+		&packageCapacity, &cpuTopology->onlineCpus))
+	{
+		return false;
+	}
+	if (!addUniqueCpuSet(&cpuTopology->nodes, &cpuTopology->nodeCount, &nodeCapacity, &cpuTopology->onlineCpus))
+		return false;
+
+	int64_t lineSize = 0; size_t size = sizeof(int64_t);
+	sysctlbyname("hw.cachelinesize", &lineSize, &size, NULL, 0);
+
+	uint64_t cacheConfig[10], cacheSizes[10];
+	size_t configSize = sizeof(cacheConfig), sizesSize = sizeof(cacheSizes);
+	memset(cacheConfig, 0, sizeof(cacheConfig)); memset(cacheSizes, 0, sizeof(cacheSizes));
+	if (sysctlbyname("hw.cacheconfig", cacheConfig, &configSize, NULL, 0) != 0 ||
+		sysctlbyname("hw.cachesize", cacheSizes, &sizesSize, NULL, 0) != 0)
+	{
+		return true; // Note: Cache information is not available.
+	}
+
+	int64_t instructionSize = 0; size = sizeof(int64_t);
+	sysctlbyname("hw.l1icachesize", &instructionSize, &size, NULL, 0);
+
+	// Note: Index 0 describes the main memory, assuming sharing CPUs are numbered consecutively.
+	for (int level = 1; level < 10 && cacheConfig[level] > 0 && cacheSizes[level] > 0; level++)
+	{
+		int shareCount = (int)cacheConfig[level];
+		for (int i = 0; i < logicalCpuCount; i += shareCount)
+		{
+			CpuCache cache;
+			memset(&cache, 0, sizeof(CpuCache));
+			for (int j = i; j < i + shareCount && j < logicalCpuCount; j++)
+				addCpuToSet(&cache.cpus, j);
+			cache.size = (int64_t)cacheSizes[level];
+			cache.lineSize = (int)lineSize;
+			cache.level = (uint8_t)level;
+			cache.type = level == 1 ? DATA_CPU_CACHE_TYPE : UNIFIED_CPU_CACHE_TYPE;
+			if (!addUniqueCpuCache(cpuTopology, &cacheCapacity, &cache))
+				return false;
+
+			if (level == 1 && instructionSize > 0)
 			{
-				char value = line[i];
-				if (value != '\n' && value != '\0')
-					continue;
-
-				if (i > 64)
-				{
-					free(line); fclose(file);
-					return cpuName;
-				}
-
-				size_t count = i - index;
-				memcpy(cpuName, line + index, count);
-				cpuName[count] = '\0';
-				break;
+				cache.size = instructionSize;
+				cache.type = INSTRUCTION_CPU_CACHE_TYPE;
+				if (!addUniqueCpuCache(cpuTopology, &cacheCapacity, &cache))
+					return false;
 			}
 		}
-		free(line); fclose(file);
 	}
-	#endif
-#endif
+	return true;
+}
+#elif _WIN32
+static void addGroupAffinity(CpuSet* cpuSet, const GROUP_AFFINITY* affinity)
+{
+	for (int i = 0; i < 64; i++)
+	{
+		if ((affinity->Mask >> i) & 1)
+			addCpuToSet(cpuSet, affinity->Group * 64 + i);
+	}
+}
+static bool fillCpuTopology(CpuTopology* cpuTopology)
+{
+	int coreCapacity = 0, packageCapacity = 0, nodeCapacity = 0, cacheCapacity = 0;
 
-	size_t nameLength = strlen(cpuName);
-	for (int64_t i = nameLength - 1; i > 0; i--)
+	DWORD infoSize = 0; GetLogicalProcessorInformationEx(RelationAll, NULL, &infoSize);
+	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+		return false;
+
+	char* infoBuffer = malloc(infoSize);
+	if (!infoBuffer)
+		return false;
+
+	PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)infoBuffer;
+	if (GetLogicalProcessorInformationEx(RelationAll, info, &infoSize) != TRUE)
 	{
-		if (cpuName[i] != ' ')
+		free(infoBuffer);
+		return false;
+	}
+
+	size_t offset = 0; bool result = true;
+	while (offset < infoSize && result)
+	{
+		const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX currentInfo =
+			(const PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(infoBuffer + offset);
+		CpuSet cpuSet; clearCpuSet(&cpuSet);
+
+		if (currentInfo->Relationship == RelationProcessorCore)
 		{
-			nameLength = i + 1;
-			break;
+			for (WORD i = 0; i < currentInfo->Processor.GroupCount; i++)
+				addGroupAffinity(&cpuSet, &currentInfo->Processor.GroupMask[i]);
+			for (int i = 0; i < MAX_CPU_SET_COUNT / 64; i++)
+				cpuTopology->onlineCpus.bits[i] |= cpuSet.bits[i];
+			result = addUniqueCpuSet(&cpuTopology->cores, &cpuTopology->coreCount, &coreCapacity, &cpuSet);
+		}
+		else if (currentInfo->Relationship == RelationProcessorPackage)
+		{
+			for (WORD i = 0; i < currentInfo->Processor.GroupCount; i++)
+				addGroupAffinity(&cpuSet, &currentInfo->Processor.GroupMask[i]);
+			result = addUniqueCpuSet(&cpuTopology->packages, &cpuTopology->packageCount, &packageCapacity, &cpuSet);
+		}
+		else if (currentInfo->Relationship == RelationNumaNode)
+		{
+			addGroupAffinity(&cpuSet, &currentInfo->NumaNode.GroupMask);
+			result = addUniqueCpuSet(&cpuTopology->nodes, &cpuTopology->nodeCount, &nodeCapacity, &cpuSet);
+		}
+		else if (currentInfo->Relationship == RelationCache && currentInfo->Cache.Type != CacheTrace)
+		{
+			CpuCache cache;
+			memset(&cache, 0, sizeof(CpuCache));
+			addGroupAffinity(&cache.cpus, &currentInfo->Cache.GroupMask);
+			cache.size = currentInfo->Cache.CacheSize;
+			cache.lineSize = currentInfo->Cache.LineSize;
+			cache.associativity = currentInfo->Cache.Associativity == CACHE_FULLY_ASSOCIATIVE ?
+				0 : currentInfo->Cache.Associativity;
+			cache.level = currentInfo->Cache.Level;
+			if (currentInfo->Cache.Type == CacheData)
+				cache.type = DATA_CPU_CACHE_TYPE;
+			else if (currentInfo->Cache.Type == CacheInstruction)
+				cache.type = INSTRUCTION_CPU_CACHE_TYPE;
+			result = addUniqueCpuCache(cpuTopology, &cacheCapacity, &cache);
 		}
+		offset += currentInfo->Size;
 	}
-	cpuName[nameLength] = '\0';
 
-	char* newCpuName = realloc(cpuName, nameLength + 1);
-	if (!newCpuName)
+	free(infoBuffer);
+	return result;
+}
+#endif
+
+CpuTopology* createCpuTopology()
+{
+	CpuTopology* cpuTopology = calloc(1, sizeof(CpuTopology));
+	if (!cpuTopology)
+		return NULL;
+
+	if (!fillCpuTopology(cpuTopology))
 	{
-		free(cpuName);
+		destroyCpuTopology(cpuTopology);
 		return NULL;
 	}
-	return newCpuName;
+
+	int cacheLineSize = 0;
+	for (int i = 0; i < cpuTopology->cacheCount; i++)
+	{
+		const CpuCache* cache = &cpuTopology->caches[i];
+		if (cache->level > cpuTopology->lastCacheLevel)
+			cpuTopology->lastCacheLevel = cache->level;
+		if (cache->type != INSTRUCTION_CPU_CACHE_TYPE && cache->lineSize > 0 &&
+			(cacheLineSize == 0 || cache->lineSize < cacheLineSize))
+		{
+			cacheLineSize = cache->lineSize;
+		}
+	}
+	cpuTopology->cacheLineSize = cacheLineSize > 0 ? cacheLineSize : 64;
+	return cpuTopology;
+}
+void destroyCpuTopology(CpuTopology* cpuTopology)
+{
+	if (!cpuTopology)
+		return;
+	free(cpuTopology->nodes);
+	free(cpuTopology->packages);
+	free(cpuTopology->cores);
+	free(cpuTopology->caches);
+	free(cpuTopology);
+}
+int64_t getCpuCacheSize(const CpuTopology* cpuTopology, uint8_t level)
+{
+	assert(cpuTopology);
+	int64_t size = 0;
+	for (int i = 0; i < cpuTopology->cacheCount; i++)
+	{
+		const CpuCache* cache = &cpuTopology->caches[i];
+		if (cache->level == level && cache->type != INSTRUCTION_CPU_CACHE_TYPE && cache->size > size)
+			size = cache->size;
+	}
+	return size;
 }
 
 //**********************************************************************************************************************
@@ -470,25 +2015,7 @@ int executeFileA(const char* filePath, char** args)
 {
 	assert(filePath);
 	assert(args);
-
-#if __linux__ || __APPLE__
-	pid_t pid = fork();
-	if (pid < 0)
-		return -1;
-
-	if (pid == 0)
-	{
-		execvp(filePath, args);
-		_exit(1);
-	}
-
-	int status = 0; waitpid(pid, &status, 0);
-	if (!WIFEXITED(status))
-		return -1;
-	return WEXITSTATUS(status);
-#elif _WIN32
-	return _spawnvp(_P_WAIT, filePath, args);
-#endif
+	return runProcess(filePath, args, NULL, NULL);
 }
 int executeFileVA(const char* filePath, va_list args)
 {
@@ -519,7 +2046,9 @@ int executeFileVA(const char* filePath, va_list args)
 	}
 	while (arg != NULL);
 
-	return executeFileA(filePath, argv);
+	int exitCode = executeFileA(filePath, argv);
+	free(argv);
+	return exitCode;
 }
 int executeFile(const char* filePath, ...)
 {
@@ -0,0 +1,1198 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "mpio/process.h"
+#include "mpio/thread.h"
+#include "mpio/os.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if __linux__ || __APPLE__
+#include <poll.h>
+#include <spawn.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#if __linux__
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#endif
+
+extern char** environ;
+#elif _WIN32
+#include <windows.h>
+#define PSAPI_VERSION 2 // Note: Uses K32GetProcessMemoryInfo() from the kernel32.
+#include <psapi.h>
+#else
+#error Unknown operating system
+#endif
+
+#define PROCESS_PIPE_BUFFER_SIZE 65536
+#define PROCESS_POLL_DELAY 1000000 // Note: In nanoseconds.
+
+#if __linux__ || __APPLE__
+typedef pid_t NativeProcess;
+typedef int NativePipe;
+#define INVALID_NATIVE_PROCESS -1
+#define INVALID_NATIVE_PIPE -1
+#elif _WIN32
+typedef HANDLE NativeProcess;
+typedef HANDLE NativePipe;
+#define INVALID_NATIVE_PROCESS NULL
+#define INVALID_NATIVE_PIPE NULL
+#endif
+
+struct Process_T
+{
+	int64_t startTime;
+	NativeProcess native;
+	int fd;
+	bool hasExited;
+	bool isWatched;
+	ProcessStats stats;
+};
+
+typedef struct CaptureBuffer
+{
+	char* data;
+	size_t size;
+	size_t capacity;
+} CaptureBuffer;
+
+static bool appendCaptureBuffer(CaptureBuffer* buffer, const char* data, size_t size)
+{
+	if (buffer->size + size + 1 > buffer->capacity)
+	{
+		size_t capacity = buffer->capacity > 0 ? buffer->capacity : 4096;
+		while (buffer->size + size + 1 > capacity)
+			capacity *= 2;
+		char* newData = realloc(buffer->data, capacity);
+		if (!newData)
+			return false;
+		buffer->data = newData; buffer->capacity = capacity;
+	}
+
+	memcpy(buffer->data + buffer->size, data, size);
+	buffer->size += size;
+	buffer->data[buffer->size] = '\0';
+	return true;
+}
+
+inline static ProcessStream getStreamType(const ProcessOptions* options, int index)
+{
+	return index == 0 ? options->stdinType : (index == 1 ? options->stdoutType : options->stderrType);
+}
+inline static const char* getStreamPath(const ProcessOptions* options, int index)
+{
+	return index == 0 ? options->stdinPath : (index == 1 ? options->stdoutPath : options->stderrPath);
+}
+
+#if __linux__ || __APPLE__
+//**********************************************************************************************************************
+static bool createPipe(int* fds)
+{
+#if __linux__
+	return pipe2(fds, O_CLOEXEC) == 0;
+#else
+	if (pipe(fds) != 0)
+		return false;
+	fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+	fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+	return true;
+#endif
+}
+
+// Note: posix_spawn() uses vfork / clone(CLONE_VM), it does not copy parent page tables like the fork().
+static NativeProcess spawnProcess(const char* filePath, char** args,
+	const ProcessOptions* options, NativePipe* parentPipes)
+{
+	parentPipes[0] = parentPipes[1] = parentPipes[2] = INVALID_NATIVE_PIPE;
+	int childPipes[3] = { -1, -1, -1 };
+
+	posix_spawn_file_actions_t actions;
+	if (posix_spawn_file_actions_init(&actions) != 0)
+		return INVALID_NATIVE_PROCESS;
+
+	bool result = true;
+	for (int i = 0; i < 3 && result; i++)
+	{
+		ProcessStream type = getStreamType(options, i);
+		int flags = i == 0 ? O_RDONLY : O_WRONLY | O_CREAT | O_TRUNC;
+
+		if (type == NULL_PROCESS_STREAM)
+		{
+			result = posix_spawn_file_actions_addopen(&actions, i, "/dev/null", flags, 0) == 0;
+		}
+		else if (type == FILE_PROCESS_STREAM)
+		{
+			const char* path = getStreamPath(options, i);
+			result = path && posix_spawn_file_actions_addopen(&actions, i, path, flags, 0644) == 0;
+		}
+		else if (type == PIPE_PROCESS_STREAM)
+		{
+			int fds[2];
+			if (!createPipe(fds))
+			{
+				result = false;
+				break;
+			}
+			childPipes[i] = i == 0 ? fds[0] : fds[1];
+			parentPipes[i] = i == 0 ? fds[1] : fds[0];
+			result = posix_spawn_file_actions_adddup2(&actions, childPipes[i], i) == 0;
+		}
+	}
+
+	if (result && options->workingDirectory)
+	{
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 29)
+		result = false; // Note: Not supported by the old glibc versions.
+#else
+		result = posix_spawn_file_actions_addchdir_np(&actions, options->workingDirectory) == 0;
+#endif
+	}
+
+	pid_t pid = INVALID_NATIVE_PROCESS;
+	if (result)
+	{
+		char** environment = options->environment ? (char**)options->environment : environ;
+		if (posix_spawnp(&pid, filePath, &actions, NULL, args, environment) != 0)
+			pid = INVALID_NATIVE_PROCESS;
+	}
+	posix_spawn_file_actions_destroy(&actions);
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (childPipes[i] != -1)
+			close(childPipes[i]);
+		if (pid == INVALID_NATIVE_PROCESS && parentPipes[i] != INVALID_NATIVE_PIPE)
+		{
+			close(parentPipes[i]);
+			parentPipes[i] = INVALID_NATIVE_PIPE;
+		}
+	}
+	return pid;
+}
+
+static bool communicateProcess(NativePipe* pipes, const void* inputData, size_t inputSize, CaptureBuffer* captures)
+{
+	size_t inputOffset = 0;
+	if (pipes[0] != -1)
+	{
+		if (inputSize == 0)
+		{
+			close(pipes[0]);
+			pipes[0] = -1;
+		}
+		else
+		{
+			fcntl(pipes[0], F_SETFL, fcntl(pipes[0], F_GETFL) | O_NONBLOCK);
+#if __APPLE__
+			fcntl(pipes[0], F_SETNOSIGPIPE, 1);
+#endif
+		}
+	}
+
+#if __linux__
+	// Note: Child can exit without reading the input, blocking SIGPIPE to get EPIPE error instead.
+	sigset_t pipeSignals, oldSignals;
+	sigemptyset(&pipeSignals); sigaddset(&pipeSignals, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &pipeSignals, &oldSignals);
+#endif
+
+	char buffer[PROCESS_PIPE_BUFFER_SIZE];
+	bool result = true;
+
+	while (pipes[0] != -1 || pipes[1] != -1 || pipes[2] != -1)
+	{
+		struct pollfd pollFds[3]; int indices[3]; nfds_t count = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			if (pipes[i] == -1)
+				continue;
+			pollFds[count].fd = pipes[i];
+			pollFds[count].events = i == 0 ? POLLOUT : POLLIN;
+			pollFds[count].revents = 0;
+			indices[count++] = i;
+		}
+
+		if (poll(pollFds, count, -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			result = false;
+			break;
+		}
+
+		for (nfds_t j = 0; j < count; j++)
+		{
+			int i = indices[j];
+			if (pollFds[j].revents == 0)
+				continue;
+
+			if (i == 0)
+			{
+				size_t size = inputSize - inputOffset;
+				ssize_t written = write(pipes[0], (const uint8_t*)inputData + inputOffset,
+					size < PROCESS_PIPE_BUFFER_SIZE ? size : PROCESS_PIPE_BUFFER_SIZE);
+				if (written < 0 && (errno == EAGAIN || errno == EINTR))
+					continue;
+				if (written > 0)
+					inputOffset += (size_t)written;
+				if (written < 0 || inputOffset == inputSize)
+				{
+					close(pipes[0]);
+					pipes[0] = -1;
+				}
+			}
+			else
+			{
+				ssize_t readSize = read(pipes[i], buffer, sizeof(buffer));
+				if (readSize < 0 && (errno == EAGAIN || errno == EINTR))
+					continue;
+				if (readSize > 0 && appendCaptureBuffer(&captures[i - 1], buffer, (size_t)readSize))
+					continue;
+				if (readSize > 0)
+					result = false;
+				close(pipes[i]);
+				pipes[i] = -1;
+			}
+		}
+	}
+
+#if __linux__
+	if (!sigismember(&oldSignals, SIGPIPE))
+	{
+		sigset_t pendingSignals; sigpending(&pendingSignals);
+		if (sigismember(&pendingSignals, SIGPIPE))
+		{
+			struct timespec timeout = { 0, 0 };
+			sigtimedwait(&pipeSignals, NULL, &timeout);
+		}
+	}
+	pthread_sigmask(SIG_SETMASK, &oldSignals, NULL);
+#endif
+	return result;
+}
+
+static int waitNativeProcess(NativeProcess process)
+{
+	int status = 0;
+	while (waitpid(process, &status, 0) == -1)
+	{
+		if (errno != EINTR)
+			return -1;
+	}
+	if (!WIFEXITED(status))
+		return -1;
+	return WEXITSTATUS(status);
+}
+
+// Note: Collects process resource usage while reaping it, the rusage has a peak RSS in kilobytes (bytes on macOS).
+static bool reapProcess(Process process, bool wait)
+{
+	int status = 0; struct rusage usage;
+	pid_t result;
+	do
+	{
+		result = wait4(process->native, &status, wait ? 0 : WNOHANG, &usage);
+	} while (result == -1 && errno == EINTR);
+
+	if (result == 0)
+		return false;
+
+	ProcessStats* stats = &process->stats;
+	stats->wallTimeNs = getCurrentClockNs() - process->startTime;
+	if (result == -1)
+	{
+		stats->userTimeNs = stats->systemTimeNs = 0;
+		stats->peakRssSize = -1; stats->exitCode = -1;
+	}
+	else
+	{
+		stats->userTimeNs = (int64_t)usage.ru_utime.tv_sec * 1000000000 + (int64_t)usage.ru_utime.tv_usec * 1000;
+		stats->systemTimeNs = (int64_t)usage.ru_stime.tv_sec * 1000000000 + (int64_t)usage.ru_stime.tv_usec * 1000;
+#if __APPLE__
+		stats->peakRssSize = (int64_t)usage.ru_maxrss;
+#else
+		stats->peakRssSize = (int64_t)usage.ru_maxrss * 1024;
+#endif
+		stats->exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+	}
+
+#if __linux__
+	if (process->fd != -1)
+	{
+		close(process->fd);
+		process->fd = -1;
+	}
+#endif
+	process->hasExited = true;
+	return true;
+}
+#elif _WIN32
+//**********************************************************************************************************************
+// Note: Quotes arguments using the CommandLineToArgvW() rules.
+static bool appendCommandLineArg(CaptureBuffer* commandLine, const char* arg)
+{
+	if (commandLine->size > 0 && !appendCaptureBuffer(commandLine, " ", 1))
+		return false;
+	if (arg[0] != '\0' && !strpbrk(arg, " \t\n\v\""))
+		return appendCaptureBuffer(commandLine, arg, strlen(arg));
+
+	if (!appendCaptureBuffer(commandLine, "\"", 1))
+		return false;
+	for (const char* c = arg; true; c++)
+	{
+		size_t backslashCount = 0;
+		while (*c == '\\')
+		{
+			c++; backslashCount++;
+		}
+
+		size_t repeatCount = backslashCount;
+		if (*c == '\0' || *c == '"')
+			repeatCount = backslashCount * 2 + (*c == '"' ? 1 : 0);
+		for (size_t i = 0; i < repeatCount; i++)
+		{
+			if (!appendCaptureBuffer(commandLine, "\\", 1))
+				return false;
+		}
+
+		if (*c == '\0')
+			break;
+		if (!appendCaptureBuffer(commandLine, c, 1))
+			return false;
+	}
+	return appendCaptureBuffer(commandLine, "\"", 1);
+}
+
+// Note: Searches the file in the PATH directories like posix_spawnp(), if it does not contain a path separator.
+static char* resolveApplicationPath(const char* filePath)
+{
+	if (strpbrk(filePath, "\\/:"))
+		return _strdup(filePath);
+
+	DWORD size = SearchPathA(NULL, filePath, ".exe", 0, NULL, NULL);
+	while (size > 0)
+	{
+		char* path = malloc(size);
+		if (!path)
+			return NULL;
+
+		DWORD length = SearchPathA(NULL, filePath, ".exe", size, path, NULL);
+		if (length > 0 && length < size)
+			return path;
+		free(path);
+		size = length; // Note: PATH was changed between the calls.
+	}
+	return NULL;
+}
+
+static NativeProcess spawnProcess(const char* filePath, char** args,
+	const ProcessOptions* options, NativePipe* parentPipes)
+{
+	parentPipes[0] = parentPipes[1] = parentPipes[2] = INVALID_NATIVE_PIPE;
+	HANDLE childHandles[3] = { NULL, NULL, NULL };
+	bool closeChildHandles[3] = { false, false, false };
+
+	// Note: Handles are created not inheritable and then passed only to this child through the handle list,
+	//       otherwise concurrently spawned processes inherit each other pipe ends and never see the EOF.
+	const DWORD stdHandles[3] = { STD_INPUT_HANDLE, STD_OUTPUT_HANDLE, STD_ERROR_HANDLE };
+	HANDLE currentProcess = GetCurrentProcess();
+	bool result = true;
+
+	for (int i = 0; i < 3 && result; i++)
+	{
+		ProcessStream type = getStreamType(options, i);
+		HANDLE handle = NULL;
+
+		if (type == NULL_PROCESS_STREAM || type == FILE_PROCESS_STREAM)
+		{
+			const char* path = type == NULL_PROCESS_STREAM ? "NUL" : getStreamPath(options, i);
+			handle = path ? CreateFileA(path, i == 0 ? GENERIC_READ : GENERIC_WRITE,
+				FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, i == 0 ? OPEN_EXISTING : CREATE_ALWAYS,
+				FILE_ATTRIBUTE_NORMAL, NULL) : INVALID_HANDLE_VALUE;
+			result = handle != INVALID_HANDLE_VALUE;
+		}
+		else if (type == PIPE_PROCESS_STREAM)
+		{
+			HANDLE readPipe, writePipe;
+			result = CreatePipe(&readPipe, &writePipe, NULL, 0) != FALSE;
+			if (!result)
+				break;
+			handle = i == 0 ? readPipe : writePipe;
+			parentPipes[i] = i == 0 ? writePipe : readPipe;
+		}
+		else
+		{
+			// Note: Duplicated, because the handle list accepts only inheritable handles.
+			HANDLE stdHandle = GetStdHandle(stdHandles[i]);
+			if (!stdHandle || stdHandle == INVALID_HANDLE_VALUE || DuplicateHandle(currentProcess, stdHandle,
+				currentProcess, &handle, 0, TRUE, DUPLICATE_SAME_ACCESS) == FALSE)
+			{
+				childHandles[i] = stdHandle; // Note: Not a real handle, child gets it without inheritance.
+				continue;
+			}
+		}
+
+		if (!result)
+			break;
+		childHandles[i] = handle; closeChildHandles[i] = true;
+		result = SetHandleInformation(handle, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT) != FALSE;
+	}
+
+	HANDLE inheritHandles[3]; DWORD inheritHandleCount = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		if (closeChildHandles[i])
+			inheritHandles[inheritHandleCount++] = childHandles[i];
+	}
+
+	CaptureBuffer commandLine, environment;
+	memset(&commandLine, 0, sizeof(CaptureBuffer));
+	memset(&environment, 0, sizeof(CaptureBuffer));
+	for (char** arg = args; *arg && result; arg++)
+		result = appendCommandLineArg(&commandLine, *arg);
+	if (options->environment)
+	{
+		for (const char* const* variable = options->environment; *variable && result; variable++)
+			result = appendCaptureBuffer(&environment, *variable, strlen(*variable) + 1);
+		result &= appendCaptureBuffer(&environment, "\0", 1);
+	}
+
+	char* applicationPath = result ? resolveApplicationPath(filePath) : NULL;
+	result &= applicationPath != NULL;
+
+	LPPROC_THREAD_ATTRIBUTE_LIST attributeList = NULL;
+	if (result && inheritHandleCount > 0)
+	{
+		SIZE_T attributeListSize = 0;
+		InitializeProcThreadAttributeList(NULL, 1, 0, &attributeListSize);
+		attributeList = malloc(attributeListSize);
+		if (attributeList && InitializeProcThreadAttributeList(attributeList, 1, 0, &attributeListSize) != FALSE)
+		{
+			result = UpdateProcThreadAttribute(attributeList, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST,
+				inheritHandles, inheritHandleCount * sizeof(HANDLE), NULL, NULL) != FALSE;
+		}
+		else
+		{
+			free(attributeList);
+			attributeList = NULL;
+			result = false;
+		}
+	}
+
+	PROCESS_INFORMATION processInfo;
+	memset(&processInfo, 0, sizeof(PROCESS_INFORMATION));
+	if (result && commandLine.data)
+	{
+		STARTUPINFOEXA startupInfo;
+		memset(&startupInfo, 0, sizeof(STARTUPINFOEXA));
+		startupInfo.StartupInfo.cb = sizeof(STARTUPINFOEXA);
+		startupInfo.StartupInfo.dwFlags = STARTF_USESTDHANDLES;
+		startupInfo.StartupInfo.hStdInput = childHandles[0];
+		startupInfo.StartupInfo.hStdOutput = childHandles[1];
+		startupInfo.StartupInfo.hStdError = childHandles[2];
+		startupInfo.lpAttributeList = attributeList;
+
+		result = CreateProcessA(applicationPath, commandLine.data, NULL, NULL, attributeList ? TRUE : FALSE,
+			EXTENDED_STARTUPINFO_PRESENT, environment.data, options->workingDirectory,
+			&startupInfo.StartupInfo, &processInfo) != FALSE;
+		if (result)
+			CloseHandle(processInfo.hThread);
+	}
+
+	if (attributeList)
+	{
+		DeleteProcThreadAttributeList(attributeList);
+		free(attributeList);
+	}
+	free(applicationPath);
+	free(commandLine.data);
+	free(environment.data);
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (closeChildHandles[i])
+			CloseHandle(childHandles[i]);
+		if (!result && parentPipes[i] != INVALID_NATIVE_PIPE)
+		{
+			CloseHandle(parentPipes[i]);
+			parentPipes[i] = INVALID_NATIVE_PIPE;
+		}
+	}
+	return result ? processInfo.hProcess : INVALID_NATIVE_PROCESS;
+}
+
+typedef struct PipeThreadData
+{
+	HANDLE pipe;
+	const void* inputData;
+	size_t inputSize;
+	CaptureBuffer* capture;
+	bool result;
+} PipeThreadData;
+
+static void pipeThreadFunction(void* argument)
+{
+	PipeThreadData* data = (PipeThreadData*)argument;
+	if (data->capture)
+	{
+		char buffer[PROCESS_PIPE_BUFFER_SIZE]; DWORD readSize;
+		while (ReadFile(data->pipe, buffer, sizeof(buffer), &readSize, NULL) != FALSE && readSize > 0)
+		{
+			if (!appendCaptureBuffer(data->capture, buffer, readSize))
+				data->result = false;
+		}
+	}
+	else
+	{
+		size_t offset = 0; DWORD writtenSize;
+		while (offset < data->inputSize)
+		{
+			size_t size = data->inputSize - offset;
+			if (WriteFile(data->pipe, (const uint8_t*)data->inputData + offset, size < PROCESS_PIPE_BUFFER_SIZE ?
+				(DWORD)size : PROCESS_PIPE_BUFFER_SIZE, &writtenSize, NULL) == FALSE)
+			{
+				break; // Note: Child closed its input.
+			}
+			offset += writtenSize;
+		}
+	}
+	CloseHandle(data->pipe);
+}
+
+// Note: Anonymous pipes do not support overlapped I/O, so each pipe is served by a separate thread.
+static bool communicateProcess(NativePipe* pipes, const void* inputData, size_t inputSize, CaptureBuffer* captures)
+{
+	PipeThreadData threadData[3]; Thread threads[3] = { NULL, NULL, NULL };
+	bool result = true;
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (pipes[i] == INVALID_NATIVE_PIPE)
+			continue;
+
+		threadData[i].pipe = pipes[i];
+		threadData[i].inputData = inputData;
+		threadData[i].inputSize = inputSize;
+		threadData[i].capture = i == 0 ? NULL : &captures[i - 1];
+		threadData[i].result = true;
+		pipes[i] = INVALID_NATIVE_PIPE;
+
+		threads[i] = createThread(pipeThreadFunction, &threadData[i], 0, "mpio-pipe");
+		if (!threads[i])
+		{
+			CloseHandle(threadData[i].pipe);
+			result = false;
+		}
+	}
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (!threads[i])
+			continue;
+		destroyThread(threads[i]);
+		result &= threadData[i].result;
+	}
+	return result;
+}
+
+static int waitNativeProcess(NativeProcess process)
+{
+	DWORD exitCode = 0;
+	if (WaitForSingleObject(process, INFINITE) != WAIT_OBJECT_0 ||
+		GetExitCodeProcess(process, &exitCode) == FALSE)
+	{
+		CloseHandle(process);
+		return -1;
+	}
+	CloseHandle(process);
+	return (int)exitCode;
+}
+
+inline static int64_t fileTimeToNs(FILETIME fileTime)
+{
+	return (int64_t)(((uint64_t)fileTime.dwHighDateTime << 32) | fileTime.dwLowDateTime) * 100;
+}
+static bool reapProcess(Process process, bool wait)
+{
+	DWORD result = WaitForSingleObject(process->native, wait ? INFINITE : 0);
+	if (result == WAIT_TIMEOUT)
+		return false;
+
+	ProcessStats* stats = &process->stats;
+	stats->wallTimeNs = getCurrentClockNs() - process->startTime;
+
+	DWORD exitCode = 0;
+	if (result != WAIT_OBJECT_0 || GetExitCodeProcess(process->native, &exitCode) == FALSE)
+		exitCode = (DWORD)-1;
+	stats->exitCode = (int)exitCode;
+
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (GetProcessTimes(process->native, &creationTime, &exitTime, &kernelTime, &userTime) != FALSE)
+	{
+		stats->userTimeNs = fileTimeToNs(userTime);
+		stats->systemTimeNs = fileTimeToNs(kernelTime);
+	}
+	else
+	{
+		stats->userTimeNs = stats->systemTimeNs = 0;
+	}
+
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(process->native, &counters, sizeof(PROCESS_MEMORY_COUNTERS)) != FALSE)
+		stats->peakRssSize = (int64_t)counters.PeakWorkingSetSize;
+	else
+		stats->peakRssSize = -1;
+
+	process->hasExited = true;
+	return true;
+}
+#endif
+
+//**********************************************************************************************************************
+int runProcess(const char* filePath, char** args, const ProcessOptions* options, ProcessOutput* output)
+{
+	assert(filePath);
+	assert(args);
+
+	ProcessOptions defaultOptions;
+	if (!options)
+	{
+		memset(&defaultOptions, 0, sizeof(ProcessOptions));
+		options = &defaultOptions;
+	}
+
+	assert(options->stdinType < PROCESS_STREAM_COUNT);
+	assert(options->stdoutType < PROCESS_STREAM_COUNT);
+	assert(options->stderrType < PROCESS_STREAM_COUNT);
+	assert(output || (options->stdoutType != PIPE_PROCESS_STREAM &&
+		options->stderrType != PIPE_PROCESS_STREAM));
+
+	if (output)
+		memset(output, 0, sizeof(ProcessOutput));
+
+	NativePipe pipes[3];
+	NativeProcess process = spawnProcess(filePath, args, options, pipes);
+	if (process == INVALID_NATIVE_PROCESS)
+		return -1;
+
+	CaptureBuffer captures[2];
+	memset(captures, 0, sizeof(captures));
+
+	bool result = true;
+	if (pipes[0] != INVALID_NATIVE_PIPE || pipes[1] != INVALID_NATIVE_PIPE || pipes[2] != INVALID_NATIVE_PIPE)
+		result = communicateProcess(pipes, options->stdinData, options->stdinSize, captures);
+	int exitCode = waitNativeProcess(process);
+
+	for (int i = 0; i < 2; i++)
+	{
+		if (getStreamType(options, i + 1) == PIPE_PROCESS_STREAM && !captures[i].data)
+			result &= appendCaptureBuffer(&captures[i], "", 0);
+	}
+
+	if (!result)
+	{
+		free(captures[0].data);
+		free(captures[1].data);
+		return -1;
+	}
+
+	if (output)
+	{
+		output->stdoutData = captures[0].data;
+		output->stdoutSize = captures[0].size;
+		output->stderrData = captures[1].data;
+		output->stderrSize = captures[1].size;
+	}
+	return exitCode;
+}
+
+//**********************************************************************************************************************
+Process startProcess(const char* filePath, char** args, const ProcessOptions* options)
+{
+	assert(filePath);
+	assert(args);
+
+	ProcessOptions defaultOptions;
+	if (!options)
+	{
+		memset(&defaultOptions, 0, sizeof(ProcessOptions));
+		options = &defaultOptions;
+	}
+
+	assert(options->stdinType < PIPE_PROCESS_STREAM);
+	assert(options->stdoutType < PIPE_PROCESS_STREAM);
+	assert(options->stderrType < PIPE_PROCESS_STREAM);
+
+	Process process = calloc(1, sizeof(Process_T));
+	if (!process)
+		return NULL;
+
+	NativePipe pipes[3];
+	process->startTime = getCurrentClockNs();
+	process->native = spawnProcess(filePath, args, options, pipes);
+	if (process->native == INVALID_NATIVE_PROCESS)
+	{
+		free(process);
+		return NULL;
+	}
+
+#if __linux__
+	// Note: pidfd can not refer to a recycled PID, because the process is not reaped yet.
+	process->fd = (int)syscall(SYS_pidfd_open, process->native, 0);
+#else
+	process->fd = -1;
+#endif
+	return process;
+}
+void destroyProcess(Process process)
+{
+	if (!process)
+		return;
+
+	if (!process->hasExited)
+	{
+		killProcess(process);
+		reapProcess(process, true);
+	}
+#if _WIN32
+	CloseHandle(process->native);
+#endif
+	free(process);
+}
+
+int getProcessFd(Process process)
+{
+	assert(process);
+	return process->fd;
+}
+bool killProcess(Process process)
+{
+	assert(process);
+	if (process->hasExited)
+		return true;
+#if __linux__ || __APPLE__
+	return kill(process->native, SIGKILL) == 0;
+#elif _WIN32
+	return TerminateProcess(process->native, (UINT)-1) != FALSE ||
+		WaitForSingleObject(process->native, 0) == WAIT_OBJECT_0;
+#endif
+}
+
+bool pollProcess(Process process, ProcessStats* stats)
+{
+	assert(process);
+	if (!process->hasExited && !reapProcess(process, false))
+		return false;
+	if (stats)
+		*stats = process->stats;
+	return true;
+}
+void waitProcess(Process process, ProcessStats* stats)
+{
+	assert(process);
+	if (!process->hasExited)
+		reapProcess(process, true);
+	if (stats)
+		*stats = process->stats;
+}
+
+//**********************************************************************************************************************
+typedef struct ProcessPoolJob
+{
+	const char* filePath;
+	char** args;
+	void* userData;
+	ProcessOptions options;
+} ProcessPoolJob;
+
+typedef struct RunningProcess
+{
+	Process process;
+	void* userData;
+} RunningProcess;
+
+struct ProcessPool_T
+{
+	ProcessPoolJob** jobs;
+	ProcessCompletion* completions;
+	RunningProcess* runningProcesses;
+	uint32_t jobOffset;
+	uint32_t jobCount;
+	uint32_t jobCapacity;
+	uint32_t completionOffset;
+	uint32_t completionCount;
+	uint32_t completionCapacity;
+	uint32_t runningCount;
+	uint32_t concurrency;
+	uint32_t unwatchedCount;
+#if __linux__
+	int epollFd;
+#endif
+};
+
+ProcessPool createProcessPool(uint32_t concurrency)
+{
+	if (concurrency == 0)
+	{
+		int cpuCount = getEffectiveCpuCount();
+		concurrency = cpuCount > 0 ? (uint32_t)cpuCount : 1;
+	}
+
+	ProcessPool processPool = calloc(1, sizeof(ProcessPool_T));
+	if (!processPool)
+		return NULL;
+
+	processPool->concurrency = concurrency;
+	processPool->runningProcesses = malloc(concurrency * sizeof(RunningProcess));
+	if (!processPool->runningProcesses)
+	{
+		free(processPool);
+		return NULL;
+	}
+
+#if __linux__
+	processPool->epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (processPool->epollFd == -1)
+	{
+		free(processPool->runningProcesses);
+		free(processPool);
+		return NULL;
+	}
+#endif
+	return processPool;
+}
+void destroyProcessPool(ProcessPool processPool)
+{
+	if (!processPool)
+		return;
+
+	for (uint32_t i = 0; i < processPool->runningCount; i++)
+	{
+		Process process = processPool->runningProcesses[i].process;
+		waitProcess(process, NULL);
+		destroyProcess(process);
+	}
+	for (uint32_t i = 0; i < processPool->jobCount; i++)
+		free(processPool->jobs[processPool->jobOffset + i]);
+
+#if __linux__
+	close(processPool->epollFd);
+#endif
+	free(processPool->runningProcesses);
+	free(processPool->completions);
+	free(processPool->jobs);
+	free(processPool);
+}
+
+uint32_t getProcessPoolConcurrency(ProcessPool processPool)
+{
+	assert(processPool);
+	return processPool->concurrency;
+}
+uint32_t getProcessPoolJobCount(ProcessPool processPool)
+{
+	assert(processPool);
+	return processPool->jobCount + processPool->runningCount + processPool->completionCount;
+}
+
+//**********************************************************************************************************************
+inline static size_t getStringListSize(const char* const* strings, size_t* count)
+{
+	size_t size = 0, index = 0;
+	for (; strings[index]; index++)
+		size += strlen(strings[index]) + 1;
+	*count = index;
+	return size;
+}
+inline static char* copyString(char** cursor, const char* string)
+{
+	if (!string)
+		return NULL;
+	size_t size = strlen(string) + 1;
+	char* copy = *cursor;
+	memcpy(copy, string, size);
+	*cursor += size;
+	return copy;
+}
+
+// Note: Copies job arguments and options to the one allocation.
+bool addProcessPoolJob(ProcessPool processPool, const char* filePath,
+	char** args, const ProcessOptions* options, void* userData)
+{
+	assert(processPool);
+	assert(filePath);
+	assert(args);
+	assert(!options || options->stdinType < PIPE_PROCESS_STREAM);
+	assert(!options || options->stdoutType < PIPE_PROCESS_STREAM);
+	assert(!options || options->stderrType < PIPE_PROCESS_STREAM);
+
+	if (processPool->jobOffset + processPool->jobCount == processPool->jobCapacity)
+	{
+		if (processPool->jobOffset > 0)
+		{
+			memmove(processPool->jobs, processPool->jobs + processPool->jobOffset,
+				processPool->jobCount * sizeof(ProcessPoolJob*));
+			processPool->jobOffset = 0;
+		}
+		else
+		{
+			uint32_t capacity = processPool->jobCapacity > 0 ? processPool->jobCapacity * 2 : 16;
+			ProcessPoolJob** jobs = realloc(processPool->jobs, capacity * sizeof(ProcessPoolJob*));
+			if (!jobs)
+				return false;
+			processPool->jobs = jobs; processPool->jobCapacity = capacity;
+		}
+	}
+
+	size_t argCount, environmentCount = 0;
+	size_t stringSize = strlen(filePath) + 1 + getStringListSize((const char* const*)args, &argCount);
+	if (options)
+	{
+		const char* paths[4] = { options->workingDirectory,
+			options->stdinPath, options->stdoutPath, options->stderrPath };
+		for (int i = 0; i < 4; i++)
+			stringSize += paths[i] ? strlen(paths[i]) + 1 : 0;
+		if (options->environment)
+			stringSize += getStringListSize(options->environment, &environmentCount);
+	}
+
+	size_t listCount = argCount + 1 + (options && options->environment ? environmentCount + 1 : 0);
+	ProcessPoolJob* job = malloc(sizeof(ProcessPoolJob) + listCount * sizeof(char*) + stringSize);
+	if (!job)
+		return false;
+
+	char** lists = (char**)(job + 1);
+	char* cursor = (char*)(lists + listCount);
+
+	if (options)
+		job->options = *options;
+	else
+		memset(&job->options, 0, sizeof(ProcessOptions));
+
+	job->filePath = copyString(&cursor, filePath);
+	job->args = lists;
+	for (size_t i = 0; i < argCount; i++)
+		job->args[i] = copyString(&cursor, args[i]);
+	job->args[argCount] = NULL;
+	job->userData = userData;
+
+	if (options)
+	{
+		job->options.workingDirectory = copyString(&cursor, options->workingDirectory);
+		job->options.stdinPath = copyString(&cursor, options->stdinPath);
+		job->options.stdoutPath = copyString(&cursor, options->stdoutPath);
+		job->options.stderrPath = copyString(&cursor, options->stderrPath);
+
+		if (options->environment)
+		{
+			char** environment = lists + argCount + 1;
+			for (size_t i = 0; i < environmentCount; i++)
+				environment[i] = copyString(&cursor, options->environment[i]);
+			environment[environmentCount] = NULL;
+			job->options.environment = (const char* const*)environment;
+		}
+	}
+
+	processPool->jobs[processPool->jobOffset + processPool->jobCount++] = job;
+	return true;
+}
+
+//**********************************************************************************************************************
+static bool addProcessPoolCompletion(ProcessPool processPool, void* userData, const ProcessStats* stats)
+{
+	if (processPool->completionOffset + processPool->completionCount == processPool->completionCapacity)
+	{
+		if (processPool->completionOffset > 0)
+		{
+			memmove(processPool->completions, processPool->completions + processPool->completionOffset,
+				processPool->completionCount * sizeof(ProcessCompletion));
+			processPool->completionOffset = 0;
+		}
+		else
+		{
+			uint32_t capacity = processPool->completionCapacity > 0 ? processPool->completionCapacity * 2 : 16;
+			ProcessCompletion* completions = realloc(processPool->completions, capacity * sizeof(ProcessCompletion));
+			if (!completions)
+				return false;
+			processPool->completions = completions; processPool->completionCapacity = capacity;
+		}
+	}
+
+	ProcessCompletion* completion = &processPool->completions[
+		processPool->completionOffset + processPool->completionCount++];
+	completion->userData = userData;
+	completion->stats = *stats;
+	return true;
+}
+
+static void startProcessPoolJobs(ProcessPool processPool)
+{
+	while (processPool->jobCount > 0 && processPool->runningCount < processPool->concurrency)
+	{
+		ProcessPoolJob* job = processPool->jobs[processPool->jobOffset];
+		Process process = startProcess(job->filePath, job->args, &job->options);
+
+		if (!process)
+		{
+			ProcessStats stats;
+			memset(&stats, 0, sizeof(ProcessStats));
+			stats.peakRssSize = -1; stats.exitCode = -1;
+			if (!addProcessPoolCompletion(processPool, job->userData, &stats))
+				return; // Note: Retrying on the next call.
+		}
+		else
+		{
+			bool isWatched = false;
+#if __linux__
+			if (process->fd != -1)
+			{
+				struct epoll_event event;
+				memset(&event, 0, sizeof(struct epoll_event));
+				event.events = EPOLLIN;
+				event.data.ptr = process;
+				isWatched = epoll_ctl(processPool->epollFd, EPOLL_CTL_ADD, process->fd, &event) == 0;
+			}
+#endif
+			process->isWatched = isWatched;
+			if (!isWatched)
+				processPool->unwatchedCount++;
+
+			RunningProcess* runningProcess = &processPool->runningProcesses[processPool->runningCount++];
+			runningProcess->process = process;
+			runningProcess->userData = job->userData;
+		}
+
+		free(job);
+		processPool->jobOffset++; processPool->jobCount--;
+		if (processPool->jobCount == 0)
+			processPool->jobOffset = 0;
+	}
+}
+
+// Note: pidfd becomes readable when the process exits, so there is no SIGCHLD handler or a polling loop.
+static void waitProcessPoolEvent(ProcessPool processPool)
+{
+#if __linux__
+	if (processPool->unwatchedCount == 0)
+	{
+		struct epoll_event events[16];
+		while (epoll_wait(processPool->epollFd, events, 16, -1) == -1 && errno == EINTR) { }
+		return;
+	}
+#elif _WIN32
+	if (processPool->runningCount <= MAXIMUM_WAIT_OBJECTS)
+	{
+		HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+		for (uint32_t i = 0; i < processPool->runningCount; i++)
+			handles[i] = processPool->runningProcesses[i].process->native;
+		WaitForMultipleObjects(processPool->runningCount, handles, FALSE, INFINITE);
+		return;
+	}
+#endif
+
+#if __linux__ || __APPLE__
+	struct timespec delay = { 0, PROCESS_POLL_DELAY };
+	nanosleep(&delay, NULL);
+#elif _WIN32
+	Sleep(PROCESS_POLL_DELAY / 1000000);
+#endif
+}
+
+static void reapProcessPoolJobs(ProcessPool processPool)
+{
+	for (uint32_t i = 0; i < processPool->runningCount; )
+	{
+		RunningProcess* runningProcess = &processPool->runningProcesses[i];
+		Process process = runningProcess->process;
+		if (!pollProcess(process, NULL))
+		{
+			i++;
+			continue;
+		}
+
+		if (!addProcessPoolCompletion(processPool, runningProcess->userData, &process->stats))
+			return; // Note: Process stays exited in the running list, retrying on the next call.
+
+		if (!process->isWatched)
+			processPool->unwatchedCount--;
+		destroyProcess(process);
+		*runningProcess = processPool->runningProcesses[--processPool->runningCount];
+	}
+}
+
+static uint32_t getProcessPoolCompletions(ProcessPool processPool, ProcessCompletion* completions, uint32_t capacity)
+{
+	uint32_t count = processPool->completionCount < capacity ? processPool->completionCount : capacity;
+	memcpy(completions, processPool->completions + processPool->completionOffset, count * sizeof(ProcessCompletion));
+	processPool->completionOffset += count; processPool->completionCount -= count;
+	if (processPool->completionCount == 0)
+		processPool->completionOffset = 0;
+	return count;
+}
+
+uint32_t pollProcessPoolCompletions(ProcessPool processPool, ProcessCompletion* completions, uint32_t capacity)
+{
+	assert(processPool);
+	assert(completions || capacity == 0);
+
+	startProcessPoolJobs(processPool);
+	reapProcessPoolJobs(processPool);
+	startProcessPoolJobs(processPool);
+	return getProcessPoolCompletions(processPool, completions, capacity);
+}
+uint32_t waitProcessPoolCompletions(ProcessPool processPool,
+	ProcessCompletion* completions, uint32_t capacity, uint32_t minCount)
+{
+	assert(processPool);
+	assert(completions || capacity == 0);
+
+	uint32_t jobCount = getProcessPoolJobCount(processPool);
+	if (minCount > jobCount)
+		minCount = jobCount;
+	if (minCount > capacity)
+		minCount = capacity;
+
+	startProcessPoolJobs(processPool);
+	reapProcessPoolJobs(processPool);
+	startProcessPoolJobs(processPool);
+
+	while (processPool->completionCount < minCount)
+	{
+		if (processPool->runningCount == 0)
+			break; // Note: Failed to start or allocate completions.
+		waitProcessPoolEvent(processPool);
+		reapProcessPoolJobs(processPool);
+		startProcessPoolJobs(processPool);
+	}
+	return getProcessPoolCompletions(processPool, completions, capacity);
+}
@@ -0,0 +1,103 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Internal thread synchronization primitives. (Not a public API)
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdbool.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+#if __linux__ || __APPLE__
+#include <limits.h>
+#include <pthread.h>
+
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Cond;
+typedef pthread_t NativeThread;
+typedef void* NativeThreadResult;
+#define NATIVE_THREAD_CALL
+
+inline static bool initMutex(Mutex* mutex) { return pthread_mutex_init(mutex, NULL) == 0; }
+inline static void destroyMutex(Mutex* mutex) { pthread_mutex_destroy(mutex); }
+inline static void lockMutex(Mutex* mutex) { pthread_mutex_lock(mutex); }
+inline static void unlockMutex(Mutex* mutex) { pthread_mutex_unlock(mutex); }
+
+inline static bool initCond(Cond* cond) { return pthread_cond_init(cond, NULL) == 0; }
+inline static void destroyCond(Cond* cond) { pthread_cond_destroy(cond); }
+inline static void waitCond(Cond* cond, Mutex* mutex) { pthread_cond_wait(cond, mutex); }
+inline static void signalCond(Cond* cond) { pthread_cond_signal(cond); }
+inline static void broadcastCond(Cond* cond) { pthread_cond_broadcast(cond); }
+
+inline static bool startNativeThread(NativeThread* thread,
+	NativeThreadResult(*function)(void*), void* argument, size_t stackSize)
+{
+	if (stackSize == 0)
+		return pthread_create(thread, NULL, function, argument) == 0;
+
+	pthread_attr_t attributes;
+	if (pthread_attr_init(&attributes) != 0)
+		return false;
+	if (stackSize < (size_t)PTHREAD_STACK_MIN)
+		stackSize = (size_t)PTHREAD_STACK_MIN;
+
+	bool result = pthread_attr_setstacksize(&attributes, stackSize) == 0 &&
+		pthread_create(thread, &attributes, function, argument) == 0;
+	pthread_attr_destroy(&attributes);
+	return result;
+}
+inline static void joinNativeThread(NativeThread thread) { pthread_join(thread, NULL); }
+#elif _WIN32
+#include <windows.h>
+
+typedef SRWLOCK Mutex;
+typedef CONDITION_VARIABLE Cond;
+typedef HANDLE NativeThread;
+typedef DWORD NativeThreadResult;
+#define NATIVE_THREAD_CALL WINAPI
+
+inline static bool initMutex(Mutex* mutex) { InitializeSRWLock(mutex); return true; }
+inline static void destroyMutex(Mutex* mutex) { (void)mutex; }
+inline static void lockMutex(Mutex* mutex) { AcquireSRWLockExclusive(mutex); }
+inline static void unlockMutex(Mutex* mutex) { ReleaseSRWLockExclusive(mutex); }
+
+inline static bool initCond(Cond* cond) { InitializeConditionVariable(cond); return true; }
+inline static void destroyCond(Cond* cond) { (void)cond; }
+inline static void waitCond(Cond* cond, Mutex* mutex) { SleepConditionVariableSRW(cond, mutex, INFINITE, 0); }
+inline static void signalCond(Cond* cond) { WakeConditionVariable(cond); }
+inline static void broadcastCond(Cond* cond) { WakeAllConditionVariable(cond); }
+
+inline static bool startNativeThread(NativeThread* thread,
+	NativeThreadResult(WINAPI *function)(void*), void* argument, size_t stackSize)
+{
+	*thread = CreateThread(NULL, stackSize, function, argument,
+		stackSize > 0 ? STACK_SIZE_PARAM_IS_A_RESERVATION : 0, NULL);
+	return *thread != NULL;
+}
+inline static void joinNativeThread(NativeThread thread)
+{
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+}
+#else
+#error Unknown operating system
+#endif
@@ -0,0 +1,300 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "mpio/thread.h"
+#include "sync.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if __linux__ || __APPLE__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#if __linux__
+#include <sys/syscall.h>
+#endif
+#elif _WIN32
+#include <windows.h>
+#else
+#error Unknown operating system
+#endif
+
+struct Thread_T
+{
+	ThreadFunction function;
+	void* argument;
+	NativeThread thread;
+	Mutex mutex;
+	Cond startCond;
+#if __linux__
+	pid_t threadId;
+#endif
+	bool isStarted;
+	char name[MAX_THREAD_NAME_LENGTH];
+};
+
+static void copyThreadName(char* threadName, const char* name)
+{
+	size_t length = strlen(name);
+	if (length >= MAX_THREAD_NAME_LENGTH)
+		length = MAX_THREAD_NAME_LENGTH - 1;
+	memcpy(threadName, name, length);
+	threadName[length] = '\0';
+}
+
+#if _WIN32
+static bool setWindowsThreadName(HANDLE thread, const char* name)
+{
+	WCHAR wideName[MAX_THREAD_NAME_LENGTH];
+	if (MultiByteToWideChar(CP_UTF8, 0, name, -1, wideName, MAX_THREAD_NAME_LENGTH) == 0)
+		return false;
+	return SUCCEEDED(SetThreadDescription(thread, wideName));
+}
+#endif
+
+static bool setCurrentThreadName(const char* name)
+{
+#if __linux__
+	return pthread_setname_np(pthread_self(), name) == 0;
+#elif __APPLE__
+	return pthread_setname_np(name) == 0;
+#elif _WIN32
+	return setWindowsThreadName(GetCurrentThread(), name);
+#endif
+}
+
+static NativeThreadResult NATIVE_THREAD_CALL threadFunction(void* argument)
+{
+	Thread thread = (Thread)argument;
+	if (thread->name[0] != '\0')
+		setCurrentThreadName(thread->name);
+
+	lockMutex(&thread->mutex);
+#if __linux__
+	thread->threadId = (pid_t)syscall(SYS_gettid);
+#endif
+	thread->isStarted = true;
+	signalCond(&thread->startCond);
+	unlockMutex(&thread->mutex);
+
+	thread->function(thread->argument);
+	return 0;
+}
+
+//**********************************************************************************************************************
+Thread createThread(ThreadFunction function, void* argument, size_t stackSize, const char* name)
+{
+	assert(function);
+
+	Thread thread = calloc(1, sizeof(Thread_T));
+	if (!thread)
+		return NULL;
+
+	thread->function = function;
+	thread->argument = argument;
+	if (name)
+		copyThreadName(thread->name, name);
+
+	if (!initMutex(&thread->mutex))
+	{
+		free(thread);
+		return NULL;
+	}
+	if (!initCond(&thread->startCond))
+	{
+		destroyMutex(&thread->mutex);
+		free(thread);
+		return NULL;
+	}
+	if (!startNativeThread(&thread->thread, threadFunction, thread, stackSize))
+	{
+		destroyCond(&thread->startCond);
+		destroyMutex(&thread->mutex);
+		free(thread);
+		return NULL;
+	}
+
+	// Note: Waiting for the thread ID, so that the priority can be changed right after the creation.
+	lockMutex(&thread->mutex);
+	while (!thread->isStarted)
+		waitCond(&thread->startCond, &thread->mutex);
+	unlockMutex(&thread->mutex);
+	return thread;
+}
+void destroyThread(Thread thread)
+{
+	if (!thread)
+		return;
+
+	joinNativeThread(thread->thread);
+	destroyCond(&thread->startCond);
+	destroyMutex(&thread->mutex);
+	free(thread);
+}
+
+//**********************************************************************************************************************
+bool setThreadName(Thread thread, const char* name)
+{
+	assert(name);
+	char threadName[MAX_THREAD_NAME_LENGTH];
+	copyThreadName(threadName, name);
+
+	if (!thread)
+		return setCurrentThreadName(threadName);
+
+#if __linux__
+	return pthread_setname_np(thread->thread, threadName) == 0;
+#elif __APPLE__
+	if (pthread_equal(thread->thread, pthread_self()))
+		return setCurrentThreadName(threadName);
+	return false;
+#elif _WIN32
+	return setWindowsThreadName(thread->thread, threadName);
+#endif
+}
+
+bool setThreadAffinity(Thread thread, const CpuSet* cpuSet)
+{
+	assert(cpuSet);
+#if __linux__
+	cpu_set_t affinity; CPU_ZERO(&affinity);
+	for (int i = 0; i < MAX_CPU_SET_COUNT && i < CPU_SETSIZE; i++)
+	{
+		if (isCpuInSet(cpuSet, i))
+			CPU_SET(i, &affinity);
+	}
+
+	pthread_t nativeThread = thread ? thread->thread : pthread_self();
+	return pthread_setaffinity_np(nativeThread, sizeof(cpu_set_t), &affinity) == 0;
+#elif __APPLE__
+	return false;
+#elif _WIN32
+	int firstCpu = -1;
+	for (int i = 0; i < MAX_CPU_SET_COUNT; i++)
+	{
+		if (isCpuInSet(cpuSet, i))
+		{
+			firstCpu = i;
+			break;
+		}
+	}
+	if (firstCpu < 0)
+		return false;
+
+	GROUP_AFFINITY affinity;
+	memset(&affinity, 0, sizeof(GROUP_AFFINITY));
+	affinity.Group = (WORD)(firstCpu / 64);
+	for (int i = 0; i < 64; i++)
+	{
+		if (isCpuInSet(cpuSet, affinity.Group * 64 + i))
+			affinity.Mask |= (KAFFINITY)1 << i;
+	}
+
+	HANDLE nativeThread = thread ? thread->thread : GetCurrentThread();
+	return SetThreadGroupAffinity(nativeThread, &affinity, NULL) != FALSE;
+#endif
+}
+bool getThreadAffinity(Thread thread, CpuSet* cpuSet)
+{
+	assert(cpuSet);
+	clearCpuSet(cpuSet);
+#if __linux__
+	cpu_set_t affinity;
+	pthread_t nativeThread = thread ? thread->thread : pthread_self();
+	if (pthread_getaffinity_np(nativeThread, sizeof(cpu_set_t), &affinity) != 0)
+		return false;
+
+	for (int i = 0; i < MAX_CPU_SET_COUNT && i < CPU_SETSIZE; i++)
+	{
+		if (CPU_ISSET(i, &affinity))
+			addCpuToSet(cpuSet, i);
+	}
+	return true;
+#elif __APPLE__
+	return false;
+#elif _WIN32
+	GROUP_AFFINITY affinity;
+	HANDLE nativeThread = thread ? thread->thread : GetCurrentThread();
+	if (GetThreadGroupAffinity(nativeThread, &affinity) == FALSE)
+		return false;
+
+	for (int i = 0; i < 64; i++)
+	{
+		if ((affinity.Mask >> i) & 1)
+			addCpuToSet(cpuSet, affinity.Group * 64 + i);
+	}
+	return true;
+#endif
+}
+
+bool setThreadPriority(Thread thread, ThreadPriority priority)
+{
+	assert(priority < THREAD_PRIORITY_COUNT);
+#if __linux__
+	pthread_t nativeThread = thread ? thread->thread : pthread_self();
+	struct sched_param parameters;
+	memset(&parameters, 0, sizeof(struct sched_param));
+
+	if (priority == REALTIME_THREAD_PRIORITY)
+	{
+		parameters.sched_priority = (sched_get_priority_min(SCHED_FIFO) + sched_get_priority_max(SCHED_FIFO)) / 2;
+		return pthread_setschedparam(nativeThread, SCHED_FIFO, &parameters) == 0;
+	}
+	if (pthread_setschedparam(nativeThread, SCHED_OTHER, &parameters) != 0)
+		return false;
+
+	// Note: On Linux nice value is a per thread attribute, addressed by the kernel thread ID.
+	static const int niceValues[REALTIME_THREAD_PRIORITY] = { 10, 0, -10 };
+	pid_t threadId = thread ? thread->threadId : (pid_t)syscall(SYS_gettid);
+	return setpriority(PRIO_PROCESS, (id_t)threadId, niceValues[priority]) == 0;
+#elif __APPLE__
+	pthread_t nativeThread = thread ? thread->thread : pthread_self();
+	int policy = priority == REALTIME_THREAD_PRIORITY ? SCHED_RR : SCHED_OTHER;
+	int minPriority = sched_get_priority_min(policy), maxPriority = sched_get_priority_max(policy);
+
+	struct sched_param parameters;
+	memset(&parameters, 0, sizeof(struct sched_param));
+	if (priority == LOW_THREAD_PRIORITY)
+		parameters.sched_priority = minPriority;
+	else if (priority == NORMAL_THREAD_PRIORITY)
+		parameters.sched_priority = (minPriority + maxPriority) / 2;
+	else
+		parameters.sched_priority = maxPriority;
+	return pthread_setschedparam(nativeThread, policy, &parameters) == 0;
+#elif _WIN32
+	static const int priorities[THREAD_PRIORITY_COUNT] = { THREAD_PRIORITY_LOWEST,
+		THREAD_PRIORITY_NORMAL, THREAD_PRIORITY_HIGHEST, THREAD_PRIORITY_TIME_CRITICAL };
+	HANDLE nativeThread = thread ? thread->thread : GetCurrentThread();
+	return SetThreadPriority(nativeThread, priorities[priority]) != FALSE;
+#endif
+}
+
+int getCurrentThreadCpu()
+{
+#if __linux__
+	return sched_getcpu();
+#elif __APPLE__
+	return -1;
+#elif _WIN32
+	PROCESSOR_NUMBER processorNumber;
+	GetCurrentProcessorNumberEx(&processorNumber);
+	return processorNumber.Group * 64 + processorNumber.Number;
+#endif
+}
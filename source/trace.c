@@ -0,0 +1,390 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/trace.h"
+#include <stddef.h>
+
+#if MPIO_ENABLE_TRACING
+#include "mpio/os.h"
+#include "mpio/file.h"
+#include "mpio/thread.h"
+#include "mpio/directory.h"
+#include "atomic.h"
+#include "sync.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if __linux__ || __APPLE__
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#elif _WIN32
+#include <windows.h>
+#else
+#error Unknown operating system
+#endif
+
+#define TRACE_FLUSH_DELAY 10000000 // Note: In nanoseconds.
+#define TRACE_CACHE_LINE_SIZE 64
+
+#define BEGIN_TRACE_EVENT 0
+#define END_TRACE_EVENT 1
+#define COUNTER_TRACE_EVENT 2
+
+typedef struct TraceEvent
+{
+	uint64_t time;
+	const char* name;
+	int64_t value;
+	uint8_t type;
+} TraceEvent;
+
+// Note: Single producer (owner thread), single consumer (flush thread) ring buffer.
+typedef struct TraceBuffer
+{
+	volatile int64_t head;
+	int64_t cachedTail;
+	volatile int64_t droppedCount;
+	uint8_t _headPadding[TRACE_CACHE_LINE_SIZE - sizeof(int64_t) * 3];
+	volatile int64_t tail;
+	uint8_t _tailPadding[TRACE_CACHE_LINE_SIZE - sizeof(int64_t)];
+	struct TraceBuffer* next;
+	volatile int32_t isOwned;
+	uint32_t threadId;
+	TraceEvent events[TRACE_BUFFER_CAPACITY];
+} TraceBuffer;
+
+// Note: Buffers are never freed, they are reused by the new threads after the owner thread exit.
+static THREAD_LOCAL TraceBuffer* threadBuffer = NULL;
+static TraceBuffer* bufferList = NULL;
+static Mutex bufferMutex;
+static bool isInitialized = false;
+
+static volatile int32_t isTracingActive = 0;
+static volatile int32_t isFlushRunning = 0;
+static Thread flushThread = NULL;
+static FILE* traceFile = NULL;
+static char* traceFilePath = NULL;
+static uint64_t startCycleCount = 0;
+static uint32_t lastThreadId = 0;
+static int processId = 0;
+
+#if __linux__ || __APPLE__
+static pthread_key_t bufferKey;
+
+static void releaseTraceBuffer(void* buffer)
+{
+	atomicStore32(&((TraceBuffer*)buffer)->isOwned, 0);
+}
+#elif _WIN32
+static DWORD bufferKey = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI releaseTraceBuffer(PVOID buffer)
+{
+	if (buffer)
+		atomicStore32(&((TraceBuffer*)buffer)->isOwned, 0);
+}
+#endif
+
+static TraceBuffer* acquireTraceBuffer()
+{
+	lockMutex(&bufferMutex);
+	TraceBuffer* buffer = bufferList;
+	while (buffer)
+	{
+		int32_t isOwned = 0;
+		if (atomicLoad64(&buffer->head) == buffer->tail && atomicCompareExchange32(&buffer->isOwned, &isOwned, 1))
+			break;
+		buffer = buffer->next;
+	}
+
+	if (!buffer)
+	{
+		buffer = calloc(1, sizeof(TraceBuffer));
+		if (!buffer)
+		{
+			unlockMutex(&bufferMutex);
+			return NULL;
+		}
+		buffer->isOwned = 1;
+		buffer->next = bufferList;
+		bufferList = buffer;
+	}
+
+	buffer->cachedTail = buffer->tail;
+	buffer->threadId = ++lastThreadId;
+	unlockMutex(&bufferMutex);
+
+#if __linux__ || __APPLE__
+	pthread_setspecific(bufferKey, buffer);
+#elif _WIN32
+	FlsSetValue(bufferKey, buffer);
+#endif
+	threadBuffer = buffer;
+	return buffer;
+}
+
+inline static void writeTraceEvent(uint8_t type, const char* name, int64_t value)
+{
+	if (!atomicLoad32(&isTracingActive))
+		return;
+
+	TraceBuffer* buffer = threadBuffer;
+	if (!buffer)
+	{
+		buffer = acquireTraceBuffer();
+		if (!buffer)
+			return;
+	}
+
+	int64_t head = buffer->head;
+	if (head - buffer->cachedTail >= TRACE_BUFFER_CAPACITY)
+	{
+		buffer->cachedTail = atomicLoad64(&buffer->tail);
+		if (head - buffer->cachedTail >= TRACE_BUFFER_CAPACITY)
+		{
+			atomicStore64(&buffer->droppedCount, buffer->droppedCount + 1);
+			return;
+		}
+	}
+
+	TraceEvent* event = &buffer->events[head & (TRACE_BUFFER_CAPACITY - 1)];
+	event->time = getCycleCount();
+	event->name = name;
+	event->value = value;
+	event->type = type;
+	atomicStore64(&buffer->head, head + 1);
+}
+
+//**********************************************************************************************************************
+static void writeJsonString(const char* string)
+{
+	fputc('"', traceFile);
+	for (const char* c = string; *c; c++)
+	{
+		if (*c == '"' || *c == '\\')
+			fputc('\\', traceFile);
+		if ((unsigned char)*c >= 0x20)
+			fputc(*c, traceFile);
+	}
+	fputc('"', traceFile);
+}
+
+static void writeTraceEventJson(const TraceEvent* event, uint32_t threadId)
+{
+	int64_t cycles = (int64_t)(event->time - startCycleCount);
+	if (cycles < 0)
+		return; // Note: Stale event from the previous tracing session.
+	double time = (double)convertCyclesToNs((uint64_t)cycles) / 1000.0;
+
+	if (event->type == END_TRACE_EVENT)
+	{
+		fprintf(traceFile, ",\n{\"ph\":\"E\",\"ts\":%.3lf,\"pid\":%d,\"tid\":%u}", time, processId, threadId);
+		return;
+	}
+
+	fputs(",\n{\"name\":", traceFile);
+	writeJsonString(event->name);
+	if (event->type == BEGIN_TRACE_EVENT)
+	{
+		fprintf(traceFile, ",\"ph\":\"B\",\"ts\":%.3lf,\"pid\":%d,\"tid\":%u}", time, processId, threadId);
+	}
+	else
+	{
+		fprintf(traceFile, ",\"ph\":\"C\",\"ts\":%.3lf,\"pid\":%d,\"tid\":%u,\"args\":{\"value\":%lld}}",
+			time, processId, threadId, (long long)event->value);
+	}
+}
+
+static void flushTraceBuffers()
+{
+	lockMutex(&bufferMutex);
+	TraceBuffer* buffer = bufferList;
+	while (buffer)
+	{
+		int64_t head = atomicLoad64(&buffer->head), tail = buffer->tail;
+		for (; tail < head; tail++)
+			writeTraceEventJson(&buffer->events[tail & (TRACE_BUFFER_CAPACITY - 1)], buffer->threadId);
+		atomicStore64(&buffer->tail, tail);
+		buffer = buffer->next;
+	}
+	unlockMutex(&bufferMutex);
+	fflush(traceFile);
+}
+
+static void traceFlushFunction(void* argument)
+{
+	while (atomicLoad32(&isFlushRunning))
+	{
+#if __linux__ || __APPLE__
+		struct timespec delay = { 0, TRACE_FLUSH_DELAY };
+		nanosleep(&delay, NULL);
+#elif _WIN32
+		Sleep(TRACE_FLUSH_DELAY / 1000000);
+#endif
+		flushTraceBuffers();
+	}
+}
+
+//**********************************************************************************************************************
+bool startTracing(const char* appName)
+{
+	assert(appName);
+	if (traceFile)
+		return false;
+
+	if (!isInitialized)
+	{
+		if (!initMutex(&bufferMutex))
+			return false;
+#if __linux__ || __APPLE__
+		if (pthread_key_create(&bufferKey, releaseTraceBuffer) != 0)
+#elif _WIN32
+		bufferKey = FlsAlloc(releaseTraceBuffer);
+		if (bufferKey == FLS_OUT_OF_INDEXES)
+#endif
+		{
+			destroyMutex(&bufferMutex);
+			return false;
+		}
+		isInitialized = true;
+	}
+
+	char* directory = getAppDataDirectory(appName, false);
+	if (!directory)
+		return false;
+	if (!isDirectoryExists(directory))
+		createDirectory(directory);
+
+	size_t directoryLength = strlen(directory);
+	char* filePath = realloc(directory, directoryLength + 12);
+	if (!filePath)
+	{
+		free(directory);
+		return false;
+	}
+	memcpy(filePath + directoryLength, "/trace.json", 12);
+
+	traceFile = openFile(filePath, "wb");
+	if (!traceFile)
+	{
+		free(filePath);
+		return false;
+	}
+	traceFilePath = filePath;
+
+#if __linux__ || __APPLE__
+	processId = (int)getpid();
+#elif _WIN32
+	processId = (int)GetCurrentProcessId();
+#endif
+
+	fputs("{\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":", traceFile);
+	fprintf(traceFile, "%d,\"args\":{\"name\":", processId);
+	writeJsonString(appName);
+	fputs("}}", traceFile);
+
+	lockMutex(&bufferMutex);
+	TraceBuffer* buffer = bufferList;
+	while (buffer)
+	{
+		atomicStore64(&buffer->tail, atomicLoad64(&buffer->head));
+		atomicStore64(&buffer->droppedCount, 0);
+		buffer = buffer->next;
+	}
+	unlockMutex(&bufferMutex);
+
+	getCycleFrequency(); // Note: Calibrating cycle counter in advance.
+	startCycleCount = getCycleCount();
+
+	atomicStore32(&isFlushRunning, 1);
+	flushThread = createThread(traceFlushFunction, NULL, 0, "mpio-trace");
+	if (!flushThread)
+	{
+		closeFile(traceFile); traceFile = NULL;
+		free(traceFilePath); traceFilePath = NULL;
+		return false;
+	}
+
+	atomicStore32(&isTracingActive, 1);
+	return true;
+}
+void stopTracing()
+{
+	if (!traceFile)
+		return;
+
+	atomicStore32(&isTracingActive, 0);
+	atomicStore32(&isFlushRunning, 0);
+	destroyThread(flushThread);
+	flushThread = NULL;
+
+	flushTraceBuffers();
+	fputs("\n]}\n", traceFile);
+	closeFile(traceFile);
+	traceFile = NULL;
+	free(traceFilePath);
+	traceFilePath = NULL;
+}
+
+bool isTracing()
+{
+	return atomicLoad32(&isTracingActive) != 0;
+}
+const char* getTraceFilePath()
+{
+	return traceFilePath;
+}
+uint64_t getTraceDroppedCount()
+{
+	if (!isInitialized)
+		return 0;
+
+	uint64_t droppedCount = 0;
+	lockMutex(&bufferMutex);
+	TraceBuffer* buffer = bufferList;
+	while (buffer)
+	{
+		droppedCount += (uint64_t)atomicLoad64(&buffer->droppedCount);
+		buffer = buffer->next;
+	}
+	unlockMutex(&bufferMutex);
+	return droppedCount;
+}
+
+void beginTraceZone(const char* name)
+{
+	writeTraceEvent(BEGIN_TRACE_EVENT, name, 0);
+}
+void endTraceZone()
+{
+	writeTraceEvent(END_TRACE_EVENT, NULL, 0);
+}
+void traceCounter(const char* name, int64_t value)
+{
+	writeTraceEvent(COUNTER_TRACE_EVENT, name, value);
+}
+#else
+bool startTracing(const char* appName) { (void)appName; return false; }
+void stopTracing() { }
+bool isTracing() { return false; }
+const char* getTraceFilePath() { return NULL; }
+uint64_t getTraceDroppedCount() { return 0; }
+void beginTraceZone(const char* name) { (void)name; }
+void endTraceZone() { }
+void traceCounter(const char* name, int64_t value) { (void)name; (void)value; }
+#endif
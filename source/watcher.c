@@ -0,0 +1,984 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/watcher.h"
+#include "mpio/directory.h"
+#include "mpio/thread.h"
+#include "mpio/os.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if __linux__
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+
+#define PATH_SEPARATOR '/'
+#define INOTIFY_WATCH_MASK (IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | \
+	IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK)
+#elif _WIN32
+#include <windows.h>
+
+#define PATH_SEPARATOR '\\'
+#define NOTIFY_CHANGE_FILTER (FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | \
+	FILE_NOTIFY_CHANGE_ATTRIBUTES | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE)
+#elif !__APPLE__
+#error Unknown operating system
+#endif
+
+// Note: macOS is not supported, there is no FSEvents stream backend, so a watcher is never created.
+#if __linux__ || _WIN32
+#define WATCHER_BUFFER_SIZE 65536
+#define MAX_DEBOUNCE_FACTOR 10 // Note: Continuous events are still delivered after 10 debounce delays.
+#define DROPPED_WATCH_EVENT_TYPE WATCH_EVENT_TYPE_COUNT
+
+typedef struct PendingEvent
+{
+	char* path;
+	char* oldPath;
+	uint32_t pathLength;
+	uint32_t oldPathLength;
+	uint32_t hash;
+	WatchEventType type;
+	bool isDirectory;
+	bool isModified;
+} PendingEvent;
+
+struct Watcher_T
+{
+	char* rootPath;
+	WatcherFunction onEvents;
+	void* argument;
+	PendingEvent* pendingEvents;
+	uint32_t* eventSlots;
+	WatchEvent* events;
+	uint8_t* buffer;
+	double debounceDelay;
+	double firstEventTime;
+	double lastEventTime;
+	uint32_t pendingCount;
+	uint32_t pendingCapacity;
+	uint32_t slotCapacity;
+	bool isRecursive;
+	bool isRescanPending;
+#if __linux__
+	Thread thread;
+	char** watchPaths;
+	char* movePath;
+	uint32_t watchCapacity;
+	uint32_t moveCookie;
+	int inotifyFd;
+	int stopFd;
+	bool isMoveDirectory;
+#elif _WIN32
+	Thread thread;
+	HANDLE directory;
+	HANDLE stopEvent;
+	char* movePath;
+	OVERLAPPED overlapped;
+	bool isReading;
+#endif
+};
+
+//**********************************************************************************************************************
+static char* joinPath(const char* parent, size_t parentLength, const char* name, size_t nameLength)
+{
+	bool hasSeparator = parentLength > 0 && nameLength > 0;
+	size_t length = hasSeparator ? parentLength + 1 + nameLength : parentLength + nameLength;
+	char* path = malloc(length + 1);
+	if (!path)
+		return NULL;
+
+	memcpy(path, parent, parentLength);
+	if (hasSeparator)
+		path[parentLength] = PATH_SEPARATOR;
+	memcpy(path + length - nameLength, name, nameLength);
+	path[length] = '\0';
+	return path;
+}
+
+inline static uint32_t hashPath(const char* path, size_t pathLength)
+{
+	uint32_t hash = 2166136261u; // Note: FNV-1a hash.
+	for (size_t i = 0; i < pathLength; i++)
+		hash = (hash ^ (uint8_t)path[i]) * 16777619u;
+	return hash;
+}
+static PendingEvent* findPendingEvent(Watcher watcher, const char* path, size_t pathLength, uint32_t hash)
+{
+	if (watcher->slotCapacity == 0)
+		return NULL;
+
+	uint32_t mask = watcher->slotCapacity - 1;
+	for (uint32_t i = hash & mask; watcher->eventSlots[i] != 0; i = (i + 1) & mask)
+	{
+		PendingEvent* event = &watcher->pendingEvents[watcher->eventSlots[i] - 1];
+		if (event->hash == hash && event->pathLength == pathLength && memcmp(event->path, path, pathLength) == 0)
+			return event;
+	}
+	return NULL;
+}
+static bool reserveEventCapacity(Watcher watcher)
+{
+	if (watcher->pendingCount < watcher->pendingCapacity)
+		return true;
+
+	uint32_t capacity = watcher->pendingCapacity > 0 ? watcher->pendingCapacity * 2 : 64;
+	PendingEvent* pendingEvents = realloc(watcher->pendingEvents, capacity * sizeof(PendingEvent));
+	if (!pendingEvents)
+		return false;
+	watcher->pendingEvents = pendingEvents;
+
+	WatchEvent* events = realloc(watcher->events, (capacity + 1) * sizeof(WatchEvent));
+	if (!events)
+		return false;
+	watcher->events = events;
+
+	// Note: Slot table is kept at most half full, so that the linear probing stays short.
+	uint32_t slotCapacity = capacity * 2;
+	uint32_t* eventSlots = calloc(slotCapacity, sizeof(uint32_t));
+	if (!eventSlots)
+		return false;
+
+	uint32_t mask = slotCapacity - 1;
+	for (uint32_t i = 0; i < watcher->pendingCount; i++)
+	{
+		uint32_t slot = pendingEvents[i].hash & mask;
+		while (eventSlots[slot] != 0)
+			slot = (slot + 1) & mask;
+		eventSlots[slot] = i + 1;
+	}
+
+	free(watcher->eventSlots);
+	watcher->eventSlots = eventSlots;
+	watcher->slotCapacity = slotCapacity;
+	watcher->pendingCapacity = capacity;
+	return true;
+}
+static PendingEvent* insertPendingEvent(Watcher watcher, const char* path, size_t pathLength, uint32_t hash)
+{
+	if (!reserveEventCapacity(watcher))
+		return NULL;
+
+	char* pathCopy = malloc(pathLength + 1);
+	if (!pathCopy)
+		return NULL;
+	memcpy(pathCopy, path, pathLength);
+	pathCopy[pathLength] = '\0';
+
+	uint32_t mask = watcher->slotCapacity - 1, slot = hash & mask;
+	while (watcher->eventSlots[slot] != 0)
+		slot = (slot + 1) & mask;
+	watcher->eventSlots[slot] = ++watcher->pendingCount;
+
+	PendingEvent* event = &watcher->pendingEvents[watcher->pendingCount - 1];
+	event->path = pathCopy;
+	event->oldPath = NULL;
+	event->pathLength = (uint32_t)pathLength;
+	event->oldPathLength = 0;
+	event->hash = hash;
+	event->type = DROPPED_WATCH_EVENT_TYPE;
+	event->isDirectory = false;
+	event->isModified = false;
+	return event;
+}
+static void clearPendingEvents(Watcher watcher)
+{
+	for (uint32_t i = 0; i < watcher->pendingCount; i++)
+	{
+		free(watcher->pendingEvents[i].path);
+		free(watcher->pendingEvents[i].oldPath);
+	}
+	if (watcher->slotCapacity > 0)
+		memset(watcher->eventSlots, 0, watcher->slotCapacity * sizeof(uint32_t));
+	watcher->pendingCount = 0;
+	watcher->isRescanPending = false;
+}
+
+//**********************************************************************************************************************
+static void updateEventTime(Watcher watcher)
+{
+	double time = getCurrentClock();
+	if (watcher->pendingCount == 0 && !watcher->isRescanPending)
+		watcher->firstEventTime = time;
+	watcher->lastEventTime = time;
+}
+
+static void addWatchEvent(Watcher watcher, WatchEventType type,
+	const char* path, size_t pathLength, bool isDirectory)
+{
+	uint32_t hash = hashPath(path, pathLength);
+	PendingEvent* event = findPendingEvent(watcher, path, pathLength, hash);
+	if (!event)
+	{
+		event = insertPendingEvent(watcher, path, pathLength, hash);
+		if (!event)
+		{
+			watcher->isRescanPending = true;
+			return;
+		}
+	}
+
+	// Note: Merging with the previous event, so that only the net change of the path is reported.
+	WatchEventType previousType = event->type;
+	event->isDirectory = isDirectory;
+	switch (previousType)
+	{
+	case CREATED_WATCH_EVENT_TYPE:
+		if (type == REMOVED_WATCH_EVENT_TYPE)
+			event->type = DROPPED_WATCH_EVENT_TYPE;
+		break;
+	case MODIFIED_WATCH_EVENT_TYPE:
+		if (type == REMOVED_WATCH_EVENT_TYPE)
+			event->type = REMOVED_WATCH_EVENT_TYPE;
+		break;
+	case REMOVED_WATCH_EVENT_TYPE:
+		if (type != REMOVED_WATCH_EVENT_TYPE)
+			event->type = MODIFIED_WATCH_EVENT_TYPE;
+		break;
+	case RENAMED_WATCH_EVENT_TYPE:
+		if (type == REMOVED_WATCH_EVENT_TYPE)
+		{
+			char* oldPath = event->oldPath;
+			uint32_t oldPathLength = event->oldPathLength;
+			event->type = DROPPED_WATCH_EVENT_TYPE;
+			event->oldPath = NULL;
+			event->isModified = false;
+
+			// Note: Adding the event can reallocate pending events array, so the event pointer is not used after it.
+			addWatchEvent(watcher, REMOVED_WATCH_EVENT_TYPE, oldPath, oldPathLength, isDirectory);
+			free(oldPath);
+			return;
+		}
+		break;
+	default:
+		event->type = type;
+		break;
+	}
+
+	// Note: Renamed entry keeps the modification flag, so that its changed data is not missed.
+	if (event->type == RENAMED_WATCH_EVENT_TYPE)
+		event->isModified |= type == MODIFIED_WATCH_EVENT_TYPE;
+	else
+		event->isModified = event->type == MODIFIED_WATCH_EVENT_TYPE;
+}
+static void addRenameEvent(Watcher watcher, const char* oldPath,
+	size_t oldPathLength, const char* path, size_t pathLength, bool isDirectory)
+{
+	char* originPath = NULL;
+	size_t originLength = oldPathLength;
+	bool isModified = false;
+
+	PendingEvent* oldEvent = findPendingEvent(watcher, oldPath, oldPathLength, hashPath(oldPath, oldPathLength));
+	if (oldEvent)
+	{
+		WatchEventType oldType = oldEvent->type;
+		oldEvent->type = DROPPED_WATCH_EVENT_TYPE;
+
+		// Note: Entry created and renamed in the same batch (atomic save) is reported as created.
+		if (oldType == CREATED_WATCH_EVENT_TYPE)
+		{
+			addWatchEvent(watcher, CREATED_WATCH_EVENT_TYPE, path, pathLength, isDirectory);
+			return;
+		}
+		isModified = oldType == MODIFIED_WATCH_EVENT_TYPE ||
+			(oldType == RENAMED_WATCH_EVENT_TYPE && oldEvent->isModified);
+		if (oldType == RENAMED_WATCH_EVENT_TYPE)
+		{
+			originPath = oldEvent->oldPath;
+			originLength = oldEvent->oldPathLength;
+			oldEvent->oldPath = NULL;
+		}
+	}
+
+	if (!originPath)
+	{
+		originPath = malloc(oldPathLength + 1);
+		if (!originPath)
+		{
+			watcher->isRescanPending = true;
+			return;
+		}
+		memcpy(originPath, oldPath, oldPathLength + 1);
+	}
+	if (originLength == pathLength && memcmp(originPath, path, pathLength) == 0)
+	{
+		free(originPath);
+		addWatchEvent(watcher, MODIFIED_WATCH_EVENT_TYPE, path, pathLength, isDirectory);
+		return;
+	}
+
+	uint32_t hash = hashPath(path, pathLength);
+	PendingEvent* event = findPendingEvent(watcher, path, pathLength, hash);
+	if (!event)
+		event = insertPendingEvent(watcher, path, pathLength, hash);
+	if (!event)
+	{
+		free(originPath);
+		watcher->isRescanPending = true;
+		return;
+	}
+
+	free(event->oldPath);
+	event->oldPath = originPath;
+	event->oldPathLength = (uint32_t)originLength;
+	event->type = RENAMED_WATCH_EVENT_TYPE;
+	event->isDirectory = isDirectory;
+	event->isModified = isModified;
+}
+
+static uint32_t deliverWatchEvents(Watcher watcher, WatcherFunction onEvents, void* argument)
+{
+	int32_t timeout = getWatcherTimeout(watcher);
+	if (timeout != 0)
+		return 0;
+
+	// Note: Events array has one extra element for the rescan event.
+	WatchEvent rescanEvent;
+	WatchEvent* events = watcher->events ? watcher->events : &rescanEvent;
+	uint32_t eventCount = 0;
+
+	if (watcher->isRescanPending)
+	{
+		WatchEvent* event = &events[eventCount++];
+		event->path = "";
+		event->oldPath = NULL;
+		event->pathLength = event->oldPathLength = 0;
+		event->type = RESCAN_WATCH_EVENT_TYPE;
+		event->isDirectory = true;
+		event->isModified = false;
+	}
+	for (uint32_t i = 0; i < watcher->pendingCount; i++)
+	{
+		const PendingEvent* pendingEvent = &watcher->pendingEvents[i];
+		if (pendingEvent->type == DROPPED_WATCH_EVENT_TYPE)
+			continue;
+
+		WatchEvent* event = &events[eventCount++];
+		event->path = pendingEvent->path;
+		event->oldPath = pendingEvent->oldPath;
+		event->pathLength = pendingEvent->pathLength;
+		event->oldPathLength = pendingEvent->oldPathLength;
+		event->type = pendingEvent->type;
+		event->isDirectory = pendingEvent->isDirectory;
+		event->isModified = pendingEvent->isModified;
+	}
+
+	if (eventCount > 0)
+		onEvents(events, eventCount, argument);
+	clearPendingEvents(watcher);
+	return eventCount;
+}
+
+#if __linux__
+//**********************************************************************************************************************
+static bool addWatch(Watcher watcher, const char* path, size_t pathLength)
+{
+	char* fullPath = joinPath(watcher->rootPath, strlen(watcher->rootPath), path, pathLength);
+	if (!fullPath)
+		return false;
+	int wd = inotify_add_watch(watcher->inotifyFd, fullPath,
+		INOTIFY_WATCH_MASK | (pathLength > 0 ? IN_DONT_FOLLOW : 0));
+	free(fullPath);
+	if (wd < 0)
+		return false;
+
+	if ((uint32_t)wd >= watcher->watchCapacity)
+	{
+		uint32_t capacity = watcher->watchCapacity > 0 ? watcher->watchCapacity * 2 : 64;
+		while ((uint32_t)wd >= capacity)
+			capacity *= 2;
+		char** watchPaths = realloc(watcher->watchPaths, capacity * sizeof(char*));
+		if (!watchPaths)
+			return false;
+		memset(watchPaths + watcher->watchCapacity, 0, (capacity - watcher->watchCapacity) * sizeof(char*));
+		watcher->watchPaths = watchPaths;
+		watcher->watchCapacity = capacity;
+	}
+
+	char* watchPath = malloc(pathLength + 1);
+	if (!watchPath)
+		return false;
+	memcpy(watchPath, path, pathLength);
+	watchPath[pathLength] = '\0';
+
+	free(watcher->watchPaths[wd]);
+	watcher->watchPaths[wd] = watchPath;
+	return true;
+}
+
+// Note: Entries created before the watch was added are reported, so nothing is missed in the new directory.
+static bool watchDirectoryTree(Watcher watcher, const char* path, size_t pathLength, bool isReporting)
+{
+	if (!addWatch(watcher, path, pathLength))
+		return false;
+
+	char* fullPath = joinPath(watcher->rootPath, strlen(watcher->rootPath), path, pathLength);
+	if (!fullPath)
+		return false;
+	DirectoryIterator directoryIterator = openDirectoryIterator(fullPath, true);
+	free(fullPath);
+	if (!directoryIterator)
+		return true; // Note: Directory could be already removed.
+
+	DirectoryEntry entry;
+	while (nextDirectoryEntry(directoryIterator, &entry))
+	{
+		bool isDirectory = entry.type == DIRECTORY_FILE_TYPE;
+		if (!isDirectory && !isReporting)
+			continue;
+
+		char* entryPath = joinPath(path, pathLength, entry.path, entry.pathLength);
+		if (!entryPath)
+			continue;
+		size_t entryPathLength = strlen(entryPath);
+
+		if (isDirectory)
+			addWatch(watcher, entryPath, entryPathLength);
+		if (isReporting)
+			addWatchEvent(watcher, CREATED_WATCH_EVENT_TYPE, entryPath, entryPathLength, isDirectory);
+		free(entryPath);
+	}
+	closeDirectoryIterator(directoryIterator);
+	return true;
+}
+
+static void renameWatchPaths(Watcher watcher, const char* oldPath, const char* path)
+{
+	size_t oldPathLength = strlen(oldPath), pathLength = strlen(path);
+	for (uint32_t i = 0; i < watcher->watchCapacity; i++)
+	{
+		char* watchPath = watcher->watchPaths[i];
+		if (!watchPath || strncmp(watchPath, oldPath, oldPathLength) != 0 ||
+			(watchPath[oldPathLength] != '\0' && watchPath[oldPathLength] != PATH_SEPARATOR))
+		{
+			continue;
+		}
+
+		char* newPath = joinPath(path, pathLength, watchPath + oldPathLength + (watchPath[oldPathLength] != '\0'),
+			strlen(watchPath + oldPathLength) - (watchPath[oldPathLength] != '\0'));
+		if (!newPath)
+			continue;
+		free(watchPath);
+		watcher->watchPaths[i] = newPath;
+	}
+}
+static void removeWatchPaths(Watcher watcher, const char* path)
+{
+	size_t pathLength = strlen(path);
+	for (uint32_t i = 0; i < watcher->watchCapacity; i++)
+	{
+		char* watchPath = watcher->watchPaths[i];
+		if (!watchPath || strncmp(watchPath, path, pathLength) != 0 ||
+			(watchPath[pathLength] != '\0' && watchPath[pathLength] != PATH_SEPARATOR))
+		{
+			continue;
+		}
+		inotify_rm_watch(watcher->inotifyFd, (int)i);
+		free(watchPath);
+		watcher->watchPaths[i] = NULL;
+	}
+}
+
+static void flushMoveEvent(Watcher watcher)
+{
+	if (!watcher->movePath)
+		return;
+
+	// Note: Moved out of the watched directory, there is no paired moved to event.
+	addWatchEvent(watcher, REMOVED_WATCH_EVENT_TYPE,
+		watcher->movePath, strlen(watcher->movePath), watcher->isMoveDirectory);
+	if (watcher->isMoveDirectory && watcher->isRecursive)
+		removeWatchPaths(watcher, watcher->movePath);
+	free(watcher->movePath);
+	watcher->movePath = NULL;
+}
+static void rescanWatcher(Watcher watcher)
+{
+	free(watcher->movePath);
+	watcher->movePath = NULL;
+	clearPendingEvents(watcher);
+	watcher->isRescanPending = true;
+
+	if (watcher->isRecursive)
+		watchDirectoryTree(watcher, "", 0, false);
+}
+
+static void processInotifyEvent(Watcher watcher, const struct inotify_event* inotifyEvent)
+{
+	uint32_t mask = inotifyEvent->mask;
+	if (mask & IN_Q_OVERFLOW)
+	{
+		rescanWatcher(watcher);
+		return;
+	}
+
+	// Note: Flushing before the path lookup, so that the moved out subdirectory events are ignored.
+	if (watcher->movePath && (!(mask & IN_MOVED_TO) || inotifyEvent->cookie != watcher->moveCookie))
+		flushMoveEvent(watcher);
+
+	int wd = inotifyEvent->wd;
+	if (wd < 0 || (uint32_t)wd >= watcher->watchCapacity || !watcher->watchPaths[wd])
+		return;
+	const char* directory = watcher->watchPaths[wd];
+
+	if (mask & IN_IGNORED)
+	{
+		free(watcher->watchPaths[wd]);
+		watcher->watchPaths[wd] = NULL;
+		return;
+	}
+	if (mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+	{
+		// Note: Subdirectory changes are reported by their parent directory watch.
+		if (directory[0] == '\0')
+			addWatchEvent(watcher, REMOVED_WATCH_EVENT_TYPE, "", 0, true);
+		return;
+	}
+	if (inotifyEvent->len == 0)
+		return;
+
+	bool isDirectory = (mask & IN_ISDIR) != 0;
+	char* path = joinPath(directory, strlen(directory), inotifyEvent->name, strlen(inotifyEvent->name));
+	if (!path)
+	{
+		watcher->isRescanPending = true;
+		return;
+	}
+	size_t pathLength = strlen(path);
+
+	if (mask & IN_MOVED_FROM)
+	{
+		watcher->movePath = path;
+		watcher->moveCookie = inotifyEvent->cookie;
+		watcher->isMoveDirectory = isDirectory;
+		return;
+	}
+
+	if (mask & IN_MOVED_TO)
+	{
+		if (watcher->movePath)
+		{
+			addRenameEvent(watcher, watcher->movePath, strlen(watcher->movePath), path, pathLength, isDirectory);
+			if (isDirectory && watcher->isRecursive)
+				renameWatchPaths(watcher, watcher->movePath, path);
+			free(watcher->movePath);
+			watcher->movePath = NULL;
+		}
+		else
+		{
+			addWatchEvent(watcher, CREATED_WATCH_EVENT_TYPE, path, pathLength, isDirectory);
+			if (isDirectory && watcher->isRecursive)
+				watchDirectoryTree(watcher, path, pathLength, true);
+		}
+	}
+	else if (mask & IN_CREATE)
+	{
+		addWatchEvent(watcher, CREATED_WATCH_EVENT_TYPE, path, pathLength, isDirectory);
+		if (isDirectory && watcher->isRecursive)
+			watchDirectoryTree(watcher, path, pathLength, true);
+	}
+	else if (mask & IN_DELETE)
+	{
+		addWatchEvent(watcher, REMOVED_WATCH_EVENT_TYPE, path, pathLength, isDirectory);
+	}
+	else
+	{
+		addWatchEvent(watcher, MODIFIED_WATCH_EVENT_TYPE, path, pathLength, isDirectory);
+	}
+	free(path);
+}
+static void readWatcherEvents(Watcher watcher)
+{
+	while (true)
+	{
+		ssize_t size = read(watcher->inotifyFd, watcher->buffer, WATCHER_BUFFER_SIZE);
+		if (size <= 0)
+		{
+			if (size < 0 && errno == EINTR)
+				continue;
+			break;
+		}
+
+		updateEventTime(watcher);
+		for (ssize_t offset = 0; offset < size; )
+		{
+			const struct inotify_event* inotifyEvent = (const struct inotify_event*)(watcher->buffer + offset);
+			offset += (ssize_t)(sizeof(struct inotify_event) + inotifyEvent->len);
+			processInotifyEvent(watcher, inotifyEvent);
+		}
+	}
+
+	// Note: Kernel queues rename event pairs together, so an unpaired event was moved out.
+	flushMoveEvent(watcher);
+}
+
+static void watcherThreadFunction(void* argument)
+{
+	Watcher watcher = (Watcher)argument;
+	struct pollfd fds[2];
+	fds[0].fd = watcher->inotifyFd;
+	fds[0].events = POLLIN;
+	fds[1].fd = watcher->stopFd;
+	fds[1].events = POLLIN;
+
+	while (true)
+	{
+		int count = poll(fds, 2, getWatcherTimeout(watcher));
+		if (count < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		if (fds[1].revents != 0)
+			break;
+
+		readWatcherEvents(watcher);
+		deliverWatchEvents(watcher, watcher->onEvents, watcher->argument);
+	}
+}
+#elif _WIN32
+//**********************************************************************************************************************
+static bool startDirectoryRead(Watcher watcher)
+{
+	watcher->isReading = ReadDirectoryChangesW(watcher->directory, watcher->buffer, WATCHER_BUFFER_SIZE,
+		watcher->isRecursive, NOTIFY_CHANGE_FILTER, NULL, &watcher->overlapped, NULL) == TRUE;
+	return watcher->isReading;
+}
+
+static bool isDirectoryEntry(Watcher watcher, const char* path, size_t pathLength)
+{
+	char* fullPath = joinPath(watcher->rootPath, strlen(watcher->rootPath), path, pathLength);
+	if (!fullPath)
+		return false;
+	DWORD attributes = GetFileAttributesA(fullPath);
+	free(fullPath);
+	return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+}
+static void processNotifyEvent(Watcher watcher, const FILE_NOTIFY_INFORMATION* notifyInfo)
+{
+	char path[MAX_PATH * 4];
+	int pathLength = WideCharToMultiByte(CP_ACP, 0, notifyInfo->FileName,
+		(int)(notifyInfo->FileNameLength / sizeof(WCHAR)), path, (int)sizeof(path) - 1, NULL, NULL);
+	if (pathLength <= 0)
+	{
+		watcher->isRescanPending = true;
+		return;
+	}
+	path[pathLength] = '\0';
+
+	DWORD action = notifyInfo->Action;
+	if (action == FILE_ACTION_RENAMED_OLD_NAME)
+	{
+		free(watcher->movePath);
+		watcher->movePath = _strdup(path);
+		return;
+	}
+
+	bool isDirectory = action != FILE_ACTION_REMOVED && isDirectoryEntry(watcher, path, (size_t)pathLength);
+	switch (action)
+	{
+	case FILE_ACTION_ADDED:
+		addWatchEvent(watcher, CREATED_WATCH_EVENT_TYPE, path, (size_t)pathLength, isDirectory);
+		break;
+	case FILE_ACTION_REMOVED:
+		addWatchEvent(watcher, REMOVED_WATCH_EVENT_TYPE, path, (size_t)pathLength, false);
+		break;
+	case FILE_ACTION_MODIFIED:
+		// Note: Directory is reported as modified when its entries are changed, they are reported separately.
+		if (!isDirectory)
+			addWatchEvent(watcher, MODIFIED_WATCH_EVENT_TYPE, path, (size_t)pathLength, false);
+		break;
+	case FILE_ACTION_RENAMED_NEW_NAME:
+		if (watcher->movePath)
+		{
+			addRenameEvent(watcher, watcher->movePath, strlen(watcher->movePath),
+				path, (size_t)pathLength, isDirectory);
+			free(watcher->movePath);
+			watcher->movePath = NULL;
+		}
+		else
+		{
+			addWatchEvent(watcher, CREATED_WATCH_EVENT_TYPE, path, (size_t)pathLength, isDirectory);
+		}
+		break;
+	default:
+		break;
+	}
+}
+static void readWatcherEvents(Watcher watcher)
+{
+	DWORD size = 0;
+	while (watcher->isReading && GetOverlappedResult(watcher->directory, &watcher->overlapped, &size, FALSE) == TRUE)
+	{
+		updateEventTime(watcher);
+		if (size == 0)
+		{
+			// Note: Zero size means that the buffer has overflowed and events were lost.
+			clearPendingEvents(watcher);
+			watcher->isRescanPending = true;
+		}
+		else
+		{
+			for (DWORD offset = 0; true; )
+			{
+				const FILE_NOTIFY_INFORMATION* notifyInfo =
+					(const FILE_NOTIFY_INFORMATION*)(watcher->buffer + offset);
+				processNotifyEvent(watcher, notifyInfo);
+				if (notifyInfo->NextEntryOffset == 0)
+					break;
+				offset += notifyInfo->NextEntryOffset;
+			}
+		}
+
+		if (!startDirectoryRead(watcher))
+		{
+			updateEventTime(watcher);
+			watcher->isRescanPending = true;
+		}
+	}
+}
+
+static void watcherThreadFunction(void* argument)
+{
+	Watcher watcher = (Watcher)argument;
+	HANDLE handles[2] = { watcher->stopEvent, watcher->overlapped.hEvent };
+
+	while (true)
+	{
+		int32_t timeout = getWatcherTimeout(watcher);
+		DWORD result = WaitForMultipleObjects(watcher->isReading ? 2 : 1,
+			handles, FALSE, timeout < 0 ? INFINITE : (DWORD)timeout);
+		if (result == WAIT_OBJECT_0 || result == WAIT_FAILED)
+			break;
+
+		readWatcherEvents(watcher);
+		deliverWatchEvents(watcher, watcher->onEvents, watcher->argument);
+	}
+}
+#endif
+
+//**********************************************************************************************************************
+Watcher createWatcher(const char* path, bool isRecursive,
+	uint32_t debounceDelay, WatcherFunction onEvents, void* argument)
+{
+	assert(path);
+	Watcher watcher = calloc(1, sizeof(Watcher_T));
+	if (!watcher)
+		return NULL;
+
+	watcher->onEvents = onEvents;
+	watcher->argument = argument;
+	watcher->debounceDelay = (double)debounceDelay / 1000.0;
+	watcher->isRecursive = isRecursive;
+
+	size_t pathLength = strlen(path);
+	watcher->rootPath = malloc(pathLength + 1);
+	watcher->buffer = malloc(WATCHER_BUFFER_SIZE);
+	if (!watcher->rootPath || !watcher->buffer)
+	{
+		free(watcher->buffer); free(watcher->rootPath); free(watcher);
+		return NULL;
+	}
+	memcpy(watcher->rootPath, path, pathLength + 1);
+
+#if __linux__
+	watcher->stopFd = -1;
+	watcher->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (watcher->inotifyFd == -1)
+	{
+		free(watcher->buffer); free(watcher->rootPath); free(watcher);
+		return NULL;
+	}
+
+	bool result = isRecursive ? watchDirectoryTree(watcher, "", 0, false) : addWatch(watcher, "", 0);
+	if (!result)
+	{
+		destroyWatcher(watcher);
+		return NULL;
+	}
+
+	if (onEvents)
+	{
+		watcher->stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		if (watcher->stopFd == -1)
+		{
+			destroyWatcher(watcher);
+			return NULL;
+		}
+
+		watcher->thread = createThread(watcherThreadFunction, watcher, 0, "mpio-watcher");
+		if (!watcher->thread)
+		{
+			destroyWatcher(watcher);
+			return NULL;
+		}
+	}
+#elif _WIN32
+	watcher->directory = CreateFileA(path, FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+	if (watcher->directory == INVALID_HANDLE_VALUE)
+	{
+		free(watcher->buffer); free(watcher->rootPath); free(watcher);
+		return NULL;
+	}
+
+	watcher->overlapped.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+	if (!watcher->overlapped.hEvent || !startDirectoryRead(watcher))
+	{
+		destroyWatcher(watcher);
+		return NULL;
+	}
+
+	if (onEvents)
+	{
+		watcher->stopEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+		if (!watcher->stopEvent)
+		{
+			destroyWatcher(watcher);
+			return NULL;
+		}
+
+		watcher->thread = createThread(watcherThreadFunction, watcher, 0, "mpio-watcher");
+		if (!watcher->thread)
+		{
+			destroyWatcher(watcher);
+			return NULL;
+		}
+	}
+#endif
+	return watcher;
+}
+void destroyWatcher(Watcher watcher)
+{
+	if (!watcher)
+		return;
+
+#if __linux__
+	if (watcher->thread)
+	{
+		uint64_t value = 1;
+		ssize_t result = write(watcher->stopFd, &value, sizeof(uint64_t));
+		(void)result;
+		destroyThread(watcher->thread);
+	}
+
+	for (uint32_t i = 0; i < watcher->watchCapacity; i++)
+		free(watcher->watchPaths[i]);
+	free(watcher->watchPaths);
+	free(watcher->movePath);
+	if (watcher->stopFd != -1)
+		close(watcher->stopFd);
+	close(watcher->inotifyFd);
+#elif _WIN32
+	if (watcher->thread)
+	{
+		SetEvent(watcher->stopEvent);
+		destroyThread(watcher->thread);
+	}
+
+	if (watcher->isReading)
+	{
+		DWORD size = 0;
+		CancelIoEx(watcher->directory, &watcher->overlapped);
+		GetOverlappedResult(watcher->directory, &watcher->overlapped, &size, TRUE);
+	}
+	if (watcher->stopEvent)
+		CloseHandle(watcher->stopEvent);
+	if (watcher->overlapped.hEvent)
+		CloseHandle(watcher->overlapped.hEvent);
+	free(watcher->movePath);
+	CloseHandle(watcher->directory);
+#endif
+
+	clearPendingEvents(watcher);
+	free(watcher->pendingEvents);
+	free(watcher->eventSlots);
+	free(watcher->events);
+	free(watcher->buffer);
+	free(watcher->rootPath);
+	free(watcher);
+}
+
+int getWatcherFd(Watcher watcher)
+{
+	assert(watcher);
+#if __linux__
+	return watcher->inotifyFd;
+#else
+	return -1;
+#endif
+}
+int32_t getWatcherTimeout(Watcher watcher)
+{
+	assert(watcher);
+	if (watcher->pendingCount == 0 && !watcher->isRescanPending)
+		return -1;
+
+	double debounceDelay = watcher->debounceDelay;
+	double readyTime = watcher->lastEventTime + debounceDelay;
+	double maxReadyTime = watcher->firstEventTime + debounceDelay * MAX_DEBOUNCE_FACTOR;
+	if (maxReadyTime < readyTime)
+		readyTime = maxReadyTime;
+
+	double timeout = readyTime - getCurrentClock();
+	if (timeout <= 0.0)
+		return 0;
+	return (int32_t)(timeout * 1000.0) + 1; // Note: Rounding up, so that the poll does not wake up too early.
+}
+
+uint32_t pollWatcherEvents(Watcher watcher, WatcherFunction onEvents, void* argument)
+{
+	assert(watcher);
+	assert(onEvents);
+	assert(!watcher->onEvents);
+
+	readWatcherEvents(watcher);
+	return deliverWatchEvents(watcher, onEvents, argument);
+}
+#else
+//**********************************************************************************************************************
+Watcher createWatcher(const char* path, bool isRecursive,
+	uint32_t debounceDelay, WatcherFunction onEvents, void* argument)
+{
+	assert(path);
+	return NULL;
+}
+void destroyWatcher(Watcher watcher)
+{
+	assert(!watcher);
+}
+
+int getWatcherFd(Watcher watcher)
+{
+	assert(watcher);
+	return -1;
+}
+int32_t getWatcherTimeout(Watcher watcher)
+{
+	assert(watcher);
+	return -1;
+}
+uint32_t pollWatcherEvents(Watcher watcher, WatcherFunction onEvents, void* argument)
+{
+	assert(watcher);
+	return 0;
+}
+#endif
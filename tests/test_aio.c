@@ -0,0 +1,145 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/aio.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_FILE_PATH "mpio-test-aio.bin"
+#define TEST_BLOCK_SIZE 4096
+#define TEST_BLOCK_COUNT 64
+#define TEST_QUEUE_DEPTH 8
+
+inline static bool testAioQueue(bool useThreadPool)
+{
+	AioQueue aioQueue = createAioQueue(TEST_QUEUE_DEPTH, useThreadPool);
+	if (!aioQueue)
+	{
+		printf("Failed to create AIO queue.\n");
+		return false;
+	}
+
+	const char* backendName = getAioQueueBackend(aioQueue) == IO_URING_AIO_BACKEND ? "io_uring" : "thread pool";
+	printf("AIO queue backend: %s\n", backendName);
+
+	FILE* file = openFile(TEST_FILE_PATH, "w+b");
+	uint8_t* blocks = malloc(TEST_BLOCK_SIZE * TEST_BLOCK_COUNT);
+	if (!file || !blocks)
+	{
+		printf("Failed to create test file.\n");
+		if (file)
+			closeFile(file);
+		destroyAioQueue(aioQueue);
+		return false;
+	}
+
+	for (int i = 0; i < TEST_BLOCK_COUNT; i++)
+		memset(blocks + i * TEST_BLOCK_SIZE, i + 1, TEST_BLOCK_SIZE);
+
+	AioRequest requests[TEST_BLOCK_COUNT];
+	AioCompletion completions[TEST_BLOCK_COUNT];
+	memset(requests, 0, sizeof(requests));
+
+	for (int i = 0; i < TEST_BLOCK_COUNT; i++)
+	{
+		AioRequest* request = &requests[i];
+		request->buffer = blocks + i * TEST_BLOCK_SIZE;
+		request->userData = (void*)(size_t)i;
+		request->offset = (int64_t)i * TEST_BLOCK_SIZE;
+		request->size = TEST_BLOCK_SIZE;
+		request->file = getFileHandle(file);
+		request->operation = WRITE_AIO_OPERATION;
+	}
+
+	bool result = true;
+	uint32_t submitCount = 0;
+	while (submitCount < TEST_BLOCK_COUNT)
+	{
+		submitCount += submitAioRequests(aioQueue, requests + submitCount, TEST_BLOCK_COUNT - submitCount);
+		uint32_t count = waitAioCompletions(aioQueue, completions, TEST_BLOCK_COUNT, 1);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (completions[i].result != TEST_BLOCK_SIZE)
+				result = false;
+		}
+	}
+	while (getAioQueueInFlightCount(aioQueue) > 0)
+		waitAioCompletions(aioQueue, completions, TEST_BLOCK_COUNT, 1);
+
+	AioRequest syncRequest;
+	memset(&syncRequest, 0, sizeof(AioRequest));
+	syncRequest.file = getFileHandle(file);
+	syncRequest.operation = SYNC_AIO_OPERATION;
+	submitAioRequests(aioQueue, &syncRequest, 1);
+	if (waitAioCompletions(aioQueue, completions, 1, 1) != 1 || completions[0].result != 0)
+		result = false;
+
+	if (!result)
+	{
+		printf("Failed to write AIO blocks.\n");
+		free(blocks); closeFile(file);
+		destroyAioQueue(aioQueue);
+		return false;
+	}
+
+	memset(blocks, 0, TEST_BLOCK_SIZE * TEST_BLOCK_COUNT);
+	for (int i = 0; i < TEST_BLOCK_COUNT; i++)
+		requests[i].operation = READ_AIO_OPERATION;
+
+	submitCount = 0;
+	while (submitCount < TEST_BLOCK_COUNT || getAioQueueInFlightCount(aioQueue) > 0)
+	{
+		submitCount += submitAioRequests(aioQueue, requests + submitCount, TEST_BLOCK_COUNT - submitCount);
+		uint32_t count = pollAioCompletions(aioQueue, completions, TEST_BLOCK_COUNT);
+		if (count == 0)
+			count = waitAioCompletions(aioQueue, completions, TEST_BLOCK_COUNT, 1);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			size_t index = (size_t)completions[i].userData;
+			if (completions[i].result != TEST_BLOCK_SIZE ||
+				blocks[index * TEST_BLOCK_SIZE] != (uint8_t)(index + 1) ||
+				blocks[index * TEST_BLOCK_SIZE + TEST_BLOCK_SIZE - 1] != (uint8_t)(index + 1))
+			{
+				result = false;
+			}
+		}
+	}
+
+	if (!result)
+		printf("Failed to read AIO blocks.\n");
+
+	// Note: Read crossing the end of file should return only the remaining byte count on all backends.
+	requests[0].offset = (int64_t)(TEST_BLOCK_COUNT - 1) * TEST_BLOCK_SIZE + TEST_BLOCK_SIZE / 2;
+	if (submitAioRequests(aioQueue, requests, 1) != 1 || waitAioCompletions(aioQueue, completions, 1, 1) != 1 ||
+		completions[0].result != TEST_BLOCK_SIZE / 2)
+	{
+		printf("Invalid AIO read size at the end of file.\n");
+		result = false;
+	}
+
+	free(blocks); closeFile(file);
+	destroyAioQueue(aioQueue);
+	remove(TEST_FILE_PATH);
+	return result;
+}
+
+int main()
+{
+	bool result = testAioQueue(false);
+	result &= testAioQueue(true);
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -18,6 +18,17 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if __linux__ || __APPLE__
+#include <unistd.h>
+#define removeTestDirectory(path) rmdir(path)
+#elif _WIN32
+#include <windows.h>
+#define removeTestDirectory(path) RemoveDirectoryA(path)
+#endif
+
+#define TEST_DIRECTORY_PATH "mpio-test-directory"
+#define TEST_FILE_COUNT 100
+
 inline static bool testGetDataDirectory()
 {
 	char* dataDirectory = getDataDirectory(false);
@@ -96,10 +107,263 @@ inline static bool testGetResourcesDirectory()
 	return true;
 }
 
+inline static bool testCreateDirectories()
+{
+	const char* const paths[] =
+	{
+		TEST_DIRECTORY_PATH, TEST_DIRECTORY_PATH "/a", TEST_DIRECTORY_PATH "/a/b", TEST_DIRECTORY_PATH "/a/b/c",
+	};
+
+	bool isCreated = false;
+	bool result = createDirectories(TEST_DIRECTORY_PATH "//a/b/c/", &isCreated) && isCreated;
+	result &= isDirectoryExists(paths[3]);
+	result &= createDirectories(paths[3], &isCreated) && !isCreated;
+	result &= createDirectories(paths[1], NULL);
+
+	FILE* file = fopen(TEST_DIRECTORY_PATH "/file", "w");
+	if (file)
+		fclose(file);
+	result &= file && !createDirectories(TEST_DIRECTORY_PATH "/file", &isCreated) &&
+		!createDirectories(TEST_DIRECTORY_PATH "/file/d", &isCreated);
+	remove(TEST_DIRECTORY_PATH "/file");
+
+	for (size_t i = sizeof(paths) / sizeof(const char*); i > 0; i--)
+		removeTestDirectory(paths[i - 1]);
+
+	if (!result)
+	{
+		printf("Failed to create directories.\n");
+		return false;
+	}
+	return true;
+}
+
+inline static bool testGetFileInfo()
+{
+	const char* filePath = "mpio-test-info.txt";
+	FILE* file = fopen(filePath, "w");
+	if (!file)
+	{
+		printf("Failed to create file info test file.\n");
+		return false;
+	}
+	fputs("0123456789", file);
+	fclose(file);
+
+	FileInfo info;
+	bool result = getFileInfo(filePath, ALL_FILE_INFO_FIELDS, false, &info) &&
+		info.type == REGULAR_FILE_TYPE && info.size == 10 && info.modifyTime > 0 &&
+		(info.fields & FILE_INFO_FIELD_BIT(SIZE_FILE_INFO_FIELD));
+	result &= getFileInfo(".", FILE_INFO_FIELD_BIT(TYPE_FILE_INFO_FIELD), true, &info) &&
+		info.type == DIRECTORY_FILE_TYPE && (info.fields & FILE_INFO_FIELD_BIT(TYPE_FILE_INFO_FIELD));
+
+	const char* paths[3] = { filePath, "mpio-missing-file", "." };
+	FileInfo infos[3];
+	result &= getFileInfos(NULL, paths, 3, ALL_FILE_INFO_FIELDS, false, infos) == 2 &&
+		infos[0].size == 10 && infos[1].fields == 0 && infos[2].type == DIRECTORY_FILE_TYPE;
+	if (infos[0].fields & FILE_INFO_FIELD_BIT(INODE_FILE_INFO_FIELD))
+		result &= infos[0].inode != 0 && infos[0].inode != infos[2].inode;
+	remove(filePath);
+
+	if (!result)
+	{
+		printf("Invalid file info.\n");
+		return false;
+	}
+	if (getFileInfo("mpio-missing-file", ALL_FILE_INFO_FIELDS, false, &info))
+	{
+		printf("Got missing file info.\n");
+		return false;
+	}
+	return true;
+}
+
+static const char* const testDirectories[] =
+{
+	TEST_DIRECTORY_PATH "/a", TEST_DIRECTORY_PATH "/a/b", TEST_DIRECTORY_PATH "/a/b/c", TEST_DIRECTORY_PATH "/skip",
+};
+
+inline static bool createTestTree()
+{
+	createDirectory(TEST_DIRECTORY_PATH);
+	for (size_t i = 0; i < sizeof(testDirectories) / sizeof(const char*); i++)
+		createDirectory(testDirectories[i]);
+
+	char path[256];
+	for (int i = 0; i < TEST_FILE_COUNT; i++)
+	{
+		const char* directory = i % 2 == 0 ? TEST_DIRECTORY_PATH : testDirectories[i % 4];
+		snprintf(path, sizeof(path), "%s/file-%d.txt", directory, i);
+		FILE* file = fopen(path, "w");
+		if (!file)
+			return false;
+		fclose(file);
+	}
+	return true;
+}
+inline static void removeTestTree()
+{
+	char path[256];
+	for (int i = 0; i < TEST_FILE_COUNT; i++)
+	{
+		const char* directory = i % 2 == 0 ? TEST_DIRECTORY_PATH : testDirectories[i % 4];
+		snprintf(path, sizeof(path), "%s/file-%d.txt", directory, i);
+		remove(path);
+	}
+	for (size_t i = sizeof(testDirectories) / sizeof(const char*); i > 0; i--)
+		removeTestDirectory(testDirectories[i - 1]);
+	removeTestDirectory(TEST_DIRECTORY_PATH);
+}
+
+inline static bool testDirectoryIterator()
+{
+	if (!createTestTree())
+	{
+		printf("Failed to create test directory tree.\n");
+		removeTestTree();
+		return false;
+	}
+
+	DirectoryIterator directoryIterator = openDirectoryIterator(TEST_DIRECTORY_PATH, false);
+	if (!directoryIterator)
+	{
+		printf("Failed to open directory iterator.\n");
+		removeTestTree();
+		return false;
+	}
+
+	DirectoryEntry entry;
+	int fileCount = 0, directoryCount = 0;
+	while (nextDirectoryEntry(directoryIterator, &entry))
+	{
+		if (entry.type == REGULAR_FILE_TYPE)
+			fileCount++;
+		else if (entry.type == DIRECTORY_FILE_TYPE)
+			directoryCount++;
+	}
+	bool result = !isDirectoryIteratorFailed(directoryIterator) &&
+		fileCount == TEST_FILE_COUNT / 2 && directoryCount == 2;
+	closeDirectoryIterator(directoryIterator);
+
+	directoryIterator = openDirectoryIterator(TEST_DIRECTORY_PATH, true);
+	fileCount = directoryCount = 0;
+	int maxDepth = 0;
+	while (directoryIterator && nextDirectoryEntry(directoryIterator, &entry))
+	{
+		if (entry.type == REGULAR_FILE_TYPE)
+			fileCount++;
+		else if (entry.type == DIRECTORY_FILE_TYPE)
+			directoryCount++;
+		if ((int)entry.depth > maxDepth)
+			maxDepth = (int)entry.depth;
+
+		result &= strlen(entry.name) == entry.nameLength && strlen(entry.path) == entry.pathLength &&
+			strcmp(entry.path + entry.pathLength - entry.nameLength, entry.name) == 0;
+		if (entry.type == DIRECTORY_FILE_TYPE && strcmp(entry.name, "skip") == 0)
+			skipDirectoryEntries(directoryIterator);
+		if (strcmp(entry.name, "file-3.txt") == 0)
+			result &= strcmp(entry.path, "skip/file-3.txt") != 0;
+		if (strcmp(entry.name, "file-5.txt") == 0)
+			result &= strcmp(entry.path, "a/b/file-5.txt") == 0 || strcmp(entry.path, "a\\b\\file-5.txt") == 0;
+	}
+
+	// Note: Files with i % 4 == 3 are stored in the skipped directory.
+	result &= directoryIterator && !isDirectoryIteratorFailed(directoryIterator) &&
+		fileCount == TEST_FILE_COUNT - TEST_FILE_COUNT / 4 && directoryCount == 4 && maxDepth == 2;
+	closeDirectoryIterator(directoryIterator);
+	removeTestTree();
+
+	if (!result)
+	{
+		printf("Invalid directory iterator entries.\n");
+		return false;
+	}
+	if (openDirectoryIterator("mpio-missing-directory", false))
+	{
+		printf("Opened missing directory iterator.\n");
+		return false;
+	}
+	return true;
+}
+
+static volatile int32_t walkResults[TEST_FILE_COUNT];
+
+static bool filterWalkEntry(const DirectoryEntry* entry, void* argument)
+{
+	return entry->type != DIRECTORY_FILE_TYPE || strcmp(entry->name, "skip") != 0;
+}
+static void onWalkEntry(const DirectoryEntry* entry, void* argument)
+{
+	int index = -1;
+	if (entry->type != REGULAR_FILE_TYPE || sscanf(entry->name, "file-%d.txt", &index) != 1 ||
+		index < 0 || index >= TEST_FILE_COUNT)
+	{
+		return;
+	}
+
+	bool isValid = strlen(entry->path) == entry->pathLength && entry->nameLength == strlen(entry->name) &&
+		strcmp(entry->path + entry->pathLength - entry->nameLength, entry->name) == 0;
+	if (index == 5)
+		isValid &= strcmp(entry->path, "a/b/file-5.txt") == 0 || strcmp(entry->path, "a\\b\\file-5.txt") == 0;
+	if (index % 2 == 0)
+		isValid &= entry->depth == 0;
+	walkResults[index] += isValid ? 1 : 2;
+}
+
+inline static bool testWalkDirectory()
+{
+	JobSystem jobSystem = createJobSystem(0, false);
+	if (!jobSystem)
+	{
+		printf("Failed to create job system.\n");
+		return false;
+	}
+	if (!createTestTree())
+	{
+		printf("Failed to create test directory tree.\n");
+		removeTestTree(); destroyJobSystem(jobSystem);
+		return false;
+	}
+
+	memset((void*)walkResults, 0, sizeof(walkResults));
+	DirectoryWalkStats stats;
+	bool result = walkDirectory(jobSystem, TEST_DIRECTORY_PATH, filterWalkEntry, onWalkEntry, NULL, &stats);
+
+	DirectoryWalkStats serialStats;
+	result &= walkDirectory(NULL, TEST_DIRECTORY_PATH, filterWalkEntry, NULL, NULL, &serialStats) &&
+		memcmp(&serialStats, &stats, sizeof(DirectoryWalkStats)) == 0;
+	removeTestTree();
+
+	// Note: Files with i % 4 == 3 are stored in the filtered out directory.
+	result &= stats.fileCount == TEST_FILE_COUNT - TEST_FILE_COUNT / 4 && stats.directoryCount == 3 &&
+		stats.entryCount == stats.fileCount + stats.directoryCount && stats.failedDirectoryCount == 0;
+	for (int i = 0; i < TEST_FILE_COUNT; i++)
+		result &= walkResults[i] == (i % 4 == 3 ? 0 : 1);
+
+	if (!result)
+	{
+		printf("Invalid directory walk entries.\n");
+		destroyJobSystem(jobSystem);
+		return false;
+	}
+	if (walkDirectory(jobSystem, "mpio-missing-directory", NULL, NULL, NULL, NULL))
+	{
+		printf("Walked missing directory.\n");
+		destroyJobSystem(jobSystem);
+		return false;
+	}
+	destroyJobSystem(jobSystem);
+	return true;
+}
+
 int main()
 {
 	bool result = testGetDataDirectory();
 	result |= testGetAppDataDirectory();
 	result |= testGetResourcesDirectory();
+	result &= testCreateDirectories();
+	result &= testGetFileInfo();
+	result &= testDirectoryIterator();
+	result &= testWalkDirectory();
 	return result ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file
@@ -0,0 +1,326 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_FILE_PATH "mpio-test-file.bin"
+#define TEST_FILE_SIZE 100000
+
+inline static bool createTestFile()
+{
+	FILE* file = openFile(TEST_FILE_PATH, "wb");
+	if (!file)
+	{
+		printf("Failed to create test file.\n");
+		return false;
+	}
+	for (int i = 0; i < TEST_FILE_SIZE; i++)
+		fputc((uint8_t)i, file);
+	closeFile(file);
+	return true;
+}
+inline static bool testMapFileReadOnly()
+{
+	size_t size = 0;
+	const uint8_t* data = mapFile(TEST_FILE_PATH, READ_ONLY_MAP_FILE_ACCESS, 0, &size, false);
+	if (!data)
+	{
+		printf("Failed to map read-only file.\n");
+		return false;
+	}
+	if (size != TEST_FILE_SIZE)
+	{
+		printf("Invalid mapped file size.\n");
+		unmapFile((void*)data, size);
+		return false;
+	}
+	for (int i = 0; i < TEST_FILE_SIZE; i++)
+	{
+		if (data[i] != (uint8_t)i)
+		{
+			printf("Invalid mapped file data.\n");
+			unmapFile((void*)data, size);
+			return false;
+		}
+	}
+	if (!unmapFile((void*)data, size))
+	{
+		printf("Failed to unmap read-only file.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testMapFileWindow()
+{
+	const int64_t offset = 70001;
+	size_t size = 1234;
+	const uint8_t* data = mapFile(TEST_FILE_PATH, READ_ONLY_MAP_FILE_ACCESS, offset, &size, true);
+	if (!data)
+	{
+		printf("Failed to map file window.\n");
+		return false;
+	}
+	for (int i = 0; i < (int)size; i++)
+	{
+		if (data[i] != (uint8_t)(offset + i))
+		{
+			printf("Invalid mapped file window data.\n");
+			unmapFile((void*)data, size);
+			return false;
+		}
+	}
+	unmapFile((void*)data, size);
+
+	size = TEST_FILE_SIZE;
+	data = mapFile(TEST_FILE_PATH, READ_ONLY_MAP_FILE_ACCESS, offset, &size, false);
+	if (data)
+	{
+		printf("Mapped file window outside the file.\n");
+		unmapFile((void*)data, size);
+		return false;
+	}
+	return true;
+}
+inline static bool testMapFileWrite()
+{
+	size_t size = 0;
+	uint8_t* data = mapFile(TEST_FILE_PATH, COPY_ON_WRITE_MAP_FILE_ACCESS, 0, &size, false);
+	if (!data)
+	{
+		printf("Failed to map copy-on-write file.\n");
+		return false;
+	}
+	data[0] = 255;
+	unmapFile(data, size);
+
+	data = mapFile(TEST_FILE_PATH, READ_WRITE_MAP_FILE_ACCESS, 0, &size, false);
+	if (!data)
+	{
+		printf("Failed to map read-write file.\n");
+		return false;
+	}
+	if (data[0] != 0)
+	{
+		printf("Copy-on-write changes were stored to the file.\n");
+		unmapFile(data, size);
+		return false;
+	}
+	data[1] = 128;
+	if (!flushMappedFile(data, size))
+	{
+		printf("Failed to flush mapped file.\n");
+		unmapFile(data, size);
+		return false;
+	}
+	unmapFile(data, size);
+
+	FILE* file = openFile(TEST_FILE_PATH, "rb");
+	if (!file)
+	{
+		printf("Failed to open test file.\n");
+		return false;
+	}
+	fgetc(file);
+	int value = fgetc(file);
+	closeFile(file);
+
+	if (value != 128)
+	{
+		printf("Read-write changes were not stored to the file.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testPositionalIO()
+{
+	FileHandle file = openFileHandle(TEST_FILE_PATH, "r+");
+	if (file == INVALID_FILE_HANDLE)
+	{
+		printf("Failed to open file handle.\n");
+		return false;
+	}
+	if (getFileHandleSize(file) != TEST_FILE_SIZE)
+	{
+		printf("Invalid file handle size.\n");
+		closeFileHandle(file);
+		return false;
+	}
+
+	uint8_t buffer[256];
+	if (readFileAt(file, buffer, 256, 1000) != 256 || buffer[0] != (uint8_t)1000 || buffer[255] != (uint8_t)1255)
+	{
+		printf("Failed to read file at offset.\n");
+		closeFileHandle(file);
+		return false;
+	}
+	if (readFileAt(file, buffer, 256, TEST_FILE_SIZE - 10) != 10)
+	{
+		printf("Invalid file read size at the end of file.\n");
+		closeFileHandle(file);
+		return false;
+	}
+
+	uint8_t first[3] = { 11, 22, 33 }, second[2] = { 44, 55 };
+	FileBuffer buffers[2] = { { first, 3 }, { second, 2 } };
+	if (writeFileVectorAt(file, buffers, 2, 500) != 5)
+	{
+		printf("Failed to write file vector at offset.\n");
+		closeFileHandle(file);
+		return false;
+	}
+
+	memset(first, 0, 3); memset(second, 0, 2);
+	buffers[0].size = 2; buffers[1].size = 2;
+	if (readFileVectorAt(file, buffers, 2, 501) != 4 || first[0] != 22 ||
+		first[1] != 33 || second[0] != 44 || second[1] != 55)
+	{
+		printf("Failed to read file vector at offset.\n");
+		closeFileHandle(file);
+		return false;
+	}
+
+	if (!closeFileHandle(file))
+	{
+		printf("Failed to close file handle.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testCopyFile()
+{
+	const char* copyPath = "mpio-test-file-copy.bin";
+	CopyFileMethod method = COPY_FILE_METHOD_COUNT;
+	if (!copyFile(TEST_FILE_PATH, copyPath, &method))
+	{
+		printf("Failed to copy file.\n");
+		return false;
+	}
+
+	const char* methodNames[COPY_FILE_METHOD_COUNT] = { "clone", "copy range", "send file", "system", "buffered" };
+	printf("Copy file method: %s\n", method < COPY_FILE_METHOD_COUNT ? methodNames[method] : "invalid");
+
+	size_t sourceSize = 0, copySize = 0;
+	uint8_t* sourceData = mapFile(TEST_FILE_PATH, READ_ONLY_MAP_FILE_ACCESS, 0, &sourceSize, false);
+	uint8_t* copyData = mapFile(copyPath, READ_ONLY_MAP_FILE_ACCESS, 0, &copySize, false);
+	bool result = sourceData && copyData && sourceSize == copySize && memcmp(sourceData, copyData, copySize) == 0;
+	if (sourceData)
+		unmapFile(sourceData, sourceSize);
+	if (copyData)
+		unmapFile(copyData, copySize);
+	remove(copyPath);
+
+	if (!result)
+	{
+		printf("Invalid copied file data.\n");
+		return false;
+	}
+
+	if (copyFile(TEST_FILE_PATH, TEST_FILE_PATH, NULL))
+	{
+		printf("Copied file to itself.\n");
+		return false;
+	}
+	FileHandle file = openFileHandle(TEST_FILE_PATH, "r");
+	int64_t fileSize = file != INVALID_FILE_HANDLE ? getFileHandleSize(file) : -1;
+	if (file != INVALID_FILE_HANDLE)
+		closeFileHandle(file);
+	if (fileSize != TEST_FILE_SIZE)
+	{
+		printf("Source file was truncated by copying to itself.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testSparseFile()
+{
+	const char* sparsePath = "mpio-test-file-sparse.bin";
+	const int64_t fileSize = 4 * 1024 * 1024;
+
+	FileHandle file = openFileHandle(sparsePath, "w+");
+	if (file == INVALID_FILE_HANDLE)
+	{
+		printf("Failed to create sparse file.\n");
+		return false;
+	}
+
+	bool result = true;
+	if (!preallocateFile(file, 0, fileSize, false) || getFileHandleSize(file) != fileSize)
+	{
+		printf("Failed to preallocate file.\n");
+		result = false;
+	}
+	if (!adviseFileAccess(file, 0, 0, SEQUENTIAL_FILE_ACCESS_HINT))
+	{
+		printf("Failed to advise file access.\n");
+		result = false;
+	}
+
+	uint8_t buffer[4096];
+	memset(buffer, 1, sizeof(buffer));
+	writeFileAt(file, buffer, sizeof(buffer), 0);
+	writeFileAt(file, buffer, sizeof(buffer), fileSize - (int64_t)sizeof(buffer));
+
+	if (punchFileHole(file, 1024 * 1024, 2 * 1024 * 1024))
+	{
+		if (readFileAt(file, buffer, sizeof(buffer), 1024 * 1024) != sizeof(buffer) || buffer[0] != 0)
+		{
+			printf("Invalid punched file hole data.\n");
+			result = false;
+		}
+
+		FileExtent extents[16];
+		int64_t extentCount = getFileExtents(file, 0, extents, 16);
+		int64_t extentSize = 0, holeSize = 0;
+		for (int64_t i = 0; i < extentCount; i++)
+		{
+			extentSize += extents[i].size;
+			if (extents[i].isHole)
+				holeSize += extents[i].size;
+		}
+
+		if (extentCount <= 0 || extents[0].offset != 0 || extentSize != fileSize)
+		{
+			printf("Invalid file extents.\n");
+			result = false;
+		}
+		printf("File extents: %lld, hole size: %lld\n", (long long)extentCount, (long long)holeSize);
+	}
+	else
+	{
+		printf("File hole punching is not supported.\n");
+	}
+
+	closeFileHandle(file);
+	remove(sparsePath);
+	return result;
+}
+
+int main()
+{
+	if (!createTestFile())
+		return EXIT_FAILURE;
+
+	bool result = testMapFileReadOnly();
+	result &= testMapFileWindow();
+	result &= testMapFileWrite();
+	result &= testPositionalIO();
+	result &= testCopyFile();
+	result &= testSparseFile();
+	remove(TEST_FILE_PATH);
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,209 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/jobs.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_JOB_COUNT 10000
+#define TEST_RANGE_SIZE 100000
+
+static volatile int32_t jobResults[TEST_JOB_COUNT];
+static uint8_t rangeResults[TEST_RANGE_SIZE];
+
+static void countJob(void* argument)
+{
+	size_t index = (size_t)argument;
+	jobResults[index]++;
+}
+
+inline static bool testRunJobs(JobSystem jobSystem)
+{
+	JobCounter jobCounter = createJobCounter();
+	if (!jobCounter)
+	{
+		printf("Failed to create job counter.\n");
+		return false;
+	}
+
+	memset((void*)jobResults, 0, sizeof(jobResults));
+	for (size_t i = 0; i < TEST_JOB_COUNT; i++)
+	{
+		if (!runJob(jobSystem, countJob, (void*)i, jobCounter, NULL))
+		{
+			printf("Failed to run job.\n");
+			destroyJobCounter(jobCounter);
+			return false;
+		}
+	}
+	waitJobCounter(jobSystem, jobCounter);
+
+	bool result = getJobCounterValue(jobCounter) == 0;
+	for (size_t i = 0; i < TEST_JOB_COUNT; i++)
+	{
+		if (jobResults[i] != 1)
+			result = false;
+	}
+	destroyJobCounter(jobCounter);
+
+	if (!result)
+		printf("Invalid job results.\n");
+	return result;
+}
+
+#define TEST_DEPENDENCY_COUNT 100
+#define TEST_DEPENDENT_COUNT 10
+
+static volatile int32_t dependencyResults[TEST_DEPENDENCY_COUNT];
+static volatile int32_t dependentResults[TEST_DEPENDENT_COUNT];
+
+static void dependencyJob(void* argument)
+{
+	dependencyResults[(size_t)argument] = 1;
+}
+static void dependentJob(void* argument)
+{
+	int32_t isOrderValid = 1;
+	for (int i = 0; i < TEST_DEPENDENCY_COUNT; i++)
+	{
+		if (!dependencyResults[i])
+			isOrderValid = 0;
+	}
+	dependentResults[(size_t)argument] = isOrderValid ? 1 : -1;
+}
+
+inline static bool testJobDependencies(JobSystem jobSystem)
+{
+	JobCounter dependencyCounter = createJobCounter(), dependentCounter = createJobCounter();
+	if (!dependencyCounter || !dependentCounter)
+	{
+		printf("Failed to create job counters.\n");
+		destroyJobCounter(dependencyCounter); destroyJobCounter(dependentCounter);
+		return false;
+	}
+
+	memset((void*)dependencyResults, 0, sizeof(dependencyResults));
+	memset((void*)dependentResults, 0, sizeof(dependentResults));
+
+	for (size_t i = 0; i < TEST_DEPENDENCY_COUNT; i++)
+		runJob(jobSystem, dependencyJob, (void*)i, dependencyCounter, NULL);
+	for (size_t i = 0; i < TEST_DEPENDENT_COUNT; i++)
+		runJob(jobSystem, dependentJob, (void*)i, dependentCounter, dependencyCounter);
+
+	waitJobCounter(jobSystem, dependentCounter);
+	waitJobCounter(jobSystem, dependencyCounter);
+	destroyJobCounter(dependentCounter); destroyJobCounter(dependencyCounter);
+
+	for (int i = 0; i < TEST_DEPENDENT_COUNT; i++)
+	{
+		if (dependentResults[i] != 1)
+		{
+			printf("Invalid job dependency order.\n");
+			return false;
+		}
+	}
+	return true;
+}
+
+static void rangeFunction(void* argument, uint32_t begin, uint32_t end)
+{
+	for (uint32_t i = begin; i < end; i++)
+		rangeResults[i]++;
+}
+
+inline static bool testParallelFor(JobSystem jobSystem)
+{
+	memset(rangeResults, 0, sizeof(rangeResults));
+	parallelFor(jobSystem, rangeFunction, NULL, TEST_RANGE_SIZE, 16);
+	parallelFor(jobSystem, rangeFunction, NULL, TEST_RANGE_SIZE, 0);
+
+	for (uint32_t i = 0; i < TEST_RANGE_SIZE; i++)
+	{
+		if (rangeResults[i] != 2)
+		{
+			printf("Invalid parallel for range results.\n");
+			return false;
+		}
+	}
+	return true;
+}
+
+typedef struct NestedTestData
+{
+	JobSystem jobSystem;
+	JobCounter jobCounter;
+} NestedTestData;
+
+static void nestedJob(void* argument)
+{
+	NestedTestData* data = (NestedTestData*)argument;
+	for (size_t i = 0; i < TEST_JOB_COUNT; i++)
+		runJob(data->jobSystem, countJob, (void*)i, data->jobCounter, NULL);
+}
+
+inline static bool testNestedJobs(JobSystem jobSystem)
+{
+	NestedTestData data;
+	data.jobSystem = jobSystem;
+	data.jobCounter = createJobCounter();
+	if (!data.jobCounter)
+	{
+		printf("Failed to create job counter.\n");
+		return false;
+	}
+
+	memset((void*)jobResults, 0, sizeof(jobResults));
+	runJob(jobSystem, nestedJob, &data, data.jobCounter, NULL);
+	waitJobCounter(jobSystem, data.jobCounter);
+	destroyJobCounter(data.jobCounter);
+
+	for (size_t i = 0; i < TEST_JOB_COUNT; i++)
+	{
+		if (jobResults[i] != 1)
+		{
+			printf("Invalid nested job results.\n");
+			return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	JobSystem jobSystem = createJobSystem(4, false);
+	if (!jobSystem)
+	{
+		printf("Failed to create job system.\n");
+		return EXIT_FAILURE;
+	}
+
+	bool result = testRunJobs(jobSystem);
+	result &= testJobDependencies(jobSystem);
+	result &= testParallelFor(jobSystem);
+	result &= testNestedJobs(jobSystem);
+	destroyJobSystem(jobSystem);
+
+	jobSystem = createJobSystem(0, true);
+	if (!jobSystem)
+	{
+		printf("Failed to create pinned job system.\n");
+		return EXIT_FAILURE;
+	}
+	printf("Default job system worker count: %u\n", getJobSystemWorkerCount(jobSystem));
+	result &= testParallelFor(jobSystem);
+	destroyJobSystem(jobSystem);
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
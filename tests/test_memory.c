@@ -0,0 +1,202 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void onMemoryPressure(MemoryPressure pressure, void* argument)
+{
+	printf("Memory pressure event: %d\n", (int)pressure);
+}
+
+inline static bool testPollMemoryPressure()
+{
+	MemoryMonitor memoryMonitor = createMemoryMonitor(NULL, NULL);
+	if (!memoryMonitor)
+	{
+		printf("Memory pressure monitoring is not supported.\n");
+		return true;
+	}
+
+#if __linux__
+	if (getMemoryMonitorFd(memoryMonitor) < 0)
+	{
+		printf("Invalid memory monitor file descriptor.\n");
+		destroyMemoryMonitor(memoryMonitor);
+		return false;
+	}
+#endif
+
+	MemoryPressure pressure = pollMemoryPressure(memoryMonitor);
+	destroyMemoryMonitor(memoryMonitor);
+
+	if (pressure >= MEMORY_PRESSURE_COUNT)
+	{
+		printf("Invalid memory pressure level.\n");
+		return false;
+	}
+
+	printf("Memory pressure level: %d\n", (int)pressure);
+	return true;
+}
+inline static bool testMemoryPressureCallback()
+{
+	MemoryMonitor memoryMonitor = createMemoryMonitor(onMemoryPressure, NULL);
+	if (!memoryMonitor)
+	{
+		printf("Memory pressure monitoring is not supported.\n");
+		return true;
+	}
+
+	destroyMemoryMonitor(memoryMonitor);
+	return true;
+}
+
+inline static bool testVirtualMemory()
+{
+	size_t pageSize = getPageSize();
+	if (pageSize == 0 || (pageSize & (pageSize - 1)) != 0)
+	{
+		printf("Invalid page size.\n");
+		return false;
+	}
+
+	const size_t size = 64 * 1024 * 1024;
+	uint8_t* memory = reserveMemory(size);
+	if (!memory)
+	{
+		printf("Failed to reserve memory.\n");
+		return false;
+	}
+
+	bool result = commitMemory(memory, pageSize * 4);
+	if (result)
+	{
+		memory[0] = 1; memory[pageSize * 4 - 1] = 2;
+		result = decommitMemory(memory, pageSize * 4) && commitMemory(memory, pageSize * 4) &&
+			memory[0] == 0 && memory[pageSize * 4 - 1] == 0; // Note: Decommitted pages should be zeroed.
+		result &= guardMemory(memory + pageSize, pageSize);
+	}
+	if (!result)
+		printf("Failed to commit or decommit memory.\n");
+
+	if (lockMemory(memory, pageSize))
+		unlockMemory(memory, pageSize);
+	else
+		printf("Memory locking is not permitted.\n");
+
+	printf("Page size: %zu, huge page size: %zu\n", pageSize, getHugePageSize());
+	result &= releaseMemory(memory, size);
+	return result;
+}
+inline static bool testMemoryArena()
+{
+	MemoryArena memoryArena = createMemoryArena(16 * 1024 * 1024, false);
+	if (!memoryArena)
+	{
+		printf("Failed to create memory arena.\n");
+		return false;
+	}
+
+	uint8_t* first = allocateArenaMemory(memoryArena, 100, 1);
+	uint64_t* second = allocateArenaMemory(memoryArena, sizeof(uint64_t) * 4, 64);
+	bool result = first && second && ((size_t)second & 63) == 0 && (uint8_t*)second >= first + 100;
+	if (result)
+	{
+		memset(first, 1, 100);
+		second[0] = second[3] = UINT64_MAX;
+	}
+
+	size_t marker = getMemoryArenaSize(memoryArena);
+	uint8_t* large = allocateArenaMemory(memoryArena, 4 * 1024 * 1024, 16);
+	result &= large != NULL && getMemoryArenaCommittedSize(memoryArena) >= marker + 4 * 1024 * 1024;
+	if (large)
+		memset(large, 2, 4 * 1024 * 1024);
+	result &= first[99] == 1 && second[3] == UINT64_MAX;
+
+	rewindMemoryArena(memoryArena, marker);
+	result &= getMemoryArenaSize(memoryArena) == marker && allocateArenaMemory(memoryArena, 1, 1) == large;
+	result &= allocateArenaMemory(memoryArena, 32 * 1024 * 1024, 1) == NULL;
+
+	resetMemoryArena(memoryArena);
+	result &= getMemoryArenaSize(memoryArena) == 0 && trimMemoryArena(memoryArena) &&
+		getMemoryArenaCommittedSize(memoryArena) < 4 * 1024 * 1024;
+	result &= allocateArenaMemory(memoryArena, 100, 1) == first && first[0] == 1;
+	destroyMemoryArena(memoryArena);
+
+	memoryArena = createMemoryArena(1024, true);
+	result &= memoryArena && allocateArenaMemory(memoryArena, 1024, 1) != NULL;
+	destroyMemoryArena(memoryArena);
+
+	if (!result)
+	{
+		printf("Invalid memory arena allocations.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testMemoryPool()
+{
+	const size_t maxItemCount = 100000;
+	MemoryPool memoryPool = createMemoryPool(24, maxItemCount);
+	if (!memoryPool)
+	{
+		printf("Failed to create memory pool.\n");
+		return false;
+	}
+
+	bool result = getMemoryPoolItemSize(memoryPool) == 32;
+	void** items = malloc(maxItemCount * sizeof(void*));
+	for (size_t i = 0; i < maxItemCount && items && result; i++)
+	{
+		items[i] = allocatePoolItem(memoryPool);
+		result = items[i] && ((size_t)items[i] & 15) == 0;
+		if (result)
+			*(size_t*)items[i] = i;
+	}
+	result &= allocatePoolItem(memoryPool) == NULL && getMemoryPoolItemCount(memoryPool) == maxItemCount;
+
+	if (items && result)
+	{
+		for (size_t i = 0; i < maxItemCount; i += 2)
+			freePoolItem(memoryPool, items[i]);
+		for (size_t i = 1; i < maxItemCount; i += 2)
+			result &= *(size_t*)items[i] == i;
+		result &= getMemoryPoolItemCount(memoryPool) == maxItemCount / 2;
+		result &= allocatePoolItem(memoryPool) == items[maxItemCount - 2];
+	}
+
+	free(items);
+	destroyMemoryPool(memoryPool);
+
+	if (!result)
+	{
+		printf("Invalid memory pool allocations.\n");
+		return false;
+	}
+	return true;
+}
+
+int main()
+{
+	bool result = testPollMemoryPressure();
+	result &= testMemoryPressureCallback();
+	result &= testVirtualMemory();
+	result &= testMemoryArena();
+	result &= testMemoryPool();
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -34,6 +34,60 @@ inline static bool testGetCurrentClock()
 
 	return true;
 }
+inline static bool testGetCurrentClockNs()
+{
+	int64_t startClock = getCurrentClockNs(), coarseClock = getCoarseClockNs();
+	uint64_t startCycles = getCycleCount(), frequency = getCycleFrequency();
+
+	int64_t stopClock;
+	do { stopClock = getCurrentClockNs(); } while (stopClock - startClock < 5000000);
+	uint64_t stopCycles = getCycleCount();
+
+	if (frequency == 0 || stopCycles <= startCycles || getCoarseClockNs() < coarseClock)
+	{
+		printf("Invalid clock values.\n");
+		return false;
+	}
+
+	// Note: Virtual machines can have an imprecise cycle counter, so the tolerance is large.
+	double cycleTime = (double)convertCyclesToNs(stopCycles - startCycles);
+	double clockTime = (double)(stopClock - startClock);
+	if (cycleTime < clockTime * 0.75 || cycleTime > clockTime * 1.25)
+	{
+		printf("Invalid cycle counter calibration. (%.0lf ns, %.0lf ns)\n", cycleTime, clockTime);
+		return false;
+	}
+
+	ClockCorrelation clockCorrelation;
+	getClockCorrelation(&clockCorrelation);
+	if (clockCorrelation.wallTimeNs <= 0 || clockCorrelation.monotonicNs < startClock ||
+		clockCorrelation.cycleCount < startCycles)
+	{
+		printf("Invalid clock correlation.\n");
+		return false;
+	}
+
+	const int callCount = 100000;
+	int64_t checksum = 0;
+	startClock = getCurrentClockNs();
+	for (int i = 0; i < callCount; i++)
+		checksum += getCurrentClockNs();
+	double clockCallTime = (double)(getCurrentClockNs() - startClock) / callCount;
+
+	startClock = getCurrentClockNs();
+	for (int i = 0; i < callCount; i++)
+		checksum += getCoarseClockNs();
+	double coarseCallTime = (double)(getCurrentClockNs() - startClock) / callCount;
+
+	startClock = getCurrentClockNs();
+	for (int i = 0; i < callCount; i++)
+		checksum += (int64_t)getCycleCount();
+	double cycleCallTime = (double)(getCurrentClockNs() - startClock) / callCount;
+
+	printf("Cycle frequency: %llu Hz, clock: %.1lf ns, coarse: %.1lf ns, cycles: %.1lf ns (%lld)\n",
+		(unsigned long long)frequency, clockCallTime, coarseCallTime, cycleCallTime, (long long)(checksum & 1));
+	return true;
+}
 inline static bool testGetLogicalCpuCount()
 {
 	int cpuCount = getLogicalCpuCount();
@@ -70,6 +124,30 @@ inline static bool testGetPerformanceCpuCount()
 	printf("Performance CPU count: %d\n", cpuCount);
 	return true;
 }
+inline static bool testGetHybridCpuSets()
+{
+	CpuSet performanceCpus, efficiencyCpus;
+	bool isHybrid = getHybridCpuSets(&performanceCpus, &efficiencyCpus);
+
+	int performanceCount = getCpuSetCount(&performanceCpus), efficiencyCount = getCpuSetCount(&efficiencyCpus);
+	if (performanceCount <= 0 || (isHybrid && efficiencyCount <= 0) || (!isHybrid && efficiencyCount != 0))
+	{
+		printf("Invalid hybrid CPU sets.\n");
+		return false;
+	}
+	for (int i = 0; i < MAX_CPU_SET_COUNT; i++)
+	{
+		if (isCpuInSet(&performanceCpus, i) && isCpuInSet(&efficiencyCpus, i))
+		{
+			printf("Overlapping hybrid CPU sets.\n");
+			return false;
+		}
+	}
+
+	printf("Hybrid CPU: %s, performance CPUs: %d, efficiency CPUs: %d\n",
+		isHybrid ? "yes" : "no", performanceCount, efficiencyCount);
+	return true;
+}
 inline static bool testGetTotalRamSize()
 {
 	int64_t ramSize = getTotalRamSize();
@@ -94,6 +172,71 @@ inline static bool testGetFreeRamSize()
 	printf("Free RAM size: %lld\n", ramSize);
 	return true;
 }
+inline static bool testGetEffectiveLimits()
+{
+	int cpuCount = getEffectiveCpuCount();
+	if (cpuCount <= 0 || cpuCount > getLogicalCpuCount())
+	{
+		printf("Invalid effective CPU count.\n");
+		return false;
+	}
+
+	int64_t ramSize = getEffectiveRamSize();
+	if (ramSize <= 0 || ramSize > getTotalRamSize())
+	{
+		printf("Invalid effective RAM size.\n");
+		return false;
+	}
+
+	printf("Effective CPU count: %d, RAM size: %lld\n", cpuCount, (long long)ramSize);
+	return true;
+}
+inline static bool testGetResourceUsage()
+{
+	const size_t size = 8 * 1024 * 1024;
+	uint8_t* data = malloc(size);
+	if (!data)
+		return false;
+	memset(data, 1, size);
+
+	volatile uint64_t sum = 0;
+	for (size_t i = 0; i < size; i++)
+		sum += data[i];
+
+	ResourceUsage process, thread;
+	bool result = getResourceUsage(THREAD_RESOURCE_USAGE_TARGET, &thread) &&
+		getResourceUsage(PROCESS_RESOURCE_USAGE_TARGET, &process);
+	free(data);
+
+	if (!result || process.userTimeNs < 0 || process.systemTimeNs < 0 ||
+		process.peakRssSize < (int64_t)size || thread.userTimeNs < 0 ||
+		thread.userTimeNs + thread.systemTimeNs > process.userTimeNs + process.systemTimeNs)
+	{
+		printf("Invalid resource usage.\n");
+		return false;
+	}
+#if __linux__ || __APPLE__
+	ResourceUsage children;
+	if (process.currentRssSize <= 0 || process.currentRssSize > process.peakRssSize ||
+		!getResourceUsage(CHILDREN_RESOURCE_USAGE_TARGET, &children))
+	{
+		printf("Invalid process RSS or children resource usage.\n");
+		return false;
+	}
+#endif
+
+	int64_t threadTime = getThreadCpuTimeNs(), processTime = getProcessCpuTimeNs();
+	if (threadTime <= 0 || processTime < threadTime)
+	{
+		printf("Invalid thread or process CPU time.\n");
+		return false;
+	}
+
+	printf("Process RSS: %lld, peak RSS: %lld, minor faults: %lld, read: %lld, written: %lld\n",
+		(long long)process.currentRssSize, (long long)process.peakRssSize, (long long)process.minorFaultCount,
+		(long long)process.readSize, (long long)process.writeSize);
+	return true;
+}
 inline static bool testGetCpuName()
 {
 	char* cpuName = getCpuName();
@@ -112,6 +255,131 @@ inline static bool testGetCpuName()
 	free(cpuName);
 	return true;
 }
+typedef int(*SumFunction)(const int* values, int count);
+
+static int sumGeneric(const int* values, int count)
+{
+	int sum = 0;
+	for (int i = 0; i < count; i++)
+		sum += values[i];
+	return sum;
+}
+MPIO_TARGET_AVX2 static int sumAvx2(const int* values, int count)
+{
+	int sum = 0;
+	for (int i = 0; i < count; i++)
+		sum += values[i];
+	return sum;
+}
+
+inline static bool testGetCpuFeatures()
+{
+	uint64_t cpuFeatures = getCpuFeatures();
+	printf("CPU features:");
+	for (uint8_t i = 0; i < CPU_FEATURE_COUNT; i++)
+	{
+		if (cpuFeatures & CPU_FEATURE_BIT(i))
+			printf(" %s", getCpuFeatureName(i));
+	}
+	printf("\n");
+
+#if __x86_64__ || _M_X64
+	if (!hasCpuFeature(SSE2_CPU_FEATURE))
+	{
+		printf("Invalid x86-64 CPU features.\n");
+		return false;
+	}
+#elif __aarch64__ || _M_ARM64
+	if (!hasCpuFeature(NEON_CPU_FEATURE))
+	{
+		printf("Invalid ARM64 CPU features.\n");
+		return false;
+	}
+#endif
+
+	const CpuFunctionVariant variants[2] =
+	{
+		{ (CpuFunction)sumAvx2, CPU_FEATURE_BIT(AVX2_CPU_FEATURE) },
+		{ (CpuFunction)sumGeneric, 0 },
+	};
+	SumFunction sumFunction = (SumFunction)selectCpuFunction(variants, 2);
+	SumFunction expectedFunction = hasCpuFeature(AVX2_CPU_FEATURE) ? sumAvx2 : sumGeneric;
+
+	const int values[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	if (sumFunction != expectedFunction || sumFunction(values, 8) != 36)
+	{
+		printf("Invalid selected CPU function.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testGetSystemInfo()
+{
+	SystemInfo systemInfo;
+	getSystemInfo(&systemInfo);
+
+	if (systemInfo.logicalCpuCount != getLogicalCpuCount() || systemInfo.physicalCpuCount != getPhysicalCpuCount() ||
+		systemInfo.performanceCpuCount != getPerformanceCpuCount() || systemInfo.totalRamSize != getTotalRamSize())
+	{
+		printf("Invalid system info snapshot.\n");
+		return false;
+	}
+	if (!updateSystemInfo())
+	{
+		printf("Failed to update system info.\n");
+		return false;
+	}
+
+	const int callCount = 100000;
+	double startClock = getCurrentClock();
+	int64_t checksum = 0;
+	for (int i = 0; i < callCount; i++)
+		checksum += getLogicalCpuCount() + getFreeRamSize();
+	double callTime = (getCurrentClock() - startClock) / (callCount * 2);
+
+	printf("System info getter time: %.1lf ns (%lld)\n", callTime * 1000000000.0, (long long)(checksum & 1));
+	return true;
+}
+inline static bool testCreateCpuTopology()
+{
+	CpuTopology* cpuTopology = createCpuTopology();
+	if (!cpuTopology)
+	{
+		printf("Failed to create CPU topology.\n");
+		return false;
+	}
+
+	bool result = true;
+	int onlineCount = getCpuSetCount(&cpuTopology->onlineCpus), coreCpuCount = 0;
+	for (int i = 0; i < cpuTopology->coreCount; i++)
+		coreCpuCount += getCpuSetCount(&cpuTopology->cores[i]);
+
+	if (onlineCount <= 0 || cpuTopology->coreCount <= 0 || cpuTopology->packageCount <= 0 ||
+		cpuTopology->nodeCount <= 0 || coreCpuCount != onlineCount || cpuTopology->cacheLineSize <= 0)
+	{
+		printf("Invalid CPU topology.\n");
+		result = false;
+	}
+
+	printf("CPU topology: %d CPUs, %d cores, %d packages, %d nodes, %d byte cache line\n", onlineCount,
+		cpuTopology->coreCount, cpuTopology->packageCount, cpuTopology->nodeCount, cpuTopology->cacheLineSize);
+	for (int i = 0; i < cpuTopology->cacheCount; i++)
+	{
+		const CpuCache* cache = &cpuTopology->caches[i];
+		const char* typeNames[CPU_CACHE_TYPE_COUNT] = { "unified", "data", "instruction" };
+		printf("L%d %s cache: %lld KB, %d byte line, %d way, %d CPUs\n", (int)cache->level,
+			cache->type < CPU_CACHE_TYPE_COUNT ? typeNames[cache->type] : "invalid", (long long)(cache->size / 1024),
+			cache->lineSize, cache->associativity, getCpuSetCount(&cache->cpus));
+	}
+	if (cpuTopology->cacheCount > 0 && getCpuCacheSize(cpuTopology, 1) <= 0)
+	{
+		printf("Invalid L1 CPU cache size.\n");
+		result = false;
+	}
+
+	destroyCpuTopology(cpuTopology);
+	return result;
+}
 
 int main()
 {
@@ -122,5 +390,12 @@ int main()
 	result |= testGetTotalRamSize();
 	result |= testGetFreeRamSize();
 	result |= testGetCpuName();
+	result &= testGetCurrentClockNs();
+	result &= testGetHybridCpuSets();
+	result &= testGetEffectiveLimits();
+	result &= testGetResourceUsage();
+	result &= testGetCpuFeatures();
+	result &= testGetSystemInfo();
+	result &= testCreateCpuTopology();
 	return result ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file
@@ -0,0 +1,262 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/process.h"
+#include "mpio/file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_FILE_PATH "mpio-test-process.txt"
+#define TEST_INPUT_SIZE (256 * 1024)
+#define TEST_POOL_JOB_COUNT 8
+
+#if _WIN32
+#define TEST_SHELL "cmd"
+#define TEST_SHELL_FLAG "/c"
+#define TEST_OUTPUT_COMMAND "echo out& echo err 1>&2& exit 3"
+#define TEST_FILE_COMMAND "echo file"
+#define TEST_SLEEP_ARGS { "ping", "-n", "30", "127.0.0.1", NULL }
+#else
+#define TEST_SHELL "sh"
+#define TEST_SHELL_FLAG "-c"
+#define TEST_OUTPUT_COMMAND "echo out; echo err >&2; exit 3"
+#define TEST_FILE_COMMAND "echo file"
+#define TEST_SLEEP_ARGS { "sleep", "30", NULL }
+#endif
+
+inline static bool testCaptureOutput()
+{
+	char* args[] = { TEST_SHELL, TEST_SHELL_FLAG, TEST_OUTPUT_COMMAND, NULL };
+	ProcessOptions options;
+	memset(&options, 0, sizeof(ProcessOptions));
+	options.stdoutType = PIPE_PROCESS_STREAM;
+	options.stderrType = PIPE_PROCESS_STREAM;
+
+	ProcessOutput output;
+	int exitCode = runProcess(TEST_SHELL, args, &options, &output);
+	bool result = exitCode == 3 && output.stdoutData && output.stderrData &&
+		strncmp(output.stdoutData, "out", 3) == 0 && strncmp(output.stderrData, "err", 3) == 0;
+	free(output.stdoutData); free(output.stderrData);
+
+	if (!result)
+	{
+		printf("Failed to capture process output.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testRedirectFile()
+{
+	char* args[] = { TEST_SHELL, TEST_SHELL_FLAG, TEST_FILE_COMMAND, NULL };
+	ProcessOptions options;
+	memset(&options, 0, sizeof(ProcessOptions));
+	options.stdinType = NULL_PROCESS_STREAM;
+	options.stdoutType = FILE_PROCESS_STREAM;
+	options.stdoutPath = TEST_FILE_PATH;
+
+	if (runProcess(TEST_SHELL, args, &options, NULL) != 0)
+	{
+		printf("Failed to redirect process output to file.\n");
+		return false;
+	}
+
+	char buffer[16];
+	memset(buffer, 0, sizeof(buffer));
+	FILE* file = openFile(TEST_FILE_PATH, "rb");
+	if (file)
+	{
+		size_t readSize = fread(buffer, 1, sizeof(buffer) - 1, file);
+		(void)readSize;
+		closeFile(file);
+	}
+	remove(TEST_FILE_PATH);
+
+	if (strncmp(buffer, "file", 4) != 0)
+	{
+		printf("Invalid redirected process output.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testMissingFile()
+{
+	char* args[] = { "mpio-missing-executable", NULL };
+	int exitCode = runProcess("mpio-missing-executable", args, NULL, NULL);
+	if (exitCode != -1 && exitCode != 127) // Note: Some shells and old libc report missing file with 127.
+	{
+		printf("Launched missing executable.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testStartProcess()
+{
+	char* args[] = { TEST_SHELL, TEST_SHELL_FLAG, "exit 5", NULL };
+	Process process = startProcess(TEST_SHELL, args, NULL);
+	if (!process)
+	{
+		printf("Failed to start process.\n");
+		return false;
+	}
+
+	ProcessStats stats;
+	waitProcess(process, &stats);
+	destroyProcess(process);
+
+	if (stats.exitCode != 5 || stats.wallTimeNs <= 0)
+	{
+		printf("Invalid started process stats.\n");
+		return false;
+	}
+
+	char* sleepArgs[] = TEST_SLEEP_ARGS;
+	ProcessOptions options;
+	memset(&options, 0, sizeof(ProcessOptions));
+	options.stdoutType = NULL_PROCESS_STREAM;
+	process = startProcess(sleepArgs[0], sleepArgs, &options);
+	if (!process)
+	{
+		printf("Failed to start process.\n");
+		return false;
+	}
+
+	bool result = !pollProcess(process, NULL) && killProcess(process);
+	waitProcess(process, &stats);
+	destroyProcess(process);
+
+	if (!result || stats.exitCode == 0 || stats.wallTimeNs >= 10000000000LL)
+	{
+		printf("Failed to kill process.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testProcessPool()
+{
+	ProcessPool processPool = createProcessPool(3);
+	if (!processPool)
+	{
+		printf("Failed to create process pool.\n");
+		return false;
+	}
+
+	bool result = true;
+	for (int i = 0; i < TEST_POOL_JOB_COUNT; i++)
+	{
+		char command[16];
+		snprintf(command, sizeof(command), "exit %d", i);
+		char* args[] = { TEST_SHELL, TEST_SHELL_FLAG, command, NULL };
+		result &= addProcessPoolJob(processPool, TEST_SHELL, args, NULL, (void*)(size_t)i);
+	}
+	char* missingArgs[] = { "mpio-missing-executable", NULL };
+	result &= addProcessPoolJob(processPool, "mpio-missing-executable",
+		missingArgs, NULL, (void*)(size_t)TEST_POOL_JOB_COUNT);
+
+	ProcessCompletion completions[4];
+	uint32_t completionCount = 0;
+	while (getProcessPoolJobCount(processPool) > 0)
+	{
+		uint32_t count = waitProcessPoolCompletions(processPool, completions, 4, 1);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			size_t index = (size_t)completions[i].userData;
+			int exitCode = completions[i].stats.exitCode;
+			if (index == TEST_POOL_JOB_COUNT)
+				result &= exitCode == -1 || exitCode == 127;
+			else
+				result &= exitCode == (int)index && completions[i].stats.wallTimeNs > 0;
+		}
+		completionCount += count;
+		if (count == 0)
+			break;
+	}
+	destroyProcessPool(processPool);
+
+	if (!result || completionCount != TEST_POOL_JOB_COUNT + 1)
+	{
+		printf("Invalid process pool completions.\n");
+		return false;
+	}
+	return true;
+}
+
+#if __linux__ || __APPLE__
+inline static bool testWriteInput()
+{
+	char* input = malloc(TEST_INPUT_SIZE);
+	if (!input)
+		return false;
+	for (int i = 0; i < TEST_INPUT_SIZE; i++)
+		input[i] = (char)('a' + i % 26);
+
+	char* args[] = { "cat", NULL };
+	ProcessOptions options;
+	memset(&options, 0, sizeof(ProcessOptions));
+	options.stdinType = PIPE_PROCESS_STREAM;
+	options.stdinData = input;
+	options.stdinSize = TEST_INPUT_SIZE;
+	options.stdoutType = PIPE_PROCESS_STREAM;
+
+	ProcessOutput output;
+	int exitCode = runProcess("cat", args, &options, &output);
+	bool result = exitCode == 0 && output.stdoutSize == TEST_INPUT_SIZE &&
+		memcmp(output.stdoutData, input, TEST_INPUT_SIZE) == 0;
+	free(output.stdoutData); free(input);
+
+	if (!result)
+	{
+		printf("Failed to write process input.\n");
+		return false;
+	}
+	return true;
+}
+inline static bool testEnvironment()
+{
+	const char* environment[] = { "MPIO_TEST=value", NULL };
+	char* args[] = { "sh", "-c", "pwd; echo $MPIO_TEST", NULL };
+	ProcessOptions options;
+	memset(&options, 0, sizeof(ProcessOptions));
+	options.workingDirectory = "/";
+	options.environment = environment;
+	options.stdoutType = PIPE_PROCESS_STREAM;
+
+	ProcessOutput output;
+	int exitCode = runProcess("sh", args, &options, &output);
+	bool result = exitCode == 0 && output.stdoutData && strcmp(output.stdoutData, "/\nvalue\n") == 0;
+	free(output.stdoutData);
+
+	if (!result)
+	{
+		printf("Invalid process working directory or environment.\n");
+		return false;
+	}
+	return true;
+}
+#endif
+
+int main()
+{
+	bool result = testCaptureOutput();
+	result &= testRedirectFile();
+	result &= testMissingFile();
+	result &= testStartProcess();
+	result &= testProcessPool();
+#if __linux__ || __APPLE__
+	result &= testWriteInput();
+	result &= testEnvironment();
+#endif
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,138 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ThreadTestData
+{
+	int cpuIndex;
+	bool isPriorityLowered;
+	volatile uint8_t stackCheck;
+} ThreadTestData;
+
+static void threadFunction(void* argument)
+{
+	ThreadTestData* data = (ThreadTestData*)argument;
+
+	// Note: Touching a large stack buffer to check custom thread stack size.
+	volatile uint8_t buffer[512 * 1024];
+	memset((void*)buffer, 1, sizeof(buffer));
+	data->stackCheck = buffer[sizeof(buffer) - 1];
+
+	data->isPriorityLowered = setThreadPriority(NULL, LOW_THREAD_PRIORITY);
+	data->cpuIndex = getCurrentThreadCpu();
+}
+
+inline static bool testCreateThread()
+{
+	ThreadTestData data;
+	memset(&data, 0, sizeof(ThreadTestData));
+	data.cpuIndex = -2;
+
+	Thread thread = createThread(threadFunction, &data, 2 * 1024 * 1024, "mpio-test-thread-name");
+	if (!thread)
+	{
+		printf("Failed to create thread.\n");
+		return false;
+	}
+	destroyThread(thread);
+
+	if (data.stackCheck != 1 || data.cpuIndex == -2)
+	{
+		printf("Thread function has not been executed.\n");
+		return false;
+	}
+	if (!data.isPriorityLowered)
+	{
+		printf("Failed to lower thread priority.\n");
+		return false;
+	}
+
+	printf("Thread CPU: %d\n", data.cpuIndex);
+	return true;
+}
+inline static bool testThreadAffinity()
+{
+	CpuSet oldAffinity;
+	if (!getThreadAffinity(NULL, &oldAffinity))
+	{
+		printf("Thread affinity is not supported.\n");
+		return true;
+	}
+
+	int targetCpu = -1;
+	for (int i = MAX_CPU_SET_COUNT - 1; i >= 0; i--)
+	{
+		if (isCpuInSet(&oldAffinity, i))
+		{
+			targetCpu = i;
+			break;
+		}
+	}
+	if (targetCpu < 0)
+	{
+		printf("Invalid thread affinity.\n");
+		return false;
+	}
+
+	CpuSet affinity; clearCpuSet(&affinity);
+	addCpuToSet(&affinity, targetCpu);
+	if (!setThreadAffinity(NULL, &affinity))
+	{
+		printf("Failed to set thread affinity.\n");
+		return false;
+	}
+
+	bool result = true;
+	int currentCpu = getCurrentThreadCpu();
+	if (currentCpu >= 0 && currentCpu != targetCpu)
+	{
+		printf("Thread is running outside of its affinity.\n");
+		result = false;
+	}
+
+	CpuSet newAffinity;
+	if (!getThreadAffinity(NULL, &newAffinity) || !isCpuSetEqual(&affinity, &newAffinity))
+	{
+		printf("Invalid pinned thread affinity.\n");
+		result = false;
+	}
+	if (!setThreadAffinity(NULL, &oldAffinity))
+	{
+		printf("Failed to restore thread affinity.\n");
+		result = false;
+	}
+	return result;
+}
+inline static bool testSetThreadName()
+{
+	if (!setThreadName(NULL, "mpio-test"))
+	{
+		printf("Failed to set thread name.\n");
+		return false;
+	}
+	return true;
+}
+
+int main()
+{
+	bool result = testCreateThread();
+	result &= testThreadAffinity();
+	result &= testSetThreadName();
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,123 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/trace.h"
+#include "mpio/thread.h"
+#include "mpio/file.h"
+#include "mpio/os.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_APP_NAME "mpio-test-trace"
+#define TEST_ZONE_COUNT 10000
+
+inline static void traceThreadFunction(void* argument)
+{
+	for (int i = 0; i < 100; i++)
+	{
+		MPIO_TRACE_BEGIN("Thread Zone");
+		MPIO_TRACE_COUNTER("Thread Counter", i);
+		MPIO_TRACE_END();
+	}
+}
+inline static bool testTracing()
+{
+	if (!startTracing(TEST_APP_NAME))
+	{
+		printf("Failed to start tracing.\n");
+		return false;
+	}
+	if (!isTracing() || !getTraceFilePath())
+	{
+		printf("Invalid tracing state.\n");
+		stopTracing();
+		return false;
+	}
+
+	Thread thread = createThread(traceThreadFunction, NULL, 0, "mpio-test");
+	if (!thread)
+	{
+		printf("Failed to create trace thread.\n");
+		stopTracing();
+		return false;
+	}
+
+	int64_t startTime = getCurrentClockNs();
+	for (int i = 0; i < TEST_ZONE_COUNT; i++)
+	{
+		MPIO_TRACE_BEGIN("Main \"Zone\"");
+		MPIO_TRACE_END();
+	}
+	int64_t time = getCurrentClockNs() - startTime;
+	printf("Trace zone cost: %.1lf ns\n", (double)time / TEST_ZONE_COUNT);
+	destroyThread(thread);
+
+	size_t pathLength = strlen(getTraceFilePath());
+	char* filePath = malloc(pathLength + 1);
+	if (!filePath)
+	{
+		stopTracing();
+		return false;
+	}
+	memcpy(filePath, getTraceFilePath(), pathLength + 1);
+	uint64_t droppedCount = getTraceDroppedCount();
+	stopTracing();
+
+	FILE* file = openFile(filePath, "rb");
+	if (!file)
+	{
+		printf("Failed to open trace file.\n");
+		free(filePath);
+		return false;
+	}
+	seekFile(file, 0, SEEK_END);
+	int64_t fileSize = tellFile(file);
+	seekFile(file, 0, SEEK_SET);
+
+	char* data = calloc((size_t)fileSize + 1, 1);
+	bool result = data && fread(data, 1, (size_t)fileSize, file) == (size_t)fileSize;
+	closeFile(file);
+
+	if (!result || !strstr(data, "\"traceEvents\"") || !strstr(data, "Main \\\"Zone\\\"") ||
+		!strstr(data, "Thread Zone") || !strstr(data, "Thread Counter") || !strstr(data, "]}"))
+	{
+		printf("Invalid trace file data.\n");
+		result = false;
+	}
+	if (droppedCount != 0)
+	{
+		printf("Dropped trace events: %llu\n", (unsigned long long)droppedCount);
+		result = false;
+	}
+
+	free(data);
+	remove(filePath);
+	*strrchr(filePath, '/') = '\0';
+	remove(filePath);
+	free(filePath);
+	return result;
+}
+
+int main()
+{
+#if MPIO_ENABLE_TRACING
+	bool result = testTracing();
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+#else
+	printf("Tracing is disabled.\n");
+	return EXIT_SUCCESS;
+#endif
+}
@@ -0,0 +1,289 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpio/watcher.h"
+#include "mpio/directory.h"
+#include "mpio/os.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if __linux__ || __APPLE__
+#include <poll.h>
+#include <unistd.h>
+#define removeTestDirectory(path) rmdir(path)
+#define sleepTestThread(milliseconds) usleep((milliseconds) * 1000)
+#define incrementTestCounter(counter) __atomic_add_fetch(counter, 1, __ATOMIC_RELEASE)
+#define loadTestCounter(counter) __atomic_load_n(counter, __ATOMIC_ACQUIRE)
+#elif _WIN32
+#include <windows.h>
+#define removeTestDirectory(path) RemoveDirectoryA(path)
+#define sleepTestThread(milliseconds) Sleep(milliseconds)
+#define incrementTestCounter(counter) InterlockedIncrement(counter)
+#define loadTestCounter(counter) InterlockedCompareExchange(counter, 0, 0)
+#endif
+
+#define TEST_DIRECTORY_PATH "mpio-test-watcher"
+#define TEST_DEBOUNCE_DELAY 20
+#define TEST_WAIT_TIME 5.0
+#define MAX_TEST_EVENT_COUNT 16
+#define TEST_CAPACITY_FILE_COUNT 63
+
+typedef struct TestEvent
+{
+	char path[64];
+	char oldPath[64];
+	WatchEventType type;
+	bool isDirectory;
+	bool isModified;
+} TestEvent;
+
+static TestEvent testEvents[MAX_TEST_EVENT_COUNT];
+static uint32_t testEventCount = 0;
+static volatile long testCallbackCount = 0; // Note: Published by the watcher thread after the events are stored.
+
+static void onWatchEvents(const WatchEvent* events, uint32_t eventCount, void* argument)
+{
+	for (uint32_t i = 0; i < eventCount && testEventCount < MAX_TEST_EVENT_COUNT; i++)
+	{
+		TestEvent* testEvent = &testEvents[testEventCount];
+		snprintf(testEvent->path, sizeof(testEvent->path), "%s", events[i].path);
+		snprintf(testEvent->oldPath, sizeof(testEvent->oldPath), "%s", events[i].oldPath ? events[i].oldPath : "");
+		for (char* c = testEvent->path; *c; c++)
+			*c = *c == '\\' ? '/' : *c;
+		for (char* c = testEvent->oldPath; *c; c++)
+			*c = *c == '\\' ? '/' : *c;
+		testEvent->type = events[i].type;
+		testEvent->isDirectory = events[i].isDirectory;
+		testEvent->isModified = events[i].isModified;
+		testEventCount++;
+	}
+	incrementTestCounter(&testCallbackCount);
+}
+
+static const TestEvent* findTestEvent(WatchEventType type, const char* path, const char* oldPath)
+{
+	const TestEvent* testEvent = NULL;
+	for (uint32_t i = 0; i < testEventCount; i++)
+	{
+		if (testEvents[i].type == type && strcmp(testEvents[i].path, path) == 0 &&
+			(!oldPath || strcmp(testEvents[i].oldPath, oldPath) == 0))
+		{
+			if (testEvent)
+				return NULL;
+			testEvent = &testEvents[i];
+		}
+	}
+	return testEvent;
+}
+static bool hasTestEvent(WatchEventType type, const char* path, const char* oldPath)
+{
+	return findTestEvent(type, path, oldPath) != NULL;
+}
+
+inline static bool writeTestFile(const char* path, const char* data)
+{
+	FILE* file = fopen(path, "ab");
+	if (!file)
+		return false;
+	fputs(data, file);
+	fclose(file);
+	return true;
+}
+inline static uint32_t waitWatcherEvents(Watcher watcher)
+{
+	double deadline = getCurrentClock() + TEST_WAIT_TIME;
+	while (getCurrentClock() < deadline)
+	{
+	#if __linux__
+		struct pollfd fd;
+		fd.fd = getWatcherFd(watcher);
+		fd.events = POLLIN;
+		int32_t timeout = getWatcherTimeout(watcher);
+		poll(&fd, 1, timeout < 0 ? 100 : timeout);
+	#endif
+		uint32_t count = pollWatcherEvents(watcher, onWatchEvents, NULL);
+		if (count > 0)
+			return count;
+	}
+	return 0;
+}
+
+inline static bool testPollWatcher()
+{
+	createDirectory(TEST_DIRECTORY_PATH);
+	Watcher watcher = createWatcher(TEST_DIRECTORY_PATH, true, TEST_DEBOUNCE_DELAY, NULL, NULL);
+	if (!watcher)
+	{
+		removeTestDirectory(TEST_DIRECTORY_PATH);
+		printf("File system watcher is not supported.\n");
+		return true;
+	}
+
+#if __linux__
+	if (getWatcherFd(watcher) < 0)
+	{
+		printf("Invalid watcher file descriptor.\n");
+		destroyWatcher(watcher); removeTestDirectory(TEST_DIRECTORY_PATH);
+		return false;
+	}
+#endif
+
+	// Note: Multiple writes and the atomic save (write temporary file and rename) are coalesced.
+	testEventCount = 0;
+	bool result = writeTestFile(TEST_DIRECTORY_PATH "/a.txt", "a") && writeTestFile(TEST_DIRECTORY_PATH "/a.txt", "b");
+	result &= createDirectory(TEST_DIRECTORY_PATH "/sub");
+	result &= writeTestFile(TEST_DIRECTORY_PATH "/sub/b.txt", "b");
+	result &= writeTestFile(TEST_DIRECTORY_PATH "/sub/c.tmp", "c");
+	result &= rename(TEST_DIRECTORY_PATH "/sub/c.tmp", TEST_DIRECTORY_PATH "/sub/c.txt") == 0;
+
+	result &= waitWatcherEvents(watcher) > 0;
+	result &= testEventCount == 4 && hasTestEvent(CREATED_WATCH_EVENT_TYPE, "a.txt", NULL) &&
+		hasTestEvent(CREATED_WATCH_EVENT_TYPE, "sub", NULL) &&
+		hasTestEvent(CREATED_WATCH_EVENT_TYPE, "sub/b.txt", NULL) &&
+		hasTestEvent(CREATED_WATCH_EVENT_TYPE, "sub/c.txt", NULL);
+	if (!result)
+		printf("Invalid coalesced watch events. (count: %u)\n", testEventCount);
+
+	testEventCount = 0;
+	bool eventResult = rename(TEST_DIRECTORY_PATH "/a.txt", TEST_DIRECTORY_PATH "/d.txt") == 0;
+	eventResult &= writeTestFile(TEST_DIRECTORY_PATH "/sub/b.txt", "b");
+	eventResult &= remove(TEST_DIRECTORY_PATH "/sub/c.txt") == 0;
+
+	eventResult &= waitWatcherEvents(watcher) > 0;
+	const TestEvent* renameEvent = findTestEvent(RENAMED_WATCH_EVENT_TYPE, "d.txt", "a.txt");
+	eventResult &= testEventCount == 3 && renameEvent && !renameEvent->isModified &&
+		hasTestEvent(MODIFIED_WATCH_EVENT_TYPE, "sub/b.txt", NULL) &&
+		hasTestEvent(REMOVED_WATCH_EVENT_TYPE, "sub/c.txt", NULL);
+	if (!eventResult)
+		printf("Invalid renamed, modified and removed watch events. (count: %u)\n", testEventCount);
+	result &= eventResult;
+
+	// Note: Entry modified and renamed in the same batch is reported as renamed with the modified flag.
+	testEventCount = 0;
+	eventResult = writeTestFile(TEST_DIRECTORY_PATH "/d.txt", "d");
+	eventResult &= rename(TEST_DIRECTORY_PATH "/d.txt", TEST_DIRECTORY_PATH "/e.txt") == 0;
+
+	eventResult &= waitWatcherEvents(watcher) > 0;
+	renameEvent = findTestEvent(RENAMED_WATCH_EVENT_TYPE, "e.txt", "d.txt");
+	eventResult &= testEventCount == 1 && renameEvent && renameEvent->isModified;
+	if (!eventResult)
+		printf("Invalid modified and renamed watch event. (count: %u)\n", testEventCount);
+	result &= eventResult;
+
+	destroyWatcher(watcher);
+	remove(TEST_DIRECTORY_PATH "/e.txt");
+	remove(TEST_DIRECTORY_PATH "/sub/b.txt");
+	removeTestDirectory(TEST_DIRECTORY_PATH "/sub");
+	removeTestDirectory(TEST_DIRECTORY_PATH);
+	return result;
+}
+static uint32_t capacityEventCount = 0;
+static bool hasCapacityRemoveEvent = false;
+
+static void onCapacityEvents(const WatchEvent* events, uint32_t eventCount, void* argument)
+{
+	for (uint32_t i = 0; i < eventCount; i++)
+	{
+		if (events[i].type == REMOVED_WATCH_EVENT_TYPE && strcmp(events[i].path, "x.txt") == 0)
+			hasCapacityRemoveEvent = true;
+	}
+	capacityEventCount += eventCount;
+}
+
+// Note: Renamed and then removed entry adds a new pending event while the pending events array is full.
+inline static bool testWatcherCapacity()
+{
+	createDirectory(TEST_DIRECTORY_PATH);
+	bool result = writeTestFile(TEST_DIRECTORY_PATH "/x.txt", "x");
+	Watcher watcher = createWatcher(TEST_DIRECTORY_PATH, false, TEST_DEBOUNCE_DELAY, NULL, NULL);
+	if (!watcher)
+	{
+		remove(TEST_DIRECTORY_PATH "/x.txt");
+		removeTestDirectory(TEST_DIRECTORY_PATH);
+		printf("File system watcher is not supported.\n");
+		return true;
+	}
+
+	char path[64];
+	for (int i = 0; i < TEST_CAPACITY_FILE_COUNT; i++)
+	{
+		snprintf(path, sizeof(path), TEST_DIRECTORY_PATH "/file-%d.txt", i);
+		result &= writeTestFile(path, "f");
+	}
+	result &= rename(TEST_DIRECTORY_PATH "/x.txt", TEST_DIRECTORY_PATH "/y.txt") == 0;
+	result &= remove(TEST_DIRECTORY_PATH "/y.txt") == 0;
+
+	capacityEventCount = 0; hasCapacityRemoveEvent = false;
+	double deadline = getCurrentClock() + TEST_WAIT_TIME;
+	while (capacityEventCount < TEST_CAPACITY_FILE_COUNT + 1 && getCurrentClock() < deadline)
+	{
+		if (pollWatcherEvents(watcher, onCapacityEvents, NULL) == 0)
+			sleepTestThread(1);
+	}
+	destroyWatcher(watcher);
+
+	for (int i = 0; i < TEST_CAPACITY_FILE_COUNT; i++)
+	{
+		snprintf(path, sizeof(path), TEST_DIRECTORY_PATH "/file-%d.txt", i);
+		remove(path);
+	}
+	removeTestDirectory(TEST_DIRECTORY_PATH);
+
+	result &= capacityEventCount == TEST_CAPACITY_FILE_COUNT + 1 && hasCapacityRemoveEvent;
+	if (!result)
+	{
+		printf("Invalid watch events after pending capacity growth. (count: %u)\n", capacityEventCount);
+		return false;
+	}
+	return true;
+}
+inline static bool testWatcherCallback()
+{
+	createDirectory(TEST_DIRECTORY_PATH);
+	testEventCount = 0; testCallbackCount = 0;
+	Watcher watcher = createWatcher(TEST_DIRECTORY_PATH, false, TEST_DEBOUNCE_DELAY, onWatchEvents, NULL);
+	if (!watcher)
+	{
+		removeTestDirectory(TEST_DIRECTORY_PATH);
+		printf("File system watcher is not supported.\n");
+		return true;
+	}
+
+	bool result = writeTestFile(TEST_DIRECTORY_PATH "/e.txt", "e");
+	double deadline = getCurrentClock() + TEST_WAIT_TIME;
+	while (loadTestCounter(&testCallbackCount) == 0 && getCurrentClock() < deadline)
+		sleepTestThread(1);
+
+	destroyWatcher(watcher); // Note: Joins the watcher thread, so the stored events are visible.
+	result &= testEventCount == 1 && hasTestEvent(CREATED_WATCH_EVENT_TYPE, "e.txt", NULL);
+	remove(TEST_DIRECTORY_PATH "/e.txt");
+	removeTestDirectory(TEST_DIRECTORY_PATH);
+
+	if (!result)
+	{
+		printf("Invalid watcher callback events. (count: %u)\n", testEventCount);
+		return false;
+	}
+	return true;
+}
+
+int main()
+{
+	bool result = testPollWatcher();
+	result &= testWatcherCapacity();
+	result &= testWatcherCallback();
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
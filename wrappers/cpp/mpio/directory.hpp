@@ -19,8 +19,12 @@
  */
 
 #pragma once
+#include "mpio/jobs.hpp"
 #include "mpio/error.hpp"
+#include <vector>
+#include <iterator>
 #include <filesystem>
+#include <string_view>
 
 extern "C"
 {
@@ -38,8 +42,82 @@ using namespace std;
  */
 class Directory
 {
+	template<typename F, typename P>
+	struct WalkFunctions
+	{
+		const F* onEntry;
+		const P* filter;
+	};
+
+	template<typename F, typename P>
+	static void walkEntryFunction(const DirectoryEntry* entry, void* argument)
+	{
+		(*((const WalkFunctions<F, P>*)argument)->onEntry)(*entry);
+	}
+	template<typename F, typename P>
+	static bool walkFilterFunction(const DirectoryEntry* entry, void* argument)
+	{
+		return (*((const WalkFunctions<F, P>*)argument)->filter)(*entry);
+	}
 public:
 	// Note: Use std:: functions instead of createDirectory(), isDirectoryExists()!
+	//       Below create() is a faster create_directories(), it does only one mkdirat() per new directory.
+
+	/**
+	 * @brief Creates a new directory and all missing parent directories. (MT-Safe)
+	 * @details See the @ref createDirectories().
+	 *
+	 * @param[in] path target directory path
+	 * @return True if a new directory was created, false if it already exists.
+	 * @throw Error if failed to create directories.
+	 */
+	static bool create(const filesystem::path& path)
+	{
+		bool isCreated = false;
+		if (!createDirectories(path.generic_string().c_str(), &isCreated))
+			throw Error("Failed to create directories.");
+		return isCreated;
+	}
+
+	/**
+	 * @brief Returns file information. (MT-Safe)
+	 * @details See the @ref getFileInfo().
+	 *
+	 * @param[in] path target file path
+	 * @param fields requested field bit mask (FILE_INFO_FIELD_BIT)
+	 * @param isCached allow cached file information
+	 * @return File information on success.
+	 * @throw Error if failed to get file information.
+	 */
+	static FileInfo getInfo(const filesystem::path& path,
+		uint32_t fields = ALL_FILE_INFO_FIELDS, bool isCached = false)
+	{
+		FileInfo info;
+		if (!getFileInfo(path.generic_string().c_str(), fields, isCached, &info))
+			throw Error("Failed to get file info.");
+		return info;
+	}
+	/**
+	 * @brief Returns multiple file information at once. (MT-Safe)
+	 * @details See the @ref getFileInfos().
+	 *
+	 * @param[in] directoryPath base directory path
+	 * @param[in] paths file paths, relative to the base directory
+	 * @param fields requested field bit mask (FILE_INFO_FIELD_BIT)
+	 * @param isCached allow cached file information
+	 * @return File information array, failed paths have zero fields.
+	 */
+	static vector<FileInfo> getInfos(const filesystem::path& directoryPath, const vector<string>& paths,
+		uint32_t fields = ALL_FILE_INFO_FIELDS, bool isCached = false)
+	{
+		vector<const char*> pathStrings(paths.size());
+		for (size_t i = 0; i < paths.size(); i++)
+			pathStrings[i] = paths[i].c_str();
+		vector<FileInfo> infos(paths.size());
+		getFileInfos(directoryPath.generic_string().c_str(), pathStrings.data(),
+			(uint32_t)paths.size(), fields, isCached, infos.data());
+		return infos;
+	}
 
 	/**
 	 * @brief Returns application data directory. (MT-Safe)
@@ -94,6 +172,167 @@ public:
 		free(dataPath);
 		return path;
 	}
+
+	/**
+	 * @brief Walks directory tree in parallel using the job system. (MT-Safe)
+	 * @details See the @ref walkDirectory().
+	 * @warning Functions are called concurrently from the worker threads and should not throw!
+	 *
+	 * @param[in] jobSystem target job system instance
+	 * @param[in] path target directory path
+	 * @param[in] onEntry accepted entry function: void(const DirectoryEntry&)
+	 * @param[in] filter entry filter function: bool(const DirectoryEntry&), false drops the entry
+	 *
+	 * @return Directory walk aggregated results.
+	 * @throw Error if failed to open the directory.
+	 */
+	template<typename F, typename P>
+	static DirectoryWalkStats walk(const JobSystem& jobSystem,
+		const filesystem::path& path, const F& onEntry, const P& filter)
+	{
+		WalkFunctions<F, P> functions = { &onEntry, &filter };
+		DirectoryWalkStats stats;
+		if (!walkDirectory(jobSystem.getInstance(), path.generic_string().c_str(),
+			walkFilterFunction<F, P>, walkEntryFunction<F, P>, &functions, &stats))
+		{
+			throw Error("Failed to walk directory.");
+		}
+		return stats;
+	}
+	/**
+	 * @brief Walks directory tree in parallel using the job system. (MT-Safe)
+	 * @details See the @ref walkDirectory().
+	 * @warning Function is called concurrently from the worker threads and should not throw!
+	 *
+	 * @param[in] jobSystem target job system instance
+	 * @param[in] path target directory path
+	 * @param[in] onEntry entry function: void(const DirectoryEntry&)
+	 *
+	 * @return Directory walk aggregated results.
+	 * @throw Error if failed to open the directory.
+	 */
+	template<typename F>
+	static DirectoryWalkStats walk(const JobSystem& jobSystem, const filesystem::path& path, const F& onEntry)
+	{
+		WalkFunctions<F, F> functions = { &onEntry, nullptr };
+		DirectoryWalkStats stats;
+		if (!walkDirectory(jobSystem.getInstance(), path.generic_string().c_str(),
+			nullptr, walkEntryFunction<F, F>, &functions, &stats))
+		{
+			throw Error("Failed to walk directory.");
+		}
+		return stats;
+	}
+};
+
+/**
+ * @brief Directory entry iterator, usable in the range-based for loop.
+ * @details See the @ref openDirectoryIterator().
+ *
+ * @code
+ * mpio::DirectoryIterator directory("assets", true);
+ * for (const auto& entry : directory)
+ * {
+ *     if (entry.type == DIRECTORY_FILE_TYPE && entry.name[0] == '.')
+ *         directory.skip();
+ * }
+ * @endcode
+ */
+class DirectoryIterator
+{
+	::DirectoryIterator instance = nullptr;
+	DirectoryEntry entry = {};
+public:
+	/**
+	 * @brief Directory entry input iterator.
+	 */
+	class Iterator
+	{
+		DirectoryIterator* directory = nullptr;
+	public:
+		using iterator_category = input_iterator_tag;
+		using value_type = DirectoryEntry;
+		using difference_type = ptrdiff_t;
+		using pointer = const DirectoryEntry*;
+		using reference = const DirectoryEntry&;
+
+		Iterator(DirectoryIterator* directory = nullptr) : directory(directory)
+		{
+			if (directory && !directory->next())
+				this->directory = nullptr;
+		}
+
+		reference operator*() const noexcept { return directory->entry; }
+		pointer operator->() const noexcept { return &directory->entry; }
+		Iterator& operator++()
+		{
+			if (!directory->next())
+				directory = nullptr;
+			return *this;
+		}
+		bool operator==(const Iterator& other) const noexcept { return directory == other.directory; }
+		bool operator!=(const Iterator& other) const noexcept { return directory != other.directory; }
+	};
+
+	/**
+	 * @brief Opens a new directory iterator instance.
+	 * @details See the @ref openDirectoryIterator().
+	 *
+	 * @param[in] path target directory path
+	 * @param isRecursive also iterate subdirectory entries (depth-first)
+	 *
+	 * @throw Error if failed to open directory iterator.
+	 */
+	DirectoryIterator(const filesystem::path& path, bool isRecursive = false)
+	{
+		instance = openDirectoryIterator(path.generic_string().c_str(), isRecursive);
+		if (!instance)
+			throw Error("Failed to open directory iterator.");
+	}
+	/**
+	 * @brief Closes directory iterator instance.
+	 */
+	~DirectoryIterator() { closeDirectoryIterator(instance); }
+
+	DirectoryIterator(const DirectoryIterator&) = delete;
+	DirectoryIterator& operator=(const DirectoryIterator&) = delete;
+
+	/**
+	 * @brief Reads the next directory entry.
+	 * @details See the @ref nextDirectoryEntry().
+	 * @return True on success, otherwise false if there are no more entries or an error occurred.
+	 */
+	bool next() noexcept { return nextDirectoryEntry(instance, &entry); }
+	/**
+	 * @brief Returns the last read directory entry.
+	 * @warning Strings are valid only until the next iterator call!
+	 */
+	const DirectoryEntry& getEntry() const noexcept { return entry; }
+	/**
+	 * @brief Returns the last read directory entry path, relative to the iterated directory.
+	 */
+	string_view getPath() const noexcept { return string_view(entry.path, entry.pathLength); }
+
+	/**
+	 * @brief Skips the last returned subdirectory entries. (Prunes recursion)
+	 * @details See the @ref skipDirectoryEntries().
+	 */
+	void skip() noexcept { skipDirectoryEntries(instance); }
+	/**
+	 * @brief Returns true if failed to read some directory, its entries are skipped.
+	 * @details See the @ref isDirectoryIteratorFailed().
+	 */
+	bool isFailed() const noexcept { return isDirectoryIteratorFailed(instance); }
+
+	/**
+	 * @brief Reads the first directory entry and returns its iterator.
+	 * @note Directory can be iterated only once.
+	 */
+	Iterator begin() { return Iterator(this); }
+	/**
+	 * @brief Returns directory end iterator.
+	 */
+	Iterator end() noexcept { return Iterator(); }
 };
 
 } // mpio
\ No newline at end of file
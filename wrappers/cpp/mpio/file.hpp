@@ -0,0 +1,370 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Common file functions.
+ * @details See the @ref file.h
+ */
+
+#pragma once
+#include "mpio/error.hpp"
+#include <vector>
+#include <filesystem>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+extern "C"
+{
+#include "mpio/file.h"
+}
+
+namespace mpio
+{
+
+using namespace std;
+
+/**
+ * @brief Memory mapped file region. (RAII)
+ * @details See the @ref mapFile().
+ */
+class MappedFile
+{
+	uint8_t* data = nullptr;
+	size_t size = 0;
+public:
+	/**
+	 * @brief Creates a new empty mapped file region.
+	 */
+	MappedFile() = default;
+
+	/**
+	 * @brief Maps file region into the process address space.
+	 * @details See the @ref mapFile().
+	 *
+	 * @param[in] filePath target file path
+	 * @param access mapped memory access mode
+	 * @param offset file region offset in bytes
+	 * @param size file region size in bytes, or 0 to map until the end of the file
+	 * @param prefault populate mapped memory pages in advance
+	 *
+	 * @throw Error if failed to map file.
+	 */
+	MappedFile(const filesystem::path& filePath, MapFileAccess access = READ_ONLY_MAP_FILE_ACCESS,
+		int64_t offset = 0, size_t size = 0, bool prefault = false)
+	{
+		this->data = (uint8_t*)mapFile(filePath.string().c_str(), access, offset, &size, prefault);
+		if (!this->data)
+			throw Error("Failed to map file.");
+		this->size = size;
+	}
+	/**
+	 * @brief Unmaps file region from the process address space.
+	 */
+	~MappedFile()
+	{
+		if (data)
+			unmapFile(data, size);
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept : data(other.data), size(other.size)
+	{
+		other.data = nullptr; other.size = 0;
+	}
+	MappedFile& operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (data)
+				unmapFile(data, size);
+			data = other.data; size = other.size;
+			other.data = nullptr; other.size = 0;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Returns mapped file region data.
+	 */
+	uint8_t* getData() noexcept { return data; }
+	/**
+	 * @brief Returns mapped file region data.
+	 */
+	const uint8_t* getData() const noexcept { return data; }
+	/**
+	 * @brief Returns mapped file region size in bytes.
+	 */
+	size_t getSize() const noexcept { return size; }
+	/**
+	 * @brief Returns true if file region is mapped.
+	 */
+	bool isMapped() const noexcept { return data; }
+
+	#if __cplusplus >= 202002L
+	/**
+	 * @brief Returns mapped file region bytes span.
+	 */
+	span<uint8_t> getSpan() noexcept { return span<uint8_t>(data, size); }
+	/**
+	 * @brief Returns mapped file region bytes span.
+	 */
+	span<const uint8_t> getSpan() const noexcept { return span<const uint8_t>(data, size); }
+	#endif
+
+	uint8_t* begin() noexcept { return data; }
+	uint8_t* end() noexcept { return data + size; }
+	const uint8_t* begin() const noexcept { return data; }
+	const uint8_t* end() const noexcept { return data + size; }
+	uint8_t& operator[](size_t index) noexcept { return data[index]; }
+	const uint8_t& operator[](size_t index) const noexcept { return data[index]; }
+
+	/**
+	 * @brief Writes modified mapped memory pages to the file.
+	 * @details See the @ref flushMappedFile().
+	 * @throw Error if failed to flush mapped file.
+	 */
+	void flush()
+	{
+		if (data && !flushMappedFile(data, size))
+			throw Error("Failed to flush mapped file.");
+	}
+};
+
+/**
+ * @brief Native file handle for the positional I/O. (RAII, MT-Safe)
+ * 
+ * @details
+ * Read and write functions take explicit file offset and do not modify
+ * shared file position, so the same instance can be used from multiple threads.
+ */
+class File
+{
+	FileHandle handle = INVALID_FILE_HANDLE;
+public:
+	/**
+	 * @brief Creates a new closed file handle.
+	 */
+	File() = default;
+
+	/**
+	 * @brief Opens a native file handle for the positional I/O.
+	 * @details See the @ref openFileHandle().
+	 *
+	 * @param[in] filePath target file path
+	 * @param[in] mode file access mode string ("r", "w", "a", "r+", "w+", "a+")
+	 *
+	 * @throw Error if failed to open file.
+	 */
+	File(const filesystem::path& filePath, const char* mode = "r")
+	{
+		handle = openFileHandle(filePath.string().c_str(), mode);
+		if (handle == INVALID_FILE_HANDLE)
+			throw Error("Failed to open file.");
+	}
+	/**
+	 * @brief Closes the native file handle.
+	 */
+	~File()
+	{
+		if (handle != INVALID_FILE_HANDLE)
+			closeFileHandle(handle);
+	}
+
+	File(const File&) = delete;
+	File& operator=(const File&) = delete;
+
+	File(File&& other) noexcept : handle(other.handle) { other.handle = INVALID_FILE_HANDLE; }
+	File& operator=(File&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (handle != INVALID_FILE_HANDLE)
+				closeFileHandle(handle);
+			handle = other.handle;
+			other.handle = INVALID_FILE_HANDLE;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Returns native file handle.
+	 */
+	FileHandle getHandle() const noexcept { return handle; }
+	/**
+	 * @brief Returns true if file handle is open.
+	 */
+	bool isOpen() const noexcept { return handle != INVALID_FILE_HANDLE; }
+
+	/**
+	 * @brief Returns file size in bytes.
+	 * @details See the @ref getFileHandleSize().
+	 * @throw Error if failed to get file size.
+	 */
+	int64_t getSize() const
+	{
+		auto size = getFileHandleSize(handle);
+		if (size < 0)
+			throw Error("Failed to get file size.");
+		return size;
+	}
+	/**
+	 * @brief Flushes written file data to the storage device.
+	 * @details See the @ref flushFileHandle().
+	 * @throw Error if failed to flush file.
+	 */
+	void flush()
+	{
+		if (!flushFileHandle(handle))
+			throw Error("Failed to flush file.");
+	}
+
+	/**
+	 * @brief Allocates file storage space for the specified byte range.
+	 * @details See the @ref preallocateFile().
+	 *
+	 * @param offset allocated range offset in bytes
+	 * @param size allocated range size in bytes
+	 * @param keepSize do not change the file size
+	 *
+	 * @throw Error if failed to preallocate file.
+	 */
+	void preallocate(int64_t offset, int64_t size, bool keepSize = false)
+	{
+		if (!preallocateFile(handle, offset, size, keepSize))
+			throw Error("Failed to preallocate file.");
+	}
+	/**
+	 * @brief Deallocates file storage space for the specified byte range.
+	 * @details See the @ref punchFileHole().
+	 *
+	 * @param offset deallocated range offset in bytes
+	 * @param size deallocated range size in bytes
+	 *
+	 * @return True on success, false if not supported by the file system.
+	 */
+	bool punchHole(int64_t offset, int64_t size) noexcept
+	{
+		return punchFileHole(handle, offset, size);
+	}
+	/**
+	 * @brief Returns all file data and hole extents.
+	 * @details See the @ref getFileExtents().
+	 * @throw Error if failed to get file extents.
+	 */
+	vector<FileExtent> getExtents() const
+	{
+		vector<FileExtent> extents; FileExtent buffer[64]; int64_t offset = 0;
+		while (true)
+		{
+			auto count = getFileExtents(handle, offset, buffer, 64);
+			if (count < 0)
+				throw Error("Failed to get file extents.");
+			if (count == 0)
+				break;
+			extents.insert(extents.end(), buffer, buffer + count);
+			offset = buffer[count - 1].offset + buffer[count - 1].size;
+		}
+		return extents;
+	}
+	/**
+	 * @brief Gives the kernel a hint about the file range access pattern.
+	 * @details See the @ref adviseFileAccess().
+	 *
+	 * @param hint file access pattern hint type
+	 * @param offset file range offset in bytes
+	 * @param size file range size in bytes, or 0 until the end of file
+	 */
+	bool advise(FileAccessHint hint, int64_t offset = 0, int64_t size = 0) noexcept
+	{
+		return adviseFileAccess(handle, offset, size, hint);
+	}
+
+	/**
+	 * @brief Reads file data at the offset, without changing the file position.
+	 * @details See the @ref readFileAt().
+	 *
+	 * @param[out] buffer destination data buffer
+	 * @param size data buffer size in bytes
+	 * @param offset file offset in bytes
+	 *
+	 * @return Read byte count. (less than size at the end of file)
+	 * @throw Error if failed to read file.
+	 */
+	size_t readAt(void* buffer, size_t size, int64_t offset) const
+	{
+		auto result = readFileAt(handle, buffer, size, offset);
+		if (result < 0)
+			throw Error("Failed to read file.");
+		return (size_t)result;
+	}
+	/**
+	 * @brief Writes file data at the offset, without changing the file position.
+	 * @details See the @ref writeFileAt().
+	 *
+	 * @param[in] buffer source data buffer
+	 * @param size data buffer size in bytes
+	 * @param offset file offset in bytes
+	 *
+	 * @throw Error if failed to write file.
+	 */
+	void writeAt(const void* buffer, size_t size, int64_t offset)
+	{
+		if (writeFileAt(handle, buffer, size, offset) < 0)
+			throw Error("Failed to write file.");
+	}
+
+	/**
+	 * @brief Reads file data at the offset to the multiple buffers.
+	 * @details See the @ref readFileVectorAt().
+	 *
+	 * @param[in] buffers destination data buffer array
+	 * @param count data buffer array size
+	 * @param offset file offset in bytes
+	 *
+	 * @return Read byte count.
+	 * @throw Error if failed to read file.
+	 */
+	size_t readVectorAt(const FileBuffer* buffers, uint32_t count, int64_t offset) const
+	{
+		auto result = readFileVectorAt(handle, buffers, count, offset);
+		if (result < 0)
+			throw Error("Failed to read file.");
+		return (size_t)result;
+	}
+	/**
+	 * @brief Writes file data at the offset from the multiple buffers.
+	 * @details See the @ref writeFileVectorAt().
+	 *
+	 * @param[in] buffers source data buffer array
+	 * @param count data buffer array size
+	 * @param offset file offset in bytes
+	 *
+	 * @return Written byte count.
+	 * @throw Error if failed to write file.
+	 */
+	size_t writeVectorAt(const FileBuffer* buffers, uint32_t count, int64_t offset)
+	{
+		auto result = writeFileVectorAt(handle, buffers, count, offset);
+		if (result < 0)
+			throw Error("Failed to write file.");
+		return (size_t)result;
+	}
+};
+
+} // mpio
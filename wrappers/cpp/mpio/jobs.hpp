@@ -0,0 +1,159 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Work-stealing job system functions.
+ * @details See the @ref jobs.h
+ */
+
+#pragma once
+#include "mpio/error.hpp"
+
+extern "C"
+{
+#include "mpio/jobs.h"
+}
+
+namespace mpio
+{
+
+using namespace std;
+
+/**
+ * @brief Job counter, used to wait for the jobs and as a dependency of other jobs.
+ * @details See the @ref jobs.h
+ */
+class JobCounter
+{
+	::JobCounter instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new job counter.
+	 * @throw Error if failed to create job counter.
+	 */
+	JobCounter()
+	{
+		instance = createJobCounter();
+		if (!instance)
+			throw Error("Failed to create job counter.");
+	}
+	/**
+	 * @brief Destroys job counter.
+	 * @warning Counter should not have pending jobs!
+	 */
+	~JobCounter() { destroyJobCounter(instance); }
+
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	/**
+	 * @brief Returns job counter instance.
+	 */
+	::JobCounter getInstance() const noexcept { return instance; }
+	/**
+	 * @brief Returns job counter pending job count.
+	 */
+	int32_t getValue() const noexcept { return getJobCounterValue(instance); }
+};
+
+/**
+ * @brief Work-stealing job system.
+ * @details See the @ref jobs.h
+ */
+class JobSystem
+{
+	::JobSystem instance = nullptr;
+
+	template<typename F>
+	static void parallelForFunction(void* argument, uint32_t begin, uint32_t end)
+	{
+		(*(F*)argument)(begin, end);
+	}
+public:
+	/**
+	 * @brief Creates a new job system.
+	 * @details See the @ref createJobSystem().
+	 *
+	 * @param workerCount worker thread count, or 0 for the default
+	 * @param pinWorkers pin each worker thread to a separate performance core
+	 *
+	 * @throw Error if failed to create job system.
+	 */
+	JobSystem(uint32_t workerCount = 0, bool pinWorkers = false)
+	{
+		instance = createJobSystem(workerCount, pinWorkers);
+		if (!instance)
+			throw Error("Failed to create job system.");
+	}
+	/**
+	 * @brief Destroys job system, after executing all scheduled jobs.
+	 */
+	~JobSystem() { destroyJobSystem(instance); }
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/**
+	 * @brief Returns job system instance.
+	 */
+	::JobSystem getInstance() const noexcept { return instance; }
+	/**
+	 * @brief Returns job system worker thread count.
+	 */
+	uint32_t getWorkerCount() const noexcept { return getJobSystemWorkerCount(instance); }
+
+	/**
+	 * @brief Schedules a new job for the execution.
+	 * @details See the @ref runJob().
+	 *
+	 * @param[in] function job function
+	 * @param[in] argument job function argument or nullptr
+	 * @param[in] jobCounter job counter to increment until the job is executed, or nullptr
+	 * @param[in] dependency job counter to wait for before the execution, or nullptr
+	 *
+	 * @throw Error if failed to run job.
+	 */
+	void run(JobFunction function, void* argument = nullptr,
+		const JobCounter* jobCounter = nullptr, const JobCounter* dependency = nullptr)
+	{
+		if (!runJob(instance, function, argument, jobCounter ? jobCounter->getInstance() : nullptr,
+			dependency ? dependency->getInstance() : nullptr))
+		{
+			throw Error("Failed to run job.");
+		}
+	}
+	/**
+	 * @brief Waits until job counter reaches zero, executing other pending jobs.
+	 * @details See the @ref waitJobCounter().
+	 * @param[in] jobCounter job counter
+	 */
+	void wait(const JobCounter& jobCounter) noexcept { waitJobCounter(instance, jobCounter.getInstance()); }
+
+	/**
+	 * @brief Executes function for the index range in parallel and waits for it.
+	 * @details See the @ref parallelFor(). Callable is invoked as function(begin, end), without allocations.
+	 *
+	 * @param count total index count
+	 * @param[in] function range function
+	 * @param minChunkSize minimum range size for the single function call, or 0 for 1
+	 */
+	template<typename F>
+	void parallelFor(uint32_t count, const F& function, uint32_t minChunkSize = 0) noexcept
+	{
+		::parallelFor(instance, parallelForFunction<const F>, (void*)&function, count, minChunkSize);
+	}
+};
+
+} // mpio
@@ -0,0 +1,288 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Virtual memory, arena allocator and memory pressure monitoring functions.
+ * @details See the @ref memory.h
+ */
+
+#pragma once
+#include "mpio/error.hpp"
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <functional>
+
+extern "C"
+{
+#include "mpio/memory.h"
+}
+
+namespace mpio
+{
+
+using namespace std;
+
+/**
+ * @brief Memory pressure monitor.
+ * @details See the @ref memory.h
+ */
+class MemoryMonitor
+{
+	::MemoryMonitor instance = nullptr;
+	unique_ptr<function<void(MemoryPressure)>> callback;
+
+	static void onPressure(MemoryPressure pressure, void* argument)
+	{
+		(*(function<void(MemoryPressure)>*)argument)(pressure);
+	}
+public:
+	/**
+	 * @brief Creates a new memory pressure monitor with polling.
+	 * @details See the @ref createMemoryMonitor().
+	 * @throw Error if failed to create memory monitor.
+	 */
+	MemoryMonitor()
+	{
+		instance = createMemoryMonitor(nullptr, nullptr);
+		if (!instance)
+			throw Error("Failed to create memory monitor.");
+	}
+	/**
+	 * @brief Creates a new memory pressure monitor with the event function.
+	 * @details See the @ref createMemoryMonitor().
+	 * @warning Function is called from the monitor background thread!
+	 *
+	 * @param onPressure memory pressure event function
+	 * @throw Error if failed to create memory monitor.
+	 */
+	MemoryMonitor(function<void(MemoryPressure)> onPressure) :
+		callback(make_unique<function<void(MemoryPressure)>>(std::move(onPressure)))
+	{
+		instance = createMemoryMonitor(MemoryMonitor::onPressure, callback.get());
+		if (!instance)
+			throw Error("Failed to create memory monitor.");
+	}
+	/**
+	 * @brief Destroys memory pressure monitor.
+	 */
+	~MemoryMonitor() { destroyMemoryMonitor(instance); }
+
+	MemoryMonitor(const MemoryMonitor&) = delete;
+	MemoryMonitor& operator=(const MemoryMonitor&) = delete;
+
+	MemoryMonitor(MemoryMonitor&& other) noexcept :
+		instance(other.instance), callback(std::move(other.callback)) { other.instance = nullptr; }
+	MemoryMonitor& operator=(MemoryMonitor&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyMemoryMonitor(instance);
+			instance = other.instance;
+			callback = std::move(other.callback);
+			other.instance = nullptr;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Returns memory pressure monitor file descriptor, readable on a new event.
+	 * @details See the @ref getMemoryMonitorFd().
+	 */
+	int getFd() const noexcept { return getMemoryMonitorFd(instance); }
+	/**
+	 * @brief Returns the highest memory pressure level since the last poll, without blocking.
+	 * @details See the @ref pollMemoryPressure().
+	 */
+	MemoryPressure poll() noexcept { return pollMemoryPressure(instance); }
+};
+
+/**
+ * @brief Linear memory arena, grows in place without moving allocations.
+ * @details See the @ref createMemoryArena().
+ */
+class MemoryArena
+{
+	::MemoryArena instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new linear memory arena instance.
+	 * @details See the @ref createMemoryArena().
+	 *
+	 * @param maxSize maximum arena size in bytes
+	 * @param useHugePages align and advise the arena to be backed by huge pages
+	 *
+	 * @throw Error if failed to create memory arena.
+	 */
+	MemoryArena(size_t maxSize, bool useHugePages = false)
+	{
+		instance = createMemoryArena(maxSize, useHugePages);
+		if (!instance)
+			throw Error("Failed to create memory arena.");
+	}
+	/**
+	 * @brief Destroys linear memory arena, releasing all its memory.
+	 */
+	~MemoryArena() { destroyMemoryArena(instance); }
+
+	MemoryArena(const MemoryArena&) = delete;
+	MemoryArena& operator=(const MemoryArena&) = delete;
+
+	MemoryArena(MemoryArena&& other) noexcept : instance(other.instance) { other.instance = nullptr; }
+	MemoryArena& operator=(MemoryArena&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyMemoryArena(instance);
+			instance = other.instance;
+			other.instance = nullptr;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Allocates memory from the linear arena.
+	 * @details See the @ref allocateArenaMemory().
+	 *
+	 * @param size allocation size in bytes
+	 * @param alignment allocation alignment in bytes (power of two)
+	 *
+	 * @throw bad_alloc if the arena is full.
+	 */
+	void* allocate(size_t size, size_t alignment = alignof(max_align_t))
+	{
+		auto memory = allocateArenaMemory(instance, size, alignment);
+		if (!memory)
+			throw bad_alloc();
+		return memory;
+	}
+	/**
+	 * @brief Allocates array of the objects from the linear arena.
+	 * @note Object destructors are never called, use it for the trivially destructible types.
+	 *
+	 * @tparam T object type
+	 * @param count array object count
+	 *
+	 * @throw bad_alloc if the arena is full.
+	 */
+	template<typename T>
+	T* allocate(size_t count = 1)
+	{
+		if (count > SIZE_MAX / sizeof(T))
+			throw bad_alloc();
+		auto objects = (T*)allocate(sizeof(T) * count, alignof(T));
+		for (size_t i = 0; i < count; i++)
+			new (objects + i) T();
+		return objects;
+	}
+
+	/**
+	 * @brief Returns linear memory arena allocated size in bytes. (Use it as a rewind marker)
+	 */
+	size_t getSize() const noexcept { return getMemoryArenaSize(instance); }
+	/**
+	 * @brief Returns linear memory arena committed size in bytes.
+	 */
+	size_t getCommittedSize() const noexcept { return getMemoryArenaCommittedSize(instance); }
+
+	/**
+	 * @brief Frees all linear memory arena allocations after the marker.
+	 * @param size arena size marker, returned by the getSize()
+	 */
+	void rewind(size_t size) noexcept { rewindMemoryArena(instance, size); }
+	/**
+	 * @brief Frees all linear memory arena allocations.
+	 * @details See the @ref resetMemoryArena().
+	 */
+	void reset() noexcept { resetMemoryArena(instance); }
+	/**
+	 * @brief Decommits unused linear memory arena pages.
+	 * @details See the @ref trimMemoryArena().
+	 */
+	bool trim() noexcept { return trimMemoryArena(instance); }
+};
+
+/**
+ * @brief Fixed-size memory pool, grows in place without moving items.
+ * @details See the @ref createMemoryPool().
+ */
+class MemoryPool
+{
+	::MemoryPool instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new fixed-size memory pool instance.
+	 * @details See the @ref createMemoryPool().
+	 *
+	 * @param itemSize pool item size in bytes
+	 * @param maxItemCount maximum pool item count
+	 *
+	 * @throw Error if failed to create memory pool.
+	 */
+	MemoryPool(size_t itemSize, size_t maxItemCount)
+	{
+		instance = createMemoryPool(itemSize, maxItemCount);
+		if (!instance)
+			throw Error("Failed to create memory pool.");
+	}
+	/**
+	 * @brief Destroys fixed-size memory pool, releasing all its memory.
+	 */
+	~MemoryPool() { destroyMemoryPool(instance); }
+
+	MemoryPool(const MemoryPool&) = delete;
+	MemoryPool& operator=(const MemoryPool&) = delete;
+
+	MemoryPool(MemoryPool&& other) noexcept : instance(other.instance) { other.instance = nullptr; }
+	MemoryPool& operator=(MemoryPool&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyMemoryPool(instance);
+			instance = other.instance;
+			other.instance = nullptr;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Allocates item from the fixed-size memory pool.
+	 * @throw bad_alloc if the pool is full.
+	 */
+	void* allocate()
+	{
+		auto item = allocatePoolItem(instance);
+		if (!item)
+			throw bad_alloc();
+		return item;
+	}
+	/**
+	 * @brief Returns item to the fixed-size memory pool.
+	 * @param[in] item allocated item pointer or nullptr
+	 */
+	void free(void* item) noexcept { freePoolItem(instance, item); }
+
+	/**
+	 * @brief Returns fixed-size memory pool item size in bytes.
+	 */
+	size_t getItemSize() const noexcept { return getMemoryPoolItemSize(instance); }
+	/**
+	 * @brief Returns fixed-size memory pool allocated item count.
+	 */
+	size_t getItemCount() const noexcept { return getMemoryPoolItemCount(instance); }
+};
+
+} // mpio
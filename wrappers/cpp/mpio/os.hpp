@@ -21,6 +21,9 @@
 #pragma once
 #include "mpio/error.hpp"
 #include <filesystem>
+#include <initializer_list>
+#include <utility>
+#include <vector>
 
 extern "C"
 {
@@ -32,6 +35,36 @@ namespace mpio
 
 using namespace std;
 
+/**
+ * @brief CPU cache and topology information.
+ * @details See the @ref createCpuTopology().
+ */
+struct CpuTopology
+{
+	vector<CpuCache> caches;   /**< CPU caches, one entry per sharing CPU set. */
+	vector<CpuSet> cores;      /**< Physical core logical CPU sets. */
+	vector<CpuSet> packages;   /**< Physical package (socket) logical CPU sets. */
+	vector<CpuSet> nodes;      /**< NUMA node logical CPU sets. */
+	CpuSet onlineCpus = {};    /**< Online logical CPU set. */
+	int cacheLineSize = 0;     /**< Smallest data cache line size in bytes. */
+	int lastCacheLevel = 0;    /**< Last (outermost) CPU cache level. */
+
+	/**
+	 * @brief Returns largest data or unified CPU cache size of the specified level in bytes.
+	 * @param level target CPU cache level (1, 2, 3...)
+	 */
+	int64_t getCacheSize(uint8_t level) const noexcept
+	{
+		int64_t size = 0;
+		for (const auto& cache : caches)
+		{
+			if (cache.level == level && cache.type != INSTRUCTION_CPU_CACHE_TYPE && cache.size > size)
+				size = cache.size;
+		}
+		return size;
+	}
+};
+
 /**
  * @brief Common operating system functions. (MT-Safe)
  * @details See the @ref os.h
@@ -47,6 +80,86 @@ public:
 	{
 		return ::getCurrentClock();
 	}
+	/**
+	 * @brief Returns monotonic time stamp in nanoseconds.
+	 * @details See the @ref getCurrentClockNs().
+	 */
+	static int64_t getCurrentClockNs() noexcept { return ::getCurrentClockNs(); }
+	/**
+	 * @brief Returns cheap low resolution monotonic time stamp in nanoseconds.
+	 * @details See the @ref getCoarseClockNs().
+	 */
+	static int64_t getCoarseClockNs() noexcept { return ::getCoarseClockNs(); }
+	/**
+	 * @brief Returns raw CPU cycle counter value.
+	 * @details See the @ref getCycleCount().
+	 */
+	static uint64_t getCycleCount() noexcept { return ::getCycleCount(); }
+	/**
+	 * @brief Returns CPU cycle counter frequency in hertz.
+	 * @details See the @ref getCycleFrequency().
+	 */
+	static uint64_t getCycleFrequency() noexcept { return ::getCycleFrequency(); }
+	/**
+	 * @brief Converts CPU cycle counter value difference to the nanoseconds.
+	 * @details See the @ref convertCyclesToNs().
+	 * @param cycles CPU cycle counter value or difference
+	 */
+	static int64_t convertCyclesToNs(uint64_t cycles) noexcept { return ::convertCyclesToNs(cycles); }
+	/**
+	 * @brief Samples wall, monotonic and CPU cycle clocks at the same moment.
+	 * @details See the @ref getClockCorrelation().
+	 */
+	static ClockCorrelation getClockCorrelation() noexcept
+	{
+		ClockCorrelation clockCorrelation;
+		::getClockCorrelation(&clockCorrelation);
+		return clockCorrelation;
+	}
+
+	/**
+	 * @brief Returns cached system information snapshot. (MT-Safe)
+	 * @details See the @ref getSystemInfo().
+	 */
+	static SystemInfo getSystemInfo() noexcept
+	{
+		SystemInfo systemInfo;
+		::getSystemInfo(&systemInfo);
+		return systemInfo;
+	}
+	/**
+	 * @brief Refreshes cached system information snapshot. (MT-Safe)
+	 * @details See the @ref updateSystemInfo().
+	 * @throw Error if failed to update system information.
+	 */
+	static void updateSystemInfo()
+	{
+		if (!::updateSystemInfo())
+			throw Error("Failed to update system information.");
+	}
+
+	/**
+	 * @brief Returns system CPU cache and topology information.
+	 * @details See the @ref createCpuTopology().
+	 * @throw Error if failed to get CPU topology.
+	 */
+	static CpuTopology getCpuTopology()
+	{
+		auto instance = createCpuTopology();
+		if (!instance)
+			throw Error("Failed to get CPU topology.");
+
+		CpuTopology cpuTopology;
+		cpuTopology.caches.assign(instance->caches, instance->caches + instance->cacheCount);
+		cpuTopology.cores.assign(instance->cores, instance->cores + instance->coreCount);
+		cpuTopology.packages.assign(instance->packages, instance->packages + instance->packageCount);
+		cpuTopology.nodes.assign(instance->nodes, instance->nodes + instance->nodeCount);
+		cpuTopology.onlineCpus = instance->onlineCpus;
+		cpuTopology.cacheLineSize = instance->cacheLineSize;
+		cpuTopology.lastCacheLevel = instance->lastCacheLevel;
+		destroyCpuTopology(instance);
+		return cpuTopology;
+	}
 
 	/**
 	 * @brief Returns system logical CPU count. (MT-Safe)
@@ -87,6 +200,19 @@ public:
 		return cpuCount;
 	}
 
+	/**
+	 * @brief Returns system performance and efficiency core logical CPU sets.
+	 * @details See the @ref getHybridCpuSets().
+	 *
+	 * @param[out] performanceCpus performance core logical CPU set
+	 * @param[out] efficiencyCpus efficiency core logical CPU set
+	 * @return True if CPU is hybrid, otherwise false and all logical CPUs are reported as performance.
+	 */
+	static bool getHybridCpuSets(CpuSet& performanceCpus, CpuSet& efficiencyCpus) noexcept
+	{
+		return ::getHybridCpuSets(&performanceCpus, &efficiencyCpus);
+	}
+
 	/**
 	 * @brief Returns system total physical RAM size. (MT-Safe)
 	 * @details See the @ref getTotalRamSize().
@@ -113,6 +239,49 @@ public:
 		return ramSize;
 	}
 
+	/**
+	 * @brief Returns CPU count available to the process. (MT-Safe)
+	 * @details See the @ref getEffectiveCpuCount().
+	 */
+	static int getEffectiveCpuCount() noexcept { return ::getEffectiveCpuCount(); }
+
+	/**
+	 * @brief Returns RAM size available to the process. (MT-Safe)
+	 * @details See the @ref getEffectiveRamSize().
+	 * @throw Error if failed to get effective RAM size.
+	 */
+	static int64_t getEffectiveRamSize()
+	{
+		auto ramSize = ::getEffectiveRamSize();
+		if (ramSize <= 0)
+			throw Error("Failed to get effective RAM size.");
+		return ramSize;
+	}
+
+	/**
+	 * @brief Returns process, thread or children resource usage counters. (MT-Safe)
+	 * @details See the @ref getResourceUsage().
+	 * @param target resource usage measurement target
+	 * @throw Error if failed to get resource usage.
+	 */
+	static ResourceUsage getResourceUsage(ResourceUsageTarget target = PROCESS_RESOURCE_USAGE_TARGET)
+	{
+		ResourceUsage resourceUsage;
+		if (!::getResourceUsage(target, &resourceUsage))
+			throw Error("Failed to get resource usage.");
+		return resourceUsage;
+	}
+	/**
+	 * @brief Returns CPU time consumed by the calling thread in nanoseconds. (MT-Safe)
+	 * @details See the @ref getThreadCpuTimeNs().
+	 */
+	static int64_t getThreadCpuTimeNs() noexcept { return ::getThreadCpuTimeNs(); }
+	/**
+	 * @brief Returns CPU time consumed by the current process in nanoseconds. (MT-Safe)
+	 * @details See the @ref getProcessCpuTimeNs().
+	 */
+	static int64_t getProcessCpuTimeNs() noexcept { return ::getProcessCpuTimeNs(); }
+
 	/**
 	 * @brief Returns system CPU name string. (MT-Safe)
 	 * @details See the @ref getCpuName().
@@ -128,6 +297,43 @@ public:
 		return cpuString;
 	}
 
+	/**
+	 * @brief Returns supported CPU feature bit mask. (MT-Safe)
+	 * @details See the @ref getCpuFeatures().
+	 */
+	static uint64_t getCpuFeatures() noexcept { return ::getCpuFeatures(); }
+	/**
+	 * @brief Returns true if CPU feature is supported. (MT-Safe)
+	 * @details See the @ref hasCpuFeature().
+	 * @param feature target CPU feature type
+	 */
+	static bool hasCpuFeature(CpuFeature feature) noexcept { return ::hasCpuFeature(feature); }
+	/**
+	 * @brief Returns CPU feature name string. ("AVX2", "NEON", etc.)
+	 * @param feature target CPU feature type
+	 */
+	static string_view getCpuFeatureName(CpuFeature feature) noexcept { return ::getCpuFeatureName(feature); }
+
+	/**
+	 * @brief Returns the first function variant supported by the CPU. (MT-Safe)
+	 * @details See the @ref selectCpuFunction().
+	 *
+	 * @tparam F function pointer type
+	 * @param variants function pointer and required CPU feature bit mask pairs
+	 * @throw Error if none of the variants is supported.
+	 */
+	template<typename F>
+	static F selectCpuFunction(initializer_list<pair<F, uint64_t>> variants)
+	{
+		auto features = ::getCpuFeatures();
+		for (const auto& variant : variants)
+		{
+			if ((variant.second & features) == variant.second)
+				return variant.first;
+		}
+		throw Error("No supported CPU function variant.");
+	}
+
 	/**
 	 * @brief Executes specified file with arguments. (MT-Safe)
 	 * @details See the @ref executeFileA().
@@ -0,0 +1,246 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Child process launching functions.
+ * @details See the @ref process.h
+ */
+
+#pragma once
+#include "mpio/error.hpp"
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+extern "C"
+{
+#include "mpio/process.h"
+}
+
+namespace mpio
+{
+
+using namespace std;
+
+/**
+ * @brief Child process exit code and captured output.
+ */
+struct ProcessResult
+{
+	string stdoutData; /**< Captured stdout data. (PIPE_PROCESS_STREAM) */
+	string stderrData; /**< Captured stderr data. (PIPE_PROCESS_STREAM) */
+	int exitCode = -1; /**< Program exit code or -1 if failed to launch, process stopped or crashed. */
+};
+
+/**
+ * @brief Child process instance.
+ * @details See the @ref process.h
+ */
+class Process
+{
+	::Process instance = nullptr;
+
+	static vector<char*> getArgs(const vector<string>& args)
+	{
+		vector<char*> argv(args.size() + 1);
+		for (size_t i = 0; i < args.size(); i++)
+			argv[i] = (char*)args[i].c_str();
+		argv[args.size()] = nullptr;
+		return argv;
+	}
+	friend class ProcessPool;
+public:
+	/**
+	 * @brief Starts specified file with arguments without waiting for it to exit. (MT-Safe)
+	 * @details See the @ref startProcess().
+	 *
+	 * @param[in] filePath executable file path or name string
+	 * @param[in] args program arguments, first is the program name
+	 * @param[in] options process launch options
+	 *
+	 * @throw Error if failed to start process.
+	 */
+	Process(const string& filePath, const vector<string>& args, const ProcessOptions& options = {})
+	{
+		auto argv = getArgs(args);
+		instance = startProcess(filePath.c_str(), argv.data(), &options);
+		if (!instance)
+			throw Error("Failed to start process.");
+	}
+	/**
+	 * @brief Destroys child process instance, kills it if still running.
+	 */
+	~Process() { destroyProcess(instance); }
+
+	Process(const Process&) = delete;
+	Process& operator=(const Process&) = delete;
+
+	Process(Process&& other) noexcept : instance(other.instance) { other.instance = nullptr; }
+	Process& operator=(Process&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyProcess(instance);
+			instance = other.instance;
+			other.instance = nullptr;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Returns child process file descriptor, readable when the process exits.
+	 * @details See the @ref getProcessFd().
+	 */
+	int getFd() const noexcept { return getProcessFd(instance); }
+	/**
+	 * @brief Kills child process.
+	 * @details See the @ref killProcess().
+	 */
+	bool kill() noexcept { return killProcess(instance); }
+	/**
+	 * @brief Returns true if child process has exited, without blocking.
+	 * @details See the @ref pollProcess().
+	 * @param[out] stats exited process statistics, or nullptr
+	 */
+	bool poll(ProcessStats* stats = nullptr) noexcept { return pollProcess(instance, stats); }
+	/**
+	 * @brief Waits for the child process to exit and returns its statistics.
+	 * @details See the @ref waitProcess().
+	 */
+	ProcessStats wait() noexcept
+	{
+		ProcessStats stats;
+		waitProcess(instance, &stats);
+		return stats;
+	}
+
+	/**
+	 * @brief Runs specified file with arguments and waits for it to exit. (MT-Safe)
+	 * @details See the @ref runProcess().
+	 *
+	 * @param[in] filePath executable file path or name string
+	 * @param[in] args program arguments, first is the program name
+	 * @param[in] options process launch options
+	 */
+	static ProcessResult run(const string& filePath, const vector<string>& args, const ProcessOptions& options = {})
+	{
+		auto argv = getArgs(args);
+
+		ProcessOutput output;
+		ProcessResult result;
+		result.exitCode = runProcess(filePath.c_str(), argv.data(), &options, &output);
+
+		if (output.stdoutData)
+		{
+			result.stdoutData.assign(output.stdoutData, output.stdoutSize);
+			free(output.stdoutData);
+		}
+		if (output.stderrData)
+		{
+			result.stderrData.assign(output.stderrData, output.stderrSize);
+			free(output.stderrData);
+		}
+		return result;
+	}
+};
+
+/**
+ * @brief Child process pool, runs queued jobs concurrently.
+ * @details See the @ref process.h
+ */
+class ProcessPool
+{
+	::ProcessPool instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new child process pool instance.
+	 * @details See the @ref createProcessPool().
+	 *
+	 * @param concurrency maximum running process count, or 0 for the getEffectiveCpuCount()
+	 * @throw Error if failed to create process pool.
+	 */
+	ProcessPool(uint32_t concurrency = 0)
+	{
+		instance = createProcessPool(concurrency);
+		if (!instance)
+			throw Error("Failed to create process pool.");
+	}
+	/**
+	 * @brief Destroys child process pool, waits for the running processes.
+	 */
+	~ProcessPool() { destroyProcessPool(instance); }
+
+	ProcessPool(const ProcessPool&) = delete;
+	ProcessPool& operator=(const ProcessPool&) = delete;
+
+	ProcessPool(ProcessPool&& other) noexcept : instance(other.instance) { other.instance = nullptr; }
+	ProcessPool& operator=(ProcessPool&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyProcessPool(instance);
+			instance = other.instance;
+			other.instance = nullptr;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Returns child process pool maximum running process count.
+	 */
+	uint32_t getConcurrency() const noexcept { return getProcessPoolConcurrency(instance); }
+	/**
+	 * @brief Returns child process pool queued, running and not yet returned completed job count.
+	 */
+	uint32_t getJobCount() const noexcept { return getProcessPoolJobCount(instance); }
+
+	/**
+	 * @brief Adds a new job to the child process pool queue.
+	 * @details See the @ref addProcessPoolJob().
+	 *
+	 * @param[in] filePath executable file path or name string
+	 * @param[in] args program arguments, first is the program name
+	 * @param[in] options process launch options
+	 * @param[in] userData arbitrary user data, returned with the completion
+	 *
+	 * @throw Error if failed to add process pool job.
+	 */
+	void add(const string& filePath, const vector<string>& args,
+		const ProcessOptions& options = {}, void* userData = nullptr)
+	{
+		auto argv = Process::getArgs(args);
+		if (!addProcessPoolJob(instance, filePath.c_str(), argv.data(), &options, userData))
+			throw Error("Failed to add process pool job.");
+	}
+
+	/**
+	 * @brief Starts queued jobs and returns completed ones without blocking.
+	 * @details See the @ref pollProcessPoolCompletions().
+	 */
+	uint32_t poll(ProcessCompletion* completions, uint32_t capacity) noexcept
+	{
+		return pollProcessPoolCompletions(instance, completions, capacity);
+	}
+	/**
+	 * @brief Starts queued jobs and waits for the completed ones.
+	 * @details See the @ref waitProcessPoolCompletions().
+	 */
+	uint32_t wait(ProcessCompletion* completions, uint32_t capacity, uint32_t minCount = 1) noexcept
+	{
+		return waitProcessPoolCompletions(instance, completions, capacity, minCount);
+	}
+};
+
+} // mpio
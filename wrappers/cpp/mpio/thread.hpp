@@ -0,0 +1,208 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Common thread functions.
+ * @details See the @ref thread.h
+ */
+
+#pragma once
+#include "mpio/error.hpp"
+#include <string>
+#include <functional>
+
+extern "C"
+{
+#include "mpio/thread.h"
+}
+
+namespace mpio
+{
+
+using namespace std;
+
+/**
+ * @brief Thread with a custom stack size, name, affinity and priority.
+ * @details Joins the thread on destruction. See the @ref thread.h
+ */
+class Thread
+{
+	::Thread instance = nullptr;
+
+	static void threadFunction(void* argument)
+	{
+		auto callback = (std::function<void()>*)argument;
+		(*callback)();
+		delete callback;
+	}
+public:
+	/**
+	 * @brief Creates a new empty thread.
+	 */
+	Thread() = default;
+
+	/**
+	 * @brief Creates and starts a new thread.
+	 * @details See the @ref createThread().
+	 *
+	 * @param function thread function
+	 * @param stackSize thread stack size in bytes, or 0 for the system default
+	 * @param[in] name thread name, truncated to the MAX_THREAD_NAME_LENGTH
+	 *
+	 * @throw Error if failed to create thread.
+	 */
+	Thread(function<void()> function, size_t stackSize = 0, const string& name = "")
+	{
+		auto argument = new std::function<void()>(std::move(function));
+		instance = createThread(threadFunction, argument, stackSize, name.empty() ? nullptr : name.c_str());
+		if (!instance)
+		{
+			delete argument;
+			throw Error("Failed to create thread.");
+		}
+	}
+	/**
+	 * @brief Waits for the thread function to return.
+	 */
+	~Thread() { destroyThread(instance); }
+
+	Thread(const Thread&) = delete;
+	Thread& operator=(const Thread&) = delete;
+
+	Thread(Thread&& other) noexcept : instance(other.instance) { other.instance = nullptr; }
+	Thread& operator=(Thread&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyThread(instance);
+			instance = other.instance;
+			other.instance = nullptr;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Returns true if thread is created and not joined yet.
+	 */
+	bool isJoinable() const noexcept { return instance; }
+	/**
+	 * @brief Waits for the thread function to return.
+	 * @details See the @ref destroyThread().
+	 */
+	void join() noexcept
+	{
+		destroyThread(instance);
+		instance = nullptr;
+	}
+
+	/**
+	 * @brief Sets thread name, visible in debuggers and profilers.
+	 * @details See the @ref setThreadName().
+	 * @param[in] name thread name
+	 * @throw Error if failed to set thread name.
+	 */
+	void setName(const string& name)
+	{
+		if (!instance || !setThreadName(instance, name.c_str()))
+			throw Error("Failed to set thread name.");
+	}
+	/**
+	 * @brief Pins thread to the logical CPU set.
+	 * @details See the @ref setThreadAffinity().
+	 * @param[in] cpuSet target logical CPU set
+	 * @throw Error if failed to set thread affinity.
+	 */
+	void setAffinity(const CpuSet& cpuSet)
+	{
+		if (!instance || !setThreadAffinity(instance, &cpuSet))
+			throw Error("Failed to set thread affinity.");
+	}
+	/**
+	 * @brief Returns thread logical CPU affinity set.
+	 * @details See the @ref getThreadAffinity().
+	 * @throw Error if failed to get thread affinity.
+	 */
+	CpuSet getAffinity() const
+	{
+		CpuSet cpuSet;
+		if (!instance || !getThreadAffinity(instance, &cpuSet))
+			throw Error("Failed to get thread affinity.");
+		return cpuSet;
+	}
+	/**
+	 * @brief Sets thread scheduling priority.
+	 * @details See the @ref setThreadPriority().
+	 * @param priority thread scheduling priority type
+	 * @throw Error if failed to set thread priority.
+	 */
+	void setPriority(ThreadPriority priority)
+	{
+		if (!instance || !setThreadPriority(instance, priority))
+			throw Error("Failed to set thread priority.");
+	}
+
+	/**
+	 * @brief Sets calling thread name, visible in debuggers and profilers.
+	 * @details See the @ref setThreadName().
+	 * @param[in] name thread name
+	 * @throw Error if failed to set thread name.
+	 */
+	static void setCurrentName(const string& name)
+	{
+		if (!setThreadName(nullptr, name.c_str()))
+			throw Error("Failed to set thread name.");
+	}
+	/**
+	 * @brief Pins calling thread to the logical CPU set.
+	 * @details See the @ref setThreadAffinity().
+	 * @param[in] cpuSet target logical CPU set
+	 * @throw Error if failed to set thread affinity.
+	 */
+	static void setCurrentAffinity(const CpuSet& cpuSet)
+	{
+		if (!setThreadAffinity(nullptr, &cpuSet))
+			throw Error("Failed to set thread affinity.");
+	}
+	/**
+	 * @brief Returns calling thread logical CPU affinity set.
+	 * @details See the @ref getThreadAffinity().
+	 * @throw Error if failed to get thread affinity.
+	 */
+	static CpuSet getCurrentAffinity()
+	{
+		CpuSet cpuSet;
+		if (!getThreadAffinity(nullptr, &cpuSet))
+			throw Error("Failed to get thread affinity.");
+		return cpuSet;
+	}
+	/**
+	 * @brief Sets calling thread scheduling priority.
+	 * @details See the @ref setThreadPriority().
+	 * @param priority thread scheduling priority type
+	 * @throw Error if failed to set thread priority.
+	 */
+	static void setCurrentPriority(ThreadPriority priority)
+	{
+		if (!setThreadPriority(nullptr, priority))
+			throw Error("Failed to set thread priority.");
+	}
+	/**
+	 * @brief Returns logical CPU index the calling thread is running on.
+	 * @details See the @ref getCurrentThreadCpu().
+	 */
+	static int getCurrentCpu() noexcept { return getCurrentThreadCpu(); }
+};
+
+} // mpio
@@ -0,0 +1,108 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Scoped tracing zones with the Chrome trace export.
+ * @details See the @ref trace.h
+ */
+
+#pragma once
+#include "mpio/error.hpp"
+
+extern "C"
+{
+#include "mpio/trace.h"
+}
+
+namespace mpio
+{
+
+using namespace std;
+
+/**
+ * @brief Trace session functions.
+ * @details See the @ref trace.h
+ */
+class Trace final
+{
+public:
+	/**
+	 * @brief Starts writing trace events to the application data directory file.
+	 * @details See the @ref startTracing().
+	 *
+	 * @param appName target application name string
+	 * @throw Error if failed to start tracing.
+	 */
+	static void start(const string& appName)
+	{
+		if (!startTracing(appName.c_str()))
+			throw Error("Failed to start tracing.");
+	}
+	/**
+	 * @brief Stops tracing and flushes remaining events to the trace file.
+	 */
+	static void stop() noexcept { stopTracing(); }
+	/**
+	 * @brief Returns true if tracing is started. (MT-Safe)
+	 */
+	static bool isActive() noexcept { return isTracing(); }
+	/**
+	 * @brief Returns current trace file path, or empty string if tracing is not started.
+	 */
+	static string getFilePath()
+	{
+		auto path = getTraceFilePath();
+		return path ? string(path) : string();
+	}
+	/**
+	 * @brief Returns trace event count dropped due to the full buffers. (MT-Safe)
+	 */
+	static uint64_t getDroppedCount() noexcept { return getTraceDroppedCount(); }
+};
+
+/**
+ * @brief Trace zone which ends on the scope exit.
+ * @note Name string should be valid until the trace is stopped, use string literals.
+ */
+class TraceZone final
+{
+public:
+	/**
+	 * @brief Begins a new trace zone on the calling thread. (MT-Safe)
+	 * @param[in] name target zone name literal
+	 */
+	explicit TraceZone(const char* name) noexcept { beginTraceZone(name); }
+	/**
+	 * @brief Ends the trace zone on the calling thread. (MT-Safe)
+	 */
+	~TraceZone() { endTraceZone(); }
+
+	TraceZone(const TraceZone&) = delete;
+	TraceZone& operator=(const TraceZone&) = delete;
+};
+
+} // mpio
+
+#if MPIO_ENABLE_TRACING
+#define MPIO_TRACE_CONCAT_IMPL(a, b) a##b
+#define MPIO_TRACE_CONCAT(a, b) MPIO_TRACE_CONCAT_IMPL(a, b)
+/**
+ * @brief Traces current scope, if tracing is enabled.
+ * @param name target zone name literal
+ */
+#define MPIO_TRACE_ZONE(name) mpio::TraceZone MPIO_TRACE_CONCAT(_mpioTraceZone, __LINE__)(name)
+#else
+#define MPIO_TRACE_ZONE(name) ((void)0)
+#endif
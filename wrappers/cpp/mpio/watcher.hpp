@@ -0,0 +1,143 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief File system watcher functions.
+ * @details See the @ref watcher.h
+ */
+
+#pragma once
+#include "mpio/error.hpp"
+#include <cstdint>
+#include <memory>
+#include <filesystem>
+#include <functional>
+
+extern "C"
+{
+#include "mpio/watcher.h"
+}
+
+namespace mpio
+{
+
+using namespace std;
+
+/**
+ * @brief File system watcher, delivers coalesced and debounced change events.
+ * @details See the @ref watcher.h
+ */
+class Watcher
+{
+public:
+	/**
+	 * @brief Watch events batch function.
+	 */
+	using Function = function<void(const WatchEvent* events, uint32_t eventCount)>;
+private:
+	::Watcher instance = nullptr;
+	unique_ptr<Function> callback;
+
+	static void onEvents(const WatchEvent* events, uint32_t eventCount, void* argument)
+	{
+		(*(Function*)argument)(events, eventCount);
+	}
+	template<typename F>
+	static void pollFunction(const WatchEvent* events, uint32_t eventCount, void* argument)
+	{
+		(*(F*)argument)(events, eventCount);
+	}
+public:
+	/**
+	 * @brief Creates a new file system watcher with polling.
+	 * @details See the @ref createWatcher().
+	 *
+	 * @param[in] path target directory path
+	 * @param isRecursive also watch all subdirectories
+	 * @param debounceDelay batch delivery delay after the last event in milliseconds
+	 *
+	 * @throw Error if failed to create file system watcher.
+	 */
+	Watcher(const filesystem::path& path, bool isRecursive = true, uint32_t debounceDelay = 50)
+	{
+		instance = createWatcher(path.generic_string().c_str(), isRecursive, debounceDelay, nullptr, nullptr);
+		if (!instance)
+			throw Error("Failed to create file system watcher.");
+	}
+	/**
+	 * @brief Creates a new file system watcher with the events function.
+	 * @details See the @ref createWatcher().
+	 * @warning Function is called from the watcher background thread!
+	 *
+	 * @param[in] path target directory path
+	 * @param onEvents watch events batch function
+	 * @param isRecursive also watch all subdirectories
+	 * @param debounceDelay batch delivery delay after the last event in milliseconds
+	 *
+	 * @throw Error if failed to create file system watcher.
+	 */
+	Watcher(const filesystem::path& path, Function onEvents, bool isRecursive = true, uint32_t debounceDelay = 50) :
+		callback(make_unique<Function>(std::move(onEvents)))
+	{
+		instance = createWatcher(path.generic_string().c_str(),
+			isRecursive, debounceDelay, Watcher::onEvents, callback.get());
+		if (!instance)
+			throw Error("Failed to create file system watcher.");
+	}
+	/**
+	 * @brief Destroys file system watcher.
+	 */
+	~Watcher() { destroyWatcher(instance); }
+
+	Watcher(const Watcher&) = delete;
+	Watcher& operator=(const Watcher&) = delete;
+
+	Watcher(Watcher&& other) noexcept :
+		instance(other.instance), callback(std::move(other.callback)) { other.instance = nullptr; }
+	Watcher& operator=(Watcher&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyWatcher(instance);
+			instance = other.instance;
+			callback = std::move(other.callback);
+			other.instance = nullptr;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Returns file system watcher file descriptor, readable on a new event.
+	 * @details See the @ref getWatcherFd().
+	 */
+	int getFd() const noexcept { return getWatcherFd(instance); }
+	/**
+	 * @brief Returns time until the pending events batch is ready in milliseconds, or -1.
+	 * @details See the @ref getWatcherTimeout().
+	 */
+	int32_t getTimeout() const noexcept { return getWatcherTimeout(instance); }
+
+	/**
+	 * @brief Reads new events and delivers the batch if it is ready, without blocking.
+	 * @details See the @ref pollWatcherEvents().
+	 *
+	 * @param[in] onEvents watch events batch function: void(const WatchEvent* events, uint32_t eventCount)
+	 * @return Delivered watch event count.
+	 */
+	template<typename F>
+	uint32_t poll(const F& onEvents) { return pollWatcherEvents(instance, pollFunction<const F>, (void*)&onEvents); }
+};
+
+} // mpio